@@ -74,7 +74,10 @@
 #include <boost/asio/connect.hpp>
 #include <boost/asio/connect_pipe.hpp>
 #include <boost/asio/consign.hpp>
+#include <boost/asio/context_metrics.hpp>
+#include <boost/asio/context_options.hpp>
 #include <boost/asio/coroutine.hpp>
+#include <boost/asio/current_processor.hpp>
 #include <boost/asio/deadline_timer.hpp>
 #include <boost/asio/defer.hpp>
 #include <boost/asio/deferred.hpp>
@@ -156,6 +159,7 @@
 #include <boost/asio/post.hpp>
 #include <boost/asio/prefer.hpp>
 #include <boost/asio/prepend.hpp>
+#include <boost/asio/provided_buffer_pool.hpp>
 #include <boost/asio/query.hpp>
 #include <boost/asio/random_access_file.hpp>
 #include <boost/asio/read.hpp>
@@ -169,6 +173,8 @@
 #include <boost/asio/require_concept.hpp>
 #include <boost/asio/serial_port.hpp>
 #include <boost/asio/serial_port_base.hpp>
+#include <boost/asio/sharded_acceptor.hpp>
+#include <boost/asio/sharded_context.hpp>
 #include <boost/asio/signal_set.hpp>
 #include <boost/asio/signal_set_base.hpp>
 #include <boost/asio/socket_base.hpp>
@@ -182,6 +188,7 @@
 #include <boost/asio/system_timer.hpp>
 #include <boost/asio/this_coro.hpp>
 #include <boost/asio/thread_pool.hpp>
+#include <boost/asio/thread_pool_elasticity.hpp>
 #include <boost/asio/time_traits.hpp>
 #include <boost/asio/use_awaitable.hpp>
 #include <boost/asio/use_future.hpp>
@@ -1223,6 +1223,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_send(basic_datagram_socket* self)
       : self_(self)
@@ -1257,6 +1258,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_send_to(basic_datagram_socket* self)
       : self_(self)
@@ -1291,6 +1293,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_receive(basic_datagram_socket* self)
       : self_(self)
@@ -1325,6 +1328,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_receive_from(basic_datagram_socket* self)
       : self_(self)
@@ -617,6 +617,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_write_some_at(basic_random_access_file* self)
       : self_(self)
@@ -650,6 +651,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_read_some_at(basic_random_access_file* self)
       : self_(self)
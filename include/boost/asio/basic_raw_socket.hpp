@@ -1217,6 +1217,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_send(basic_raw_socket* self)
       : self_(self)
@@ -1251,6 +1252,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_send_to(basic_raw_socket* self)
       : self_(self)
@@ -1285,6 +1287,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_receive(basic_raw_socket* self)
       : self_(self)
@@ -1319,6 +1322,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_receive_from(basic_raw_socket* self)
       : self_(self)
@@ -579,6 +579,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_read_some(basic_readable_pipe* self)
       : self_(self)
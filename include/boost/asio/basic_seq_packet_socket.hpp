@@ -751,6 +751,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_send(basic_seq_packet_socket* self)
       : self_(self)
@@ -909,6 +909,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_write_some(basic_serial_port* self)
       : self_(self)
@@ -942,6 +943,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_read_some(basic_serial_port* self)
       : self_(self)
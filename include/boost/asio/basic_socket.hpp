@@ -19,6 +19,7 @@
 #include <boost/asio/any_io_executor.hpp>
 #include <boost/asio/detail/config.hpp>
 #include <boost/asio/async_result.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/handler_type_requirements.hpp>
 #include <boost/asio/detail/io_object_impl.hpp>
 #include <boost/asio/detail/non_const_lvalue.hpp>
@@ -67,7 +68,9 @@ class basic_socket
   : public socket_base
 {
 private:
+  class initiate_async_close;
   class initiate_async_connect;
+  class initiate_async_shutdown;
   class initiate_async_wait;
 
 public:
@@ -543,6 +546,73 @@ public:
     BOOST_ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+  /// Start an asynchronous operation to close the socket.
+  /**
+   * This function is used to close the socket without waiting for the
+   * underlying descriptor to be released, which may block if the socket has
+   * been set to linger. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * The socket object is closed before this function returns. Any asynchronous
+   * send, receive or connect operations will be cancelled immediately, and
+   * will complete with the boost::asio::error::operation_aborted error, and
+   * the socket object may be reopened or destroyed at once. The underlying
+   * descriptor is closed by the kernel when the io_uring backend is used, and
+   * otherwise on a helper thread.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the underlying descriptor
+   * has been closed. Potential completion tokens include @ref use_future, @ref
+   * use_awaitable, @ref yield_context, or a function object with the correct
+   * completion signature. The function signature of the completion handler
+   * must be:
+   * @code void handler(
+   *   const boost::system::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code) @endcode
+   *
+   * @par Example
+   * @code
+   * void close_handler(const boost::system::error_code& error)
+   * {
+   *   if (error)
+   *   {
+   *     // An error occurred.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * boost::asio::ip::tcp::socket socket(my_context);
+   * ...
+   * socket.set_option(boost::asio::socket_base::linger(true, 30));
+   * socket.async_close(close_handler);
+   * @endcode
+   *
+   * @note As with close(), the underlying descriptor is closed even if the
+   * completion handler is passed an error. If the context is not run by more
+   * than one thread, as indicated by its concurrency hint, the descriptor is
+   * closed immediately when the io_uring backend is not used.
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code))
+        CloseToken = default_completion_token_t<executor_type>>
+  auto async_close(
+      CloseToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<CloseToken, void (boost::system::error_code)>(
+          declval<initiate_async_close>(), token))
+  {
+    return async_initiate<CloseToken, void (boost::system::error_code)>(
+        initiate_async_close(this), token);
+  }
+
   /// Release ownership of the underlying native socket.
   /**
    * This function causes all outstanding asynchronous connect, send and receive
@@ -701,6 +771,76 @@ public:
     BOOST_ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+  /// Move the socket to the calling thread's own reactor.
+  /**
+   * This function is used when the socket's execution context was created
+   * with the context_options::per_thread_reactors() option. When called from
+   * a thread that is running the context, the socket is moved to that
+   * thread's reactor, so that the completions of its asynchronous operations
+   * run on the thread from then on. When called from any other thread, the
+   * socket is moved to the least loaded reactor. Otherwise, the function has
+   * no effect.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  void migrate()
+  {
+    boost::system::error_code ec;
+    impl_.get_service().migrate(impl_.get_implementation(), ec);
+    boost::asio::detail::throw_error(ec, "migrate");
+  }
+
+  /// Move the socket to the calling thread's own reactor.
+  /**
+   * This function is used when the socket's execution context was created
+   * with the context_options::per_thread_reactors() option. When called from
+   * a thread that is running the context, the socket is moved to that
+   * thread's reactor, so that the completions of its asynchronous operations
+   * run on the thread from then on. When called from any other thread, the
+   * socket is moved to the least loaded reactor. Otherwise, the function has
+   * no effect.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  BOOST_ASIO_SYNC_OP_VOID migrate(boost::system::error_code& ec)
+  {
+    impl_.get_service().migrate(impl_.get_implementation(), ec);
+    BOOST_ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Get the number of speculative operations on the socket that completed
+  /// at once.
+  /**
+   * An asynchronous operation started on a socket is first attempted at once,
+   * if the socket may be ready, and only waits for the reactor if the attempt
+   * would block. This function returns the number of such attempts that
+   * completed the operation. It returns 0 if the socket is not open or if
+   * the reactor does not count speculative operations.
+   */
+  uint64_t speculative_hits() const
+  {
+    uint64_t hits = 0, misses = 0;
+    impl_.get_service().speculative_counts(
+        impl_.get_implementation(), hits, misses);
+    return hits;
+  }
+
+  /// Get the number of speculative operations on the socket that would have
+  /// blocked.
+  /**
+   * This function returns the number of attempts to complete an asynchronous
+   * operation at once that would have blocked, each of which cost a wasted
+   * system call. It returns 0 if the socket is not open or if the reactor
+   * does not count speculative operations.
+   */
+  uint64_t speculative_misses() const
+  {
+    uint64_t hits = 0, misses = 0;
+    impl_.get_service().speculative_counts(
+        impl_.get_implementation(), hits, misses);
+    return misses;
+  }
+
   /// Determine whether the socket is at the out-of-band data mark.
   /**
    * This function is used to check whether the socket input is currently
@@ -1711,6 +1851,68 @@ public:
     BOOST_ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+  /// Start an asynchronous operation to disable sends or receives on the
+  /// socket.
+  /**
+   * This function is used to asynchronously disable send operations, receive
+   * operations, or both. It is an initiating function for an @ref
+   * asynchronous_operation, and always returns immediately.
+   *
+   * When the io_uring backend is used, the shutdown is performed by the kernel
+   * after any outstanding asynchronous send operations on the socket have
+   * completed. Other backends perform the shutdown immediately, as a shutdown
+   * does not wait for the peer, and only the completion is deferred.
+   *
+   * @param what Determines what types of operation will no longer be allowed.
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called when the shutdown completes.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code) @endcode
+   *
+   * @par Example
+   * Shutting down the send side of the socket:
+   * @code
+   * void shutdown_handler(const boost::system::error_code& error)
+   * {
+   *   if (!error)
+   *   {
+   *     // Shutdown succeeded.
+   *   }
+   * }
+   *
+   * ...
+   *
+   * boost::asio::ip::tcp::socket socket(my_context);
+   * ...
+   * socket.async_shutdown(
+   *     boost::asio::ip::tcp::socket::shutdown_send, shutdown_handler);
+   * @endcode
+   */
+  template <
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code))
+        ShutdownToken = default_completion_token_t<executor_type>>
+  auto async_shutdown(shutdown_type what,
+      ShutdownToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ShutdownToken, void (boost::system::error_code)>(
+          declval<initiate_async_shutdown>(), token, what))
+  {
+    return async_initiate<ShutdownToken, void (boost::system::error_code)>(
+        initiate_async_shutdown(this), token, what);
+  }
+
   /// Wait for the socket to become ready to read, ready to write, or to have
   /// pending error conditions.
   /**
@@ -1858,6 +2060,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_connect(basic_socket* self)
       : self_(self)
@@ -1897,6 +2100,70 @@ private:
     basic_socket* self_;
   };
 
+  class initiate_async_close
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_close(basic_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename CloseHandler>
+    void operator()(CloseHandler&& handler) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a CloseHandler.
+      BOOST_ASIO_WAIT_HANDLER_CHECK(CloseHandler, handler) type_check;
+
+      detail::non_const_lvalue<CloseHandler> handler2(handler);
+      self_->impl_.get_service().async_close(
+          self_->impl_.get_implementation(),
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_socket* self_;
+  };
+
+  class initiate_async_shutdown
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_shutdown(basic_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ShutdownHandler>
+    void operator()(ShutdownHandler&& handler, shutdown_type what) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a ShutdownHandler.
+      BOOST_ASIO_WAIT_HANDLER_CHECK(ShutdownHandler, handler) type_check;
+
+      detail::non_const_lvalue<ShutdownHandler> handler2(handler);
+      self_->impl_.get_service().async_shutdown(
+          self_->impl_.get_implementation(), what,
+          handler2.value, self_->impl_.get_executor());
+    }
+
+  private:
+    basic_socket* self_;
+  };
+
   class initiate_async_wait
   {
   public:
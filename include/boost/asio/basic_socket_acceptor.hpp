@@ -86,6 +86,7 @@ private:
   class initiate_async_wait;
   class initiate_async_accept;
   class initiate_async_move_accept;
+  class initiate_async_accept_many;
 
 public:
   /// The type of the executor associated with the object.
@@ -784,6 +785,43 @@ public:
     BOOST_ASIO_SYNC_OP_VOID_RETURN(ec);
   }
 
+  /// Move the acceptor to the calling thread's own reactor.
+  /**
+   * This function is used when the acceptor's execution context was created
+   * with the context_options::per_thread_reactors() option. When called from
+   * a thread that is running the context, the acceptor is moved to that
+   * thread's reactor, so that the completions of its asynchronous operations
+   * run on the thread from then on. When called from any other thread, the
+   * acceptor is moved to the least loaded reactor. Otherwise, the function has
+   * no effect.
+   *
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  void migrate()
+  {
+    boost::system::error_code ec;
+    impl_.get_service().migrate(impl_.get_implementation(), ec);
+    boost::asio::detail::throw_error(ec, "migrate");
+  }
+
+  /// Move the acceptor to the calling thread's own reactor.
+  /**
+   * This function is used when the acceptor's execution context was created
+   * with the context_options::per_thread_reactors() option. When called from
+   * a thread that is running the context, the acceptor is moved to that
+   * thread's reactor, so that the completions of its asynchronous operations
+   * run on the thread from then on. When called from any other thread, the
+   * acceptor is moved to the least loaded reactor. Otherwise, the function has
+   * no effect.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  BOOST_ASIO_SYNC_OP_VOID migrate(boost::system::error_code& ec)
+  {
+    impl_.get_service().migrate(impl_.get_implementation(), ec);
+    BOOST_ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
   /// Set an option on the acceptor.
   /**
    * This function is used to set an option on the acceptor.
@@ -2581,6 +2619,92 @@ public:
               typename ExecutionContext::executor_type>::other*>(0));
   }
 
+  /// Start an asynchronous accept of a stream of connections.
+  /**
+   * This function is used to asynchronously accept new connections until an
+   * error occurs or the operation is cancelled. It is an initiating function
+   * for an @ref asynchronous_operation, and always returns immediately.
+   *
+   * Where the platform allows it, a single accept request is kept running for
+   * the whole operation, so that new connections are accepted without waiting
+   * for earlier ones to be handled. The number of accepted connections that
+   * may wait for the connection handler is limited by
+   * context_options::max_pending_accepts(). Otherwise, connections are
+   * accepted one at a time.
+   *
+   * This overload requires that the Protocol template parameter satisfy the
+   * AcceptableProtocol type requirements.
+   *
+   * @param connection_handler The function object to be invoked with each
+   * newly accepted socket. It is invoked using the completion handler's
+   * associated executor, and must be callable as:
+   * @code void connection_handler(
+   *   typename Protocol::socket::template
+   *     rebind_executor<executor_type>::other peer
+   * ); @endcode
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called once no more connections will be
+   * accepted, and all accepted connections have been passed to the connection
+   * handler. Potential completion tokens include @ref use_future,
+   * @ref use_awaitable, @ref yield_context, or a function object with the
+   * correct completion signature. The function signature of the completion
+   * handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code) @endcode
+   *
+   * @par Example
+   * @code
+   * void connection_handler(boost::asio::ip::tcp::socket peer)
+   * {
+   *   // Start using the new connection.
+   * }
+   *
+   * void accept_many_handler(const boost::system::error_code& error)
+   * {
+   *   // No more connections will be accepted.
+   * }
+   *
+   * ...
+   *
+   * boost::asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * acceptor.async_accept_many(connection_handler, accept_many_handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename ConnectionHandler,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code))
+        AcceptManyToken = default_completion_token_t<executor_type>>
+  auto async_accept_many(ConnectionHandler&& connection_handler,
+      AcceptManyToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<AcceptManyToken, void (boost::system::error_code)>(
+        declval<initiate_async_accept_many>(), token,
+        static_cast<ConnectionHandler&&>(connection_handler)))
+  {
+    return async_initiate<AcceptManyToken, void (boost::system::error_code)>(
+        initiate_async_accept_many(this), token,
+        static_cast<ConnectionHandler&&>(connection_handler));
+  }
+
 private:
   // Disallow copying and assignment.
   basic_socket_acceptor(const basic_socket_acceptor&) = delete;
@@ -2623,6 +2747,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_accept(basic_socket_acceptor* self)
       : self_(self)
@@ -2657,6 +2782,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_move_accept(basic_socket_acceptor* self)
       : self_(self)
@@ -2687,6 +2813,42 @@ private:
     basic_socket_acceptor* self_;
   };
 
+  class initiate_async_accept_many
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_accept_many(basic_socket_acceptor* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename AcceptManyHandler, typename ConnectionHandler>
+    void operator()(AcceptManyHandler&& handler,
+        ConnectionHandler&& connection_handler) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WaitHandler.
+      BOOST_ASIO_WAIT_HANDLER_CHECK(AcceptManyHandler, handler) type_check;
+
+      detail::non_const_lvalue<AcceptManyHandler> handler2(handler);
+      detail::non_const_lvalue<ConnectionHandler> connection_handler2(
+          connection_handler);
+      self_->impl_.get_service().async_accept_many(
+          self_->impl_.get_implementation(), self_->impl_.get_executor(),
+          connection_handler2.value, handler2.value,
+          self_->impl_.get_executor());
+    }
+
+  private:
+    basic_socket_acceptor* self_;
+  };
+
 #if defined(BOOST_ASIO_WINDOWS_RUNTIME)
   detail::io_object_impl<
     detail::null_socket_service<Protocol>, Executor> impl_;
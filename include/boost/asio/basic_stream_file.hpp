@@ -672,6 +672,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_write_some(basic_stream_file* self)
       : self_(self)
@@ -705,6 +706,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_read_some(basic_stream_file* self)
       : self_(self)
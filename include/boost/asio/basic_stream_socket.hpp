@@ -23,6 +23,7 @@
 #include <boost/asio/detail/non_const_lvalue.hpp>
 #include <boost/asio/detail/throw_error.hpp>
 #include <boost/asio/error.hpp>
+#include <boost/asio/provided_buffer_pool.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -64,6 +65,7 @@ class basic_stream_socket
 private:
   class initiate_async_send;
   class initiate_async_receive;
+  class initiate_async_receive_many;
 
 public:
   /// The type of the executor associated with the object.
@@ -822,6 +824,98 @@ public:
         initiate_async_receive(this), token, buffers, flags);
   }
 
+  /// Start an asynchronous receive of a stream of data into pooled buffers.
+  /**
+   * This function is used to asynchronously receive data from the stream
+   * socket until the end of the stream is reached, an error occurs, or the
+   * operation is cancelled. Rather than being given a buffer up front, the
+   * operation takes a buffer from the pool each time data arrives, so that a
+   * socket waiting for data holds no buffer. Each buffer of received data is
+   * passed to the data handler, in the order in which the data was received,
+   * and is returned to the pool when the data handler has finished with it.
+   *
+   * With the io_uring backend, a single receive submission is kept running and
+   * the kernel selects the buffers. The number of buffers that may wait for
+   * the data handler is limited by context_options::max_pending_receives().
+   * Otherwise, the operation waits for the socket to become readable before
+   * taking a buffer and receiving into it.
+   *
+   * @param pool The pool from which buffers are taken. The pool must remain
+   * valid until the completion handler is called.
+   *
+   * @param data_handler The function object to be invoked with each buffer of
+   * received data. It is invoked using the completion handler's associated
+   * executor, and must be callable as:
+   * @code void data_handler(
+   *   boost::asio::leased_buffer buffer // The received data.
+   * ); @endcode
+   *
+   * @param token The @ref completion_token that will be used to produce a
+   * completion handler, which will be called once no more data will be
+   * received, and all received data has been passed to the data handler.
+   * Potential completion tokens include @ref use_future, @ref use_awaitable,
+   * @ref yield_context, or a function object with the correct completion
+   * signature. The function signature of the completion handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error // Result of operation.
+   * ); @endcode
+   * Regardless of whether the asynchronous operation completes immediately or
+   * not, the completion handler will not be invoked from within this function.
+   * On immediate completion, invocation of the handler will be performed in a
+   * manner equivalent to using boost::asio::async_immediate().
+   *
+   * @par Completion Signature
+   * @code void(boost::system::error_code) @endcode
+   *
+   * @note The operation completes with boost::asio::error::eof when the peer
+   * closes the connection, and with boost::asio::error::no_buffer_space when
+   * data arrives while all of the pool's buffers are leased. The operation may
+   * be started again once buffers have been returned to the pool.
+   *
+   * @par Example
+   * @code
+   * void data_handler(boost::asio::leased_buffer buffer)
+   * {
+   *   // Use the data in buffer.data().
+   * }
+   *
+   * void receive_many_handler(const boost::system::error_code& error)
+   * {
+   *   // No more data will be received.
+   * }
+   *
+   * ...
+   *
+   * boost::asio::provided_buffer_pool pool(my_context, 4096, 1024);
+   * socket.async_receive_many(pool, data_handler, receive_many_handler);
+   * @endcode
+   *
+   * @par Per-Operation Cancellation
+   * On POSIX or Windows operating systems, this asynchronous operation supports
+   * cancellation for the following boost::asio::cancellation_type values:
+   *
+   * @li @c cancellation_type::terminal
+   *
+   * @li @c cancellation_type::partial
+   *
+   * @li @c cancellation_type::total
+   */
+  template <typename DataHandler,
+      BOOST_ASIO_COMPLETION_TOKEN_FOR(void (boost::system::error_code))
+        ReceiveManyToken = default_completion_token_t<executor_type>>
+  auto async_receive_many(provided_buffer_pool& pool,
+      DataHandler&& data_handler,
+      ReceiveManyToken&& token = default_completion_token_t<executor_type>())
+    -> decltype(
+      async_initiate<ReceiveManyToken, void (boost::system::error_code)>(
+        declval<initiate_async_receive_many>(), token,
+        &pool, static_cast<DataHandler&&>(data_handler)))
+  {
+    return async_initiate<ReceiveManyToken, void (boost::system::error_code)>(
+        initiate_async_receive_many(this), token,
+        &pool, static_cast<DataHandler&&>(data_handler));
+  }
+
   /// Write some data to the socket.
   /**
    * This function is used to write data to the stream socket. The function call
@@ -1092,6 +1186,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_send(basic_stream_socket* self)
       : self_(self)
@@ -1126,6 +1221,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_receive(basic_stream_socket* self)
       : self_(self)
@@ -1155,6 +1251,41 @@ private:
   private:
     basic_stream_socket* self_;
   };
+
+  class initiate_async_receive_many
+  {
+  public:
+    typedef Executor executor_type;
+
+    explicit initiate_async_receive_many(basic_stream_socket* self)
+      : self_(self)
+    {
+    }
+
+    const executor_type& get_executor() const noexcept
+    {
+      return self_->get_executor();
+    }
+
+    template <typename ReceiveManyHandler, typename DataHandler>
+    void operator()(ReceiveManyHandler&& handler,
+        provided_buffer_pool* pool, DataHandler&& data_handler) const
+    {
+      // If you get an error on the following line it means that your handler
+      // does not meet the documented type requirements for a WaitHandler.
+      BOOST_ASIO_WAIT_HANDLER_CHECK(ReceiveManyHandler, handler) type_check;
+
+      detail::non_const_lvalue<ReceiveManyHandler> handler2(handler);
+      detail::non_const_lvalue<DataHandler> data_handler2(data_handler);
+      self_->impl_.get_service().async_receive_many(
+          self_->impl_.get_implementation(), *pool,
+          data_handler2.value, handler2.value,
+          self_->impl_.get_executor());
+    }
+
+  private:
+    basic_stream_socket* self_;
+  };
 };
 
 } // namespace asio
@@ -575,6 +575,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_write_some(basic_writable_pipe* self)
       : self_(self)
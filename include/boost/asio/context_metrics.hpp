@@ -0,0 +1,347 @@
+//
+// context_metrics.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_CONTEXT_METRICS_HPP
+#define BOOST_ASIO_CONTEXT_METRICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <boost/asio/detail/chrono.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class scheduler;
+class thread_metrics;
+class win_iocp_io_context;
+
+} // namespace detail
+
+/// A snapshot of the activity of the scheduler that underlies an execution
+/// context.
+/**
+ * Objects of this class are obtained by calling io_context::metrics() or
+ * thread_pool::metrics(). All counts are cumulative from the construction of
+ * the execution context.
+ *
+ * The spin, poll budget and io_uring counts are always collected. The
+ * remaining counts are collected only when context_options::collect_metrics()
+ * is set, and are otherwise zero. Each thread running the context keeps its
+ * own counters, which are added together when the snapshot is taken. Taking a
+ * snapshot does not lock the context's queue, so it may be done as often as
+ * needed from any thread, but counts that are updated by different threads
+ * may be slightly out of step with each other.
+ *
+ * @par Example
+ * @code boost::asio::context_metrics m = io_context.metrics();
+ * std::cout << "spin hit rate: "
+ *   << double(m.spin_hits()) / m.spin_count() << "\n"; @endcode
+ */
+class context_metrics
+{
+public:
+  /// The number of buckets in each histogram.
+  static constexpr std::size_t histogram_buckets = 32;
+
+  /// The time that a single thread has spent busy and idle.
+  struct thread_times
+  {
+    /// The time spent running handlers.
+    chrono::nanoseconds busy;
+
+    /// The time spent blocked waiting for work.
+    chrono::nanoseconds idle;
+  };
+
+  /// Default constructor. All counts are zero.
+  context_metrics() noexcept
+    : spin_count_(0),
+      spin_hits_(0),
+      spin_misses_(0),
+      spin_time_(0),
+      poll_budget_handler_hits_(0),
+      poll_budget_time_hits_(0),
+      enqueued_(0),
+      handlers_run_(0),
+      busy_time_(0),
+      idle_time_(0),
+      reactor_polls_(0),
+      reactor_events_(0),
+      registered_descriptors_(0),
+      descriptor_state_size_(0),
+      descriptor_state_memory_(0),
+      io_uring_cq_overflows_(0),
+      io_uring_sq_full_flushes_(0),
+      io_uring_submits_(0),
+      io_uring_submitted_entries_(0)
+  {
+    for (std::size_t i = 0; i < histogram_buckets; ++i)
+    {
+      queue_wait_histogram_[i] = 0;
+      poll_events_histogram_[i] = 0;
+    }
+  }
+
+  /// Get the number of times a thread spun while waiting for work.
+  uint64_t spin_count() const noexcept
+  {
+    return spin_count_;
+  }
+
+  /// Get the number of times that work arrived while a thread was spinning.
+  uint64_t spin_hits() const noexcept
+  {
+    return spin_hits_;
+  }
+
+  /// Get the number of times that a thread stopped spinning and blocked
+  /// because no work arrived within its spin budget.
+  uint64_t spin_misses() const noexcept
+  {
+    return spin_misses_;
+  }
+
+  /// Get the total time that threads have spent spinning.
+  /**
+   * Spinning threads do not yield the processor, so this is also the CPU time
+   * consumed by the spin-then-block idle policy.
+   */
+  chrono::nanoseconds spin_time() const noexcept
+  {
+    return spin_time_;
+  }
+
+  /// Get the number of times the reactor was polled early because the
+  /// handler budget was exhausted.
+  /**
+   * @see context_options::poll_budget_handlers().
+   */
+  uint64_t poll_budget_handler_hits() const noexcept
+  {
+    return poll_budget_handler_hits_;
+  }
+
+  /// Get the number of times the reactor was polled early because the time
+  /// budget was exhausted.
+  /**
+   * @see context_options::poll_budget_time().
+   */
+  uint64_t poll_budget_time_hits() const noexcept
+  {
+    return poll_budget_time_hits_;
+  }
+
+  /// Get the number of handlers that have been run.
+  uint64_t handlers_run() const noexcept
+  {
+    return handlers_run_;
+  }
+
+  /// Get the number of handlers that are waiting to be run.
+  /**
+   * This is the number of handlers that have been queued for execution but
+   * have not yet started running. It does not include asynchronous operations
+   * that have not yet completed.
+   */
+  uint64_t queue_depth() const noexcept
+  {
+    return enqueued_ > handlers_run_ ? enqueued_ - handlers_run_ : 0;
+  }
+
+  /// Get the total time that threads have spent running handlers.
+  chrono::nanoseconds busy_time() const noexcept
+  {
+    return busy_time_;
+  }
+
+  /// Get the total time that threads have spent blocked waiting for work.
+  /**
+   * This includes time spent blocked in the reactor, but not time spent
+   * spinning, which is reported by spin_time().
+   */
+  chrono::nanoseconds idle_time() const noexcept
+  {
+    return idle_time_;
+  }
+
+  /// Get the busy and idle times of each thread.
+  /**
+   * There is one entry for each thread that has run the context at the same
+   * time as the others. Counters are reused by a thread that starts running
+   * the context after another has stopped, so an entry may cover the
+   * activity of more than one thread.
+   */
+  const std::vector<thread_times>& threads() const noexcept
+  {
+    return threads_;
+  }
+
+  /// Get the number of times the reactor has been polled for events.
+  uint64_t reactor_polls() const noexcept
+  {
+    return reactor_polls_;
+  }
+
+  /// Get the total number of events returned by polls of the reactor.
+  /**
+   * Each ready descriptor, expired timer, or other completed operation
+   * returned by a single poll counts as one event.
+   */
+  uint64_t reactor_events() const noexcept
+  {
+    return reactor_events_;
+  }
+
+  /// Get the number of descriptors registered with the reactor.
+  uint64_t registered_descriptors() const noexcept
+  {
+    return registered_descriptors_;
+  }
+
+  /// Get the number of bytes of reactor state kept for each descriptor.
+  /**
+   * This is the size of the slot that holds the state of one registered
+   * descriptor, rounded up to a whole number of cache lines. It is zero if
+   * the reactor does not report its memory use.
+   */
+  uint64_t descriptor_state_size() const noexcept
+  {
+    return descriptor_state_size_;
+  }
+
+  /// Get the total number of bytes reserved for descriptor state.
+  /**
+   * This includes slots that are not currently in use, and is the memory
+   * obtained from the system for descriptor state since the context was
+   * created. Dividing it by registered_descriptors() gives the cost of each
+   * registered socket.
+   */
+  uint64_t descriptor_state_memory() const noexcept
+  {
+    return descriptor_state_memory_;
+  }
+
+  /// Get the number of io_uring completions that did not fit in the
+  /// completion queue.
+  /**
+   * This is the kernel's count of completion queue entries that were dropped,
+   * or deferred until the completion queue had room for them, because
+   * completions arrived faster than they were harvested. A steadily
+   * increasing count suggests that context_options::io_uring_cq_entries()
+   * should be raised. The count is zero unless io_uring is the context's I/O
+   * backend.
+   */
+  uint64_t io_uring_cq_overflows() const noexcept
+  {
+    return io_uring_cq_overflows_;
+  }
+
+  /// Get the number of times the io_uring submission queue was flushed early
+  /// because it was full.
+  /**
+   * The count is zero unless io_uring is the context's I/O backend.
+   */
+  uint64_t io_uring_sq_full_flushes() const noexcept
+  {
+    return io_uring_sq_full_flushes_;
+  }
+
+  /// Get the number of times entries were submitted to the io_uring
+  /// submission queue.
+  /**
+   * Each submission makes one @c io_uring_enter system call, unless a kernel
+   * thread polls the submission queue. The count is zero unless io_uring is
+   * the context's I/O backend.
+   */
+  uint64_t io_uring_submits() const noexcept
+  {
+    return io_uring_submits_;
+  }
+
+  /// Get the total number of entries submitted to the io_uring submission
+  /// queue.
+  /**
+   * Dividing it by io_uring_submits() gives the average number of entries
+   * per submission.
+   */
+  uint64_t io_uring_submitted_entries() const noexcept
+  {
+    return io_uring_submitted_entries_;
+  }
+
+  /// Get the number of handlers whose time spent waiting to run fell in a
+  /// histogram bucket.
+  /**
+   * The time is measured from when a handler is queued for execution to when
+   * it starts running. Bucket 0 counts waits of less than one microsecond,
+   * and bucket @c i counts waits of at least <tt>2^(i-1)</tt> and less than
+   * <tt>2^i</tt> microseconds. The last bucket also counts all longer waits.
+   */
+  uint64_t queue_wait_histogram(std::size_t bucket) const noexcept
+  {
+    return bucket < histogram_buckets ? queue_wait_histogram_[bucket] : 0;
+  }
+
+  /// Get the number of reactor polls whose number of events fell in a
+  /// histogram bucket.
+  /**
+   * Bucket 0 counts polls that returned no events, and bucket @c i counts
+   * polls that returned at least <tt>2^(i-1)</tt> and less than <tt>2^i</tt>
+   * events. The last bucket also counts all larger polls.
+   */
+  uint64_t poll_events_histogram(std::size_t bucket) const noexcept
+  {
+    return bucket < histogram_buckets ? poll_events_histogram_[bucket] : 0;
+  }
+
+private:
+  friend class detail::scheduler;
+  friend class detail::thread_metrics;
+  friend class detail::win_iocp_io_context;
+
+  uint64_t spin_count_;
+  uint64_t spin_hits_;
+  uint64_t spin_misses_;
+  chrono::nanoseconds spin_time_;
+  uint64_t poll_budget_handler_hits_;
+  uint64_t poll_budget_time_hits_;
+  uint64_t enqueued_;
+  uint64_t handlers_run_;
+  chrono::nanoseconds busy_time_;
+  chrono::nanoseconds idle_time_;
+  uint64_t reactor_polls_;
+  uint64_t reactor_events_;
+  uint64_t registered_descriptors_;
+  uint64_t descriptor_state_size_;
+  uint64_t descriptor_state_memory_;
+  uint64_t io_uring_cq_overflows_;
+  uint64_t io_uring_sq_full_flushes_;
+  uint64_t io_uring_submits_;
+  uint64_t io_uring_submitted_entries_;
+  uint64_t queue_wait_histogram_[histogram_buckets];
+  uint64_t poll_events_histogram_[histogram_buckets];
+  std::vector<thread_times> threads_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_CONTEXT_METRICS_HPP
@@ -0,0 +1,963 @@
+//
+// context_options.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_CONTEXT_OPTIONS_HPP
+#define BOOST_ASIO_CONTEXT_OPTIONS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <boost/asio/detail/chrono.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Tuning options for the scheduler that underlies an execution context.
+/**
+ * The context_options class is used to select optional scheduling behaviour
+ * when constructing an io_context or thread_pool. A default-constructed
+ * object selects the same behaviour as the constructors that do not take a
+ * context_options argument.
+ *
+ * @par Example
+ * @code boost::asio::context_options options;
+ * options.work_stealing(true);
+ * boost::asio::io_context io_context(32, options); @endcode
+ */
+class context_options
+{
+public:
+  /// Default constructor.
+  context_options() noexcept
+    : work_stealing_(false),
+      lock_free_injection_(false),
+      local_queue_capacity_(256),
+      spin_duration_(0),
+      adaptive_spin_(true),
+      busy_poll_idle_(false),
+      pin_threads_(false),
+      dequeue_batch_size_(1),
+      dequeue_batch_time_(0),
+      priority_starvation_limit_(16),
+      poll_budget_handlers_(0),
+      poll_budget_time_(0),
+      reactor_batch_size_(128),
+      adaptive_reactor_batch_(false),
+      spread_reactor_completions_(false),
+      reactor_busy_poll_(0),
+      reactor_busy_poll_budget_(0),
+      prefer_busy_poll_(false),
+      per_thread_reactors_(false),
+      descriptor_slab_size_(256),
+      huge_page_descriptors_(false),
+      adaptive_speculation_(false),
+      max_pending_accepts_(64),
+      max_pending_receives_(16),
+      zero_copy_send_threshold_(0),
+      io_uring_entries_(16384),
+      io_uring_cq_entries_(0),
+      io_uring_sq_poll_(false),
+      io_uring_sq_poll_cpu_(-1),
+      io_uring_sq_poll_idle_(0),
+      io_uring_coop_taskrun_(false),
+      io_uring_single_issuer_(false),
+      io_uring_defer_taskrun_(false),
+      io_uring_registered_files_(0),
+      io_uring_msg_ring_(false),
+      collect_metrics_(false)
+  {
+  }
+
+  /// Get whether the work-stealing scheduler mode is enabled.
+  bool work_stealing() const noexcept
+  {
+    return work_stealing_;
+  }
+
+  /// Set whether the work-stealing scheduler mode is enabled.
+  /**
+   * When enabled, each thread that calls run() is given a bounded queue of
+   * ready handlers. Handlers posted from a thread that is running the context
+   * are added to that thread's queue, while handlers posted from other
+   * threads are added to a lock-free injection queue. Threads that run out of
+   * work take handlers from the injection queue or steal them from the queues
+   * of busy threads, and only fall back to the shared, mutex-protected queue
+   * when these are empty. Functions submitted with execution::priority.high
+   * or execution::priority.low always wait in the shared queue. While high
+   * priority functions are waiting, threads take them before the handlers in
+   * their own queues, subject to priority_starvation_limit().
+   *
+   * The option is ignored when the context is constructed with a concurrency
+   * hint of 1, or with a hint that disables scheduler locking.
+   */
+  void work_stealing(bool value) noexcept
+  {
+    work_stealing_ = value;
+  }
+
+  /// Get whether handlers posted from other threads bypass the scheduler's
+  /// lock.
+  bool lock_free_injection() const noexcept
+  {
+    return lock_free_injection_;
+  }
+
+  /// Set whether handlers posted from other threads bypass the scheduler's
+  /// lock.
+  /**
+   * When enabled, handlers posted or dispatched from threads that are not
+   * running the context are added to a lock-free queue, which is drained by
+   * the threads that run the context. Adding a handler costs a few atomic
+   * operations. Only the thread whose handler makes the queue non-empty
+   * checks for an idle thread to wake, so a burst of handlers causes at most
+   * one wakeup of the reactor. Handlers posted from within the context are
+   * queued as before.
+   *
+   * The option is always enabled in the work-stealing scheduler mode.
+   */
+  void lock_free_injection(bool value) noexcept
+  {
+    lock_free_injection_ = value;
+  }
+
+  /// Get the capacity of each thread's local queue.
+  std::size_t local_queue_capacity() const noexcept
+  {
+    return local_queue_capacity_;
+  }
+
+  /// Set the capacity of each thread's local queue.
+  /**
+   * The value is rounded up to a power of two. Handlers that do not fit in a
+   * thread's local queue are added to the shared queue instead.
+   */
+  void local_queue_capacity(std::size_t value) noexcept
+  {
+    local_queue_capacity_ = value;
+  }
+
+  /// Get the maximum time that an idle thread spins before blocking.
+  chrono::nanoseconds spin_duration() const noexcept
+  {
+    return spin_duration_;
+  }
+
+  /// Set the maximum time that an idle thread spins before blocking.
+  /**
+   * When a thread running the context finds no ready handlers, it normally
+   * blocks until it is woken by another thread. A non-zero spin duration
+   * causes the thread to first spin for up to the specified time, repeatedly
+   * polling the reactor or checking for newly queued handlers, so that work
+   * arriving within that time is picked up without the cost of a wakeup.
+   *
+   * Spinning consumes CPU time while the context is idle. The time spent
+   * spinning is reported by context_metrics::spin_time(). The default value
+   * of zero disables spinning.
+   */
+  void spin_duration(chrono::nanoseconds value) noexcept
+  {
+    spin_duration_ = value;
+  }
+
+  /// Get whether the spin duration adapts to the rate at which work arrives.
+  bool adaptive_spin() const noexcept
+  {
+    return adaptive_spin_;
+  }
+
+  /// Set whether the spin duration adapts to the rate at which work arrives.
+  /**
+   * When enabled, the context keeps a moving average of how long its threads
+   * wait for work. Threads spin for twice that average, up to the limit set
+   * by spin_duration(), and do not spin at all while the average exceeds the
+   * limit. When disabled, threads always spin for the full spin_duration().
+   * Defaults to true.
+   */
+  void adaptive_spin(bool value) noexcept
+  {
+    adaptive_spin_ = value;
+  }
+
+  /// Get whether idle threads keep polling instead of blocking.
+  bool busy_poll_idle() const noexcept
+  {
+    return busy_poll_idle_;
+  }
+
+  /// Set whether idle threads keep polling instead of blocking.
+  /**
+   * When enabled, a thread running the context that finds no ready handlers
+   * never blocks. It spins as described for spin_duration(), but without a
+   * time limit, so that the thread polling the reactor stays on its processor
+   * and picks up events as soon as they arrive. This overrides
+   * spin_duration() and adaptive_spin().
+   *
+   * Each idle thread consumes a full processor. The option is intended for
+   * latency-critical contexts run by a small number of dedicated threads.
+   */
+  void busy_poll_idle(bool value) noexcept
+  {
+    busy_poll_idle_ = value;
+  }
+
+  /// Get whether threads created by the context are bound to processors.
+  bool pin_threads() const noexcept
+  {
+    return pin_threads_;
+  }
+
+  /// Set whether threads created by the context are bound to processors.
+  /**
+   * When enabled, each thread that the execution context creates is bound to
+   * a single processor, chosen in turn from the processors on which the
+   * process is allowed to run. Binding is performed where the operating
+   * system supports it, and is otherwise silently skipped.
+   *
+   * When numa_nodes() is also set, each thread is instead bound to a single
+   * processor of the node that it is assigned to. The option is ignored when
+   * processors() is set.
+   *
+   * The option is used by thread_pool and sharded_context. It has no effect on
+   * io_context, which does not create threads of its own.
+   */
+  void pin_threads(bool value) noexcept
+  {
+    pin_threads_ = value;
+  }
+
+  /// Get the processors to which threads created by the context are bound.
+  const std::vector<std::size_t>& processors() const noexcept
+  {
+    return processors_;
+  }
+
+  /// Set the processors to which threads created by the context are bound.
+  /**
+   * When the list is not empty, the n-th thread that the execution context
+   * creates is bound to the processor with identifier
+   * <tt>value[n % value.size()]</tt>. This takes precedence over
+   * pin_threads() and numa_nodes().
+   *
+   * The option is used by thread_pool and sharded_context. Binding is
+   * performed where the operating system supports it, and is otherwise
+   * silently skipped.
+   */
+  void processors(const std::vector<std::size_t>& value)
+  {
+    processors_ = value;
+  }
+
+  /// Get the NUMA nodes across which threads created by the context are
+  /// spread.
+  const std::vector<std::size_t>& numa_nodes() const noexcept
+  {
+    return numa_nodes_;
+  }
+
+  /// Set the NUMA nodes across which threads created by the context are
+  /// spread.
+  /**
+   * When the list is not empty, the n-th thread that the execution context
+   * creates is assigned to the node <tt>value[n % value.size()]</tt> and is
+   * bound to that node's processors, or to a single one of them if
+   * pin_threads() is also set.
+   *
+   * Each thread running the context also keeps only memory that was
+   * allocated on its own node in its cache of recycled handler memory, so
+   * that memory freed on one node is not reused by handlers running on
+   * another.
+   *
+   * The option is used by thread_pool and sharded_context. For io_context,
+   * which does not create threads, only the recycling behaviour applies.
+   */
+  void numa_nodes(const std::vector<std::size_t>& value)
+  {
+    numa_nodes_ = value;
+  }
+
+  /// Get the maximum number of handlers that a thread takes from the shared
+  /// queue each time it locks the queue.
+  std::size_t dequeue_batch_size() const noexcept
+  {
+    return dequeue_batch_size_;
+  }
+
+  /// Set the maximum number of handlers that a thread takes from the shared
+  /// queue each time it locks the queue.
+  /**
+   * By default, a thread running the context removes a single handler from
+   * the shared queue each time it acquires the queue's lock, and wakes another
+   * thread if more handlers remain. When many small handlers are queued at
+   * once, the locking and wakeups may cost more than the handlers themselves.
+   * A batch size greater than one allows a thread that calls run() to take up
+   * to that many handlers in a single critical section, and then to run them
+   * without locking the queue again.
+   *
+   * To preserve fairness with I/O, a batch never extends past the point in
+   * the queue at which the reactor is next polled. Handlers that a thread has
+   * taken but not yet run are returned to the front of the shared queue if
+   * the context is stopped, a handler throws an exception, or the time limit
+   * set by dequeue_batch_time() is reached.
+   *
+   * The option is ignored by run_one(), poll() and poll_one(), and by threads
+   * in work-stealing mode, which already take handlers in bulk. A value of
+   * zero is treated as one.
+   */
+  void dequeue_batch_size(std::size_t value) noexcept
+  {
+    dequeue_batch_size_ = value;
+  }
+
+  /// Get the longest time that a thread may spend running a batch of
+  /// handlers.
+  chrono::nanoseconds dequeue_batch_time() const noexcept
+  {
+    return dequeue_batch_time_;
+  }
+
+  /// Set the longest time that a thread may spend running a batch of
+  /// handlers.
+  /**
+   * While a thread runs a batch of handlers taken from the shared queue, the
+   * remaining handlers of the batch cannot be run by other threads. When the
+   * time limit is non-zero, a thread that has spent longer than the limit
+   * running its current batch returns the rest of the batch to the shared
+   * queue, where they may be picked up by any thread. The default value of
+   * zero means that batches are always run to completion.
+   */
+  void dequeue_batch_time(chrono::nanoseconds value) noexcept
+  {
+    dequeue_batch_time_ = value;
+  }
+
+  /// Get the limit used to prevent starvation of lower priority work.
+  std::size_t priority_starvation_limit() const noexcept
+  {
+    return priority_starvation_limit_;
+  }
+
+  /// Set the limit used to prevent starvation of lower priority work.
+  /**
+   * Functions submitted through an executor that has the
+   * execution::priority.high property run ahead of other waiting work, and
+   * those submitted with execution::priority.low run after it. To prevent a
+   * backlog of higher priority work from delaying lower priority work, and
+   * the polling of I/O, indefinitely:
+   *
+   * @li after this many high priority functions have run in succession while
+   * other work was waiting, the next waiting normal priority handler is run;
+   *
+   * @li after low priority functions have been passed over this many times,
+   * the next low priority function is run;
+   *
+   * @li in work-stealing mode, after a thread has passed over its own queue
+   * this many times in succession to look for high priority functions, it
+   * runs the next handler from its own queue.
+   *
+   * Defaults to 16. A value of zero is treated as one.
+   */
+  void priority_starvation_limit(std::size_t value) noexcept
+  {
+    priority_starvation_limit_ = value;
+  }
+
+  /// Get the number of handlers that may run before the reactor must be
+  /// polled again.
+  std::size_t poll_budget_handlers() const noexcept
+  {
+    return poll_budget_handlers_;
+  }
+
+  /// Set the number of handlers that may run before the reactor must be
+  /// polled again.
+  /**
+   * The reactor, or io_uring, is polled for new events when its turn comes
+   * round in the queue of ready handlers. When many handlers are queued
+   * ahead of it, ready sockets may wait a long time for that turn. When the
+   * budget is non-zero, and this many handlers have run since the reactor
+   * was last polled, the next thread to take work polls the reactor before
+   * running any more handlers.
+   *
+   * The number of times that the budget is exhausted is reported by
+   * context_metrics::poll_budget_handler_hits(). In work-stealing mode, the
+   * budget is enforced when a thread next takes work from the shared queue.
+   * The default value of zero disables the budget.
+   */
+  void poll_budget_handlers(std::size_t value) noexcept
+  {
+    poll_budget_handlers_ = value;
+  }
+
+  /// Get the time that handlers may run before the reactor must be polled
+  /// again.
+  chrono::nanoseconds poll_budget_time() const noexcept
+  {
+    return poll_budget_time_;
+  }
+
+  /// Set the time that handlers may run before the reactor must be polled
+  /// again.
+  /**
+   * Like poll_budget_handlers(), but the budget is measured as the time that
+   * has passed since the last poll of the reactor finished. Both budgets may
+   * be set, in which case the reactor is polled when either is exhausted.
+   * The number of times that this budget is exhausted is reported by
+   * context_metrics::poll_budget_time_hits(). The default value of zero
+   * disables the budget.
+   */
+  void poll_budget_time(chrono::nanoseconds value) noexcept
+  {
+    poll_budget_time_ = value;
+  }
+
+  /// Get the most events that the reactor harvests in one poll.
+  std::size_t reactor_batch_size() const noexcept
+  {
+    return reactor_batch_size_;
+  }
+
+  /// Set the most events that the reactor harvests in one poll.
+  /**
+   * When many descriptors are ready at once, a larger batch needs fewer
+   * system calls to harvest them. The option is used by the epoll reactor,
+   * and is ignored by other reactors. The default is 128.
+   */
+  void reactor_batch_size(std::size_t value) noexcept
+  {
+    reactor_batch_size_ = value;
+  }
+
+  /// Get whether the reactor's batch size adapts to the number of ready
+  /// events.
+  bool adaptive_reactor_batch() const noexcept
+  {
+    return adaptive_reactor_batch_;
+  }
+
+  /// Set whether the reactor's batch size adapts to the number of ready
+  /// events.
+  /**
+   * When enabled, the reactor starts with a small batch. The batch doubles
+   * each time a poll fills it, up to reactor_batch_size(), and halves when
+   * polls return far fewer events than it can hold. The memory used for the
+   * batch grows only as needed. The option is used by the epoll reactor, and
+   * is ignored by other reactors.
+   */
+  void adaptive_reactor_batch(bool value) noexcept
+  {
+    adaptive_reactor_batch_ = value;
+  }
+
+  /// Get whether handlers harvested by one poll of the reactor are spread
+  /// across waiting threads.
+  bool spread_reactor_completions() const noexcept
+  {
+    return spread_reactor_completions_;
+  }
+
+  /// Set whether handlers harvested by one poll of the reactor are spread
+  /// across waiting threads.
+  /**
+   * After polling the reactor, a thread normally wakes one waiting thread,
+   * which wakes another in turn if there is still work to do, so a large
+   * batch of completions reaches the waiting threads one at a time. When
+   * this option is enabled, the polling thread wakes one waiting thread for
+   * each completion beyond the first, up to the number of waiting threads.
+   */
+  void spread_reactor_completions(bool value) noexcept
+  {
+    spread_reactor_completions_ = value;
+  }
+
+  /// Get the time for which the reactor busy polls before it blocks.
+  chrono::nanoseconds reactor_busy_poll() const noexcept
+  {
+    return reactor_busy_poll_;
+  }
+
+  /// Set the time for which the reactor busy polls before it blocks.
+  /**
+   * When non-zero, a poll of the reactor that finds no ready events keeps
+   * polling for up to the specified time before it goes to sleep. On Linux
+   * 6.9 and later the epoll reactor asks the kernel to busy poll the network
+   * devices of its sockets, which are selected with the
+   * socket_base::busy_poll option. On older kernels the reactor repeatedly
+   * polls without blocking instead. The option is ignored by other reactors.
+   * The default of zero disables busy polling.
+   */
+  void reactor_busy_poll(chrono::nanoseconds value) noexcept
+  {
+    reactor_busy_poll_ = value;
+  }
+
+  /// Get the most packets that the kernel processes in each busy poll of the
+  /// reactor.
+  std::size_t reactor_busy_poll_budget() const noexcept
+  {
+    return reactor_busy_poll_budget_;
+  }
+
+  /// Set the most packets that the kernel processes in each busy poll of the
+  /// reactor.
+  /**
+   * Budgets above the kernel's default may require elevated privileges. The
+   * default of zero uses the kernel's default budget.
+   */
+  void reactor_busy_poll_budget(std::size_t value) noexcept
+  {
+    reactor_busy_poll_budget_ = value;
+  }
+
+  /// Get whether the reactor's busy polling defers device interrupts.
+  bool prefer_busy_poll() const noexcept
+  {
+    return prefer_busy_poll_;
+  }
+
+  /// Set whether the reactor's busy polling defers device interrupts.
+  /**
+   * When enabled, the kernel defers the network device's interrupt
+   * processing while the reactor is busy polling, as with the
+   * socket_base::prefer_busy_poll option. The option only has an effect when
+   * the kernel busy polls on behalf of the reactor.
+   */
+  void prefer_busy_poll(bool value) noexcept
+  {
+    prefer_busy_poll_ = value;
+  }
+
+  /// Get whether each thread running the context owns its own reactor.
+  bool per_thread_reactors() const noexcept
+  {
+    return per_thread_reactors_;
+  }
+
+  /// Set whether each thread running the context owns its own reactor.
+  /**
+   * Normally one thread at a time waits on the reactor, and hands the
+   * completions it harvests to the other threads. When this option is
+   * enabled, each thread running the context waits on a set of descriptors
+   * of its own. A socket is added to the set of the thread that registers
+   * it, or to the least loaded set if it is registered from outside the
+   * context, and its completions then stay on the thread that owns the set.
+   * Sockets may be moved between sets by calling their migrate() member
+   * function. Handlers posted to the context are still shared by all
+   * threads. The option is used by the epoll reactor, and is ignored by
+   * other reactors and when the context is single-threaded. It takes
+   * precedence over work_stealing() and lock_free_injection(), and threads
+   * running in this mode do not spin or dequeue batches.
+   */
+  void per_thread_reactors(bool value) noexcept
+  {
+    per_thread_reactors_ = value;
+  }
+
+  /// Get the number of descriptors whose state is allocated together.
+  std::size_t descriptor_slab_size() const noexcept
+  {
+    return descriptor_slab_size_;
+  }
+
+  /// Set the number of descriptors whose state is allocated together.
+  /**
+   * The reactor keeps some state for each registered descriptor. This state
+   * is carved out of slabs that each hold this many descriptors, and each
+   * descriptor's state starts on its own cache line. Freed state is reused by
+   * later registrations, and slabs are released when the context is
+   * destroyed. The option is used by the epoll reactor, and is ignored by
+   * other reactors. The default is 256.
+   */
+  void descriptor_slab_size(std::size_t value) noexcept
+  {
+    descriptor_slab_size_ = value;
+  }
+
+  /// Get whether descriptor state is allocated from huge pages.
+  bool huge_page_descriptors() const noexcept
+  {
+    return huge_page_descriptors_;
+  }
+
+  /// Set whether descriptor state is allocated from huge pages.
+  /**
+   * When enabled, each slab of descriptor state is rounded up to a whole
+   * number of huge pages and mapped from the kernel's huge page pool. If no
+   * huge pages are available, ordinary pages are used instead, and the kernel
+   * is advised to back them with transparent huge pages. This reduces TLB
+   * misses when very many descriptors are registered. The option is used by
+   * the epoll reactor, and is ignored by other reactors.
+   */
+  void huge_page_descriptors(bool value) noexcept
+  {
+    huge_page_descriptors_ = value;
+  }
+
+  /// Get whether speculative operations adapt to each socket's history.
+  bool adaptive_speculation() const noexcept
+  {
+    return adaptive_speculation_;
+  }
+
+  /// Set whether speculative operations adapt to each socket's history.
+  /**
+   * An operation started on a socket is normally first attempted at once,
+   * unless the reactor has seen the socket run dry since it was last ready.
+   * When this option is enabled, the reactor also tracks how often such
+   * attempts succeed on each socket. It stops attempting them on sockets
+   * where they mostly fail, probing only occasionally, and keeps attempting
+   * them without waiting for readiness on sockets where they almost always
+   * succeed. The option is used by the epoll reactor, and is ignored by other
+   * reactors.
+   */
+  void adaptive_speculation(bool value) noexcept
+  {
+    adaptive_speculation_ = value;
+  }
+
+  /// Get the number of accepted connections that may wait for their handlers.
+  std::size_t max_pending_accepts() const noexcept
+  {
+    return max_pending_accepts_;
+  }
+
+  /// Set the number of accepted connections that may wait for their handlers.
+  /**
+   * An acceptor's async_accept_many operation keeps a single accept
+   * submission running, so that connections continue to be accepted while
+   * earlier ones wait for their connection handlers to run. When this many
+   * connections are waiting, the submission is cancelled, and it is made
+   * again only after all of them have been handled. The option is used by the
+   * io_uring backend, and is ignored by other backends, which accept one
+   * connection at a time.
+   */
+  void max_pending_accepts(std::size_t value) noexcept
+  {
+    max_pending_accepts_ = value;
+  }
+
+  /// Get the number of received buffers that may wait for their handlers.
+  std::size_t max_pending_receives() const noexcept
+  {
+    return max_pending_receives_;
+  }
+
+  /// Set the number of received buffers that may wait for their handlers.
+  /**
+   * A stream socket's async_receive_many operation keeps a single receive
+   * submission running, with the kernel taking a buffer from a
+   * provided_buffer_pool each time data arrives. When this many buffers are
+   * waiting to be passed to the data handler, the submission is cancelled,
+   * and it is made again only after all of them have been handled. The option
+   * is used by the io_uring backend, and is ignored by other backends, which
+   * receive one buffer at a time.
+   */
+  void max_pending_receives(std::size_t value) noexcept
+  {
+    max_pending_receives_ = value;
+  }
+
+  /// Get the size at which stream socket sends are made without copying.
+  std::size_t zero_copy_send_threshold() const noexcept
+  {
+    return zero_copy_send_threshold_;
+  }
+
+  /// Set the size at which stream socket sends are made without copying.
+  /**
+   * A send on a stream socket normally copies its data into the kernel. When
+   * the data to be sent is at least this many bytes, the send is instead made
+   * with IORING_OP_SEND_ZC, and the kernel transmits the data directly from
+   * the caller's buffers. The completion handler is not invoked until the
+   * kernel has finished with the buffers. Where the kernel or the socket does
+   * not support zero-copy sends, the data is copied as usual. Avoiding the
+   * copy has a fixed cost, and so is worthwhile only for large sends. A value
+   * of 0 disables zero-copy sends. The option is used by the io_uring backend,
+   * and is ignored by other backends.
+   */
+  void zero_copy_send_threshold(std::size_t value) noexcept
+  {
+    zero_copy_send_threshold_ = value;
+  }
+
+  /// Get the number of submission queue entries in the io_uring ring.
+  std::size_t io_uring_entries() const noexcept
+  {
+    return io_uring_entries_;
+  }
+
+  /// Set the number of submission queue entries in the io_uring ring.
+  /**
+   * The kernel rounds the value up to a power of two. When the submission
+   * queue is full, pending entries are submitted before more are added. The
+   * option is used by the io_uring backend, and is ignored by other backends.
+   */
+  void io_uring_entries(std::size_t value) noexcept
+  {
+    io_uring_entries_ = value;
+  }
+
+  /// Get the number of completion queue entries in the io_uring ring.
+  std::size_t io_uring_cq_entries() const noexcept
+  {
+    return io_uring_cq_entries_;
+  }
+
+  /// Set the number of completion queue entries in the io_uring ring.
+  /**
+   * By default the kernel makes the completion queue twice the size of the
+   * submission queue. A larger completion queue leaves room for the many
+   * completions of multishot operations. The kernel rounds the value up to a
+   * power of two, and limits it to the largest size it supports. A value of 0
+   * selects the default size. The option is used by the io_uring backend,
+   * and is ignored by other backends.
+   */
+  void io_uring_cq_entries(std::size_t value) noexcept
+  {
+    io_uring_cq_entries_ = value;
+  }
+
+  /// Get whether a kernel thread polls the io_uring submission queue.
+  bool io_uring_sq_poll() const noexcept
+  {
+    return io_uring_sq_poll_;
+  }
+
+  /// Set whether a kernel thread polls the io_uring submission queue.
+  /**
+   * When enabled, the ring is created with IORING_SETUP_SQPOLL, and a kernel
+   * thread picks up new submissions without the submitting thread making a
+   * system call. The kernel thread sleeps after it has been idle for the time
+   * set by io_uring_sq_poll_idle(), and is then woken by the next submission.
+   * The kernel thread consumes a processor while it polls. Older kernels
+   * allow it only for privileged processes, and constructing the context then
+   * fails. The option is used by the io_uring backend, and is ignored by other
+   * backends.
+   */
+  void io_uring_sq_poll(bool value) noexcept
+  {
+    io_uring_sq_poll_ = value;
+  }
+
+  /// Get the processor that the submission queue polling thread runs on.
+  int io_uring_sq_poll_cpu() const noexcept
+  {
+    return io_uring_sq_poll_cpu_;
+  }
+
+  /// Set the processor that the submission queue polling thread runs on.
+  /**
+   * A negative value lets the kernel thread run on any processor. The option
+   * is used only when io_uring_sq_poll() is enabled.
+   */
+  void io_uring_sq_poll_cpu(int value) noexcept
+  {
+    io_uring_sq_poll_cpu_ = value;
+  }
+
+  /// Get the time the submission queue polling thread polls before sleeping.
+  chrono::nanoseconds io_uring_sq_poll_idle() const noexcept
+  {
+    return io_uring_sq_poll_idle_;
+  }
+
+  /// Set the time the submission queue polling thread polls before sleeping.
+  /**
+   * The time is rounded up to whole milliseconds. A value of 0 selects the
+   * kernel's default. The option is used only when io_uring_sq_poll() is
+   * enabled.
+   */
+  void io_uring_sq_poll_idle(chrono::nanoseconds value) noexcept
+  {
+    io_uring_sq_poll_idle_ = value;
+  }
+
+  /// Get whether the kernel defers completion work until the next transition
+  /// into the kernel.
+  bool io_uring_coop_taskrun() const noexcept
+  {
+    return io_uring_coop_taskrun_;
+  }
+
+  /// Set whether the kernel defers completion work until the next transition
+  /// into the kernel.
+  /**
+   * When enabled, the ring is created with IORING_SETUP_COOP_TASKRUN, and the
+   * kernel does not interrupt a running thread to post completions. This
+   * saves an interprocessor interrupt per completion when the thread that
+   * runs the context is busy. The option is ignored when io_uring_sq_poll()
+   * is enabled. The option is used by the io_uring backend, and is ignored by
+   * other backends.
+   */
+  void io_uring_coop_taskrun(bool value) noexcept
+  {
+    io_uring_coop_taskrun_ = value;
+  }
+
+  /// Get whether only one thread submits to the io_uring ring.
+  bool io_uring_single_issuer() const noexcept
+  {
+    return io_uring_single_issuer_;
+  }
+
+  /// Set whether only one thread submits to the io_uring ring.
+  /**
+   * When enabled, the ring is created with IORING_SETUP_SINGLE_ISSUER, which
+   * lets the kernel skip synchronisation on submission. The first thread to
+   * submit to the ring becomes its only submitter, and so every operation
+   * must be started, and the context run, on that thread. The option is
+   * therefore used only when the context is constructed with the
+   * BOOST_ASIO_CONCURRENCY_HINT_UNSAFE concurrency hint. The option is used
+   * by the io_uring backend, and is ignored by other backends.
+   */
+  void io_uring_single_issuer(bool value) noexcept
+  {
+    io_uring_single_issuer_ = value;
+  }
+
+  /// Get whether completion work is run only when the context waits for it.
+  bool io_uring_defer_taskrun() const noexcept
+  {
+    return io_uring_defer_taskrun_;
+  }
+
+  /// Set whether completion work is run only when the context waits for it.
+  /**
+   * When enabled, the ring is created with IORING_SETUP_DEFER_TASKRUN, and
+   * the kernel does the work of posting completions only when the context
+   * polls or waits for them. Completions are then posted in batches on the
+   * thread that runs the context. The option implies io_uring_single_issuer(),
+   * and is subject to the same conditions. It is ignored when
+   * io_uring_sq_poll() is enabled. The option is used by the io_uring
+   * backend, and is ignored by other backends.
+   */
+  void io_uring_defer_taskrun(bool value) noexcept
+  {
+    io_uring_defer_taskrun_ = value;
+  }
+
+  /// Get the number of slots in the io_uring registered file table.
+  std::size_t io_uring_registered_files() const noexcept
+  {
+    return io_uring_registered_files_;
+  }
+
+  /// Set the number of slots in the io_uring registered file table.
+  /**
+   * Each operation normally refers to its socket or file by descriptor, and
+   * the kernel must look up and reference the descriptor each time. When this
+   * option is non-zero, a table with this many slots is registered with the
+   * ring, and each socket or file opened or assigned on the context is placed
+   * in a free slot, which is released when the object is closed. Operations
+   * then refer to the slot, avoiding the lookup. Objects opened when all
+   * slots are in use, or on kernels without support for sparse file tables,
+   * continue to use their descriptors. A value of 0 disables the table. The
+   * option is used by the io_uring backend, and is ignored by other backends.
+   */
+  void io_uring_registered_files(std::size_t value) noexcept
+  {
+    io_uring_registered_files_ = value;
+  }
+
+  /// Get whether operations posted from other contexts are sent to the ring.
+  bool io_uring_msg_ring() const noexcept
+  {
+    return io_uring_msg_ring_;
+  }
+
+  /// Set whether operations posted from other contexts are sent to the ring.
+  /**
+   * A handler posted to the context from a thread that is not running it is
+   * normally added to a shared queue, and the thread running the context is
+   * woken by a submission to its ring. When this option is enabled, and the
+   * posting thread is running another io_uring-backed context, the handler is
+   * instead sent to this context's ring with IORING_OP_MSG_RING, submitted
+   * along with the other context's operations. The handler is then returned
+   * as an ordinary completion, and the wakeup costs no system call of its own.
+   * Handlers that cannot be sent this way, such as on kernels without support
+   * for the operation, are queued as normal. The option is used by the
+   * io_uring backend, and is ignored by other backends.
+   */
+  void io_uring_msg_ring(bool value) noexcept
+  {
+    io_uring_msg_ring_ = value;
+  }
+
+  /// Get whether the context collects detailed metrics.
+  bool collect_metrics() const noexcept
+  {
+    return collect_metrics_;
+  }
+
+  /// Set whether the context collects detailed metrics.
+  /**
+   * When enabled, each thread running the context counts the handlers it
+   * runs, measures how long they waited to run and how long they took, and
+   * records its idle time and the events returned by each poll of the
+   * reactor. These counts are reported by context_metrics. Collection reads
+   * the clock around each handler, and is disabled by default.
+   */
+  void collect_metrics(bool value) noexcept
+  {
+    collect_metrics_ = value;
+  }
+
+private:
+  bool work_stealing_;
+  bool lock_free_injection_;
+  std::size_t local_queue_capacity_;
+  chrono::nanoseconds spin_duration_;
+  bool adaptive_spin_;
+  bool busy_poll_idle_;
+  bool pin_threads_;
+  std::vector<std::size_t> processors_;
+  std::vector<std::size_t> numa_nodes_;
+  std::size_t dequeue_batch_size_;
+  chrono::nanoseconds dequeue_batch_time_;
+  std::size_t priority_starvation_limit_;
+  std::size_t poll_budget_handlers_;
+  chrono::nanoseconds poll_budget_time_;
+  std::size_t reactor_batch_size_;
+  bool adaptive_reactor_batch_;
+  bool spread_reactor_completions_;
+  chrono::nanoseconds reactor_busy_poll_;
+  std::size_t reactor_busy_poll_budget_;
+  bool prefer_busy_poll_;
+  bool per_thread_reactors_;
+  std::size_t descriptor_slab_size_;
+  bool huge_page_descriptors_;
+  bool adaptive_speculation_;
+  std::size_t max_pending_accepts_;
+  std::size_t max_pending_receives_;
+  std::size_t zero_copy_send_threshold_;
+  std::size_t io_uring_entries_;
+  std::size_t io_uring_cq_entries_;
+  bool io_uring_sq_poll_;
+  int io_uring_sq_poll_cpu_;
+  chrono::nanoseconds io_uring_sq_poll_idle_;
+  bool io_uring_coop_taskrun_;
+  bool io_uring_single_issuer_;
+  bool io_uring_defer_taskrun_;
+  std::size_t io_uring_registered_files_;
+  bool io_uring_msg_ring_;
+  bool collect_metrics_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_CONTEXT_OPTIONS_HPP
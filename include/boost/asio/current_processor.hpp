@@ -0,0 +1,68 @@
+//
+// current_processor.hpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_CURRENT_PROCESSOR_HPP
+#define BOOST_ASIO_CURRENT_PROCESSOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Get the identifier of the processor that is running the calling thread.
+/**
+ * Unless the calling thread is bound to a single processor, the result may be
+ * out of date as soon as it is returned.
+ *
+ * @throws boost::system::system_error Thrown on failure, including when the
+ * operating system does not support the query.
+ */
+BOOST_ASIO_DECL std::size_t current_processor();
+
+/// Get the identifier of the processor that is running the calling thread.
+/**
+ * Unless the calling thread is bound to a single processor, the result may be
+ * out of date as soon as it is returned.
+ *
+ * @param ec Set to indicate what error occurred, if any.
+ */
+BOOST_ASIO_DECL std::size_t current_processor(boost::system::error_code& ec);
+
+/// Get the NUMA node of the processor that is running the calling thread.
+/**
+ * @throws boost::system::system_error Thrown on failure, including when the
+ * operating system does not support the query.
+ */
+BOOST_ASIO_DECL std::size_t current_numa_node();
+
+/// Get the NUMA node of the processor that is running the calling thread.
+/**
+ * @param ec Set to indicate what error occurred, if any.
+ */
+BOOST_ASIO_DECL std::size_t current_numa_node(boost::system::error_code& ec);
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/current_processor.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_CURRENT_PROCESSOR_HPP
@@ -0,0 +1,164 @@
+//
+// detail/accept_many_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_ACCEPT_MANY_OP_HPP
+#define BOOST_ASIO_DETAIL_ACCEPT_MANY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/associated_allocator.hpp>
+#include <boost/asio/associator.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Accepts connections one at a time by starting a new accept each time the
+// previous one completes. Used by socket services that have no native way to
+// keep a single accept operation running. The next accept is started before
+// the connection handler is invoked, so that the handler may cancel it. The
+// connection handler is shared by all of the accepts.
+template <typename Service, typename PeerIoExecutor,
+    typename ConnectionHandler, typename Handler, typename IoExecutor>
+class accept_many_op
+{
+public:
+  typedef typename Service::protocol_type::socket::template
+    rebind_executor<PeerIoExecutor>::other peer_socket_type;
+
+  accept_many_op(Service& service,
+      typename Service::implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex, ConnectionHandler& connection_handler,
+      Handler& handler, const IoExecutor& io_ex)
+    : service_(&service),
+      impl_(&impl),
+      peer_io_ex_(peer_io_ex),
+      io_ex_(io_ex),
+      start_(1),
+      connection_handler_(std::allocate_shared<ConnectionHandler>(
+            (get_associated_allocator)(handler),
+            static_cast<ConnectionHandler&&>(connection_handler))),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  accept_many_op(const accept_many_op& other)
+    : service_(other.service_),
+      impl_(other.impl_),
+      peer_io_ex_(other.peer_io_ex_),
+      io_ex_(other.io_ex_),
+      start_(other.start_),
+      connection_handler_(other.connection_handler_),
+      handler_(other.handler_)
+  {
+  }
+
+  // The executors are copied rather than moved, as the operation is moved into
+  // the next accept while they are still being used to start it.
+  accept_many_op(accept_many_op&& other)
+    : service_(other.service_),
+      impl_(other.impl_),
+      peer_io_ex_(other.peer_io_ex_),
+      io_ex_(other.io_ex_),
+      start_(other.start_),
+      connection_handler_(
+          static_cast<shared_ptr<ConnectionHandler>&&>(
+            other.connection_handler_)),
+      handler_(static_cast<Handler&&>(other.handler_))
+  {
+  }
+
+  // Start the first accept.
+  void start()
+  {
+    service_->async_move_accept(*impl_, peer_io_ex_, 0, *this, io_ex_);
+  }
+
+  void operator()(boost::system::error_code ec, peer_socket_type peer)
+  {
+    if (ec)
+    {
+      static_cast<Handler&&>(handler_)(ec);
+      return;
+    }
+
+    start_ = 0;
+    shared_ptr<ConnectionHandler> connection_handler = connection_handler_;
+    service_->async_move_accept(*impl_, peer_io_ex_, 0, *this, io_ex_);
+    (*connection_handler)(static_cast<peer_socket_type&&>(peer));
+  }
+
+//private:
+  Service* service_;
+  typename Service::implementation_type* impl_;
+  PeerIoExecutor peer_io_ex_;
+  IoExecutor io_ex_;
+  int start_;
+  shared_ptr<ConnectionHandler> connection_handler_;
+  Handler handler_;
+};
+
+template <typename Service, typename PeerIoExecutor,
+    typename ConnectionHandler, typename Handler, typename IoExecutor>
+inline bool asio_handler_is_continuation(
+    accept_many_op<Service, PeerIoExecutor,
+      ConnectionHandler, Handler, IoExecutor>* this_handler)
+{
+  return this_handler->start_ == 0 ? true
+    : boost_asio_handler_cont_helpers::is_continuation(
+        this_handler->handler_);
+}
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Service, typename PeerIoExecutor, typename ConnectionHandler,
+    typename Handler, typename IoExecutor, typename DefaultCandidate>
+struct associator<Associator,
+    detail::accept_many_op<Service, PeerIoExecutor,
+      ConnectionHandler, Handler, IoExecutor>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const detail::accept_many_op<Service, PeerIoExecutor,
+        ConnectionHandler, Handler, IoExecutor>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(
+      const detail::accept_many_op<Service, PeerIoExecutor,
+        ConnectionHandler, Handler, IoExecutor>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_ACCEPT_MANY_OP_HPP
@@ -0,0 +1,138 @@
+//
+// detail/atomic_op_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_ATOMIC_OP_QUEUE_HPP
+#define BOOST_ASIO_DETAIL_ATOMIC_OP_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A lock-free queue that any number of threads may push operations on to.
+// Consumers remove all queued operations at once, and receive them in the
+// order in which they were pushed.
+template <typename Operation>
+class atomic_op_queue
+  : private noncopyable
+{
+public:
+  // Constructor.
+  atomic_op_queue()
+    : head_(0)
+  {
+  }
+
+  // Destructor destroys all operations.
+  ~atomic_op_queue()
+  {
+    op_queue<Operation> ops;
+    pop_all(ops);
+  }
+
+  // Push an operation on to the queue. Returns true if the queue was empty.
+  bool push(Operation* h)
+  {
+    Operation* head = head_.load(std::memory_order_relaxed);
+    do
+    {
+      op_queue_access::next(h, head);
+    } while (!head_.compare_exchange_weak(head, h,
+          std::memory_order_release, std::memory_order_relaxed));
+    return head == 0;
+  }
+
+  // Push all operations from another queue on to the queue. Returns true if
+  // the queue was empty and the other queue was not.
+  template <typename OtherOperation>
+  bool push(op_queue<OtherOperation>& q)
+  {
+    // Reverse the source queue so that it may be spliced on to the head.
+    Operation* first = 0;
+    Operation* last = op_queue_access::front(q);
+    Operation* o = last;
+    while (o)
+    {
+      Operation* next = op_queue_access::next(o);
+      op_queue_access::next(o, first);
+      first = o;
+      o = next;
+    }
+    op_queue_access::front(q) = 0;
+    op_queue_access::back(q) = 0;
+
+    if (!first)
+      return false;
+
+    Operation* head = head_.load(std::memory_order_relaxed);
+    do
+    {
+      op_queue_access::next(last, head);
+    } while (!head_.compare_exchange_weak(head, first,
+          std::memory_order_release, std::memory_order_relaxed));
+    return head == 0;
+  }
+
+  // Remove all operations from the queue, adding them to the back of the
+  // given queue.
+  template <typename OtherOperation>
+  void pop_all(op_queue<OtherOperation>& q)
+  {
+    if (head_.load(std::memory_order_relaxed) == 0)
+      return;
+
+    Operation* o = head_.exchange(0, std::memory_order_acquire);
+
+    // Operations are linked in reverse order of insertion.
+    Operation* first = 0;
+    while (o)
+    {
+      Operation* next = op_queue_access::next(o);
+      op_queue_access::next(o, first);
+      first = o;
+      o = next;
+    }
+
+    while (first)
+    {
+      Operation* next = op_queue_access::next(first);
+      q.push(static_cast<OtherOperation*>(first));
+      first = next;
+    }
+  }
+
+  // Whether the queue is empty.
+  bool empty() const
+  {
+    return head_.load(std::memory_order_relaxed) == 0;
+  }
+
+private:
+  // The most recently pushed operation.
+  std::atomic<Operation*> head_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_ATOMIC_OP_QUEUE_HPP
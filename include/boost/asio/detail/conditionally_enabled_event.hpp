@@ -57,6 +57,14 @@ public:
       event_.signal_all(lock);
   }
 
+  // Signal up to the specified number of waiters.
+  void signal_many(conditionally_enabled_mutex::scoped_lock& lock,
+      std::size_t n)
+  {
+    if (lock.mutex_.enabled_)
+      event_.signal_many(lock, n);
+  }
+
   // Unlock the mutex and signal one waiter.
   void unlock_and_signal_one(
       conditionally_enabled_mutex::scoped_lock& lock)
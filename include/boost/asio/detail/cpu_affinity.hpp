@@ -0,0 +1,82 @@
+//
+// detail/cpu_affinity.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_CPU_AFFINITY_HPP
+#define BOOST_ASIO_DETAIL_CPU_AFFINITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <boost/asio/context_options.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+namespace cpu_affinity {
+
+// Get the number of processors on which the calling thread is allowed to run.
+// Returns 0 if the number cannot be determined.
+BOOST_ASIO_DECL std::size_t available_cpu_count();
+
+// Bind the calling thread to a single processor, chosen as the n-th of the
+// processors on which it is allowed to run. Wraps around if n is greater than
+// or equal to the number of allowed processors.
+BOOST_ASIO_DECL void bind_current_thread(
+    std::size_t n, boost::system::error_code& ec);
+
+// Bind the calling thread to the processor with the specified identifier.
+BOOST_ASIO_DECL void bind_current_thread_to_processor(
+    std::size_t processor, boost::system::error_code& ec);
+
+// Bind the calling thread to all processors of the specified NUMA node.
+BOOST_ASIO_DECL void bind_current_thread_to_node(
+    std::size_t node, boost::system::error_code& ec);
+
+// Get the identifiers of the processors that belong to a NUMA node.
+BOOST_ASIO_DECL std::vector<std::size_t> node_processors(
+    std::size_t node, boost::system::error_code& ec);
+
+// Determine whether the options ask for the threads of a context to be bound.
+inline bool binds_threads(const context_options& options)
+{
+  return options.pin_threads() || !options.processors().empty()
+    || !options.numa_nodes().empty();
+}
+
+// Bind the calling thread, which is the n-th thread created by a context, as
+// requested by the context's options. Does nothing if binds_threads() is false.
+BOOST_ASIO_DECL void bind_current_thread(const context_options& options,
+    std::size_t n, boost::system::error_code& ec);
+
+// Get the identifier of the processor that is running the calling thread.
+BOOST_ASIO_DECL std::size_t current_processor(boost::system::error_code& ec);
+
+// Get the NUMA node of the processor that is running the calling thread.
+BOOST_ASIO_DECL std::size_t current_node(boost::system::error_code& ec);
+
+} // namespace cpu_affinity
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/cpu_affinity.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_DETAIL_CPU_AFFINITY_HPP
@@ -22,6 +22,7 @@
 #include <cstddef>
 #include <vector>
 #include <sys/devpoll.h>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/hash_map.hpp>
 #include <boost/asio/detail/limits.hpp>
 #include <boost/asio/detail/mutex.hpp>
@@ -86,6 +87,22 @@ public:
       per_descriptor_data& target_descriptor_data,
       per_descriptor_data& source_descriptor_data);
 
+  // Set whether only one of the reactors waiting on the descriptor is woken
+  // when it becomes ready. Returns 0 on success, system error code on failure.
+  BOOST_ASIO_DECL int set_exclusive_wakeup(socket_type descriptor,
+      per_descriptor_data& descriptor_data, bool value);
+
+  // Move the descriptor to the calling thread's own set of descriptors.
+  // Returns 0 on success, system error code on failure.
+  BOOST_ASIO_DECL int migrate_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data);
+
+  // Get the number of speculative operations on the descriptor that completed
+  // at once, and the number that would have blocked.
+  BOOST_ASIO_DECL void speculative_counts(
+      const per_descriptor_data& descriptor_data,
+      uint64_t& hits, uint64_t& misses);
+
   // Post a reactor operation for immediate completion.
   void post_immediate_completion(operation* op, bool is_continuation) const;
 
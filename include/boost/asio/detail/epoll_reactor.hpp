@@ -21,17 +21,19 @@
 
 #include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/conditionally_enabled_mutex.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/limits.hpp>
-#include <boost/asio/detail/object_pool.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
 #include <boost/asio/detail/scheduler_task.hpp>
 #include <boost/asio/detail/select_interrupter.hpp>
+#include <boost/asio/detail/slab_object_pool.hpp>
 #include <boost/asio/detail/socket_types.hpp>
 #include <boost/asio/detail/timer_queue_base.hpp>
 #include <boost/asio/detail/timer_queue_set.hpp>
 #include <boost/asio/detail/wait_op.hpp>
 #include <boost/asio/execution_context.hpp>
+#include <sys/epoll.h>
 
 #if defined(BOOST_ASIO_HAS_TIMERFD)
 # include <sys/timerfd.h>
@@ -51,6 +53,9 @@ private:
   // The mutex type used by this reactor.
   typedef conditionally_enabled_mutex mutex;
 
+  // A set of descriptors waited on by a single thread.
+  struct local_reactor;
+
 public:
   enum op_types { read_op = 0, write_op = 1,
     connect_op = 1, except_op = 2, max_ops = 3 };
@@ -61,16 +66,28 @@ public:
     friend class epoll_reactor;
     friend class object_pool_access;
 
-    descriptor_state* next_;
-    descriptor_state* prev_;
-
-    mutex mutex_;
+    // Fields used whenever the descriptor becomes ready. Together with the
+    // operation header they fit in the first cache line of the object.
     epoll_reactor* reactor_;
+    std::atomic<uint32_t> pending_events_;
+    std::atomic<bool> enqueued_;
+    bool shutdown_;
+    bool try_speculative_[max_ops];
     int descriptor_;
     uint32_t registered_events_;
+
+    // Fields used when operations are performed.
+    mutex mutex_;
     op_queue<reactor_op> op_queue_[max_ops];
-    bool try_speculative_[max_ops];
-    bool shutdown_;
+    unsigned char speculation_score_[max_ops];
+    bool first_read_pending_;
+    uint64_t speculative_hits_;
+    uint64_t speculative_misses_;
+
+    // Fields used only when the descriptor is registered or moved.
+    descriptor_state* next_;
+    descriptor_state* prev_;
+    local_reactor* owner_;
 
     BOOST_ASIO_DECL descriptor_state(bool locking);
     void set_ready_events(uint32_t events) { task_result_ = events; }
@@ -116,6 +133,23 @@ public:
       per_descriptor_data& target_descriptor_data,
       per_descriptor_data& source_descriptor_data);
 
+  // Set whether only one of the reactors waiting on the descriptor is woken
+  // when it becomes ready. Returns 0 on success, system error code on failure.
+  BOOST_ASIO_DECL int set_exclusive_wakeup(socket_type descriptor,
+      per_descriptor_data& descriptor_data, bool value);
+
+  // Move the descriptor to the calling thread's own set of descriptors, if it
+  // is running the scheduler, or to the least loaded set otherwise. Returns 0
+  // on success, system error code on failure.
+  BOOST_ASIO_DECL int migrate_descriptor(socket_type descriptor,
+      per_descriptor_data& descriptor_data);
+
+  // Get the number of speculative operations on the descriptor that completed
+  // at once, and the number that would have blocked.
+  BOOST_ASIO_DECL void speculative_counts(
+      const per_descriptor_data& descriptor_data,
+      uint64_t& hits, uint64_t& misses);
+
   // Post a reactor operation for immediate completion.
   void post_immediate_completion(operation* op, bool is_continuation) const;
 
@@ -212,6 +246,26 @@ public:
   // Interrupt the select loop.
   BOOST_ASIO_DECL void interrupt();
 
+  // Get a set of descriptors for the calling thread to wait on. Returns 0 if
+  // the scheduler does not give threads their own sets.
+  BOOST_ASIO_DECL void* acquire_local_task();
+
+  // Give up a set of descriptors obtained from acquire_local_task. Until
+  // another thread takes it, the set is waited on through the shared set.
+  BOOST_ASIO_DECL void release_local_task(void* task);
+
+  // Run epoll once on a thread's own set of descriptors, which includes the
+  // shared set, until interrupted or events are ready to be dispatched.
+  BOOST_ASIO_DECL void run_local_task(void* task,
+      long usec, op_queue<operation>& ops);
+
+  // Interrupt a thread waiting on its own set of descriptors.
+  BOOST_ASIO_DECL void interrupt_local_task(void* task);
+
+  // Report the memory used for the state of registered descriptors.
+  BOOST_ASIO_DECL void descriptor_usage(std::size_t& descriptors,
+      std::size_t& bytes_per_descriptor, std::size_t& reserved_bytes) const;
+
 private:
   // The hint to pass to epoll_create to size its data structures.
   enum { epoll_size = 20000 };
@@ -223,6 +277,70 @@ private:
   // Create the timerfd file descriptor. Does not throw.
   BOOST_ASIO_DECL static int do_timerfd_create();
 
+  // Ask the kernel to busy poll on behalf of epoll_wait. Returns whether the
+  // kernel supports it. Does not throw.
+  BOOST_ASIO_DECL bool do_set_busy_poll_params(int fd);
+
+  // Wait for events on an epoll descriptor, busy polling first if the kernel
+  // cannot do it for us.
+  BOOST_ASIO_DECL int do_epoll_wait(int fd,
+      epoll_event* events, int max_events, int timeout);
+
+  // Create a set of descriptors for a thread to wait on, and add it to the
+  // list. Must be called with the list's mutex locked. Returns 0 on success,
+  // system error code on failure.
+  BOOST_ASIO_DECL int create_local_reactor(local_reactor*& r);
+
+  // Wait on a set through the shared set if no thread owns it, or on the
+  // shared set through it otherwise. Must be called with the list's mutex
+  // locked.
+  BOOST_ASIO_DECL void nest_local_reactor(local_reactor* r, bool owned);
+
+  // Choose the set for a descriptor being registered or migrated by the
+  // calling thread, and count the descriptor against it. Must be called with
+  // the list's mutex locked. Returns 0 for the shared set.
+  BOOST_ASIO_DECL local_reactor* choose_local_reactor();
+
+  // Get the epoll descriptor of the set that holds the given descriptor.
+  BOOST_ASIO_DECL int owner_epoll_fd(descriptor_state* descriptor_data) const;
+
+  // Poll the shared set without blocking, along with the sets of any threads
+  // that have left the scheduler.
+  BOOST_ASIO_DECL void poll_shared(epoll_event* events,
+      op_queue<operation>& ops);
+
+  // Poll a set that no thread owns without blocking.
+  BOOST_ASIO_DECL void poll_parked(local_reactor* r,
+      op_queue<operation>& ops);
+
+  // Mark a descriptor as ready in a set that may be polled by several threads
+  // at once, queueing it unless it is already queued.
+  BOOST_ASIO_DECL static void enqueue_ready(descriptor_state* descriptor_data,
+      uint32_t events, op_queue<operation>& ops);
+
+  // Collect the expired timers and update the timer descriptor.
+  BOOST_ASIO_DECL void dispatch_timers(op_queue<operation>& ops);
+
+  // Bounds for the scores that track how often speculative operations
+  // complete at once.
+  enum
+  {
+    speculation_score_max = 15,
+    speculation_score_initial = 8,
+    speculation_score_attempt = 4,
+    speculation_score_keep_ready = 12,
+    speculation_probe_interval = 16
+  };
+
+  // Reset the speculation state of a newly registered descriptor.
+  BOOST_ASIO_DECL void init_speculation(descriptor_state* descriptor_data);
+
+  // Record the outcome of a speculative operation on a descriptor. Returns
+  // whether the next operation should still be attempted at once, even though
+  // this one ran the descriptor dry or would have blocked.
+  BOOST_ASIO_DECL bool record_speculation(descriptor_state* descriptor_data,
+      int op_type, bool hit);
+
   // Allocate a new descriptor state object.
   BOOST_ASIO_DECL descriptor_state* allocate_descriptor_state();
 
@@ -264,6 +382,59 @@ private:
   // The timer file descriptor.
   int timer_fd_;
 
+  // The most events harvested by one call to epoll_wait.
+  const int max_events_;
+
+  // Whether the number of events harvested adapts to the load.
+  const bool adaptive_events_;
+
+  // Whether speculative operations adapt to each descriptor's history.
+  const bool adaptive_speculation_;
+
+  // The score of the first speculative read on new descriptors, and the
+  // number of descriptors registered, used to decide whether new descriptors
+  // should start by reading at once.
+  std::atomic<int> first_read_score_;
+  std::atomic<unsigned int> speculation_registrations_;
+
+  // The number of events to ask for in the next call to epoll_wait. Only
+  // accessed by the thread running the task.
+  int batch_events_;
+
+  // Storage for the harvested events. Only accessed by the thread running the
+  // task.
+  epoll_event* events_;
+  int events_capacity_;
+
+  // The time, in microseconds, for which epoll_wait busy polls before it
+  // blocks.
+  const long busy_poll_usec_;
+
+  // The most packets processed by each busy poll in the kernel.
+  const std::size_t busy_poll_budget_;
+
+  // Whether busy polling defers the device's interrupts.
+  const bool prefer_busy_poll_;
+
+  // Whether the kernel busy polls on behalf of epoll_wait. If not, the
+  // reactor polls without blocking until the busy poll time has elapsed.
+  bool kernel_busy_poll_;
+
+  // Whether each thread running the scheduler waits on its own set of
+  // descriptors.
+  const bool per_thread_;
+
+  // The most sets created for descriptors registered from outside the
+  // scheduler's threads.
+  const std::size_t max_local_reactors_;
+
+  // Mutex to protect the list of per-thread sets.
+  mutex local_reactors_mutex_;
+
+  // The per-thread sets, whether owned by a thread or not. Sets are not
+  // destroyed until the reactor is.
+  local_reactor* local_reactors_;
+
   // The timer queues.
   timer_queue_set timer_queues_;
 
@@ -274,7 +445,7 @@ private:
   mutex registered_descriptors_mutex_;
 
   // Keep track of all registered descriptors.
-  object_pool<descriptor_state> registered_descriptors_;
+  slab_object_pool<descriptor_state> registered_descriptors_;
 
   // Helper class to do post-perform_io cleanup.
   struct perform_io_cleanup_on_block_exit;
@@ -0,0 +1,390 @@
+//
+// detail/impl/cpu_affinity.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_IMPL_CPU_AFFINITY_IPP
+#define BOOST_ASIO_DETAIL_IMPL_CPU_AFFINITY_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/cpu_affinity.hpp>
+#include <boost/asio/error.hpp>
+
+#if defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+# include <boost/asio/detail/socket_types.hpp>
+#elif defined(__linux__)
+# include <cerrno>
+# include <cstdio>
+# include <pthread.h>
+# include <sched.h>
+# include <sys/syscall.h>
+# include <unistd.h>
+#endif // defined(BOOST_ASIO_WINDOWS) || defined(__CYGWIN__)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+namespace cpu_affinity {
+
+std::size_t available_cpu_count()
+{
+#if defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  DWORD_PTR process_mask = 0, system_mask = 0;
+  if (!::GetProcessAffinityMask(::GetCurrentProcess(),
+        &process_mask, &system_mask))
+    return 0;
+  std::size_t count = 0;
+  for (; process_mask; process_mask &= process_mask - 1)
+    ++count;
+  return count;
+#elif defined(__linux__) && defined(CPU_COUNT)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (::sched_getaffinity(0, sizeof(set), &set) != 0)
+    return 0;
+  return static_cast<std::size_t>(CPU_COUNT(&set));
+#else // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  return 0;
+#endif // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+}
+
+void bind_current_thread(std::size_t n, boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  DWORD_PTR process_mask = 0, system_mask = 0;
+  if (!::GetProcessAffinityMask(::GetCurrentProcess(),
+        &process_mask, &system_mask) || process_mask == 0)
+  {
+    DWORD last_error = ::GetLastError();
+    ec = boost::system::error_code(last_error,
+        boost::asio::error::get_system_category());
+    return;
+  }
+
+  std::size_t count = available_cpu_count();
+  n = count ? n % count : 0;
+  DWORD_PTR mask = process_mask;
+  for (; n > 0; --n)
+    mask &= mask - 1;
+  mask &= ~(mask - 1);
+
+  if (!::SetThreadAffinityMask(::GetCurrentThread(), mask))
+  {
+    DWORD last_error = ::GetLastError();
+    ec = boost::system::error_code(last_error,
+        boost::asio::error::get_system_category());
+    return;
+  }
+
+  ec = boost::system::error_code();
+#elif defined(__linux__) && defined(CPU_COUNT)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  if (::sched_getaffinity(0, sizeof(set), &set) != 0)
+  {
+    ec = boost::system::error_code(errno,
+        boost::asio::error::get_system_category());
+    return;
+  }
+
+  std::size_t count = static_cast<std::size_t>(CPU_COUNT(&set));
+  if (count == 0)
+  {
+    ec = boost::asio::error::operation_not_supported;
+    return;
+  }
+
+  n %= count;
+  int cpu = 0;
+  for (; cpu < CPU_SETSIZE; ++cpu)
+    if (CPU_ISSET(cpu, &set) && n-- == 0)
+      break;
+
+  CPU_ZERO(&set);
+  CPU_SET(cpu, &set);
+  int result = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+  if (result != 0)
+  {
+    ec = boost::system::error_code(result,
+        boost::asio::error::get_system_category());
+    return;
+  }
+
+  ec = boost::system::error_code();
+#else // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  (void)n;
+  ec = boost::asio::error::operation_not_supported;
+#endif // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+}
+
+void bind_current_thread_to_processor(
+    std::size_t processor, boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  if (processor >= sizeof(DWORD_PTR) * 8)
+  {
+    ec = boost::asio::error::invalid_argument;
+    return;
+  }
+
+  DWORD_PTR mask = static_cast<DWORD_PTR>(1) << processor;
+  if (!::SetThreadAffinityMask(::GetCurrentThread(), mask))
+  {
+    DWORD last_error = ::GetLastError();
+    ec = boost::system::error_code(last_error,
+        boost::asio::error::get_system_category());
+    return;
+  }
+
+  ec = boost::system::error_code();
+#elif defined(__linux__) && defined(CPU_COUNT)
+  if (processor >= static_cast<std::size_t>(CPU_SETSIZE))
+  {
+    ec = boost::asio::error::invalid_argument;
+    return;
+  }
+
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  CPU_SET(static_cast<int>(processor), &set);
+  int result = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+  if (result != 0)
+  {
+    ec = boost::system::error_code(result,
+        boost::asio::error::get_system_category());
+    return;
+  }
+
+  ec = boost::system::error_code();
+#else // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  (void)processor;
+  ec = boost::asio::error::operation_not_supported;
+#endif // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+}
+
+void bind_current_thread_to_node(
+    std::size_t node, boost::system::error_code& ec)
+{
+  std::vector<std::size_t> processors = node_processors(node, ec);
+  if (ec)
+    return;
+
+  if (processors.empty())
+  {
+    ec = boost::asio::error::invalid_argument;
+    return;
+  }
+
+#if defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  DWORD_PTR mask = 0;
+  for (std::size_t i = 0; i < processors.size(); ++i)
+    if (processors[i] < sizeof(DWORD_PTR) * 8)
+      mask |= static_cast<DWORD_PTR>(1) << processors[i];
+
+  if (!::SetThreadAffinityMask(::GetCurrentThread(), mask))
+  {
+    DWORD last_error = ::GetLastError();
+    ec = boost::system::error_code(last_error,
+        boost::asio::error::get_system_category());
+    return;
+  }
+
+  ec = boost::system::error_code();
+#elif defined(__linux__) && defined(CPU_COUNT)
+  cpu_set_t set;
+  CPU_ZERO(&set);
+  for (std::size_t i = 0; i < processors.size(); ++i)
+    if (processors[i] < static_cast<std::size_t>(CPU_SETSIZE))
+      CPU_SET(static_cast<int>(processors[i]), &set);
+
+  int result = ::pthread_setaffinity_np(::pthread_self(), sizeof(set), &set);
+  if (result != 0)
+  {
+    ec = boost::system::error_code(result,
+        boost::asio::error::get_system_category());
+    return;
+  }
+
+  ec = boost::system::error_code();
+#else // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  ec = boost::asio::error::operation_not_supported;
+#endif // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+}
+
+std::vector<std::size_t> node_processors(
+    std::size_t node, boost::system::error_code& ec)
+{
+  std::vector<std::size_t> processors;
+
+#if defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  ULONGLONG mask = 0;
+  if (node > 0xFF || !::GetNumaNodeProcessorMask(
+        static_cast<UCHAR>(node), &mask))
+  {
+    ec = boost::asio::error::invalid_argument;
+    return processors;
+  }
+
+  for (std::size_t i = 0; i < sizeof(mask) * 8; ++i)
+    if (mask & (static_cast<ULONGLONG>(1) << i))
+      processors.push_back(i);
+
+  ec = boost::system::error_code();
+#elif defined(__linux__)
+  // The node's processors are listed as comma-separated ranges, e.g. "0-3,8".
+  char path[64];
+  std::snprintf(path, sizeof(path),
+      "/sys/devices/system/node/node%lu/cpulist",
+      static_cast<unsigned long>(node));
+  std::FILE* f = std::fopen(path, "r");
+  if (!f)
+  {
+    ec = boost::system::error_code(errno,
+        boost::asio::error::get_system_category());
+    return processors;
+  }
+
+  unsigned long first = 0, last = 0;
+  char separator = 0;
+  while (std::fscanf(f, "%lu", &first) == 1)
+  {
+    last = first;
+    separator = static_cast<char>(std::fgetc(f));
+    if (separator == '-')
+    {
+      if (std::fscanf(f, "%lu", &last) != 1)
+        break;
+      separator = static_cast<char>(std::fgetc(f));
+    }
+
+    for (unsigned long i = first; i <= last; ++i)
+      processors.push_back(static_cast<std::size_t>(i));
+
+    if (separator != ',')
+      break;
+  }
+
+  std::fclose(f);
+  ec = boost::system::error_code();
+#else // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  (void)node;
+  ec = boost::asio::error::operation_not_supported;
+#endif // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+
+  return processors;
+}
+
+void bind_current_thread(const context_options& options,
+    std::size_t n, boost::system::error_code& ec)
+{
+  const std::vector<std::size_t>& processors = options.processors();
+  const std::vector<std::size_t>& nodes = options.numa_nodes();
+
+  if (!processors.empty())
+  {
+    bind_current_thread_to_processor(processors[n % processors.size()], ec);
+  }
+  else if (!nodes.empty())
+  {
+    // Threads are spread across the nodes in turn. When they are also to be
+    // pinned, successive threads on a node take successive processors of it.
+    std::size_t node = nodes[n % nodes.size()];
+    if (options.pin_threads())
+    {
+      std::vector<std::size_t> node_cpus = node_processors(node, ec);
+      if (!ec && node_cpus.empty())
+        ec = boost::asio::error::invalid_argument;
+      if (!ec)
+      {
+        std::size_t i = (n / nodes.size()) % node_cpus.size();
+        bind_current_thread_to_processor(node_cpus[i], ec);
+      }
+    }
+    else
+    {
+      bind_current_thread_to_node(node, ec);
+    }
+  }
+  else if (options.pin_threads())
+  {
+    bind_current_thread(n, ec);
+  }
+  else
+  {
+    ec = boost::system::error_code();
+  }
+}
+
+std::size_t current_processor(boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  ec = boost::system::error_code();
+  return static_cast<std::size_t>(::GetCurrentProcessorNumber());
+#elif defined(__linux__) && defined(CPU_COUNT)
+  int cpu = ::sched_getcpu();
+  if (cpu < 0)
+  {
+    ec = boost::system::error_code(errno,
+        boost::asio::error::get_system_category());
+    return 0;
+  }
+
+  ec = boost::system::error_code();
+  return static_cast<std::size_t>(cpu);
+#else // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  ec = boost::asio::error::operation_not_supported;
+  return 0;
+#endif // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+}
+
+std::size_t current_node(boost::system::error_code& ec)
+{
+#if defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  UCHAR node = 0;
+  if (!::GetNumaProcessorNode(
+        static_cast<UCHAR>(::GetCurrentProcessorNumber()), &node))
+  {
+    DWORD last_error = ::GetLastError();
+    ec = boost::system::error_code(last_error,
+        boost::asio::error::get_system_category());
+    return 0;
+  }
+
+  ec = boost::system::error_code();
+  return static_cast<std::size_t>(node);
+#elif defined(__linux__) && defined(SYS_getcpu)
+  unsigned cpu = 0, node = 0;
+  if (::syscall(SYS_getcpu, &cpu, &node, 0) != 0)
+  {
+    ec = boost::system::error_code(errno,
+        boost::asio::error::get_system_category());
+    return 0;
+  }
+
+  ec = boost::system::error_code();
+  return static_cast<std::size_t>(node);
+#else // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+  ec = boost::asio::error::operation_not_supported;
+  return 0;
+#endif // defined(BOOST_ASIO_WINDOWS_DESKTOP) || defined(__CYGWIN__)
+}
+
+} // namespace cpu_affinity
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_IMPL_CPU_AFFINITY_IPP
@@ -149,6 +149,28 @@ void dev_poll_reactor::move_descriptor(socket_type,
 {
 }
 
+int dev_poll_reactor::set_exclusive_wakeup(socket_type,
+    dev_poll_reactor::per_descriptor_data&, bool value)
+{
+  return value ? boost::asio::error::operation_not_supported : 0;
+}
+
+int dev_poll_reactor::migrate_descriptor(socket_type,
+    dev_poll_reactor::per_descriptor_data&)
+{
+  // All threads share the reactor's descriptors, so there is nothing to move.
+  return 0;
+}
+
+void dev_poll_reactor::speculative_counts(
+    const dev_poll_reactor::per_descriptor_data&,
+    uint64_t& hits, uint64_t& misses)
+{
+  // This reactor does not count speculative operations.
+  hits = 0;
+  misses = 0;
+}
+
 void dev_poll_reactor::call_post_immediate_completion(
     operation* op, bool is_continuation, const void* self)
 {
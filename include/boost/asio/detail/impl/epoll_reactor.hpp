@@ -28,6 +28,14 @@ namespace detail {
 inline void epoll_reactor::post_immediate_completion(
     operation* op, bool is_continuation) const
 {
+  if (per_thread_)
+  {
+    // Keep the completion on the thread that owns the descriptor.
+    scheduler_.work_started();
+    scheduler_.post_deferred_completion(op);
+    return;
+  }
+
   scheduler_.post_immediate_completion(op, is_continuation);
 }
 
@@ -21,8 +21,11 @@
 
 #include <cstddef>
 #include <sys/epoll.h>
+#include <boost/asio/detail/chrono.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/epoll_reactor.hpp>
 #include <boost/asio/detail/scheduler.hpp>
+#include <boost/asio/detail/thread.hpp>
 #include <boost/asio/detail/throw_error.hpp>
 #include <boost/asio/error.hpp>
 
@@ -30,12 +33,25 @@
 # include <sys/timerfd.h>
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
 
+#if defined(__linux__)
+# include <sys/ioctl.h>
+#endif // defined(__linux__)
+
 #include <boost/asio/detail/push_options.hpp>
 
 namespace boost {
 namespace asio {
 namespace detail {
 
+struct epoll_reactor::local_reactor
+{
+  int epoll_fd_;
+  epoll_event* events_;
+  std::size_t descriptors_;
+  bool owned_;
+  local_reactor* next_;
+};
+
 epoll_reactor::epoll_reactor(boost::asio::execution_context& ctx)
   : execution_context_service_base<epoll_reactor>(ctx),
     scheduler_(use_service<scheduler>(ctx)),
@@ -44,9 +60,35 @@ epoll_reactor::epoll_reactor(boost::asio::execution_context& ctx)
     interrupter_(),
     epoll_fd_(do_epoll_create()),
     timer_fd_(do_timerfd_create()),
+    max_events_(scheduler_.options().reactor_batch_size() == 0 ? 1
+        : scheduler_.options().reactor_batch_size() > 0x7FFFFFFF ? 0x7FFFFFFF
+        : static_cast<int>(scheduler_.options().reactor_batch_size())),
+    adaptive_events_(scheduler_.options().adaptive_reactor_batch()),
+    adaptive_speculation_(scheduler_.options().adaptive_speculation()),
+    first_read_score_(speculation_score_initial),
+    speculation_registrations_(0),
+    batch_events_(adaptive_events_ && max_events_ > 16 ? 16 : max_events_),
+    events_(new epoll_event[batch_events_]),
+    events_capacity_(batch_events_),
+    busy_poll_usec_(static_cast<long>(
+          (scheduler_.options().reactor_busy_poll().count() + 999) / 1000)),
+    busy_poll_budget_(scheduler_.options().reactor_busy_poll_budget()),
+    prefer_busy_poll_(scheduler_.options().prefer_busy_poll()),
+    kernel_busy_poll_(false),
+    per_thread_(scheduler_.per_thread_tasks()),
+    max_local_reactors_(scheduler_.concurrency_hint() > 1
+        ? static_cast<std::size_t>(scheduler_.concurrency_hint())
+        : thread::hardware_concurrency() > 1
+        ? thread::hardware_concurrency() : 1),
+    local_reactors_mutex_(mutex_.enabled()),
+    local_reactors_(0),
     shutdown_(false),
-    registered_descriptors_mutex_(mutex_.enabled())
+    registered_descriptors_mutex_(mutex_.enabled()),
+    registered_descriptors_(scheduler_.options().descriptor_slab_size(),
+        scheduler_.options().huge_page_descriptors())
 {
+  kernel_busy_poll_ = do_set_busy_poll_params(epoll_fd_);
+
   // Add the interrupter's descriptor to epoll.
   epoll_event ev = { 0, { 0 } };
   ev.events = EPOLLIN | EPOLLERR | EPOLLET;
@@ -69,6 +111,15 @@ epoll_reactor::~epoll_reactor()
     close(epoll_fd_);
   if (timer_fd_ != -1)
     close(timer_fd_);
+  delete[] events_;
+
+  while (local_reactor* r = local_reactors_)
+  {
+    local_reactors_ = r->next_;
+    close(r->epoll_fd_);
+    delete[] r->events_;
+    delete r;
+  }
 }
 
 void epoll_reactor::shutdown()
@@ -109,6 +160,8 @@ void epoll_reactor::notify_fork(
 
     interrupter_.recreate();
 
+    kernel_busy_poll_ = do_set_busy_poll_params(epoll_fd_);
+
     // Add the interrupter's descriptor to epoll.
     epoll_event ev = { 0, { 0 } };
     ev.events = EPOLLIN | EPOLLERR | EPOLLET;
@@ -126,6 +179,21 @@ void epoll_reactor::notify_fork(
 
     update_timeout();
 
+    // Recreate the per-thread sets, keeping them with their owners.
+    mutex::scoped_lock local_reactors_lock(local_reactors_mutex_);
+    for (local_reactor* r = local_reactors_; r; r = r->next_)
+    {
+      ::close(r->epoll_fd_);
+      r->epoll_fd_ = do_epoll_create();
+      do_set_busy_poll_params(r->epoll_fd_);
+      ev.events = EPOLLIN | EPOLLERR | EPOLLET;
+      ev.data.ptr = &interrupter_;
+      epoll_ctl(r->epoll_fd_, EPOLL_CTL_ADD,
+          interrupter_.read_descriptor(), &ev);
+      nest_local_reactor(r, r->owned_);
+    }
+    local_reactors_lock.unlock();
+
     // Re-register all descriptors with epoll.
     mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
     for (descriptor_state* state = registered_descriptors_.first();
@@ -133,7 +201,8 @@ void epoll_reactor::notify_fork(
     {
       ev.events = state->registered_events_;
       ev.data.ptr = state;
-      int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, state->descriptor_, &ev);
+      int result = epoll_ctl(owner_epoll_fd(state),
+          EPOLL_CTL_ADD, state->descriptor_, &ev);
       if (result != 0)
       {
         boost::system::error_code ec(errno,
@@ -158,33 +227,51 @@ int epoll_reactor::register_descriptor(socket_type descriptor,
         context(), static_cast<uintmax_t>(descriptor),
         reinterpret_cast<uintmax_t>(descriptor_data)));
 
+  local_reactor* owner = 0;
+  if (per_thread_)
+  {
+    mutex::scoped_lock local_reactors_lock(local_reactors_mutex_);
+    owner = choose_local_reactor();
+  }
+
   {
     mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
 
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
-    for (int i = 0; i < max_ops; ++i)
-      descriptor_data->try_speculative_[i] = true;
+    descriptor_data->owner_ = owner;
+    init_speculation(descriptor_data);
   }
 
   epoll_event ev = { 0, { 0 } };
   ev.events = EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET;
   descriptor_data->registered_events_ = ev.events;
   ev.data.ptr = descriptor_data;
-  int result = epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, descriptor, &ev);
+  int result = epoll_ctl(owner_epoll_fd(descriptor_data),
+      EPOLL_CTL_ADD, descriptor, &ev);
   if (result != 0)
   {
-    if (errno == EPERM)
+    result = errno;
+
+    if (owner)
+    {
+      mutex::scoped_lock local_reactors_lock(local_reactors_mutex_);
+      --owner->descriptors_;
+      descriptor_data->owner_ = 0;
+    }
+
+    if (result == EPERM)
     {
       // This file descriptor type is not supported by epoll. However, if it is
       // a regular file then operations on it will not block. We will allow
       // this descriptor to be used and fail later if an operation on it would
       // otherwise require a trip through the reactor.
       descriptor_data->registered_events_ = 0;
+      descriptor_data->try_speculative_[read_op] = true;
       return 0;
     }
-    return errno;
+    return result;
   }
 
   return 0;
@@ -206,9 +293,11 @@ int epoll_reactor::register_internal_descriptor(
     descriptor_data->reactor_ = this;
     descriptor_data->descriptor_ = descriptor;
     descriptor_data->shutdown_ = false;
+    descriptor_data->owner_ = 0;
     descriptor_data->op_queue_[op_type].push(op);
-    for (int i = 0; i < max_ops; ++i)
-      descriptor_data->try_speculative_[i] = true;
+    init_speculation(descriptor_data);
+    descriptor_data->try_speculative_[read_op] = true;
+    descriptor_data->first_read_pending_ = false;
   }
 
   epoll_event ev = { 0, { 0 } };
@@ -230,6 +319,98 @@ void epoll_reactor::move_descriptor(socket_type,
   source_descriptor_data = 0;
 }
 
+int epoll_reactor::set_exclusive_wakeup(socket_type descriptor,
+    epoll_reactor::per_descriptor_data& descriptor_data, bool value)
+{
+  if (!descriptor_data)
+    return EBADF;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (descriptor_data->registered_events_ == 0)
+    return value ? boost::asio::error::operation_not_supported : 0;
+
+#if defined(EPOLLEXCLUSIVE)
+  // An exclusive registration cannot be modified later, nor can it include
+  // EPOLLPRI, so it asks for EPOLLOUT up front.
+  uint32_t events = value
+    ? (EPOLLIN | EPOLLOUT | EPOLLERR | EPOLLHUP | EPOLLET | EPOLLEXCLUSIVE)
+    : (EPOLLIN | EPOLLERR | EPOLLHUP | EPOLLPRI | EPOLLET
+        | (descriptor_data->registered_events_ & EPOLLOUT));
+  if (events == descriptor_data->registered_events_)
+    return 0;
+
+  // The flag can only be changed by registering the descriptor again. Any
+  // readiness is reported by the new registration.
+  int epoll_fd = owner_epoll_fd(descriptor_data);
+  epoll_event ev = { 0, { 0 } };
+  ev.data.ptr = descriptor_data;
+  epoll_ctl(epoll_fd, EPOLL_CTL_DEL, descriptor, &ev);
+  ev.events = events;
+  if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, descriptor, &ev) != 0)
+  {
+    int result = errno;
+    ev.events = descriptor_data->registered_events_;
+    epoll_ctl(epoll_fd, EPOLL_CTL_ADD, descriptor, &ev);
+    return result;
+  }
+
+  descriptor_data->registered_events_ = events;
+  return 0;
+#else // defined(EPOLLEXCLUSIVE)
+  (void)descriptor;
+  return value ? boost::asio::error::operation_not_supported : 0;
+#endif // defined(EPOLLEXCLUSIVE)
+}
+
+int epoll_reactor::migrate_descriptor(socket_type descriptor,
+    epoll_reactor::per_descriptor_data& descriptor_data)
+{
+  if (!descriptor_data)
+    return EBADF;
+
+  if (!per_thread_)
+    return 0;
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+
+  if (descriptor_data->shutdown_ || descriptor_data->registered_events_ == 0)
+    return 0;
+
+  mutex::scoped_lock local_reactors_lock(local_reactors_mutex_);
+
+  local_reactor* source = descriptor_data->owner_;
+  local_reactor* target = choose_local_reactor();
+  if (target == source)
+  {
+    if (target)
+      --target->descriptors_;
+    return 0;
+  }
+
+  // Move the registration to the target set. Any readiness is reported by
+  // the new registration.
+  epoll_event ev = { 0, { 0 } };
+  ev.events = descriptor_data->registered_events_;
+  ev.data.ptr = descriptor_data;
+  int source_fd = source ? source->epoll_fd_ : epoll_fd_;
+  int target_fd = target ? target->epoll_fd_ : epoll_fd_;
+  epoll_ctl(source_fd, EPOLL_CTL_DEL, descriptor, &ev);
+  if (epoll_ctl(target_fd, EPOLL_CTL_ADD, descriptor, &ev) != 0)
+  {
+    int result = errno;
+    epoll_ctl(source_fd, EPOLL_CTL_ADD, descriptor, &ev);
+    if (target)
+      --target->descriptors_;
+    return result;
+  }
+
+  if (source)
+    --source->descriptors_;
+  descriptor_data->owner_ = target;
+  return 0;
+}
+
 void epoll_reactor::call_post_immediate_completion(
     operation* op, bool is_continuation, const void* self)
 {
@@ -268,13 +449,21 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
       {
         if (reactor_op::status status = op->perform())
         {
-          if (status == reactor_op::done_and_exhausted)
+          bool keep_trying = record_speculation(
+              descriptor_data, op_type, true);
+          if (status == reactor_op::done_and_exhausted && !keep_trying)
             if (descriptor_data->registered_events_ != 0)
               descriptor_data->try_speculative_[op_type] = false;
           descriptor_lock.unlock();
           on_immediate(op, is_continuation, immediate_arg);
           return;
         }
+
+        // The operation would have blocked, so there is no point in trying
+        // again until the descriptor becomes ready.
+        if (!record_speculation(descriptor_data, op_type, false))
+          if (descriptor_data->registered_events_ != 0)
+            descriptor_data->try_speculative_[op_type] = false;
       }
 
       if (descriptor_data->registered_events_ == 0)
@@ -291,7 +480,8 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
           epoll_event ev = { 0, { 0 } };
           ev.events = descriptor_data->registered_events_ | EPOLLOUT;
           ev.data.ptr = descriptor_data;
-          if (epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev) == 0)
+          if (epoll_ctl(owner_epoll_fd(descriptor_data),
+                EPOLL_CTL_MOD, descriptor, &ev) == 0)
           {
             descriptor_data->registered_events_ |= ev.events;
           }
@@ -321,7 +511,26 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
       epoll_event ev = { 0, { 0 } };
       ev.events = descriptor_data->registered_events_;
       ev.data.ptr = descriptor_data;
-      epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, descriptor, &ev);
+#if defined(EPOLLEXCLUSIVE)
+      if ((ev.events & EPOLLEXCLUSIVE) != 0)
+      {
+        // An exclusive registration cannot be modified, so it is armed again
+        // by registering the descriptor again.
+        int epoll_fd = owner_epoll_fd(descriptor_data);
+        epoll_ctl(epoll_fd, EPOLL_CTL_DEL, descriptor, &ev);
+        if (epoll_ctl(epoll_fd, EPOLL_CTL_ADD, descriptor, &ev) != 0)
+        {
+          descriptor_data->registered_events_ = 0;
+          op->ec_ = boost::system::error_code(errno,
+              boost::asio::error::get_system_category());
+          on_immediate(op, is_continuation, immediate_arg);
+          return;
+        }
+      }
+      else
+#endif // defined(EPOLLEXCLUSIVE)
+      epoll_ctl(owner_epoll_fd(descriptor_data),
+          EPOLL_CTL_MOD, descriptor, &ev);
     }
   }
 
@@ -329,6 +538,22 @@ void epoll_reactor::start_op(int op_type, socket_type descriptor,
   scheduler_.work_started();
 }
 
+void epoll_reactor::speculative_counts(
+    const epoll_reactor::per_descriptor_data& descriptor_data,
+    uint64_t& hits, uint64_t& misses)
+{
+  if (!descriptor_data)
+  {
+    hits = 0;
+    misses = 0;
+    return;
+  }
+
+  mutex::scoped_lock descriptor_lock(descriptor_data->mutex_);
+  hits = descriptor_data->speculative_hits_;
+  misses = descriptor_data->speculative_misses_;
+}
+
 void epoll_reactor::cancel_ops(socket_type,
     epoll_reactor::per_descriptor_data& descriptor_data)
 {
@@ -400,7 +625,15 @@ void epoll_reactor::deregister_descriptor(socket_type descriptor,
     else if (descriptor_data->registered_events_ != 0)
     {
       epoll_event ev = { 0, { 0 } };
-      epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, descriptor, &ev);
+      epoll_ctl(owner_epoll_fd(descriptor_data),
+          EPOLL_CTL_DEL, descriptor, &ev);
+    }
+
+    if (local_reactor* owner = descriptor_data->owner_)
+    {
+      mutex::scoped_lock local_reactors_lock(local_reactors_mutex_);
+      --owner->descriptors_;
+      descriptor_data->owner_ = 0;
     }
 
     op_queue<operation> ops;
@@ -505,9 +738,29 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
     }
   }
 
+  // Grow the storage for the events if the batch has grown.
+  if (batch_events_ > events_capacity_)
+  {
+    epoll_event* events = new epoll_event[batch_events_];
+    delete[] events_;
+    events_ = events;
+    events_capacity_ = batch_events_;
+  }
+
   // Block on the epoll descriptor.
-  epoll_event events[128];
-  int num_events = epoll_wait(epoll_fd_, events, 128, timeout);
+  epoll_event* events = events_;
+  int num_events = do_epoll_wait(epoll_fd_, events, batch_events_, timeout);
+
+  // A full batch suggests that more events are waiting, while a mostly empty
+  // one means that the batch can shrink.
+  if (adaptive_events_)
+  {
+    if (num_events == batch_events_ && batch_events_ < max_events_)
+      batch_events_ = batch_events_ > max_events_ / 2
+        ? max_events_ : batch_events_ * 2;
+    else if (num_events < batch_events_ / 4 && batch_events_ > 16)
+      batch_events_ /= 2;
+  }
 
 #if defined(BOOST_ASIO_ENABLE_HANDLER_TRACKING)
   // Trace the waiting events.
@@ -588,28 +841,116 @@ void epoll_reactor::run(long usec, op_queue<operation>& ops)
   }
 
   if (check_timers)
+    dispatch_timers(ops);
+}
+
+void epoll_reactor::interrupt()
+{
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN | EPOLLERR | EPOLLET;
+  ev.data.ptr = &interrupter_;
+  epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, interrupter_.read_descriptor(), &ev);
+}
+
+void* epoll_reactor::acquire_local_task()
+{
+  if (!per_thread_)
+    return 0;
+
+  mutex::scoped_lock lock(local_reactors_mutex_);
+
+  // Take over the unowned set with the most descriptors, so that descriptors
+  // registered before the thread started are waited on directly.
+  local_reactor* r = 0;
+  for (local_reactor* p = local_reactors_; p; p = p->next_)
+    if (!p->owned_ && (!r || p->descriptors_ > r->descriptors_))
+      r = p;
+
+  if (r)
   {
-    mutex::scoped_lock common_lock(mutex_);
-    timer_queues_.get_ready_timers(ops);
+    epoll_event ev = { 0, { 0 } };
+    epoll_ctl(epoll_fd_, EPOLL_CTL_DEL, r->epoll_fd_, &ev);
+  }
+  else if (int result = create_local_reactor(r))
+  {
+    boost::system::error_code ec(result,
+        boost::asio::error::get_system_category());
+    boost::asio::detail::throw_error(ec, "epoll");
+  }
 
-#if defined(BOOST_ASIO_HAS_TIMERFD)
-    if (timer_fd_ != -1)
+  nest_local_reactor(r, true);
+  return r;
+}
+
+void epoll_reactor::release_local_task(void* task)
+{
+  local_reactor* r = static_cast<local_reactor*>(task);
+
+  mutex::scoped_lock lock(local_reactors_mutex_);
+
+  epoll_event ev = { 0, { 0 } };
+  epoll_ctl(r->epoll_fd_, EPOLL_CTL_DEL, epoll_fd_, &ev);
+  nest_local_reactor(r, false);
+}
+
+void epoll_reactor::run_local_task(void* task,
+    long usec, op_queue<operation>& ops)
+{
+  local_reactor* r = static_cast<local_reactor*>(task);
+
+  // Calculate timeout. Check the timer queues only if timerfd is not in use.
+  int timeout;
+  if (usec == 0)
+    timeout = 0;
+  else
+  {
+    timeout = (usec < 0) ? -1 : ((usec - 1) / 1000 + 1);
+    if (timer_fd_ == -1)
     {
-      itimerspec new_timeout;
-      itimerspec old_timeout;
-      int flags = get_timeout(new_timeout);
-      timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
+      mutex::scoped_lock lock(mutex_);
+      timeout = get_timeout(timeout);
+    }
+  }
+
+  // Block on the thread's own epoll descriptor.
+  int num_events = do_epoll_wait(r->epoll_fd_,
+      r->events_, max_events_, timeout);
+
+  // Dispatch the waiting events. The shared set is polled only after the
+  // events have been dispatched, since it reuses the storage.
+  bool shared_ready = false;
+  for (int i = 0; i < num_events; ++i)
+  {
+    void* ptr = r->events_[i].data.ptr;
+    if (ptr == &interrupter_)
+    {
+      // The thread was woken to run a handler.
+    }
+    else if (ptr == &epoll_fd_)
+    {
+      shared_ready = true;
+    }
+    else
+    {
+      enqueue_ready(static_cast<descriptor_state*>(ptr),
+          r->events_[i].events, ops);
     }
-#endif // defined(BOOST_ASIO_HAS_TIMERFD)
   }
+
+  if (shared_ready)
+    poll_shared(r->events_, ops);
+  else if (timer_fd_ == -1)
+    dispatch_timers(ops);
 }
 
-void epoll_reactor::interrupt()
+void epoll_reactor::interrupt_local_task(void* task)
 {
+  local_reactor* r = static_cast<local_reactor*>(task);
+
   epoll_event ev = { 0, { 0 } };
   ev.events = EPOLLIN | EPOLLERR | EPOLLET;
   ev.data.ptr = &interrupter_;
-  epoll_ctl(epoll_fd_, EPOLL_CTL_MOD, interrupter_.read_descriptor(), &ev);
+  epoll_ctl(r->epoll_fd_, EPOLL_CTL_MOD, interrupter_.read_descriptor(), &ev);
 }
 
 int epoll_reactor::do_epoll_create()
@@ -661,6 +1002,302 @@ int epoll_reactor::do_timerfd_create()
 #endif // defined(BOOST_ASIO_HAS_TIMERFD)
 }
 
+bool epoll_reactor::do_set_busy_poll_params(int fd)
+{
+  if (busy_poll_usec_ <= 0)
+    return false;
+
+#if defined(__linux__) && defined(_IOW)
+  // Matches struct epoll_params, which older headers do not define.
+  struct busy_poll_params
+  {
+    uint32_t busy_poll_usecs;
+    uint16_t busy_poll_budget;
+    uint8_t prefer_busy_poll;
+    uint8_t pad;
+  };
+
+  busy_poll_params params = { 0, 0, 0, 0 };
+  params.busy_poll_usecs = busy_poll_usec_ > 0x7FFFFFFF
+    ? 0x7FFFFFFF : static_cast<uint32_t>(busy_poll_usec_);
+  params.busy_poll_budget = busy_poll_budget_ > 0xFFFF
+    ? 0xFFFF : static_cast<uint16_t>(busy_poll_budget_);
+  params.prefer_busy_poll = prefer_busy_poll_ ? 1 : 0;
+
+  // The request is EPIOCSPARAMS, which is supported from Linux 6.9.
+  return ::ioctl(fd, _IOW(0x8A, 0x01, busy_poll_params), &params) == 0;
+#else // defined(__linux__) && defined(_IOW)
+  (void)fd;
+  return false;
+#endif // defined(__linux__) && defined(_IOW)
+}
+
+int epoll_reactor::do_epoll_wait(int fd,
+    epoll_event* events, int max_events, int timeout)
+{
+  if (timeout == 0 || busy_poll_usec_ <= 0 || kernel_busy_poll_)
+    return epoll_wait(fd, events, max_events, timeout);
+
+  // The kernel cannot busy poll for us, so poll without blocking until the
+  // busy poll time has elapsed, and only then block.
+  chrono::steady_clock::time_point start = chrono::steady_clock::now();
+  chrono::steady_clock::time_point deadline
+    = start + chrono::microseconds(busy_poll_usec_);
+  int num_events = 0;
+  do
+    num_events = epoll_wait(fd, events, max_events, 0);
+  while (num_events == 0 && chrono::steady_clock::now() < deadline);
+
+  if (num_events == 0)
+  {
+    if (timeout > 0)
+    {
+      long elapsed = static_cast<long>(
+          chrono::duration_cast<chrono::milliseconds>(
+            chrono::steady_clock::now() - start).count());
+      timeout = elapsed >= timeout ? 0 : static_cast<int>(timeout - elapsed);
+    }
+    num_events = epoll_wait(fd, events, max_events, timeout);
+  }
+
+  return num_events;
+}
+
+int epoll_reactor::create_local_reactor(local_reactor*& r)
+{
+#if defined(EPOLL_CLOEXEC)
+  int fd = epoll_create1(EPOLL_CLOEXEC);
+#else // defined(EPOLL_CLOEXEC)
+  int fd = -1;
+  errno = EINVAL;
+#endif // defined(EPOLL_CLOEXEC)
+
+  if (fd == -1 && (errno == EINVAL || errno == ENOSYS))
+  {
+    fd = epoll_create(epoll_size);
+    if (fd != -1)
+      ::fcntl(fd, F_SETFD, FD_CLOEXEC);
+  }
+
+  if (fd == -1)
+    return errno;
+
+  do_set_busy_poll_params(fd);
+
+  // The set shares the interrupter's descriptor. Each set has its own
+  // registration, so modifying it wakes only the thread waiting on that set.
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN | EPOLLERR | EPOLLET;
+  ev.data.ptr = &interrupter_;
+  epoll_ctl(fd, EPOLL_CTL_ADD, interrupter_.read_descriptor(), &ev);
+
+  r = new local_reactor;
+  r->epoll_fd_ = fd;
+  r->events_ = new epoll_event[max_events_];
+  r->descriptors_ = 0;
+  r->owned_ = false;
+  r->next_ = local_reactors_;
+  local_reactors_ = r;
+  return 0;
+}
+
+void epoll_reactor::nest_local_reactor(local_reactor* r, bool owned)
+{
+  // The nested set is level-triggered, so that it stays ready for as long as
+  // it has events to harvest. The sets owned by threads are told apart from
+  // descriptors by setting the low bit of the pointer.
+  epoll_event ev = { 0, { 0 } };
+  ev.events = EPOLLIN;
+  r->owned_ = owned;
+  if (owned)
+  {
+    ev.data.ptr = &epoll_fd_;
+    epoll_ctl(r->epoll_fd_, EPOLL_CTL_ADD, epoll_fd_, &ev);
+  }
+  else
+  {
+    ev.data.ptr = reinterpret_cast<void*>(
+        reinterpret_cast<uintptr_t>(r) | 1);
+    epoll_ctl(epoll_fd_, EPOLL_CTL_ADD, r->epoll_fd_, &ev);
+  }
+}
+
+epoll_reactor::local_reactor* epoll_reactor::choose_local_reactor()
+{
+  // A thread running the scheduler keeps the descriptors it registers.
+  local_reactor* r = static_cast<local_reactor*>(
+      scheduler_.current_local_task());
+  if (!r)
+  {
+    // Otherwise spread the descriptors over the least loaded sets, creating
+    // as many as there are expected to be threads.
+    std::size_t count = 0;
+    for (local_reactor* p = local_reactors_; p; p = p->next_, ++count)
+      if (!r || p->descriptors_ < r->descriptors_)
+        r = p;
+
+    local_reactor* new_r = 0;
+    if ((!r || r->descriptors_ > 0) && count < max_local_reactors_
+        && create_local_reactor(new_r) == 0)
+    {
+      nest_local_reactor(new_r, false);
+      r = new_r;
+    }
+  }
+
+  if (r)
+    ++r->descriptors_;
+  return r;
+}
+
+int epoll_reactor::owner_epoll_fd(descriptor_state* descriptor_data) const
+{
+  return descriptor_data->owner_
+    ? descriptor_data->owner_->epoll_fd_ : epoll_fd_;
+}
+
+void epoll_reactor::poll_shared(epoll_event* events, op_queue<operation>& ops)
+{
+  int num_events = epoll_wait(epoll_fd_, events, max_events_, 0);
+
+#if defined(BOOST_ASIO_HAS_TIMERFD)
+  bool check_timers = (timer_fd_ == -1);
+#else // defined(BOOST_ASIO_HAS_TIMERFD)
+  bool check_timers = true;
+#endif // defined(BOOST_ASIO_HAS_TIMERFD)
+
+  for (int i = 0; i < num_events; ++i)
+  {
+    void* ptr = events[i].data.ptr;
+    if (ptr == &interrupter_)
+    {
+      // The timeout may need to be recalculated.
+    }
+#if defined(BOOST_ASIO_HAS_TIMERFD)
+    else if (ptr == &timer_fd_)
+    {
+      check_timers = true;
+    }
+#endif // defined(BOOST_ASIO_HAS_TIMERFD)
+    else if (reinterpret_cast<uintptr_t>(ptr) & 1)
+    {
+      poll_parked(reinterpret_cast<local_reactor*>(
+            reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(1)),
+          ops);
+    }
+    else
+    {
+      enqueue_ready(static_cast<descriptor_state*>(ptr),
+          events[i].events, ops);
+    }
+  }
+
+  if (check_timers)
+    dispatch_timers(ops);
+}
+
+void epoll_reactor::poll_parked(local_reactor* r, op_queue<operation>& ops)
+{
+  // Any events that do not fit are harvested by a later poll, since the set
+  // remains ready.
+  epoll_event events[64];
+  int num_events = epoll_wait(r->epoll_fd_, events, 64, 0);
+  for (int i = 0; i < num_events; ++i)
+  {
+    void* ptr = events[i].data.ptr;
+    if (ptr != &interrupter_)
+      enqueue_ready(static_cast<descriptor_state*>(ptr),
+          events[i].events, ops);
+  }
+}
+
+void epoll_reactor::enqueue_ready(descriptor_state* descriptor_data,
+    uint32_t events, op_queue<operation>& ops)
+{
+  // The descriptor operation doesn't count as work in and of itself, so we
+  // don't call work_started() here. The events are accumulated until the
+  // operation runs, and the operation is queued only by the thread that sees
+  // it leave the unqueued state.
+  descriptor_data->pending_events_.fetch_or(events, std::memory_order_acq_rel);
+  if (!descriptor_data->enqueued_.exchange(true, std::memory_order_acq_rel))
+    ops.push(descriptor_data);
+}
+
+void epoll_reactor::dispatch_timers(op_queue<operation>& ops)
+{
+  mutex::scoped_lock common_lock(mutex_);
+  timer_queues_.get_ready_timers(ops);
+
+#if defined(BOOST_ASIO_HAS_TIMERFD)
+  if (timer_fd_ != -1)
+  {
+    itimerspec new_timeout;
+    itimerspec old_timeout;
+    int flags = get_timeout(new_timeout);
+    timerfd_settime(timer_fd_, flags, &new_timeout, &old_timeout);
+  }
+#endif // defined(BOOST_ASIO_HAS_TIMERFD)
+}
+
+void epoll_reactor::init_speculation(
+    epoll_reactor::descriptor_state* descriptor_data)
+{
+  for (int i = 0; i < max_ops; ++i)
+  {
+    descriptor_data->try_speculative_[i] = true;
+    descriptor_data->speculation_score_[i] = speculation_score_initial;
+  }
+  descriptor_data->first_read_pending_ = adaptive_speculation_;
+  descriptor_data->speculative_hits_ = 0;
+  descriptor_data->speculative_misses_ = 0;
+
+  // A descriptor that is already readable when it is added to epoll is
+  // reported as ready, so the first read need not be attempted at once. Skip
+  // the attempt when first reads mostly fail, but keep probing occasionally.
+  if (adaptive_speculation_
+      && first_read_score_.load(std::memory_order_relaxed)
+        < speculation_score_attempt
+      && speculation_registrations_.fetch_add(1, std::memory_order_relaxed)
+        % speculation_probe_interval != 0)
+  {
+    descriptor_data->try_speculative_[read_op] = false;
+    descriptor_data->first_read_pending_ = false;
+  }
+}
+
+bool epoll_reactor::record_speculation(
+    epoll_reactor::descriptor_state* descriptor_data, int op_type, bool hit)
+{
+  if (hit)
+    ++descriptor_data->speculative_hits_;
+  else
+    ++descriptor_data->speculative_misses_;
+
+  if (!adaptive_speculation_)
+    return !hit;
+
+  // A miss costs a wasted system call, while a hit saves a trip through the
+  // reactor, so misses count for more.
+  unsigned char& score = descriptor_data->speculation_score_[op_type];
+  if (hit)
+    score = score < speculation_score_max ? score + 1 : score;
+  else
+    score = score > 2 ? score - 2 : 0;
+
+  if (op_type == read_op && descriptor_data->first_read_pending_)
+  {
+    // Updates from different descriptors may race, but the score only
+    // steers a heuristic.
+    descriptor_data->first_read_pending_ = false;
+    int first = first_read_score_.load(std::memory_order_relaxed);
+    first = hit ? (first < speculation_score_max ? first + 1 : first)
+      : (first > 2 ? first - 2 : 0);
+    first_read_score_.store(first, std::memory_order_relaxed);
+  }
+
+  return hit && score >= speculation_score_keep_ready;
+}
+
 epoll_reactor::descriptor_state* epoll_reactor::allocate_descriptor_state()
 {
   mutex::scoped_lock descriptors_lock(registered_descriptors_mutex_);
@@ -674,6 +1311,15 @@ void epoll_reactor::free_descriptor_state(epoll_reactor::descriptor_state* s)
   registered_descriptors_.free(s);
 }
 
+void epoll_reactor::descriptor_usage(std::size_t& descriptors,
+    std::size_t& bytes_per_descriptor, std::size_t& reserved_bytes) const
+{
+  // The pool's counters may be read without locking the registration mutex.
+  descriptors = registered_descriptors_.live_count();
+  bytes_per_descriptor = slab_object_pool<descriptor_state>::object_size;
+  reserved_bytes = registered_descriptors_.reserved_bytes();
+}
+
 void epoll_reactor::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -759,7 +1405,10 @@ struct epoll_reactor::perform_io_cleanup_on_block_exit
 
 epoll_reactor::descriptor_state::descriptor_state(bool locking)
   : operation(&epoll_reactor::descriptor_state::do_complete),
-    mutex_(locking)
+    pending_events_(0),
+    enqueued_(false),
+    mutex_(locking),
+    owner_(0)
 {
 }
 
@@ -810,6 +1459,14 @@ void epoll_reactor::descriptor_state::do_complete(
   {
     descriptor_state* descriptor_data = static_cast<descriptor_state*>(base);
     uint32_t events = static_cast<uint32_t>(bytes_transferred);
+    if (descriptor_data->reactor_->per_thread_)
+    {
+      // Allow the descriptor to be queued again before taking the events, so
+      // that events arriving from now on are not lost.
+      descriptor_data->enqueued_.store(false, std::memory_order_release);
+      events = descriptor_data->pending_events_.exchange(
+          0, std::memory_order_acq_rel);
+    }
     if (operation* op = descriptor_data->perform_io(events))
     {
       op->complete(owner, ec, 0);
@@ -31,6 +31,13 @@ inline void io_uring_service::post_immediate_completion(
   scheduler_.post_immediate_completion(op, is_continuation);
 }
 
+inline void io_uring_service::post_immediate_completion(
+    io_uring_operation* op, bool is_continuation)
+{
+  op->claim_deadline();
+  scheduler_.post_immediate_completion(op, is_continuation);
+}
+
 template <typename Time_Traits>
 void io_uring_service::add_timer_queue(timer_queue<Time_Traits>& queue)
 {
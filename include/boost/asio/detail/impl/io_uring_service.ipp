@@ -19,11 +19,16 @@
 
 #if defined(BOOST_ASIO_HAS_IO_URING)
 
+#include <algorithm>
 #include <cstddef>
+#include <cstring>
 #include <sys/eventfd.h>
+#include <boost/asio/detail/assert.hpp>
 #include <boost/asio/detail/io_uring_service.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
 #include <boost/asio/detail/scheduler.hpp>
+#include <boost/asio/detail/thread_context.hpp>
+#include <boost/asio/detail/thread_info_base.hpp>
 #include <boost/asio/detail/throw_error.hpp>
 #include <boost/asio/error.hpp>
 
@@ -47,10 +52,32 @@ io_uring_service::io_uring_service(boost::asio::execution_context& ctx)
     registration_mutex_(mutex_.enabled()),
     reactor_(use_service<reactor>(ctx)),
     reactor_data_(),
-    event_fd_(-1)
+    event_fd_(-1),
+    max_pending_multishot_results_(
+        scheduler_.options().max_pending_accepts() > 0
+          ? scheduler_.options().max_pending_accepts() : 1),
+    max_pending_receive_results_(
+        scheduler_.options().max_pending_receives() > 0
+          ? scheduler_.options().max_pending_receives() : 1),
+    zero_copy_send_threshold_(
+        scheduler_.options().zero_copy_send_threshold()),
+    next_buffer_group_(0),
+    sq_poll_(false),
+    defer_taskrun_(false),
+    ring_disabled_(false),
+    registered_files_(scheduler_.options().io_uring_registered_files()),
+    last_cq_overflow_(0),
+    cq_overflows_(0),
+    sq_full_flushes_(0),
+    submits_(0),
+    submitted_entries_(0)
 {
+  for (std::size_t i = registered_files_; i > 0; --i)
+    free_files_.push_back(static_cast<int>(i - 1));
+
   reactor_.init_task();
   init_ring();
+  init_registered_files();
   register_with_reactor();
 }
 
@@ -75,11 +102,12 @@ void io_uring_service::shutdown()
   {
     for (int i = 0; i < max_ops; ++i)
     {
-      if (!io_obj->queues_[i].op_queue_.empty())
+      if (io_uring_operation* op = io_obj->queues_[i].op_queue_.front())
       {
+        void* data = submission_data(&io_obj->queues_[i], op);
         ops.push(io_obj->queues_[i].op_queue_);
         if (::io_uring_sqe* sqe = get_sqe())
-          ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
+          ::io_uring_prep_cancel(sqe, data, 0);
       }
     }
     io_obj->shutdown_ = true;
@@ -91,12 +119,37 @@ void io_uring_service::shutdown()
     ::io_uring_prep_cancel(sqe, &timeout_, IOSQE_IO_DRAIN);
   submit_sqes();
 
-  // Wait for all completions to come back.
+  // Wait for all completions to come back. Operations sent from other rings
+  // are abandoned along with this ring's own, and the records of messages sent
+  // from this ring are released.
   for (; outstanding_work_ > 0; --outstanding_work_)
   {
     ::io_uring_cqe* cqe = 0;
     if (::io_uring_wait_cqe(&ring_, &cqe) != 0)
       break;
+    void* ptr = ::io_uring_cqe_get_data(cqe);
+    if ((reinterpret_cast<uintptr_t>(ptr) & 2) != 0)
+    {
+      if (perform_message(ptr, cqe->res, ops))
+        ++outstanding_work_;
+    }
+    else if ((reinterpret_cast<uintptr_t>(ptr) & 1) != 0
+        && (cqe->flags & IORING_CQE_F_MORE) != 0)
+    {
+      ++outstanding_work_;
+    }
+    ::io_uring_cqe_seen(&ring_, cqe);
+  }
+
+  // Operations sent from other rings are not counted as outstanding work, so
+  // any that arrived after the last counted completion are collected here.
+  ::io_uring_cqe* cqe = 0;
+  while (::io_uring_peek_cqe(&ring_, &cqe) == 0)
+  {
+    void* ptr = ::io_uring_cqe_get_data(cqe);
+    if ((reinterpret_cast<uintptr_t>(ptr) & 2) != 0)
+      perform_message(ptr, cqe->res, ops);
+    ::io_uring_cqe_seen(&ring_, cqe);
   }
 
   timer_queues_.get_all_timers(ops);
@@ -125,7 +178,10 @@ void io_uring_service::notify_fork(
           {
             mutex::scoped_lock lock(mutex_);
             if (::io_uring_sqe* sqe = get_sqe())
-              ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
+            {
+              ::io_uring_prep_cancel(sqe, submission_data(&io_obj->queues_[i],
+                    io_obj->queues_[i].op_queue_.front()), 0);
+            }
           }
         }
       }
@@ -150,13 +206,41 @@ void io_uring_service::notify_fork(
           break;
         if (void* ptr = ::io_uring_cqe_get_data(cqe))
         {
-          if (ptr != this && ptr != &timer_queues_ && ptr != &timeout_)
+          if ((reinterpret_cast<uintptr_t>(ptr) & 2) != 0)
           {
-            io_queue* io_q = static_cast<io_queue*>(ptr);
-            io_q->set_result(cqe->res);
-            ops.push(io_q);
+            if (perform_message(ptr, cqe->res, ops))
+              ++outstanding_work_;
+          }
+          else if (ptr != this && ptr != &timer_queues_ && ptr != &timeout_)
+          {
+            uintptr_t data = reinterpret_cast<uintptr_t>(ptr);
+            io_queue* io_q = reinterpret_cast<io_queue*>(
+                data & ~static_cast<uintptr_t>(1));
+            bool more = (cqe->flags & IORING_CQE_F_MORE) != 0;
+            int result = cqe->res;
+            if ((data & 1) != 0)
+            {
+              // A completion of a multishot operation's submission. There is
+              // no handler left to take its result, so the operation decides
+              // how the submission ends.
+              mutex::scoped_lock io_object_lock(io_q->io_object_->mutex_);
+              io_uring_operation* op = io_q->op_queue_.front();
+              if (op && op->multishot_)
+              {
+                result = static_cast<io_uring_multishot_operation*>(
+                    op)->discard(result, cqe->flags);
+              }
+            }
+            if (more)
+              ++outstanding_work_;
+            else
+            {
+              io_q->set_result(result);
+              ops.push(io_q);
+            }
           }
         }
+        ::io_uring_cqe_seen(&ring_, cqe);
       }
       scheduler_.post_deferred_completions(ops);
 
@@ -176,6 +260,7 @@ void io_uring_service::notify_fork(
       // The child process gets a new io_uring instance.
       ::io_uring_queue_exit(&ring_);
       init_ring();
+      init_registered_files();
       register_with_reactor();
     }
     break;
@@ -190,14 +275,19 @@ void io_uring_service::init_task()
 }
 
 void io_uring_service::register_io_object(
-    io_uring_service::per_io_object_data& io_obj)
+    io_uring_service::per_io_object_data& io_obj, int descriptor)
 {
   io_obj = allocate_io_object();
 
+  int fixed_file = (registered_files_ > 0 && descriptor >= 0)
+    ? register_file(descriptor) : -1;
+
   mutex::scoped_lock io_object_lock(io_obj->mutex_);
 
   io_obj->service_ = this;
   io_obj->shutdown_ = false;
+  io_obj->descriptor_ = descriptor;
+  io_obj->fixed_file_ = fixed_file;
   for (int i = 0; i < max_ops; ++i)
   {
     io_obj->queues_[i].io_object_ = io_obj;
@@ -215,6 +305,8 @@ void io_uring_service::register_internal_io_object(
 
   io_obj->service_ = this;
   io_obj->shutdown_ = false;
+  io_obj->descriptor_ = -1;
+  io_obj->fixed_file_ = -1;
   for (int i = 0; i < max_ops; ++i)
   {
     io_obj->queues_[i].io_object_ = io_obj;
@@ -224,10 +316,9 @@ void io_uring_service::register_internal_io_object(
   io_obj->queues_[op_type].op_queue_.push(op);
   io_object_lock.unlock();
   mutex::scoped_lock lock(mutex_);
-  if (::io_uring_sqe* sqe = get_sqe())
+  if (::io_uring_sqe* sqe = get_sqe(sqe_count(op)))
   {
-    op->prepare(sqe);
-    ::io_uring_sqe_set_data(sqe, &io_obj->queues_[op_type]);
+    prepare_sqe(sqe, &io_obj->queues_[op_type], op);
     post_submit_sqes_op(lock);
   }
   else
@@ -254,6 +345,31 @@ void io_uring_service::unregister_buffers()
   (void)::io_uring_unregister_buffers(&ring_);
 }
 
+::io_uring_buf_ring* io_uring_service::register_buffer_ring(
+    unsigned entries, int& group)
+{
+  mutex::scoped_lock lock(mutex_);
+  group = next_buffer_group_;
+  next_buffer_group_ = (next_buffer_group_ + 1) & 0xFFFF;
+  int result = 0;
+  ::io_uring_buf_ring* ring =
+    ::io_uring_setup_buf_ring(&ring_, entries, group, 0, &result);
+  if (!ring)
+  {
+    boost::system::error_code ec(-result,
+        boost::asio::error::get_system_category());
+    boost::asio::detail::throw_error(ec, "io_uring_setup_buf_ring");
+  }
+  return ring;
+}
+
+void io_uring_service::unregister_buffer_ring(
+    ::io_uring_buf_ring* ring, unsigned entries, int group)
+{
+  mutex::scoped_lock lock(mutex_);
+  (void)::io_uring_free_buf_ring(&ring_, ring, entries, group);
+}
+
 void io_uring_service::start_op(int op_type,
     io_uring_service::per_io_object_data& io_obj,
     io_uring_operation* op, bool is_continuation)
@@ -279,17 +395,19 @@ void io_uring_service::start_op(int op_type,
     if (op->perform(false))
     {
       io_object_lock.unlock();
-      scheduler_.post_immediate_completion(op, is_continuation);
+      post_immediate_completion(op, is_continuation);
     }
     else
     {
+      // The I/O object's lock is kept until any offered deadline has been
+      // claimed or declined, as the operation cannot complete before then.
       io_obj->queues_[op_type].op_queue_.push(op);
-      io_object_lock.unlock();
       mutex::scoped_lock lock(mutex_);
-      if (::io_uring_sqe* sqe = get_sqe())
+      ::io_uring_sqe* sqe = get_op_sqe(lock, op);
+      io_object_lock.unlock();
+      if (sqe)
       {
-        op->prepare(sqe);
-        ::io_uring_sqe_set_data(sqe, &io_obj->queues_[op_type]);
+        prepare_sqe(sqe, &io_obj->queues_[op_type], op);
         scheduler_.work_started();
         post_submit_sqes_op(lock);
       }
@@ -303,6 +421,8 @@ void io_uring_service::start_op(int op_type,
   }
   else
   {
+    // An operation queued behind another uses the timer for its deadline.
+    op->deadline_offer_.decline();
     io_obj->queues_[op_type].op_queue_.push(op);
     scheduler_.work_started();
   }
@@ -346,7 +466,8 @@ void io_uring_service::cancel_ops_by_key(
           mutex::scoped_lock lock(mutex_);
           if (::io_uring_sqe* sqe = get_sqe())
           {
-            ::io_uring_prep_cancel(sqe, &io_obj->queues_[op_type], 0);
+            ::io_uring_prep_cancel(sqe,
+                submission_data(&io_obj->queues_[op_type], op), 0);
             submit_sqes();
           }
         }
@@ -380,7 +501,11 @@ void io_uring_service::deregister_io_object(
     op_queue<operation> ops;
     bool pending_cancelled_ops = do_cancel_ops(io_obj, ops);
     io_obj->shutdown_ = true;
+    int fixed_file = io_obj->fixed_file_;
+    io_obj->fixed_file_ = -1;
     io_object_lock.unlock();
+    if (fixed_file >= 0)
+      unregister_file(fixed_file);
     scheduler_.post_deferred_completions(ops);
     if (pending_cancelled_ops)
     {
@@ -412,11 +537,81 @@ void io_uring_service::cleanup_io_object(
   }
 }
 
+bool io_uring_service::start_close_op(
+    io_uring_service::per_io_object_data& io_obj, io_uring_operation* op)
+{
+  if (!io_obj)
+    return false;
+
+  mutex::scoped_lock io_object_lock(io_obj->mutex_);
+  if (io_obj->shutdown_)
+  {
+    // We are shutting down, so let the destructor free the I/O object.
+    io_obj = 0;
+    return false;
+  }
+
+  op_queue<operation> ops;
+  do_cancel_ops(io_obj, ops);
+  io_obj->shutdown_ = true;
+  int fixed_file = io_obj->fixed_file_;
+  io_obj->fixed_file_ = -1;
+
+  // The close waits behind any cancelled operation on the same queue, and is
+  // submitted by perform_io when that operation finishes.
+  io_queue& io_q = io_obj->queues_[except_op];
+  bool submit = io_q.op_queue_.empty();
+  io_q.op_queue_.push(op);
+  io_object_lock.unlock();
+
+  if (fixed_file >= 0)
+    unregister_file(fixed_file);
+  scheduler_.post_deferred_completions(ops);
+
+  if (submit)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (::io_uring_sqe* sqe = get_sqe())
+    {
+      prepare_sqe(sqe, &io_q, op);
+      scheduler_.work_started();
+      post_submit_sqes_op(lock);
+    }
+    else
+    {
+      lock.unlock();
+      io_object_lock.lock();
+      io_q.op_queue_.pop();
+      bool idle = true;
+      for (int i = 0; i < max_ops; ++i)
+        if (!io_obj->queues_[i].op_queue_.empty())
+          idle = false;
+      io_object_lock.unlock();
+
+      // Leave io_obj set if it must be freed by cleanup_io_object.
+      if (!idle)
+        io_obj = 0;
+      return false;
+    }
+  }
+  else
+  {
+    scheduler_.work_started();
+  }
+
+  // The last operation to complete frees the I/O object.
+  io_obj = 0;
+  return true;
+}
+
 void io_uring_service::run(long usec, op_queue<operation>& ops)
 {
   __kernel_timespec ts;
   int local_ops = 0;
 
+  if (ring_disabled_)
+    enable_ring();
+
   if (usec > 0)
   {
     ts.tv_sec = usec / 1000000;
@@ -431,6 +626,13 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
     }
   }
 
+#if defined(IORING_SETUP_DEFER_TASKRUN)
+  // Deferred completion work is only run when the submitter enters the
+  // kernel, which a peek alone does not do.
+  if (defer_taskrun_ && usec == 0)
+    ::io_uring_get_events(&ring_);
+#endif // defined(IORING_SETUP_DEFER_TASKRUN)
+
   ::io_uring_cqe* cqe = 0;
   int result = (usec == 0)
     ? ::io_uring_peek_cqe(&ring_, &cqe)
@@ -451,47 +653,85 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
     }
   }
 
+  // Completions are harvested as a batch, and the completion queue is
+  // advanced once for the whole batch rather than once per entry.
   bool check_timers = false;
   int count = 0;
-  while (result == 0 || local_ops > 0)
+  int more_count = 0;
+  int received_count = 0;
+  if (result == 0 || local_ops > 0)
   {
-    if (result == 0)
+    // The kernel counts the completions it could not fit in the queue. Only
+    // the increase since the last harvest is added, and the unsigned
+    // subtraction allows for the kernel's counter wrapping around.
+    unsigned cq_overflow = IO_URING_READ_ONCE(*ring_.cq.koverflow);
+    if (cq_overflow != last_cq_overflow_)
+    {
+      cq_overflows_.fetch_add(cq_overflow - last_cq_overflow_,
+          std::memory_order_relaxed);
+      last_cq_overflow_ = cq_overflow;
+    }
+
+    ::io_uring_cqe* cqes[complete_batch_size];
+    do
     {
-      if (void* ptr = ::io_uring_cqe_get_data(cqe))
+      unsigned n = ::io_uring_peek_batch_cqe(&ring_, cqes, complete_batch_size);
+      for (unsigned i = 0; i < n; ++i)
       {
-        if (ptr == this)
-        {
-          // The io_uring service was interrupted.
-        }
-        else if (ptr == &timer_queues_)
-        {
-          check_timers = true;
-        }
-        else if (ptr == &timeout_)
-        {
-          check_timers = true;
-          timeout_.tv_sec = 0;
-          timeout_.tv_nsec = 0;
-        }
-        else if (ptr == &ts)
-        {
-          --local_ops;
-        }
-        else
+        cqe = cqes[i];
+        if (void* ptr = ::io_uring_cqe_get_data(cqe))
         {
-          io_queue* io_q = static_cast<io_queue*>(ptr);
-          io_q->set_result(cqe->res);
-          ops.push(io_q);
+          if (ptr == this)
+          {
+            // The io_uring service was interrupted.
+          }
+          else if (ptr == &timer_queues_)
+          {
+            check_timers = true;
+          }
+          else if (ptr == &timeout_)
+          {
+            check_timers = true;
+            timeout_.tv_sec = 0;
+            timeout_.tv_nsec = 0;
+          }
+          else if (ptr == &ts)
+          {
+            --local_ops;
+          }
+          else if ((reinterpret_cast<uintptr_t>(ptr) & 2) != 0)
+          {
+            if (perform_message(ptr, cqe->res, ops))
+              ++received_count;
+          }
+          else if ((reinterpret_cast<uintptr_t>(ptr) & 1) != 0)
+          {
+            // A completion of a multishot operation's submission. Only the
+            // last completion ends the submission's outstanding work.
+            io_queue* io_q = reinterpret_cast<io_queue*>(
+                reinterpret_cast<uintptr_t>(ptr) & ~static_cast<uintptr_t>(1));
+            perform_multishot(io_q, cqe->res, cqe->flags, ops);
+            if ((cqe->flags & IORING_CQE_F_MORE) != 0)
+              ++more_count;
+          }
+          else
+          {
+            io_queue* io_q = static_cast<io_queue*>(ptr);
+            io_q->set_result(cqe->res);
+            ops.push(io_q);
+          }
         }
       }
-      ::io_uring_cqe_seen(&ring_, cqe);
-      ++count;
-    }
-    result = (count < complete_batch_size || local_ops > 0)
-      ? ::io_uring_peek_cqe(&ring_, &cqe) : -EAGAIN;
+      if (n > 0)
+        ::io_uring_cq_advance(&ring_, n);
+      count += static_cast<int>(n);
+
+      // The local timeout's completions must be harvested before the timespec
+      // goes out of scope.
+    } while (local_ops > 0);
   }
 
-  decrement(outstanding_work_, count);
+  decrement(outstanding_work_, count - more_count - received_count);
 
   if (check_timers)
   {
@@ -510,6 +750,16 @@ void io_uring_service::run(long usec, op_queue<operation>& ops)
   }
 }
 
+void io_uring_service::ring_usage(uint64_t& cq_overflows,
+    uint64_t& sq_full_flushes, uint64_t& submits,
+    uint64_t& submitted_entries) const
+{
+  cq_overflows = cq_overflows_.load(std::memory_order_relaxed);
+  sq_full_flushes = sq_full_flushes_.load(std::memory_order_relaxed);
+  submits = submits_.load(std::memory_order_relaxed);
+  submitted_entries = submitted_entries_.load(std::memory_order_relaxed);
+}
+
 void io_uring_service::interrupt()
 {
   mutex::scoped_lock lock(mutex_);
@@ -521,9 +771,107 @@ void io_uring_service::interrupt()
   submit_sqes();
 }
 
+bool io_uring_service::send_operation(scheduler_task& target, operation* op)
+{
+  // The scheduler only sends operations between tasks of the same type.
+  io_uring_service* target_service = static_cast<io_uring_service*>(&target);
+
+  thread_info_base* this_thread = thread_context::top_of_thread_call_stack();
+  sent_message* msg = static_cast<sent_message*>(
+      thread_info_base::allocate(this_thread, sizeof(sent_message)));
+  msg->target_ = target_service;
+  msg->op_ = op;
+
+  mutex::scoped_lock lock(mutex_);
+  if (!shutdown_)
+  {
+    if (::io_uring_sqe* sqe = get_sqe())
+    {
+      // The operation is tagged so that the target can tell it apart from its
+      // own completions, and the message so that this ring can.
+      ::io_uring_prep_msg_ring(sqe, target_service->ring_.ring_fd, 0,
+          reinterpret_cast<__u64>(op) | 2, 0);
+      ::io_uring_sqe_set_data(sqe,
+          reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(msg) | 3));
+
+      // The message is submitted at once, as the sending context may block,
+      // stop or return from run_one() before it would submit a batch. Any
+      // entries that the kernel did not accept are submitted later as usual.
+      submit_sqes();
+      post_submit_sqes_op(lock);
+      return true;
+    }
+  }
+  lock.unlock();
+
+  thread_info_base::deallocate(this_thread, msg, sizeof(sent_message));
+  return false;
+}
+
 void io_uring_service::init_ring()
 {
-  int result = ::io_uring_queue_init(ring_size, &ring_, 0);
+  const context_options& options = scheduler_.options();
+
+  ::io_uring_params params;
+  std::memset(&params, 0, sizeof(params));
+  params.flags = IORING_SETUP_CLAMP;
+
+  if (options.io_uring_cq_entries() > 0)
+  {
+    params.flags |= IORING_SETUP_CQSIZE;
+    params.cq_entries = static_cast<__u32>(
+        (std::min)(options.io_uring_cq_entries(), std::size_t(0x80000000)));
+  }
+
+  sq_poll_ = options.io_uring_sq_poll();
+  defer_taskrun_ = false;
+  ring_disabled_ = false;
+  last_cq_overflow_ = 0;
+
+  if (sq_poll_)
+  {
+    params.flags |= IORING_SETUP_SQPOLL;
+    if (options.io_uring_sq_poll_cpu() >= 0)
+    {
+      params.flags |= IORING_SETUP_SQ_AFF;
+      params.sq_thread_cpu = static_cast<__u32>(options.io_uring_sq_poll_cpu());
+    }
+    long long idle_ns = options.io_uring_sq_poll_idle().count();
+    if (idle_ns > 0)
+      params.sq_thread_idle = static_cast<__u32>((idle_ns + 999999) / 1000000);
+  }
+#if defined(IORING_SETUP_COOP_TASKRUN)
+  else if (options.io_uring_coop_taskrun())
+  {
+    params.flags |= IORING_SETUP_COOP_TASKRUN;
+  }
+#endif // defined(IORING_SETUP_COOP_TASKRUN)
+
+#if defined(IORING_SETUP_SINGLE_ISSUER)
+  // A single issuer ring must only ever be used by one thread, and so requires
+  // that the context is used without any locking. The ring is created disabled
+  // so that the submitter is the thread that runs the context, rather than
+  // the one that constructs it.
+  if ((options.io_uring_single_issuer() || options.io_uring_defer_taskrun())
+      && !BOOST_ASIO_CONCURRENCY_HINT_IS_LOCKING(
+        SCHEDULER, scheduler_.concurrency_hint()))
+  {
+    params.flags |= IORING_SETUP_SINGLE_ISSUER | IORING_SETUP_R_DISABLED;
+    ring_disabled_ = true;
+# if defined(IORING_SETUP_DEFER_TASKRUN)
+    if (options.io_uring_defer_taskrun() && !sq_poll_)
+    {
+      params.flags |= IORING_SETUP_DEFER_TASKRUN;
+      defer_taskrun_ = true;
+    }
+# endif // defined(IORING_SETUP_DEFER_TASKRUN)
+  }
+#endif // defined(IORING_SETUP_SINGLE_ISSUER)
+
+  unsigned entries = static_cast<unsigned>((std::min)(
+        (std::max)(options.io_uring_entries(), std::size_t(1)),
+        std::size_t(32768)));
+  int result = ::io_uring_queue_init_params(entries, &ring_, &params);
   if (result < 0)
   {
     ring_.ring_fd = -1;
@@ -554,6 +902,20 @@ void io_uring_service::init_ring()
 #endif // !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
 }
 
+void io_uring_service::enable_ring()
+{
+  ring_disabled_ = false;
+#if defined(IORING_SETUP_SINGLE_ISSUER)
+  int result = ::io_uring_enable_rings(&ring_);
+  if (result < 0)
+  {
+    boost::system::error_code ec(-result,
+        boost::asio::error::get_system_category());
+    boost::asio::detail::throw_error(ec, "io_uring_enable_rings");
+  }
+#endif // defined(IORING_SETUP_SINGLE_ISSUER)
+}
+
 #if !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
 class io_uring_service::event_fd_read_op :
   public reactor_op
@@ -655,7 +1017,10 @@ bool io_uring_service::do_cancel_ops(
       {
         io_obj->queues_[i].cancel_requested_ = true;
         if (::io_uring_sqe* sqe = get_sqe())
-          ::io_uring_prep_cancel(sqe, &io_obj->queues_[i], 0);
+        {
+          ::io_uring_prep_cancel(sqe, submission_data(&io_obj->queues_[i],
+                io_obj->queues_[i].op_queue_.front()), 0);
+        }
       }
     }
     submit_sqes();
@@ -664,6 +1029,246 @@ bool io_uring_service::do_cancel_ops(
   return cancel_op;
 }
 
+bool io_uring_service::perform_message(void* ptr,
+    int result, op_queue<operation>& ops)
+{
+  uintptr_t data = reinterpret_cast<uintptr_t>(ptr);
+  if ((data & 1) == 0)
+  {
+    // An operation sent from another ring. Its work was counted by the
+    // scheduler when it was sent.
+    ops.push(reinterpret_cast<operation*>(data & ~static_cast<uintptr_t>(3)));
+    return true;
+  }
+
+  // The completion of a message sent from this ring. If the message was not
+  // delivered, the operation is queued on the target's scheduler instead.
+  sent_message* msg = reinterpret_cast<sent_message*>(
+      data & ~static_cast<uintptr_t>(3));
+  if (result < 0)
+    msg->target_->scheduler_.post_deferred_completion(msg->op_);
+  thread_info_base::deallocate(thread_context::top_of_thread_call_stack(),
+      msg, sizeof(sent_message));
+  return false;
+}
+
+void* io_uring_service::submission_data(
+    io_uring_service::io_queue* io_q, io_uring_operation* op)
+{
+  if (op && op->multishot_)
+    return reinterpret_cast<void*>(reinterpret_cast<uintptr_t>(io_q) | 1);
+  return io_q;
+}
+
+void io_uring_service::prepare_sqe(::io_uring_sqe* sqe,
+    io_uring_service::io_queue* io_q, io_uring_operation* op)
+{
+  op->prepare(sqe);
+  io_object* io_obj = io_q->io_object_;
+  if (io_obj->fixed_file_ >= 0 && sqe->fd == io_obj->descriptor_)
+  {
+    sqe->fd = io_obj->fixed_file_;
+    sqe->flags |= IOSQE_FIXED_FILE;
+  }
+  ::io_uring_sqe_set_data(sqe, submission_data(io_q, op));
+
+  // An operation that has claimed a deadline set by cancel_after or cancel_at
+  // is linked to a timeout, which cancels the operation when the deadline
+  // passes. The entry for the timeout was reserved by get_sqe. The timeout's
+  // own completion carries no data and is otherwise ignored.
+  if (sqe_count(op) > 1)
+  {
+    ::io_uring_sqe* timeout_sqe = ::io_uring_get_sqe(&ring_);
+    BOOST_ASIO_ASSERT(timeout_sqe != 0);
+    sqe->flags |= IOSQE_IO_LINK;
+    ::io_uring_prep_link_timeout(timeout_sqe,
+        &op->deadline_, IORING_TIMEOUT_ABS);
+    ::io_uring_sqe_set_data(timeout_sqe, 0);
+    ++pending_sqes_;
+  }
+}
+
+::io_uring_sqe* io_uring_service::get_op_sqe(
+    mutex::scoped_lock& lock, io_uring_operation* op)
+{
+  if (op->deadline_offer_.is_offered())
+  {
+    if (!op->multishot_)
+    {
+      if (::io_uring_sqe* sqe = get_sqe(2))
+      {
+        op->claim_deadline();
+        return sqe;
+      }
+    }
+
+    // The timer may belong to this service, so it is armed without the lock.
+    lock.unlock();
+    op->deadline_offer_.decline();
+    lock.lock();
+  }
+
+  return get_sqe(sqe_count(op));
+}
+
+void io_uring_service::init_registered_files()
+{
+  if (registered_files_ == 0)
+    return;
+
+  int result = -EINVAL;
+#if defined(IORING_RSRC_REGISTER_SPARSE)
+  result = ::io_uring_register_files_sparse(&ring_,
+      static_cast<unsigned>(registered_files_));
+#endif // defined(IORING_RSRC_REGISTER_SPARSE)
+
+  mutex::scoped_lock registration_lock(registration_mutex_);
+  for (io_object* io_obj = registered_io_objects_.first();
+      io_obj != 0; io_obj = io_obj->next_)
+  {
+    mutex::scoped_lock io_object_lock(io_obj->mutex_);
+    if (io_obj->fixed_file_ >= 0)
+    {
+      // Restore the slot's descriptor in a new ring following a fork.
+      if (result < 0 || ::io_uring_register_files_update(&ring_,
+            static_cast<unsigned>(io_obj->fixed_file_),
+            &io_obj->descriptor_, 1) < 0)
+        io_obj->fixed_file_ = -1;
+    }
+  }
+
+  if (result < 0)
+  {
+    // Without a registered file table, operations refer to descriptors.
+    registered_files_ = 0;
+    free_files_.clear();
+  }
+}
+
+int io_uring_service::register_file(int descriptor)
+{
+  mutex::scoped_lock registration_lock(registration_mutex_);
+  if (free_files_.empty())
+    return -1;
+  int slot = free_files_.back();
+  if (::io_uring_register_files_update(&ring_,
+        static_cast<unsigned>(slot), &descriptor, 1) < 0)
+    return -1;
+  free_files_.pop_back();
+  return slot;
+}
+
+void io_uring_service::unregister_file(int slot)
+{
+  // Entries referring to the slot must be submitted before it can be reused.
+  {
+    mutex::scoped_lock lock(mutex_);
+    submit_sqes();
+  }
+
+  int descriptor = -1;
+  (void)::io_uring_register_files_update(&ring_,
+      static_cast<unsigned>(slot), &descriptor, 1);
+
+  mutex::scoped_lock registration_lock(registration_mutex_);
+  free_files_.push_back(slot);
+}
+
+void io_uring_service::perform_multishot(io_uring_service::io_queue* io_q,
+    int result, unsigned flags, op_queue<operation>& ops)
+{
+  io_object* io_object_to_free = 0;
+  {
+    mutex::scoped_lock io_object_lock(io_q->io_object_->mutex_);
+
+    io_uring_operation* first_op = io_q->op_queue_.front();
+    if (!first_op || !first_op->multishot_)
+      return;
+
+    io_uring_multishot_operation* op =
+      static_cast<io_uring_multishot_operation*>(first_op);
+    op->queue_ = io_q;
+
+    operation* new_op = 0;
+    io_uring_multishot_operation::action next_action =
+      op->deliver(result, flags, io_q->cancel_requested_, new_op);
+    if (new_op)
+    {
+      ops.push(new_op);
+      scheduler_.compensating_work_started();
+    }
+
+    switch (next_action)
+    {
+    case io_uring_multishot_operation::pause:
+      {
+        mutex::scoped_lock lock(mutex_);
+        if (::io_uring_sqe* sqe = get_sqe())
+        {
+          ::io_uring_prep_cancel(sqe, submission_data(io_q, op), 0);
+          push_submit_sqes_op(ops);
+        }
+      }
+      return;
+    case io_uring_multishot_operation::restart:
+      break;
+    case io_uring_multishot_operation::finish:
+      io_q->op_queue_.pop();
+      ops.push(op);
+      break;
+    default:
+      return;
+    }
+
+    io_q->cancel_requested_ = false;
+
+    if (!io_q->op_queue_.empty())
+    {
+      mutex::scoped_lock lock(mutex_);
+      if (::io_uring_sqe* sqe = get_sqe(sqe_count(io_q->op_queue_.front())))
+      {
+        prepare_sqe(sqe, io_q, io_q->op_queue_.front());
+        push_submit_sqes_op(ops);
+      }
+      else
+      {
+        lock.unlock();
+        while (io_uring_operation* next_op = io_q->op_queue_.front())
+        {
+          next_op->ec_ = boost::asio::error::no_buffer_space;
+          io_q->op_queue_.pop();
+          ops.push(next_op);
+        }
+      }
+    }
+
+    // The last operation to complete on a shut down object must free it.
+    if (io_q->io_object_->shutdown_)
+    {
+      io_object_to_free = io_q->io_object_;
+      for (int i = 0; i < max_ops; ++i)
+        if (!io_object_to_free->queues_[i].op_queue_.empty())
+          io_object_to_free = 0;
+    }
+  }
+
+  if (io_object_to_free)
+  {
+    mutex::scoped_lock lock(mutex_);
+    free_io_object(io_object_to_free);
+  }
+}
+
+void io_uring_service::restart_multishot_op(io_uring_multishot_operation* op)
+{
+  // Restart the operation through its queue, as for an operation cancelled by
+  // a fork. If the operation has been cancelled in the meantime, the queue
+  // completes it instead.
+  io_queue* io_q = static_cast<io_queue*>(op->queue_);
+  io_q->set_result(-ECANCELED);
+  scheduler_.post_deferred_completion(io_q);
+}
+
 void io_uring_service::do_add_timer_queue(timer_queue_base& queue)
 {
   mutex::scoped_lock lock(mutex_);
@@ -694,11 +1299,20 @@ __kernel_timespec io_uring_service::get_timeout() const
   return ts;
 }
 
-::io_uring_sqe* io_uring_service::get_sqe()
+::io_uring_sqe* io_uring_service::get_sqe(unsigned count)
 {
+  if (count > 1 && ::io_uring_sq_space_left(&ring_) < count)
+  {
+    sq_full_flushes_.fetch_add(1, std::memory_order_relaxed);
+    submit_sqes();
+    if (::io_uring_sq_space_left(&ring_) < count)
+      return 0;
+  }
+
   ::io_uring_sqe* sqe = ::io_uring_get_sqe(&ring_);
   if (!sqe)
   {
+    sq_full_flushes_.fetch_add(1, std::memory_order_relaxed);
     submit_sqes();
     sqe = ::io_uring_get_sqe(&ring_);
   }
@@ -714,9 +1328,13 @@ void io_uring_service::submit_sqes()
 {
   if (pending_sqes_ != 0)
   {
+    if (ring_disabled_)
+      enable_ring();
     int result = ::io_uring_submit(&ring_);
+    submits_.fetch_add(1, std::memory_order_relaxed);
     if (result > 0)
     {
+      submitted_entries_.fetch_add(result, std::memory_order_relaxed);
       pending_sqes_ -= result;
       increment(outstanding_work_, result);
     }
@@ -725,7 +1343,9 @@ void io_uring_service::submit_sqes()
 
 void io_uring_service::post_submit_sqes_op(mutex::scoped_lock& lock)
 {
-  if (pending_sqes_ >= submit_batch_size)
+  // When a kernel thread polls the submission queue, submitting only makes the
+  // entries visible to it, and so there is nothing to gain from batching.
+  if (pending_sqes_ >= submit_batch_size || (sq_poll_ && pending_sqes_ != 0))
   {
     submit_sqes();
   }
@@ -818,7 +1438,11 @@ operation* io_uring_service::io_queue::perform_io(int result)
   perform_io_cleanup_on_block_exit io_cleanup(io_object_->service_);
   mutex::scoped_lock io_object_lock(io_object_->mutex_);
 
-  if (result != -ECANCELED || cancel_requested_)
+  // An operation cancelled without a request is restarted, as it was
+  // cancelled by a fork, unless it was cancelled by its linked timeout.
+  io_uring_operation* front = op_queue_.front();
+  if (result != -ECANCELED || cancel_requested_
+      || (front && front->has_deadline() && front->deadline_expired()))
   {
     if (io_uring_operation* op = op_queue_.front())
     {
@@ -852,10 +1476,9 @@ operation* io_uring_service::io_queue::perform_io(int result)
   {
     io_uring_service* service = io_object_->service_;
     mutex::scoped_lock lock(service->mutex_);
-    if (::io_uring_sqe* sqe = service->get_sqe())
+    if (::io_uring_sqe* sqe = service->get_sqe(sqe_count(op_queue_.front())))
     {
-      op_queue_.front()->prepare(sqe);
-      ::io_uring_sqe_set_data(sqe, this);
+      service->prepare_sqe(sqe, this, op_queue_.front());
       service->post_submit_sqes_op(lock);
     }
     else
@@ -191,6 +191,28 @@ void kqueue_reactor::move_descriptor(socket_type,
   source_descriptor_data = 0;
 }
 
+int kqueue_reactor::set_exclusive_wakeup(socket_type,
+    kqueue_reactor::per_descriptor_data&, bool value)
+{
+  return value ? boost::asio::error::operation_not_supported : 0;
+}
+
+int kqueue_reactor::migrate_descriptor(socket_type,
+    kqueue_reactor::per_descriptor_data&)
+{
+  // All threads share the reactor's descriptors, so there is nothing to move.
+  return 0;
+}
+
+void kqueue_reactor::speculative_counts(
+    const kqueue_reactor::per_descriptor_data&,
+    uint64_t& hits, uint64_t& misses)
+{
+  // This reactor does not count speculative operations.
+  hits = 0;
+  misses = 0;
+}
+
 void kqueue_reactor::call_post_immediate_completion(
     operation* op, bool is_continuation, const void* self)
 {
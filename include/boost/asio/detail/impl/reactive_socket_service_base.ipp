@@ -171,6 +171,30 @@ boost::system::error_code reactive_socket_service_base::cancel(
   return ec;
 }
 
+boost::system::error_code reactive_socket_service_base::migrate(
+    reactive_socket_service_base::base_implementation_type& impl,
+    boost::system::error_code& ec)
+{
+  if (!is_open(impl))
+  {
+    ec = boost::asio::error::bad_descriptor;
+    return ec;
+  }
+
+  BOOST_ASIO_HANDLER_OPERATION((reactor_.context(),
+        "socket", &impl, impl.socket_, "migrate"));
+
+  if (int err = reactor_.migrate_descriptor(impl.socket_, impl.reactor_data_))
+  {
+    ec = boost::system::error_code(err,
+        boost::asio::error::get_system_category());
+    return ec;
+  }
+
+  ec = boost::system::error_code();
+  return ec;
+}
+
 boost::system::error_code reactive_socket_service_base::do_open(
     reactive_socket_service_base::base_implementation_type& impl,
     int af, int type, int protocol, boost::system::error_code& ec)
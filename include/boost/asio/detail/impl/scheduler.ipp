@@ -16,8 +16,10 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <algorithm>
 
 #include <boost/asio/detail/concurrency_hint.hpp>
+#include <boost/asio/detail/cpu_affinity.hpp>
 #include <boost/asio/detail/event.hpp>
 #include <boost/asio/detail/limits.hpp>
 #include <boost/asio/detail/scheduler.hpp>
@@ -66,12 +68,34 @@ struct scheduler::task_cleanup
     }
     this_thread_->private_outstanding_work = 0;
 
+#if defined(BOOST_ASIO_HAS_THREADS)
+    // In work-stealing mode, completed operations go on to the thread's local
+    // queue where other threads may steal them.
+    if (this_thread_->local_op_queue)
+      scheduler_->push_local_op_queue(
+          *this_thread_, this_thread_->private_op_queue);
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
+    // Count the completions that other threads could help with.
+    std::size_t completions = 0;
+    if (scheduler_->spread_reactor_completions_ && !scheduler_->one_thread_)
+    {
+      operation* o = this_thread_->private_op_queue.front();
+      for (; o; o = op_queue_access::next(o))
+        ++completions;
+    }
+
     // Enqueue the completed operations and reinsert the task at the end of
     // the operation queue.
     lock_->lock();
     scheduler_->task_interrupted_ = true;
     scheduler_->op_queue_.push(this_thread_->private_op_queue);
     scheduler_->op_queue_.push(&scheduler_->task_operation_);
+
+    // This thread takes the first completion, so wake a thread for each of
+    // the others.
+    if (completions > 1)
+      scheduler_->wakeup_event_.signal_many(*lock_, completions - 1);
   }
 
   scheduler* scheduler_;
@@ -98,8 +122,17 @@ struct scheduler::work_cleanup
 #if defined(BOOST_ASIO_HAS_THREADS)
     if (!this_thread_->private_op_queue.empty())
     {
-      lock_->lock();
-      scheduler_->op_queue_.push(this_thread_->private_op_queue);
+      if (this_thread_->local_op_queue)
+      {
+        scheduler_->push_local_op_queue(
+            *this_thread_, this_thread_->private_op_queue);
+      }
+
+      if (!this_thread_->private_op_queue.empty())
+      {
+        lock_->lock();
+        scheduler_->op_queue_.push(this_thread_->private_op_queue);
+      }
     }
 #endif // defined(BOOST_ASIO_HAS_THREADS)
   }
@@ -109,8 +142,114 @@ struct scheduler::work_cleanup
   thread_info* this_thread_;
 };
 
+struct scheduler::batch_cleanup
+{
+  ~batch_cleanup()
+  {
+    if (!this_thread_->batch_op_queue.empty())
+    {
+      // Put the unrun operations back ahead of everything on the queue.
+      lock_->lock();
+      this_thread_->batch_op_queue.push(scheduler_->op_queue_);
+      scheduler_->op_queue_.push(this_thread_->batch_op_queue);
+      if (!scheduler_->one_thread_)
+        scheduler_->wake_one_thread_and_unlock(*lock_);
+    }
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+
+struct scheduler::local_op_queue_cleanup
+{
+  ~local_op_queue_cleanup()
+  {
+    scheduler_->release_local_op_queue(*this_thread_);
+  }
+
+  scheduler* scheduler_;
+  thread_info* this_thread_;
+};
+
+struct scheduler::idle_cleanup
+{
+  ~idle_cleanup()
+  {
+    if (scheduler_)
+      --scheduler_->idle_threads_;
+  }
+
+  scheduler* scheduler_;
+};
+
+struct scheduler::local_task_cleanup
+{
+  ~local_task_cleanup()
+  {
+    scheduler_->release_local_task(*this_thread_);
+  }
+
+  scheduler* scheduler_;
+  thread_info* this_thread_;
+};
+
+struct scheduler::local_idle_cleanup
+{
+  ~local_idle_cleanup()
+  {
+    lock_->lock();
+
+    // The thread is still on the idle list unless it was woken.
+    if (this_thread_->idle_local)
+    {
+      thread_info** t = &scheduler_->idle_local_threads_;
+      while (*t != this_thread_)
+        t = &(*t)->next_idle_local;
+      *t = this_thread_->next_idle_local;
+      this_thread_->next_idle_local = 0;
+      this_thread_->idle_local = false;
+    }
+  }
+
+  scheduler* scheduler_;
+  mutex::scoped_lock* lock_;
+  thread_info* this_thread_;
+};
+
+struct scheduler::thread_metrics_cleanup
+{
+  ~thread_metrics_cleanup()
+  {
+    if (this_thread_->metrics)
+      this_thread_->metrics->release();
+  }
+
+  thread_info* this_thread_;
+};
+
+struct scheduler::spin_cleanup
+{
+  ~spin_cleanup()
+  {
+    if (this_thread_->idle_start)
+      scheduler_->end_spin(*this_thread_, false);
+  }
+
+  scheduler* scheduler_;
+  thread_info* this_thread_;
+};
+
 scheduler::scheduler(boost::asio::execution_context& ctx,
     int concurrency_hint, bool own_thread, get_task_func_type get_task)
+  : scheduler(ctx, concurrency_hint, own_thread, context_options(), get_task)
+{
+}
+
+scheduler::scheduler(boost::asio::execution_context& ctx,
+    int concurrency_hint, bool own_thread, const context_options& options,
+    get_task_func_type get_task)
   : boost::asio::detail::execution_context_service_base<scheduler>(ctx),
     one_thread_(concurrency_hint == 1
         || !BOOST_ASIO_CONCURRENCY_HINT_IS_LOCKING(
@@ -126,7 +265,73 @@ scheduler::scheduler(boost::asio::execution_context& ctx,
     stopped_(false),
     shutdown_(false),
     concurrency_hint_(concurrency_hint),
-    thread_(0)
+    thread_(0),
+    options_(options),
+#if defined(BOOST_ASIO_HAS_THREADS) && defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    per_thread_tasks_(options.per_thread_reactors() && !one_thread_
+        && get_task == &scheduler::get_default_task),
+#else // defined(BOOST_ASIO_HAS_THREADS) && defined(BOOST_ASIO_HAS_EPOLL)
+      //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    per_thread_tasks_(false),
+#endif // defined(BOOST_ASIO_HAS_THREADS) && defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    idle_local_threads_(0),
+#if defined(BOOST_ASIO_HAS_THREADS)
+    work_stealing_(options.work_stealing()
+        && !one_thread_ && !per_thread_tasks_),
+    lock_free_injection_(work_stealing_
+        || (options.lock_free_injection() && !per_thread_tasks_)),
+#else // defined(BOOST_ASIO_HAS_THREADS)
+    work_stealing_(false),
+    lock_free_injection_(false),
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+    lock_free_stopped_(false),
+#if defined(BOOST_ASIO_HAS_THREADS) \
+  && defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    task_messages_(options.io_uring_msg_ring()
+        && get_task == &scheduler::get_default_task),
+#else // defined(BOOST_ASIO_HAS_THREADS)
+      //   && defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    task_messages_(false),
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+       //   && defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    message_task_(0),
+    metrics_task_(0),
+    idle_threads_(0),
+    local_op_queues_(0),
+    spin_limit_(options.busy_poll_idle() ? ~static_cast<uint64_t>(0)
+        : options.spin_duration() > chrono::nanoseconds(0)
+        ? static_cast<uint64_t>(options.spin_duration().count()) : 0),
+    adaptive_spin_(options.adaptive_spin() && !options.busy_poll_idle()),
+    average_wait_time_(spin_limit_ / 2),
+    spinning_threads_(0),
+    spin_generation_(0),
+    batch_size_(options.dequeue_batch_size() > 1
+        ? options.dequeue_batch_size() : 1),
+    batch_time_limit_(
+        options.dequeue_batch_time() > chrono::nanoseconds(0)
+        ? static_cast<uint64_t>(options.dequeue_batch_time().count()) : 0),
+    priority_starvation_limit_(options.priority_starvation_limit() > 1
+        ? options.priority_starvation_limit() : 1),
+    high_priority_run_(0),
+    low_priority_skips_(0),
+    high_priority_waiting_(false),
+    poll_budget_handlers_(options.poll_budget_handlers()),
+    poll_budget_time_(options.poll_budget_time() > chrono::nanoseconds(0)
+        ? static_cast<uint64_t>(options.poll_budget_time().count()) : 0),
+    handlers_since_poll_(0),
+    last_poll_time_(poll_budget_time_ ? spin_clock() : 0),
+    spin_count_(0),
+    spin_hits_(0),
+    spin_misses_(0),
+    spin_time_(0),
+    poll_budget_handler_hits_(0),
+    poll_budget_time_hits_(0),
+    spread_reactor_completions_(options.spread_reactor_completions()),
+    collect_metrics_(options.collect_metrics()),
+    thread_metrics_(0),
+    external_enqueued_(0)
 {
   BOOST_ASIO_HANDLER_TRACKING_INIT;
 
@@ -149,6 +354,18 @@ scheduler::~scheduler()
     thread_->join();
     delete thread_;
   }
+
+  while (stealable_op_queue<operation>* q = local_op_queues_.load())
+  {
+    local_op_queues_ = q->next();
+    delete q;
+  }
+
+  while (thread_metrics* m = thread_metrics_.load())
+  {
+    thread_metrics_ = m->next();
+    delete m;
+  }
 }
 
 void scheduler::shutdown()
@@ -168,6 +385,14 @@ void scheduler::shutdown()
   }
 
   // Destroy handler objects.
+  op_queue_.push(high_priority_op_queue_);
+  op_queue_.push(low_priority_op_queue_);
+  high_priority_waiting_.store(false, std::memory_order_relaxed);
+  injection_queue_.pop_all(op_queue_);
+  for (stealable_op_queue<operation>* q = local_op_queues_.load();
+      q; q = q->next())
+    while (operation* o = q->pop())
+      op_queue_.push(o);
   while (!op_queue_.empty())
   {
     operation* o = op_queue_.front();
@@ -178,6 +403,8 @@ void scheduler::shutdown()
 
   // Reset to initial state.
   task_ = 0;
+  message_task_.store(0, std::memory_order_release);
+  metrics_task_.store(0, std::memory_order_release);
 }
 
 void scheduler::init_task()
@@ -186,8 +413,22 @@ void scheduler::init_task()
   if (!shutdown_ && !task_)
   {
     task_ = get_task_(this->context());
-    op_queue_.push(&task_operation_);
-    wake_one_thread_and_unlock(lock);
+    metrics_task_.store(task_, std::memory_order_release);
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    if (get_task_ == &scheduler::get_default_task)
+      message_task_.store(task_, std::memory_order_release);
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+    if (per_thread_tasks_)
+    {
+      // There is no shared task to queue. Threads that were waiting for it
+      // can now get instances of their own.
+      wakeup_event_.signal_all(lock);
+    }
+    else
+    {
+      op_queue_.push(&task_operation_);
+      wake_one_thread_and_unlock(lock);
+    }
   }
 }
 
@@ -201,15 +442,59 @@ std::size_t scheduler::run(boost::system::error_code& ec)
   }
 
   thread_info this_thread;
-  this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
+  acquire_thread_metrics(this_thread);
+  thread_metrics_cleanup on_metrics_exit = { &this_thread };
+  (void)on_metrics_exit;
+
+  // Keep the thread's recycled memory local to the node it is running on.
+  if (!options_.numa_nodes().empty())
+  {
+    boost::system::error_code node_ec;
+    std::size_t node = cpu_affinity::current_node(node_ec);
+    if (!node_ec)
+      this_thread.memory_node(node);
+  }
+
+#if defined(BOOST_ASIO_HAS_THREADS)
+  if (per_thread_tasks_)
+  {
+    return run_local(this_thread,
+        static_cast<thread_info*>(ctx.next_by_key()), -1,
+        (std::numeric_limits<std::size_t>::max)(), ec);
+  }
+
+  if (work_stealing_)
+  {
+    acquire_local_op_queue(this_thread);
+    local_op_queue_cleanup on_exit = { this, &this_thread };
+    (void)on_exit;
+
+    mutex::scoped_lock lock(mutex_);
+
+    std::size_t n = 0;
+    for (; do_run_one_stealing(lock, this_thread, ec); )
+      if (n != (std::numeric_limits<std::size_t>::max)())
+        ++n;
+    return n;
+  }
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
+  // Only run() may take more than one operation from the queue at a time.
+  this_thread.batch_limit = batch_size_;
+
   mutex::scoped_lock lock(mutex_);
 
   std::size_t n = 0;
-  for (; do_run_one(lock, this_thread, ec); lock.lock())
-    if (n != (std::numeric_limits<std::size_t>::max)())
-      ++n;
+  while (std::size_t m = do_run_one(lock, this_thread, ec))
+  {
+    if (m < (std::numeric_limits<std::size_t>::max)() - n)
+      n += m;
+    else
+      n = (std::numeric_limits<std::size_t>::max)();
+    lock.lock();
+  }
   return n;
 }
 
@@ -223,9 +508,20 @@ std::size_t scheduler::run_one(boost::system::error_code& ec)
   }
 
   thread_info this_thread;
-  this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
+  acquire_thread_metrics(this_thread);
+  thread_metrics_cleanup on_metrics_exit = { &this_thread };
+  (void)on_metrics_exit;
+
+#if defined(BOOST_ASIO_HAS_THREADS)
+  if (per_thread_tasks_)
+  {
+    return run_local(this_thread,
+        static_cast<thread_info*>(ctx.next_by_key()), -1, 1, ec);
+  }
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
   mutex::scoped_lock lock(mutex_);
 
   return do_run_one(lock, this_thread, ec);
@@ -241,9 +537,20 @@ std::size_t scheduler::wait_one(long usec, boost::system::error_code& ec)
   }
 
   thread_info this_thread;
-  this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
+  acquire_thread_metrics(this_thread);
+  thread_metrics_cleanup on_metrics_exit = { &this_thread };
+  (void)on_metrics_exit;
+
+#if defined(BOOST_ASIO_HAS_THREADS)
+  if (per_thread_tasks_)
+  {
+    return run_local(this_thread,
+        static_cast<thread_info*>(ctx.next_by_key()), usec, 1, ec);
+  }
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
   mutex::scoped_lock lock(mutex_);
 
   return do_wait_one(lock, this_thread, usec, ec);
@@ -259,9 +566,21 @@ std::size_t scheduler::poll(boost::system::error_code& ec)
   }
 
   thread_info this_thread;
-  this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
+  acquire_thread_metrics(this_thread);
+  thread_metrics_cleanup on_metrics_exit = { &this_thread };
+  (void)on_metrics_exit;
+
+#if defined(BOOST_ASIO_HAS_THREADS)
+  if (per_thread_tasks_)
+  {
+    return run_local(this_thread,
+        static_cast<thread_info*>(ctx.next_by_key()), 0,
+        (std::numeric_limits<std::size_t>::max)(), ec);
+  }
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
   mutex::scoped_lock lock(mutex_);
 
 #if defined(BOOST_ASIO_HAS_THREADS)
@@ -290,9 +609,20 @@ std::size_t scheduler::poll_one(boost::system::error_code& ec)
   }
 
   thread_info this_thread;
-  this_thread.private_outstanding_work = 0;
   thread_call_stack::context ctx(this, this_thread);
 
+  acquire_thread_metrics(this_thread);
+  thread_metrics_cleanup on_metrics_exit = { &this_thread };
+  (void)on_metrics_exit;
+
+#if defined(BOOST_ASIO_HAS_THREADS)
+  if (per_thread_tasks_)
+  {
+    return run_local(this_thread,
+        static_cast<thread_info*>(ctx.next_by_key()), 0, 1, ec);
+  }
+#endif // defined(BOOST_ASIO_HAS_THREADS)
+
   mutex::scoped_lock lock(mutex_);
 
 #if defined(BOOST_ASIO_HAS_THREADS)
@@ -323,6 +653,7 @@ void scheduler::restart()
 {
   mutex::scoped_lock lock(mutex_);
   stopped_ = false;
+  lock_free_stopped_ = false;
 }
 
 void scheduler::compensating_work_started()
@@ -332,6 +663,13 @@ void scheduler::compensating_work_started()
   ++static_cast<thread_info*>(this_thread)->private_outstanding_work;
 }
 
+void* scheduler::current_local_task()
+{
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    return static_cast<thread_info*>(this_thread)->local_task;
+  return 0;
+}
+
 bool scheduler::can_dispatch()
 {
   return thread_call_stack::contains(this) != 0;
@@ -346,6 +684,9 @@ void scheduler::capture_current_exception()
 void scheduler::post_immediate_completion(
     scheduler::operation* op, bool is_continuation)
 {
+  if (collect_metrics_)
+    record_enqueued(op);
+
 #if defined(BOOST_ASIO_HAS_THREADS)
   if (one_thread_ || is_continuation)
   {
@@ -361,6 +702,12 @@ void scheduler::post_immediate_completion(
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
   work_started();
+#if defined(BOOST_ASIO_HAS_THREADS)
+  if (task_messages_ && send_to_task(op))
+    return;
+  if (lock_free_injection_ && enqueue_lock_free(op))
+    return;
+#endif // defined(BOOST_ASIO_HAS_THREADS)
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -369,6 +716,9 @@ void scheduler::post_immediate_completion(
 void scheduler::post_immediate_completions(std::size_t n,
     op_queue<scheduler::operation>& ops, bool is_continuation)
 {
+  if (collect_metrics_)
+    record_enqueued(ops);
+
 #if defined(BOOST_ASIO_HAS_THREADS)
   if (one_thread_ || is_continuation)
   {
@@ -385,13 +735,38 @@ void scheduler::post_immediate_completions(std::size_t n,
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
   increment(outstanding_work_, static_cast<long>(n));
+#if defined(BOOST_ASIO_HAS_THREADS)
+  if (lock_free_injection_ && enqueue_lock_free(ops))
+    return;
+#endif // defined(BOOST_ASIO_HAS_THREADS)
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(ops);
   wake_one_thread_and_unlock(lock);
 }
 
+void scheduler::post_prioritised_completion(
+    scheduler::operation* op, bool high)
+{
+  if (collect_metrics_)
+    record_enqueued(op);
+
+  work_started();
+  mutex::scoped_lock lock(mutex_);
+  if (high)
+  {
+    high_priority_op_queue_.push(op);
+    high_priority_waiting_.store(true, std::memory_order_release);
+  }
+  else
+    low_priority_op_queue_.push(op);
+  wake_one_thread_and_unlock(lock);
+}
+
 void scheduler::post_deferred_completion(scheduler::operation* op)
 {
+  if (collect_metrics_)
+    record_enqueued(op);
+
 #if defined(BOOST_ASIO_HAS_THREADS)
   if (one_thread_)
   {
@@ -401,6 +776,23 @@ void scheduler::post_deferred_completion(scheduler::operation* op)
       return;
     }
   }
+
+  if (per_thread_tasks_)
+  {
+    // Keep the completion on the thread, along with the others from its own
+    // instance of the task.
+    if (thread_info_base* this_thread = thread_call_stack::contains(this))
+    {
+      if (static_cast<thread_info*>(this_thread)->local_task)
+      {
+        static_cast<thread_info*>(this_thread)->local_task_op_queue.push(op);
+        return;
+      }
+    }
+  }
+
+  if (lock_free_injection_ && enqueue_lock_free(op))
+    return;
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
   mutex::scoped_lock lock(mutex_);
@@ -413,6 +805,9 @@ void scheduler::post_deferred_completions(
 {
   if (!ops.empty())
   {
+    if (collect_metrics_)
+      record_enqueued(ops);
+
 #if defined(BOOST_ASIO_HAS_THREADS)
     if (one_thread_)
     {
@@ -422,6 +817,21 @@ void scheduler::post_deferred_completions(
         return;
       }
     }
+
+    if (per_thread_tasks_)
+    {
+      if (thread_info_base* this_thread = thread_call_stack::contains(this))
+      {
+        if (static_cast<thread_info*>(this_thread)->local_task)
+        {
+          static_cast<thread_info*>(this_thread)->local_task_op_queue.push(ops);
+          return;
+        }
+      }
+    }
+
+    if (lock_free_injection_ && enqueue_lock_free(ops))
+      return;
 #endif // defined(BOOST_ASIO_HAS_THREADS)
 
     mutex::scoped_lock lock(mutex_);
@@ -433,7 +843,16 @@ void scheduler::post_deferred_completions(
 void scheduler::do_dispatch(
     scheduler::operation* op)
 {
+  if (collect_metrics_)
+    record_enqueued(op);
+
   work_started();
+#if defined(BOOST_ASIO_HAS_THREADS)
+  if (task_messages_ && send_to_task(op))
+    return;
+  if (lock_free_injection_ && enqueue_lock_free(op))
+    return;
+#endif // defined(BOOST_ASIO_HAS_THREADS)
   mutex::scoped_lock lock(mutex_);
   op_queue_.push(op);
   wake_one_thread_and_unlock(lock);
@@ -450,18 +869,40 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread,
     const boost::system::error_code& ec)
 {
+  spin_cleanup on_spin_exit = { this, &this_thread };
+  (void)on_spin_exit;
+
   while (!stopped_)
   {
+    if (lock_free_injection_)
+      injection_queue_.pop_all(op_queue_);
+
+    promote_prioritised_operation();
+    enforce_poll_budget();
+
     if (!op_queue_.empty())
     {
       // Prepare to execute first handler from queue.
       operation* o = op_queue_.front();
       op_queue_.pop();
-      bool more_handlers = (!op_queue_.empty());
+      bool more_handlers = (!op_queue_.empty() || has_prioritised_operations());
 
       if (o == &task_operation_)
       {
-        task_interrupted_ = more_handlers;
+        // A spinning thread polls the task rather than blocking in it.
+        bool spinning = !more_handlers && begin_spin(this_thread);
+
+        // Lock-free enqueuers need to know if the task is going to block.
+        idle_cleanup on_idle_exit = { 0 };
+        if (!more_handlers && !spinning && lock_free_injection_)
+        {
+          if (begin_idle(false))
+            on_idle_exit.scheduler_ = this;
+          else
+            more_handlers = true;
+        }
+
+        task_interrupted_ = more_handlers || spinning;
 
         if (more_handlers && !one_thread_)
           wakeup_event_.unlock_and_signal_one(lock);
@@ -474,38 +915,124 @@ std::size_t scheduler::do_run_one(mutex::scoped_lock& lock,
         // Run the task. May throw an exception. Only block if the operation
         // queue is empty and we're not polling, otherwise we want to return
         // as soon as possible.
-        task_->run(more_handlers ? 0 : -1, this_thread.private_op_queue);
+        run_task(this_thread, more_handlers || spinning ? 0 : -1);
       }
       else
       {
         std::size_t task_result = o->task_result_;
 
+        if (this_thread.idle_start)
+          end_spin(this_thread, true);
+
+        // Take more operations while the lock is held, stopping short of the
+        // task so that the batch does not delay the next reactor poll, and
+        // of any high priority operations.
+        for (std::size_t i = 1; i < this_thread.batch_limit
+            && !op_queue_.empty() && op_queue_.front() != &task_operation_
+            && high_priority_op_queue_.empty(); ++i)
+        {
+          operation* batch_op = op_queue_.front();
+          op_queue_.pop();
+          this_thread.batch_op_queue.push(batch_op);
+          more_handlers = (!op_queue_.empty()
+              || has_prioritised_operations());
+        }
+
         if (more_handlers && !one_thread_)
           wake_one_thread_and_unlock(lock);
         else
           lock.unlock();
 
-        // Ensure the count of outstanding work is decremented on block exit.
-        work_cleanup on_exit = { this, &lock, &this_thread };
-        (void)on_exit;
+        // Ensure the batch is returned to the queue if the operation throws.
+        batch_cleanup on_batch_exit = { this, &lock, &this_thread };
+        (void)on_batch_exit;
 
-        // Complete the operation. May throw an exception. Deletes the object.
-        o->complete(this, ec, task_result);
-        this_thread.rethrow_pending_exception();
+        {
+          // Ensure the count of outstanding work is decremented on block exit.
+          work_cleanup on_exit = { this, &lock, &this_thread };
+          (void)on_exit;
 
-        return 1;
+          // Complete the operation. May throw an exception. Deletes the
+          // object.
+          complete_operation(this_thread, o, ec, task_result);
+          this_thread.rethrow_pending_exception();
+        }
+
+        if (this_thread.batch_op_queue.empty())
+          return 1;
+        return 1 + do_run_batch(lock, this_thread, ec);
       }
     }
-    else
+    else if (begin_spin(this_thread))
+    {
+      spin_wait(lock, this_thread, false);
+    }
+    else if (!lock_free_injection_)
     {
       wakeup_event_.clear(lock);
-      wakeup_event_.wait(lock);
+      wait_for_wakeup(lock, this_thread, -1);
+    }
+    else if (begin_idle(false))
+    {
+      wakeup_event_.clear(lock);
+      wait_for_wakeup(lock, this_thread, -1);
+      --idle_threads_;
     }
   }
 
   return 0;
 }
 
+std::size_t scheduler::do_run_batch(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread,
+    const boost::system::error_code& ec)
+{
+  // Ensure any operations that are not run are returned to the queue.
+  batch_cleanup on_batch_exit = { this, &lock, &this_thread };
+  (void)on_batch_exit;
+
+  uint64_t deadline = batch_time_limit_ ? spin_clock() + batch_time_limit_ : 0;
+
+  std::size_t n = 0;
+  while (operation* o = this_thread.batch_op_queue.front())
+  {
+    // The previous operation's completions were moved to the shared queue,
+    // leaving the mutex locked. Let another thread pick them up.
+    if (lock.locked())
+    {
+      if (!one_thread_)
+        wake_one_thread_and_unlock(lock);
+      else
+        lock.unlock();
+    }
+
+    if (lock_free_stopped_.load(std::memory_order_relaxed))
+      break;
+
+    if (deadline && spin_clock() >= deadline)
+      break;
+
+    // Leave the rest of the batch so that the task can be polled.
+    if (poll_budget_exhausted())
+      break;
+
+    this_thread.batch_op_queue.pop();
+    std::size_t task_result = o->task_result_;
+
+    // Ensure the count of outstanding work is decremented on block exit.
+    work_cleanup on_exit = { this, &lock, &this_thread };
+    (void)on_exit;
+
+    // Complete the operation. May throw an exception. Deletes the object.
+    complete_operation(this_thread, o, ec, task_result);
+    this_thread.rethrow_pending_exception();
+
+    ++n;
+  }
+
+  return n;
+}
+
 std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
     scheduler::thread_info& this_thread, long usec,
     const boost::system::error_code& ec)
@@ -513,19 +1040,46 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
+  if (lock_free_injection_)
+    injection_queue_.pop_all(op_queue_);
+
+  promote_prioritised_operation();
+  enforce_poll_budget();
   operation* o = op_queue_.front();
   if (o == 0)
   {
-    wakeup_event_.clear(lock);
-    wakeup_event_.wait_for_usec(lock, usec);
+    if (!lock_free_injection_)
+    {
+      wakeup_event_.clear(lock);
+      wait_for_wakeup(lock, this_thread, usec);
+    }
+    else if (begin_idle(false))
+    {
+      wakeup_event_.clear(lock);
+      wait_for_wakeup(lock, this_thread, usec);
+      --idle_threads_;
+    }
     usec = 0; // Wait at most once.
+    if (lock_free_injection_)
+      injection_queue_.pop_all(op_queue_);
+    promote_prioritised_operation();
     o = op_queue_.front();
   }
 
   if (o == &task_operation_)
   {
     op_queue_.pop();
-    bool more_handlers = (!op_queue_.empty());
+    bool more_handlers = (!op_queue_.empty() || has_prioritised_operations());
+
+    // Lock-free enqueuers need to know if the task is going to block.
+    idle_cleanup on_idle_exit = { 0 };
+    if (!more_handlers && usec != 0 && lock_free_injection_)
+    {
+      if (begin_idle(false))
+        on_idle_exit.scheduler_ = this;
+      else
+        more_handlers = true;
+    }
 
     task_interrupted_ = more_handlers;
 
@@ -541,9 +1095,10 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
       // as soon as possible.
-      task_->run(more_handlers ? 0 : usec, this_thread.private_op_queue);
+      run_task(this_thread, more_handlers ? 0 : usec);
     }
 
+    promote_prioritised_operation();
     o = op_queue_.front();
     if (o == &task_operation_)
     {
@@ -557,7 +1112,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
     return 0;
 
   op_queue_.pop();
-  bool more_handlers = (!op_queue_.empty());
+  bool more_handlers = (!op_queue_.empty() || has_prioritised_operations());
 
   std::size_t task_result = o->task_result_;
 
@@ -571,7 +1126,7 @@ std::size_t scheduler::do_wait_one(mutex::scoped_lock& lock,
   (void)on_exit;
 
   // Complete the operation. May throw an exception. Deletes the object.
-  o->complete(this, ec, task_result);
+  complete_operation(this_thread, o, ec, task_result);
   this_thread.rethrow_pending_exception();
 
   return 1;
@@ -584,6 +1139,11 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   if (stopped_)
     return 0;
 
+  if (lock_free_injection_)
+    injection_queue_.pop_all(op_queue_);
+
+  promote_prioritised_operation();
+  enforce_poll_budget();
   operation* o = op_queue_.front();
   if (o == &task_operation_)
   {
@@ -597,9 +1157,10 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
       // Run the task. May throw an exception. Only block if the operation
       // queue is empty and we're not polling, otherwise we want to return
       // as soon as possible.
-      task_->run(0, this_thread.private_op_queue);
+      run_task(this_thread, 0);
     }
 
+    promote_prioritised_operation();
     o = op_queue_.front();
     if (o == &task_operation_)
     {
@@ -612,7 +1173,7 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
     return 0;
 
   op_queue_.pop();
-  bool more_handlers = (!op_queue_.empty());
+  bool more_handlers = (!op_queue_.empty() || has_prioritised_operations());
 
   std::size_t task_result = o->task_result_;
 
@@ -626,29 +1187,143 @@ std::size_t scheduler::do_poll_one(mutex::scoped_lock& lock,
   (void)on_exit;
 
   // Complete the operation. May throw an exception. Deletes the object.
-  o->complete(this, ec, task_result);
+  complete_operation(this_thread, o, ec, task_result);
   this_thread.rethrow_pending_exception();
 
   return 1;
 }
 
-void scheduler::stop_all_threads(
-    mutex::scoped_lock& lock)
+void scheduler::promote_prioritised_operation()
 {
-  stopped_ = true;
-  wakeup_event_.signal_all(lock);
+  if (!has_prioritised_operations())
+    return;
 
-  if (!task_interrupted_ && task_)
+  op_queue<operation>* lane = 0;
+  if (high_priority_op_queue_.empty())
   {
-    task_interrupted_ = true;
-    task_->interrupt();
+    high_priority_run_ = 0;
   }
-}
-
-void scheduler::wake_one_thread_and_unlock(
-    mutex::scoped_lock& lock)
+  else if (op_queue_.empty()
+      || high_priority_run_ < priority_starvation_limit_)
+  {
+    lane = &high_priority_op_queue_;
+    ++high_priority_run_;
+  }
+  else
+  {
+    // Give the waiting normal priority operation, which may be the task, its
+    // turn before any more high priority ones.
+    high_priority_run_ = 0;
+  }
+
+  if (!lane && !low_priority_op_queue_.empty())
+  {
+    // Low priority operations run when nothing else is waiting, ahead of each
+    // poll of the task, and whenever they have been passed over too often.
+    if (op_queue_.empty() || op_queue_.front() == &task_operation_
+        || ++low_priority_skips_ >= priority_starvation_limit_)
+    {
+      lane = &low_priority_op_queue_;
+      low_priority_skips_ = 0;
+    }
+  }
+
+  if (lane)
+  {
+    operation* o = lane->front();
+    lane->pop();
+    if (high_priority_op_queue_.empty())
+      high_priority_waiting_.store(false, std::memory_order_relaxed);
+    op_queue<operation> ops;
+    ops.push(o);
+    ops.push(op_queue_);
+    op_queue_.push(ops);
+  }
+}
+
+void scheduler::enforce_poll_budget()
+{
+  if (!poll_budget_handlers_ && !poll_budget_time_)
+    return;
+
+  if (!task_ || !op_queue_.is_enqueued(&task_operation_)
+      || op_queue_.front() == &task_operation_)
+    return;
+
+  if (poll_budget_handlers_ && handlers_since_poll_.load(
+        std::memory_order_relaxed) >= poll_budget_handlers_)
+    poll_budget_handler_hits_.fetch_add(1, std::memory_order_relaxed);
+  else if (poll_budget_time_ && spin_clock() - last_poll_time_.load(
+        std::memory_order_relaxed) >= poll_budget_time_)
+    poll_budget_time_hits_.fetch_add(1, std::memory_order_relaxed);
+  else
+    return;
+
+  // Take the task out of the queue, keeping the order of the operations that
+  // were ahead of it, and put it back at the front.
+  op_queue<operation> ahead;
+  while (operation* o = op_queue_.front())
+  {
+    op_queue_.pop();
+    if (o == &task_operation_)
+      break;
+    ahead.push(o);
+  }
+  ahead.push(op_queue_);
+  op_queue_.push(&task_operation_);
+  op_queue_.push(ahead);
+}
+
+bool scheduler::poll_budget_exhausted() const
+{
+  if (poll_budget_handlers_ && handlers_since_poll_.load(
+        std::memory_order_relaxed) >= poll_budget_handlers_)
+    return true;
+
+  return poll_budget_time_ && spin_clock() - last_poll_time_.load(
+      std::memory_order_relaxed) >= poll_budget_time_;
+}
+
+void scheduler::stop_all_threads(
+    mutex::scoped_lock& lock)
+{
+  stopped_ = true;
+  lock_free_stopped_ = true;
+  ++spin_generation_;
+  wakeup_event_.signal_all(lock);
+
+  for (thread_info* t = idle_local_threads_; t; t = t->next_idle_local)
+    task_->interrupt_local_task(t->local_task);
+
+  if (!task_interrupted_ && task_)
+  {
+    task_interrupted_ = true;
+    task_->interrupt();
+  }
+}
+
+void scheduler::wake_one_thread_and_unlock(
+    mutex::scoped_lock& lock)
 {
-  if (!wakeup_event_.maybe_unlock_and_signal_one(lock))
+  if (idle_local_threads_)
+  {
+    // Wake a thread waiting in its own instance of the task, without
+    // disturbing the others.
+    thread_info* t = idle_local_threads_;
+    idle_local_threads_ = t->next_idle_local;
+    t->next_idle_local = 0;
+    t->idle_local = false;
+    void* local_task = t->local_task;
+    lock.unlock();
+    task_->interrupt_local_task(local_task);
+  }
+  else if (spinning_threads_ > 0)
+  {
+    // A spinning thread will find the work without needing to be woken.
+    ++spin_generation_;
+    lock.unlock();
+  }
+  else if (!wakeup_event_.maybe_unlock_and_signal_one(lock))
   {
     if (!task_interrupted_ && task_)
     {
@@ -659,6 +1334,728 @@ void scheduler::wake_one_thread_and_unlock(
   }
 }
 
+std::size_t scheduler::do_run_one_stealing(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread,
+    const boost::system::error_code& ec)
+{
+  spin_cleanup on_spin_exit = { this, &this_thread };
+  (void)on_spin_exit;
+
+  lock.unlock();
+
+  while (!lock_free_stopped_.load(std::memory_order_acquire))
+  {
+    // Look for a handler that can be obtained without locking the mutex.
+    // High priority operations wait in the shared queue, so while any are
+    // waiting the thread looks there first. To bound the delay to the local
+    // queue, it is passed over at most priority_starvation_limit_ times in a
+    // row.
+    operation* o = 0;
+    if (high_priority_waiting_.load(std::memory_order_acquire)
+        && this_thread.priority_bypasses < priority_starvation_limit_)
+    {
+      ++this_thread.priority_bypasses;
+    }
+    else
+    {
+      this_thread.priority_bypasses = 0;
+      o = this_thread.local_op_queue->pop();
+      if (o == 0 && !injection_queue_.empty())
+      {
+        op_queue<operation> ops;
+        injection_queue_.pop_all(ops);
+        o = ops.front();
+        ops.pop();
+        push_local_op_queue(this_thread, ops);
+        if (!ops.empty())
+        {
+          lock.lock();
+          op_queue_.push(ops);
+          lock.unlock();
+        }
+      }
+      if (o == 0)
+        o = steal_operation(this_thread);
+    }
+
+    if (o)
+    {
+      std::size_t task_result = o->task_result_;
+
+      if (this_thread.idle_start)
+        end_spin(this_thread, true);
+
+      if (!this_thread.local_op_queue->empty())
+        wake_one_idle_thread();
+
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_cleanup on_exit = { this, &lock, &this_thread };
+      (void)on_exit;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      complete_operation(this_thread, o, ec, task_result);
+      this_thread.rethrow_pending_exception();
+
+      return 1;
+    }
+
+    // Fall back to the shared queue, which is also where the task lives.
+    lock.lock();
+
+    if (stopped_)
+      break;
+
+    promote_prioritised_operation();
+    enforce_poll_budget();
+
+    if (!op_queue_.empty())
+    {
+      o = op_queue_.front();
+      op_queue_.pop();
+      bool more_handlers = (!op_queue_.empty() || has_prioritised_operations());
+
+      if (o == &task_operation_)
+      {
+        // A spinning thread polls the task rather than blocking in it.
+        bool spinning = !more_handlers && begin_spin(this_thread);
+
+        // Lock-free enqueuers need to know if the task is going to block.
+        idle_cleanup on_idle_exit = { 0 };
+        if (!more_handlers && !spinning)
+        {
+          if (begin_idle(true))
+            on_idle_exit.scheduler_ = this;
+          else
+            more_handlers = true;
+        }
+
+        task_interrupted_ = more_handlers || spinning;
+
+        if (more_handlers)
+          wakeup_event_.unlock_and_signal_one(lock);
+        else
+          lock.unlock();
+
+        {
+          task_cleanup on_exit = { this, &lock, &this_thread };
+          (void)on_exit;
+
+          // Run the task. May throw an exception. Only block if there are no
+          // other operations, otherwise we want to return as soon as
+          // possible.
+          run_task(this_thread, more_handlers || spinning ? 0 : -1);
+        }
+
+        lock.unlock();
+      }
+      else
+      {
+        std::size_t task_result = o->task_result_;
+
+        if (this_thread.idle_start)
+          end_spin(this_thread, true);
+
+        if (more_handlers)
+          wake_one_thread_and_unlock(lock);
+        else
+          lock.unlock();
+
+        // Ensure the count of outstanding work is decremented on block exit.
+        work_cleanup on_exit = { this, &lock, &this_thread };
+        (void)on_exit;
+
+        // Complete the operation. May throw an exception. Deletes the object.
+        complete_operation(this_thread, o, ec, task_result);
+        this_thread.rethrow_pending_exception();
+
+        return 1;
+      }
+    }
+    else
+    {
+      if (begin_spin(this_thread))
+      {
+        spin_wait(lock, this_thread, true);
+      }
+      else if (begin_idle(true))
+      {
+        wakeup_event_.clear(lock);
+        wait_for_wakeup(lock, this_thread, -1);
+        --idle_threads_;
+      }
+
+      lock.unlock();
+    }
+  }
+
+  return 0;
+}
+
+std::size_t scheduler::run_local(scheduler::thread_info& this_thread,
+    scheduler::thread_info* outer_thread, long usec, std::size_t limit,
+    const boost::system::error_code& ec)
+{
+  // A nested call uses the instance of the task that belongs to the thread.
+  if (outer_thread)
+    this_thread.local_task = outer_thread->local_task;
+
+  local_task_cleanup on_exit = { this, &this_thread };
+  (void)on_exit;
+
+  mutex::scoped_lock lock(mutex_);
+
+  std::size_t n = 0;
+  for (; n < limit && do_run_one_local(lock, this_thread, usec, ec);
+      lock.lock())
+    ++n;
+  return n;
+}
+
+std::size_t scheduler::do_run_one_local(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread, long usec,
+    const boost::system::error_code& ec)
+{
+  bool waited = false;
+  while (!stopped_)
+  {
+    // Completions from the thread's own instance of the task run first, so
+    // that they stay on the thread that owns their descriptors.
+    operation* o = this_thread.local_task_op_queue.front();
+    if (o)
+    {
+      this_thread.local_task_op_queue.pop();
+    }
+    else
+    {
+      promote_prioritised_operation();
+      o = op_queue_.front();
+      if (o)
+        op_queue_.pop();
+    }
+
+    if (o)
+    {
+      std::size_t task_result = o->task_result_;
+
+      if (!op_queue_.empty() || has_prioritised_operations())
+        wake_one_thread_and_unlock(lock);
+      else
+        lock.unlock();
+
+      // Ensure the count of outstanding work is decremented on block exit.
+      work_cleanup on_exit = { this, &lock, &this_thread };
+      (void)on_exit;
+
+      // Complete the operation. May throw an exception. Deletes the object.
+      complete_operation(this_thread, o, ec, task_result);
+      this_thread.rethrow_pending_exception();
+
+      return 1;
+    }
+
+    if (waited)
+      return 0;
+
+    if (!task_)
+    {
+      // There is no task until the first I/O object is created, so wait for
+      // a handler to be posted.
+      wakeup_event_.clear(lock);
+      wait_for_wakeup(lock, this_thread, usec);
+    }
+    else if (!this_thread.local_task)
+    {
+      lock.unlock();
+      acquire_local_task(this_thread);
+      lock.lock();
+      continue;
+    }
+    else
+    {
+      // Wait in the thread's own instance of the task, where the thread can
+      // be woken on its own when a handler is posted.
+      this_thread.next_idle_local = idle_local_threads_;
+      this_thread.idle_local = true;
+      idle_local_threads_ = &this_thread;
+      lock.unlock();
+
+      local_idle_cleanup on_idle_exit = { this, &lock, &this_thread };
+      (void)on_idle_exit;
+
+      // Run the task. May throw an exception.
+      run_task(this_thread, usec);
+    }
+
+    waited = (usec >= 0);
+  }
+
+  return 0;
+}
+
+void scheduler::acquire_local_task(scheduler::thread_info& this_thread)
+{
+  this_thread.local_task = task_->acquire_local_task();
+  this_thread.owns_local_task = true;
+}
+
+void scheduler::release_local_task(scheduler::thread_info& this_thread)
+{
+  if (!this_thread.local_task_op_queue.empty())
+  {
+    // Leave the completions for the other threads. Descriptor operations do
+    // not depend on the instance of the task that harvested them.
+    mutex::scoped_lock lock(mutex_);
+    op_queue_.push(this_thread.local_task_op_queue);
+    wake_one_thread_and_unlock(lock);
+  }
+
+  if (this_thread.owns_local_task)
+  {
+    task_->release_local_task(this_thread.local_task);
+    this_thread.owns_local_task = false;
+  }
+
+  this_thread.local_task = 0;
+}
+
+void scheduler::acquire_local_op_queue(scheduler::thread_info& this_thread)
+{
+  stealable_op_queue<operation>* q = local_op_queues_.load();
+  for (; q; q = q->next())
+  {
+    if (q->try_acquire())
+    {
+      this_thread.local_op_queue = q;
+      return;
+    }
+  }
+
+  q = new stealable_op_queue<operation>(options_.local_queue_capacity());
+  q->try_acquire();
+  stealable_op_queue<operation>* head = local_op_queues_.load();
+  do
+  {
+    q->next(head);
+  } while (!local_op_queues_.compare_exchange_weak(head, q));
+  this_thread.local_op_queue = q;
+}
+
+void scheduler::release_local_op_queue(scheduler::thread_info& this_thread)
+{
+  if (stealable_op_queue<operation>* q = this_thread.local_op_queue)
+  {
+    op_queue<operation> ops;
+    while (operation* o = q->pop())
+      ops.push(o);
+    this_thread.local_op_queue = 0;
+    q->release();
+
+    if (!ops.empty())
+    {
+      mutex::scoped_lock lock(mutex_);
+      op_queue_.push(ops);
+      wake_one_thread_and_unlock(lock);
+    }
+  }
+}
+
+void scheduler::push_local_op_queue(scheduler::thread_info& this_thread,
+    op_queue<scheduler::operation>& ops)
+{
+  stealable_op_queue<operation>* q = this_thread.local_op_queue;
+  while (!ops.empty() && !q->full())
+  {
+    operation* o = ops.front();
+    ops.pop();
+    q->push(o);
+  }
+}
+
+scheduler::operation* scheduler::steal_operation(
+    scheduler::thread_info& this_thread)
+{
+  // Start with the queue after our own, so that threads spread out over the
+  // list of victims.
+  stealable_op_queue<operation>* own = this_thread.local_op_queue;
+  for (stealable_op_queue<operation>* q = own->next(); q; q = q->next())
+    if (operation* o = q->pop())
+      return o;
+  for (stealable_op_queue<operation>* q = local_op_queues_.load();
+      q != own; q = q->next())
+    if (operation* o = q->pop())
+      return o;
+  return 0;
+}
+
+bool scheduler::enqueue_lock_free(scheduler::operation* op)
+{
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+  {
+    stealable_op_queue<operation>* q =
+      static_cast<thread_info*>(this_thread)->local_op_queue;
+    if (!q || !q->push(op))
+      return false;
+  }
+  else if (!injection_queue_.push(op))
+  {
+    // The thread that made the queue non-empty takes care of the wakeup.
+    return true;
+  }
+
+  wake_one_idle_thread();
+  return true;
+}
+
+bool scheduler::enqueue_lock_free(op_queue<scheduler::operation>& ops)
+{
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+  {
+    if (!static_cast<thread_info*>(this_thread)->local_op_queue)
+      return false;
+    push_local_op_queue(*static_cast<thread_info*>(this_thread), ops);
+  }
+  else if (!injection_queue_.push(ops))
+  {
+    // The thread that made the queue non-empty takes care of the wakeup.
+    return true;
+  }
+
+  wake_one_idle_thread();
+  return ops.empty();
+}
+
+bool scheduler::send_to_task(scheduler::operation* op)
+{
+  scheduler_task* target = message_task_.load(std::memory_order_acquire);
+  if (!target)
+    return false;
+
+  // The operation is sent by the task of the scheduler that the calling
+  // thread is running. Only schedulers that use the default task publish it,
+  // and so both tasks are of the same type.
+  thread_context* top = thread_call_stack::top_key();
+  if (!top || top == this)
+    return false;
+  scheduler_task* source = static_cast<scheduler*>(
+      top)->message_task_.load(std::memory_order_acquire);
+  return source && source->send_operation(*target, op);
+}
+
+bool scheduler::has_lock_free_work(bool include_local_queues) const
+{
+  if (!injection_queue_.empty())
+    return true;
+  if (include_local_queues)
+    for (stealable_op_queue<operation>* q = local_op_queues_.load();
+        q; q = q->next())
+      if (!q->empty())
+        return true;
+  return false;
+}
+
+bool scheduler::begin_idle(bool include_local_queues)
+{
+  // The fence pairs with the one in wake_one_idle_thread(), so that either
+  // this thread sees the new operation or the enqueuer sees an idle thread.
+  ++idle_threads_;
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (has_lock_free_work(include_local_queues))
+  {
+    --idle_threads_;
+    return false;
+  }
+  return true;
+}
+
+void scheduler::wake_one_idle_thread()
+{
+  std::atomic_thread_fence(std::memory_order_seq_cst);
+  if (idle_threads_ > 0)
+  {
+    mutex::scoped_lock lock(mutex_);
+    wake_one_thread_and_unlock(lock);
+  }
+}
+
+context_metrics scheduler::metrics() const
+{
+  context_metrics m;
+  m.spin_count_ = spin_count_.load(std::memory_order_relaxed);
+  m.spin_hits_ = spin_hits_.load(std::memory_order_relaxed);
+  m.spin_misses_ = spin_misses_.load(std::memory_order_relaxed);
+  m.spin_time_ = chrono::nanoseconds(
+      static_cast<chrono::nanoseconds::rep>(
+        spin_time_.load(std::memory_order_relaxed)));
+  m.poll_budget_handler_hits_ =
+    poll_budget_handler_hits_.load(std::memory_order_relaxed);
+  m.poll_budget_time_hits_ =
+    poll_budget_time_hits_.load(std::memory_order_relaxed);
+  m.enqueued_ = external_enqueued_.load(std::memory_order_relaxed);
+  for (thread_metrics* t = thread_metrics_.load(); t; t = t->next())
+    t->merge_into(m);
+
+  if (scheduler_task* task = metrics_task_.load(std::memory_order_acquire))
+  {
+    std::size_t descriptors = 0, bytes_per_descriptor = 0, reserved_bytes = 0;
+    task->descriptor_usage(descriptors, bytes_per_descriptor, reserved_bytes);
+    m.registered_descriptors_ = descriptors;
+    m.descriptor_state_size_ = bytes_per_descriptor;
+    m.descriptor_state_memory_ = reserved_bytes;
+    task->ring_usage(m.io_uring_cq_overflows_, m.io_uring_sq_full_flushes_,
+        m.io_uring_submits_, m.io_uring_submitted_entries_);
+  }
+
+  return m;
+}
+
+void scheduler::acquire_thread_metrics(scheduler::thread_info& this_thread)
+{
+  if (!collect_metrics_)
+    return;
+
+  thread_metrics* m = thread_metrics_.load();
+  for (; m; m = m->next())
+  {
+    if (m->try_acquire())
+    {
+      this_thread.metrics = m;
+      return;
+    }
+  }
+
+  m = new thread_metrics;
+  m->try_acquire();
+  thread_metrics* head = thread_metrics_.load();
+  do
+  {
+    m->next(head);
+  } while (!thread_metrics_.compare_exchange_weak(head, m));
+  this_thread.metrics = m;
+}
+
+void scheduler::record_enqueued(scheduler::operation* op)
+{
+  // The low bit is set so that a valid timestamp is never zero.
+  op->enqueue_time_ = static_cast<uint32_t>(spin_clock() / 1000) | 1;
+
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+  {
+    if (thread_metrics* m = static_cast<thread_info*>(this_thread)->metrics)
+    {
+      m->operations_enqueued(1);
+      return;
+    }
+  }
+
+  external_enqueued_.fetch_add(1, std::memory_order_relaxed);
+}
+
+void scheduler::record_enqueued(op_queue<scheduler::operation>& ops)
+{
+  uint32_t now = static_cast<uint32_t>(spin_clock() / 1000) | 1;
+  uint64_t n = 0;
+  for (operation* o = ops.front(); o; o = op_queue_access::next(o), ++n)
+    o->enqueue_time_ = now;
+
+  if (thread_info_base* this_thread = thread_call_stack::contains(this))
+  {
+    if (thread_metrics* m = static_cast<thread_info*>(this_thread)->metrics)
+    {
+      m->operations_enqueued(n);
+      return;
+    }
+  }
+
+  external_enqueued_.fetch_add(n, std::memory_order_relaxed);
+}
+
+void scheduler::complete_operation(scheduler::thread_info& this_thread,
+    scheduler::operation* o, const boost::system::error_code& ec,
+    std::size_t task_result)
+{
+  if (poll_budget_handlers_)
+    handlers_since_poll_.fetch_add(1, std::memory_order_relaxed);
+
+  thread_metrics* m = this_thread.metrics;
+  if (!m)
+  {
+    o->complete(this, ec, task_result);
+    return;
+  }
+
+  uint64_t start = spin_clock();
+  if (o->enqueue_time_)
+  {
+    // Timestamps wrap around, but the difference is correct for any wait of
+    // less than about 70 minutes.
+    uint32_t now = static_cast<uint32_t>(start / 1000) | 1;
+    m->handler_started(static_cast<uint32_t>(now - o->enqueue_time_));
+  }
+  else
+  {
+    m->handler_started();
+  }
+
+  o->complete(this, ec, task_result);
+  m->handler_finished(spin_clock() - start);
+}
+
+void scheduler::run_task(scheduler::thread_info& this_thread, long usec)
+{
+  // A thread's own instance of the task keeps its completions apart from the
+  // operations that the thread posts.
+  op_queue<operation>& ops = this_thread.local_task
+    ? this_thread.local_task_op_queue : this_thread.private_op_queue;
+
+  thread_metrics* m = this_thread.metrics;
+  if (!m)
+  {
+    if (this_thread.local_task)
+      task_->run_local_task(this_thread.local_task, usec, ops);
+    else
+      task_->run(usec, ops);
+    if (poll_budget_handlers_)
+      handlers_since_poll_.store(0, std::memory_order_relaxed);
+    if (poll_budget_time_)
+      last_poll_time_.store(spin_clock(), std::memory_order_relaxed);
+    return;
+  }
+
+  operation* last = op_queue_access::back(ops);
+  uint64_t start = spin_clock();
+  if (this_thread.local_task)
+    task_->run_local_task(this_thread.local_task, usec, ops);
+  else
+    task_->run(usec, ops);
+  uint64_t end = spin_clock();
+  if (poll_budget_handlers_)
+    handlers_since_poll_.store(0, std::memory_order_relaxed);
+  if (poll_budget_time_)
+    last_poll_time_.store(end, std::memory_order_relaxed);
+  if (usec != 0)
+    m->idle(end - start);
+
+  // Count and timestamp the operations that the task completed.
+  uint32_t now = static_cast<uint32_t>(end / 1000) | 1;
+  uint64_t events = 0;
+  operation* o = last ? op_queue_access::next(last) : ops.front();
+  for (; o; o = op_queue_access::next(o), ++events)
+    o->enqueue_time_ = now;
+  m->operations_enqueued(events);
+  m->reactor_polled(events);
+}
+
+void scheduler::wait_for_wakeup(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread, long usec)
+{
+  uint64_t start = this_thread.metrics ? spin_clock() : 0;
+
+  if (usec < 0)
+    wakeup_event_.wait(lock);
+  else
+    wakeup_event_.wait_for_usec(lock, usec);
+
+  if (this_thread.metrics)
+    this_thread.metrics->idle(spin_clock() - start);
+}
+
+bool scheduler::begin_spin(scheduler::thread_info& this_thread)
+{
+  if (spin_limit_ == 0)
+    return false;
+
+  uint64_t now = spin_clock();
+  if (this_thread.idle_start == 0)
+  {
+    // Spin for twice the average wait, unless work is arriving too slowly
+    // for spinning to pay off.
+    uint64_t budget = spin_limit_;
+    if (adaptive_spin_)
+    {
+      uint64_t average = average_wait_time_.load(std::memory_order_relaxed);
+      budget = average > spin_limit_ ? 0 : (std::min)(average * 2, budget);
+    }
+
+    this_thread.idle_start = now;
+    this_thread.spin_deadline = budget > ~now ? ~static_cast<uint64_t>(0)
+      : now + budget;
+    if (budget == 0)
+      return false;
+
+    spin_count_.fetch_add(1, std::memory_order_relaxed);
+    this_thread.spinning = true;
+    ++spinning_threads_;
+    return true;
+  }
+
+  if (!this_thread.spinning)
+    return false;
+
+  if (now < this_thread.spin_deadline)
+    return true;
+
+  // The spin budget is exhausted, so the thread will block.
+  this_thread.spinning = false;
+  --spinning_threads_;
+  spin_misses_.fetch_add(1, std::memory_order_relaxed);
+  spin_time_.fetch_add(now - this_thread.idle_start,
+      std::memory_order_relaxed);
+  return false;
+}
+
+void scheduler::end_spin(scheduler::thread_info& this_thread, bool found_work)
+{
+  uint64_t now = spin_clock();
+  uint64_t waited = now - this_thread.idle_start;
+
+  if (this_thread.spinning)
+  {
+    this_thread.spinning = false;
+    --spinning_threads_;
+    if (found_work)
+      spin_hits_.fetch_add(1, std::memory_order_relaxed);
+    spin_time_.fetch_add(waited, std::memory_order_relaxed);
+  }
+
+  if (found_work && adaptive_spin_)
+  {
+    // Update the moving average with a weight of 1/8 for the new sample.
+    uint64_t average = average_wait_time_.load(std::memory_order_relaxed);
+    average_wait_time_.store(average - average / 8 + waited / 8,
+        std::memory_order_relaxed);
+  }
+
+  this_thread.idle_start = 0;
+}
+
+void scheduler::spin_wait(mutex::scoped_lock& lock,
+    scheduler::thread_info& this_thread, bool include_local_queues)
+{
+  long generation = spin_generation_;
+  lock.unlock();
+
+  while (spin_generation_ == generation
+      && !(lock_free_injection_ && has_lock_free_work(include_local_queues))
+      && spin_clock() < this_thread.spin_deadline)
+  {
+#if (defined(__GNUC__) || defined(__clang__)) \
+  && (defined(__i386__) || defined(__x86_64__))
+    __builtin_ia32_pause();
+#elif (defined(__GNUC__) || defined(__clang__)) && defined(__aarch64__)
+    __asm__ __volatile__ ("yield");
+#endif
+  }
+
+  lock.lock();
+}
+
+uint64_t scheduler::spin_clock()
+{
+  return static_cast<uint64_t>(
+      chrono::duration_cast<chrono::nanoseconds>(
+        chrono::steady_clock::now().time_since_epoch()).count());
+}
+
 scheduler_task* scheduler::get_default_task(boost::asio::execution_context& ctx)
 {
 #if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
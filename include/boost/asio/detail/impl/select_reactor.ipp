@@ -152,6 +152,28 @@ void select_reactor::move_descriptor(socket_type,
 {
 }
 
+int select_reactor::set_exclusive_wakeup(socket_type,
+    select_reactor::per_descriptor_data&, bool value)
+{
+  return value ? boost::asio::error::operation_not_supported : 0;
+}
+
+int select_reactor::migrate_descriptor(socket_type,
+    select_reactor::per_descriptor_data&)
+{
+  // All threads share the reactor's descriptors, so there is nothing to move.
+  return 0;
+}
+
+void select_reactor::speculative_counts(
+    const select_reactor::per_descriptor_data&,
+    uint64_t& hits, uint64_t& misses)
+{
+  // This reactor does not count speculative operations.
+  hits = 0;
+  misses = 0;
+}
+
 void select_reactor::call_post_immediate_completion(
     operation* op, bool is_continuation, const void* self)
 {
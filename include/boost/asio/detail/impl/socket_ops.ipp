@@ -1952,6 +1952,23 @@ int setsockopt(socket_type s, state_type& state, int level, int optname,
     return 0;
   }
 
+  if (level == custom_socket_option_level
+      && optname == exclusive_wakeup_option)
+  {
+    if (optlen != sizeof(int))
+    {
+      ec = boost::asio::error::invalid_argument;
+      return socket_error_retval;
+    }
+
+    if (*static_cast<const int*>(optval))
+      state |= exclusive_wakeup;
+    else
+      state &= ~exclusive_wakeup;
+    boost::asio::error::clear(ec);
+    return 0;
+  }
+
   if (level == SOL_SOCKET && optname == SO_LINGER)
     state |= user_set_linger;
 
@@ -2037,6 +2054,20 @@ int getsockopt(socket_type s, state_type state, int level, int optname,
     return 0;
   }
 
+  if (level == custom_socket_option_level
+      && optname == exclusive_wakeup_option)
+  {
+    if (*optlen != sizeof(int))
+    {
+      ec = boost::asio::error::invalid_argument;
+      return socket_error_retval;
+    }
+
+    *static_cast<int*>(optval) = (state & exclusive_wakeup) ? 1 : 0;
+    boost::asio::error::clear(ec);
+    return 0;
+  }
+
 #if defined(__BORLANDC__)
   // Mysteriously, using the getsockopt and setsockopt functions directly with
   // Borland C++ results in incorrect values being set and read. The bug can be
@@ -109,6 +109,13 @@ win_iocp_io_context::win_iocp_io_context(
   }
 }
 
+win_iocp_io_context::win_iocp_io_context(
+    boost::asio::execution_context& ctx, int concurrency_hint,
+    bool own_thread, const context_options&)
+  : win_iocp_io_context(ctx, concurrency_hint, own_thread)
+{
+}
+
 win_iocp_io_context::~win_iocp_io_context()
 {
   if (thread_.get())
@@ -34,6 +34,7 @@
 #include <boost/asio/detail/io_uring_wait_op.hpp>
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/timed_cancel_op.hpp>
 #include <boost/asio/posix/descriptor_base.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -313,8 +314,10 @@ public:
       ConstBufferSequence, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.descriptor_,
         impl.state_, buffers, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -348,7 +351,9 @@ public:
     typedef io_uring_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.descriptor_, POLLOUT, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -418,8 +423,10 @@ public:
       ConstBufferSequence, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.descriptor_,
         impl.state_, offset, buffers, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -503,8 +510,10 @@ public:
       MutableBufferSequence, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.descriptor_,
         impl.state_, buffers, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -538,7 +547,9 @@ public:
     typedef io_uring_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.descriptor_, POLLIN, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -605,8 +616,10 @@ public:
       MutableBufferSequence, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.descriptor_,
         impl.state_, offset, buffers, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
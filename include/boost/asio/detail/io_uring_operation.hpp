@@ -20,8 +20,11 @@
 #if defined(BOOST_ASIO_HAS_IO_URING)
 
 #include <liburing.h>
+#include <time.h>
+#include <boost/asio/detail/chrono.hpp>
 #include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/operation.hpp>
+#include <boost/asio/detail/timed_cancel_deadline.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -42,6 +45,49 @@ public:
   // The operation key used for targeted cancellation.
   void* cancellation_key_;
 
+  // Whether a single submission of the operation produces many completions.
+  bool multishot_;
+
+  // A deadline offered by cancel_after or cancel_at. The service claims it
+  // only when the operation is submitted at once and a second submission queue
+  // entry is available, and the deadline is then enforced by a linked timeout.
+  // An operation that waits in its queue, or that completes without being
+  // submitted, declines or discards the deadline before it can complete.
+  timed_cancel_deadline deadline_offer_;
+
+  // The absolute CLOCK_MONOTONIC time at which the operation is cancelled by a
+  // linked timeout, or zero if the operation has no deadline.
+  __kernel_timespec deadline_;
+
+  // Claim the offered deadline, if any, and record when it expires.
+  void claim_deadline()
+  {
+    chrono::nanoseconds timeout(0);
+    if (deadline_offer_.claim(timeout))
+    {
+      ::timespec now;
+      ::clock_gettime(CLOCK_MONOTONIC, &now);
+      long long ns = now.tv_nsec + (timeout.count() > 0 ? timeout.count() : 0);
+      deadline_.tv_sec = now.tv_sec + ns / 1000000000;
+      deadline_.tv_nsec = ns % 1000000000;
+    }
+  }
+
+  // Whether the operation has a deadline.
+  bool has_deadline() const
+  {
+    return deadline_.tv_sec != 0 || deadline_.tv_nsec != 0;
+  }
+
+  // Whether the operation's deadline has passed.
+  bool deadline_expired() const
+  {
+    ::timespec now;
+    ::clock_gettime(CLOCK_MONOTONIC, &now);
+    return now.tv_sec > deadline_.tv_sec
+      || (now.tv_sec == deadline_.tv_sec && now.tv_nsec >= deadline_.tv_nsec);
+  }
+
   // Prepare the operation.
   void prepare(::io_uring_sqe* sqe)
   {
@@ -65,6 +111,9 @@ protected:
       ec_(success_ec),
       bytes_transferred_(0),
       cancellation_key_(0),
+      multishot_(false),
+      deadline_offer_(),
+      deadline_(),
       prepare_func_(prepare_func),
       perform_func_(perform_func)
   {
@@ -75,6 +124,79 @@ private:
   perform_func_type perform_func_;
 };
 
+// An operation whose single submission keeps producing completions until the
+// kernel ends it. Each completion is delivered to the operation as it arrives,
+// and the operation decides what should happen to the submission.
+class io_uring_multishot_operation
+  : public io_uring_operation
+{
+public:
+  // What the service should do with the submission after a delivery.
+  enum action
+  {
+    // The submission is still running. Leave it alone.
+    keep_running,
+
+    // Cancel the submission, as its results are not being consumed quickly
+    // enough. The operation stays at the head of its queue.
+    pause,
+
+    // The submission has ended, but the operation continues. Submit it again.
+    restart,
+
+    // The submission has ended, and the operation will ask to be restarted
+    // once its results have been consumed.
+    wait,
+
+    // The operation has finished. Remove it from its queue and complete it.
+    finish
+  };
+
+  // The I/O queue that the operation is waiting in, used to restart it.
+  void* queue_;
+
+  // Deliver a completion of the submission. The completion's flags are those
+  // of the completion queue entry, where IORING_CQE_F_MORE is clear for the
+  // last completion of the submission. Any new operation resulting from the
+  // completion is returned in new_op.
+  action deliver(int result, unsigned flags,
+      bool cancel_requested, operation*& new_op)
+  {
+    return deliver_func_(this, result, flags, cancel_requested, new_op);
+  }
+
+  // Release any resources carried by a completion that cannot be delivered,
+  // such as one that arrives while the context is forking. Returns the result
+  // with which the submission should end, if this is its last completion.
+  int discard(int result, unsigned flags)
+  {
+    return discard_func_(this, result, flags);
+  }
+
+protected:
+  typedef action (*deliver_func_type)(io_uring_multishot_operation*,
+      int, unsigned, bool, operation*&);
+  typedef int (*discard_func_type)(io_uring_multishot_operation*,
+      int, unsigned);
+
+  io_uring_multishot_operation(const boost::system::error_code& success_ec,
+      prepare_func_type prepare_func, perform_func_type perform_func,
+      deliver_func_type deliver_func, discard_func_type discard_func,
+      func_type complete_func)
+    : io_uring_operation(success_ec,
+        prepare_func, perform_func, complete_func),
+      queue_(0),
+      deliver_func_(deliver_func),
+      discard_func_(discard_func)
+  {
+    multishot_ = true;
+  }
+
+private:
+  deliver_func_type deliver_func_;
+  discard_func_type discard_func_;
+};
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
@@ -20,9 +20,12 @@
 #if defined(BOOST_ASIO_HAS_IO_URING)
 
 #include <liburing.h>
+#include <atomic>
+#include <vector>
 #include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
 #include <boost/asio/detail/conditionally_enabled_mutex.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/io_uring_operation.hpp>
 #include <boost/asio/detail/limits.hpp>
 #include <boost/asio/detail/object_pool.hpp>
@@ -82,6 +85,8 @@ public:
     io_uring_service* service_;
     io_queue queues_[max_ops];
     bool shutdown_;
+    int descriptor_;
+    int fixed_file_;
 
     BOOST_ASIO_DECL io_object(bool locking);
   };
@@ -105,8 +110,10 @@ public:
   // Initialise the task.
   BOOST_ASIO_DECL void init_task();
 
-  // Register an I/O object with io_uring.
-  BOOST_ASIO_DECL void register_io_object(io_object*& io_obj);
+  // Register an I/O object with io_uring. If a descriptor is given, it is
+  // also placed in the registered file table when a slot is available.
+  BOOST_ASIO_DECL void register_io_object(
+      io_object*& io_obj, int descriptor = -1);
 
   // Register an internal I/O object with io_uring.
   BOOST_ASIO_DECL void register_internal_io_object(
@@ -118,14 +125,52 @@ public:
   // Unregister buffers from io_uring.
   BOOST_ASIO_DECL void unregister_buffers();
 
+  // Register a ring of provided buffers with io_uring. The buffer group
+  // identifier assigned to the ring is returned in group.
+  BOOST_ASIO_DECL ::io_uring_buf_ring* register_buffer_ring(
+      unsigned entries, int& group);
+
+  // Unregister a ring of provided buffers from io_uring.
+  BOOST_ASIO_DECL void unregister_buffer_ring(
+      ::io_uring_buf_ring* ring, unsigned entries, int group);
+
   // Post an operation for immediate completion.
   void post_immediate_completion(operation* op, bool is_continuation);
 
+  // Post an operation for immediate completion. Any deadline offered to the
+  // operation is claimed, as the operation no longer needs the timer.
+  void post_immediate_completion(io_uring_operation* op, bool is_continuation);
+
   // Start a new operation. The operation will be prepared and submitted to the
   // io_uring when it is at the head of its I/O operation queue.
   BOOST_ASIO_DECL void start_op(int op_type, per_io_object_data& io_obj,
       io_uring_operation* op, bool is_continuation);
 
+  // Restart a multishot operation that has been waiting for the results of
+  // its previous submission to be consumed.
+  BOOST_ASIO_DECL void restart_multishot_op(io_uring_multishot_operation* op);
+
+  // Get the number of results a multishot operation may have waiting to be
+  // consumed before its submission is paused.
+  std::size_t max_pending_multishot_results() const
+  {
+    return max_pending_multishot_results_;
+  }
+
+  // Get the number of received buffers a multishot receive operation may
+  // have waiting to be consumed before its submission is paused.
+  std::size_t max_pending_receive_results() const
+  {
+    return max_pending_receive_results_;
+  }
+
+  // Get the size at which stream socket sends are made without copying. A
+  // value of 0 means that sends are always copied.
+  std::size_t zero_copy_send_threshold() const
+  {
+    return zero_copy_send_threshold_;
+  }
+
   // Cancel all operations associated with the given I/O object. The handlers
   // associated with the I/O object will be invoked with the operation_aborted
   // error.
@@ -146,6 +191,15 @@ public:
   // object.
   BOOST_ASIO_DECL void cleanup_io_object(per_io_object_data& io_obj);
 
+  // Deregister the I/O object as for deregister_io_object, and start an
+  // operation that closes its descriptor. The operation is submitted once any
+  // cancelled operations have finished, and the last operation to complete
+  // frees the I/O object. Returns false if the operation could not be started,
+  // in which case the caller must close the descriptor and then release the
+  // service resources by calling cleanup_io_object.
+  BOOST_ASIO_DECL bool start_close_op(
+      per_io_object_data& io_obj, io_uring_operation* op);
+
   // Add a new timer queue to the reactor.
   template <typename Time_Traits>
   void add_timer_queue(timer_queue<Time_Traits>& timer_queue);
@@ -187,10 +241,18 @@ public:
   // Interrupt the io_uring wait.
   BOOST_ASIO_DECL void interrupt();
 
-private:
-  // The hint to pass to io_uring_queue_init to size its data structures.
-  enum { ring_size = 16384 };
+  // Send an operation to another io_uring service's ring, from which it is
+  // returned as a completion. The message is submitted immediately, so that
+  // its delivery does not depend on this ring's context running again.
+  // Returns false if the operation cannot be sent.
+  BOOST_ASIO_DECL bool send_operation(scheduler_task& target, operation* op);
 
+  // Report the activity of the submission and completion queues.
+  BOOST_ASIO_DECL void ring_usage(uint64_t& cq_overflows,
+      uint64_t& sq_full_flushes, uint64_t& submits,
+      uint64_t& submitted_entries) const;
+
+private:
   // The number of operations to submit in a batch.
   enum { submit_batch_size = 128 };
 
@@ -203,6 +265,10 @@ private:
   // Initialise the ring.
   BOOST_ASIO_DECL void init_ring();
 
+  // Enable a ring that was created disabled, making the calling thread its
+  // only submitter.
+  BOOST_ASIO_DECL void enable_ring();
+
   // Register the eventfd descriptor for readiness notifications.
   BOOST_ASIO_DECL void register_with_reactor();
 
@@ -218,6 +284,62 @@ private:
   BOOST_ASIO_DECL bool do_cancel_ops(
       per_io_object_data& io_obj, op_queue<operation>& ops);
 
+  // Get the user data used to submit an operation from an I/O queue. The
+  // submissions of multishot operations are tagged, so that their completions
+  // are passed to perform_multishot rather than to the queue.
+  BOOST_ASIO_DECL static void* submission_data(
+      io_queue* io_q, io_uring_operation* op);
+
+  // Get the number of submission queue entries needed by an operation, which
+  // includes a linked timeout for an operation with a deadline.
+  static unsigned sqe_count(io_uring_operation* op)
+  {
+    return op->has_deadline() && !op->multishot_ ? 2 : 1;
+  }
+
+  // Prepare a submission queue entry for an operation from an I/O queue. The
+  // entry refers to the I/O object's registered file, if it has one. If the
+  // operation has a deadline, a linked timeout is prepared in the next entry.
+  BOOST_ASIO_DECL void prepare_sqe(::io_uring_sqe* sqe,
+      io_queue* io_q, io_uring_operation* op);
+
+  // Get the submission queue entries for an operation that is about to be
+  // submitted. A deadline offered to the operation is claimed if there is room
+  // for its linked timeout, and declined otherwise. The service's lock is
+  // released while a declined deadline's timer is armed.
+  BOOST_ASIO_DECL ::io_uring_sqe* get_op_sqe(
+      mutex::scoped_lock& lock, io_uring_operation* op);
+
+  // Create the registered file table, and place the descriptors of all
+  // registered I/O objects in it.
+  BOOST_ASIO_DECL void init_registered_files();
+
+  // Place a descriptor in the registered file table, returning its slot, or
+  // -1 if there is no free slot.
+  BOOST_ASIO_DECL int register_file(int descriptor);
+
+  // Remove a descriptor from the registered file table.
+  BOOST_ASIO_DECL void unregister_file(int slot);
+
+  // Deliver a completion of a multishot operation's submission. This function
+  // must be called from within the scheduler.
+  BOOST_ASIO_DECL void perform_multishot(io_queue* io_q,
+      int result, unsigned flags, op_queue<operation>& ops);
+
+  // A message sent to another ring. It is kept until the message's completion
+  // on this ring shows whether it was delivered.
+  struct sent_message
+  {
+    io_uring_service* target_;
+    operation* op_;
+  };
+
+  // Handle a completion that carries a message between rings. An operation
+  // received from another ring is added to ops. Returns true if the operation
+  // was received, and so has no outstanding work on this ring to end.
+  BOOST_ASIO_DECL static bool perform_message(void* ptr,
+      int result, op_queue<operation>& ops);
+
   // Helper function to add a new timer queue.
   BOOST_ASIO_DECL void do_add_timer_queue(timer_queue_base& queue);
 
@@ -230,8 +352,11 @@ private:
   // Get the current timeout value.
   BOOST_ASIO_DECL __kernel_timespec get_timeout() const;
 
-  // Get a new submission queue entry, flushing the queue if necessary.
-  BOOST_ASIO_DECL ::io_uring_sqe* get_sqe();
+  // Get a new submission queue entry, flushing the queue if necessary. When
+  // count is greater than one, the queue is flushed unless it also has room
+  // for the entries that will follow, and no entry is returned if it still
+  // does not.
+  BOOST_ASIO_DECL ::io_uring_sqe* get_sqe(unsigned count = 1);
 
   // Submit pending submission queue entries.
   BOOST_ASIO_DECL void submit_sqes();
@@ -303,6 +428,42 @@ private:
 
   // The eventfd descriptor used to wait for readiness.
   int event_fd_;
+
+  // The number of results a multishot operation may have waiting.
+  std::size_t max_pending_multishot_results_;
+
+  // The number of buffers a multishot receive operation may have waiting.
+  std::size_t max_pending_receive_results_;
+
+  // The size at which stream socket sends are made without copying.
+  std::size_t zero_copy_send_threshold_;
+
+  // The buffer group identifier to assign to the next provided buffer ring.
+  int next_buffer_group_;
+
+  // Whether a kernel thread polls the submission queue.
+  bool sq_poll_;
+
+  // Whether completion work is run only when completions are waited for.
+  bool defer_taskrun_;
+
+  // Whether the ring is waiting to be enabled by its first submitter.
+  bool ring_disabled_;
+
+  // The number of slots in the registered file table.
+  std::size_t registered_files_;
+
+  // The free slots in the registered file table.
+  std::vector<int> free_files_;
+
+  // The kernel's count of overflowed completions when it was last read.
+  unsigned last_cq_overflow_;
+
+  // Counters reported by ring_usage().
+  std::atomic<uint64_t> cq_overflows_;
+  std::atomic<uint64_t> sq_full_flushes_;
+  std::atomic<uint64_t> submits_;
+  std::atomic<uint64_t> submitted_entries_;
 };
 
 } // namespace detail
@@ -24,7 +24,9 @@
 #include <boost/asio/detail/handler_alloc_helpers.hpp>
 #include <boost/asio/detail/handler_work.hpp>
 #include <boost/asio/detail/io_uring_operation.hpp>
+#include <boost/asio/detail/io_uring_service.hpp>
 #include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
 
@@ -271,6 +273,330 @@ private:
   handler_work<Handler, IoExecutor> work_;
 };
 
+// Accepts a stream of connections using a single multishot accept submission.
+// Each accepted connection is wrapped in its own operation, which hands it to
+// the connection handler. The submission is paused while too many of these
+// are waiting, and the final handler is invoked once the stream has ended and
+// every connection has been handled.
+template <typename Protocol, typename PeerIoExecutor,
+    typename ConnectionHandler, typename Handler, typename IoExecutor>
+class io_uring_socket_accept_many_op : public io_uring_multishot_operation
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_accept_many_op);
+
+  io_uring_socket_accept_many_op(const boost::system::error_code& success_ec,
+      io_uring_service& service, const PeerIoExecutor& peer_io_ex,
+      socket_type socket, const Protocol& protocol,
+      ConnectionHandler& connection_handler, Handler& handler,
+      const IoExecutor& io_ex)
+    : io_uring_multishot_operation(success_ec,
+        &io_uring_socket_accept_many_op::do_prepare,
+        &io_uring_socket_accept_many_op::do_perform,
+        &io_uring_socket_accept_many_op::do_deliver,
+        &io_uring_socket_accept_many_op::do_discard,
+        &io_uring_socket_accept_many_op::do_complete),
+      service_(service),
+      socket_(socket),
+      protocol_(protocol),
+      peer_io_ex_(peer_io_ex),
+      max_pending_(service.max_pending_multishot_results()),
+      pending_(0),
+      pausing_(false),
+      waiting_(false),
+      completed_(false),
+      connection_handler_(
+          static_cast<ConnectionHandler&&>(connection_handler)),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_accept_many_op* o(
+        static_cast<io_uring_socket_accept_many_op*>(base));
+
+    mutex::scoped_lock lock(o->mutex_);
+    o->pausing_ = false;
+    lock.unlock();
+
+    ::io_uring_prep_accept(sqe, o->socket_, 0, 0, 0);
+#if defined(IORING_ACCEPT_MULTISHOT)
+    sqe->ioprio |= IORING_ACCEPT_MULTISHOT;
+#endif // defined(IORING_ACCEPT_MULTISHOT)
+  }
+
+  static bool do_perform(io_uring_operation* base, bool after_completion)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_accept_many_op* o(
+        static_cast<io_uring_socket_accept_many_op*>(base));
+
+    // Completions are normally delivered one at a time. The queue only asks
+    // the operation to perform when the submission could not be made, or when
+    // the operation was cancelled while waiting to be restarted.
+    return after_completion && !!o->ec_;
+  }
+
+  static action do_deliver(io_uring_multishot_operation* base,
+      int result, unsigned flags, bool cancel_requested, operation*& new_op)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_accept_many_op* o(
+        static_cast<io_uring_socket_accept_many_op*>(base));
+
+    // Wrap an accepted socket so that it can be handed over once the scheduler
+    // runs it.
+    if (result >= 0)
+    {
+      socket_holder new_socket(result);
+      typename connection_op::ptr p = {
+        boost::asio::detail::addressof(o->handler_),
+        connection_op::ptr::allocate(o->handler_), 0 };
+      p.p = new (p.v) connection_op(o, new_socket.release());
+      new_op = p.p;
+      p.v = p.p = 0;
+    }
+
+    mutex::scoped_lock lock(o->mutex_);
+
+    if (new_op)
+      ++o->pending_;
+
+    if ((flags & IORING_CQE_F_MORE) != 0)
+    {
+      if (o->pending_ >= o->max_pending_
+          && !o->pausing_ && !cancel_requested)
+      {
+        o->pausing_ = true;
+        return pause;
+      }
+      return keep_running;
+    }
+
+    // The submission has ended.
+    bool paused = o->pausing_;
+    o->pausing_ = false;
+
+    if (cancel_requested)
+    {
+      o->ec_ = boost::asio::error::operation_aborted;
+      return finish;
+    }
+
+    if (result >= 0 || result == -ECONNABORTED)
+      return restart;
+
+    if (result == -ECANCELED && paused)
+    {
+      if (o->pending_ == 0)
+        return restart;
+      o->waiting_ = true;
+      return wait;
+    }
+
+    o->ec_.assign(-result, boost::asio::error::get_system_category());
+    return finish;
+  }
+
+  static int do_discard(io_uring_multishot_operation*,
+      int result, unsigned /*flags*/)
+  {
+    // No handler can take the connection. The submission is restarted.
+    if (result >= 0)
+    {
+      socket_holder new_socket(result);
+      return -ECANCELED;
+    }
+    return result;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_accept_many_op* o(
+        static_cast<io_uring_socket_accept_many_op*>(base));
+
+    // Leave the final upcall to the last connection, if any remain.
+    mutex::scoped_lock lock(o->mutex_);
+    o->completed_ = true;
+    if (o->pending_ > 0)
+      return;
+    lock.unlock();
+
+    o->complete_final(owner != 0);
+  }
+
+private:
+  typedef typename Protocol::socket::template
+    rebind_executor<PeerIoExecutor>::other peer_socket_type;
+
+  // Operation used to hand over a single accepted connection.
+  class connection_op : public operation
+  {
+  public:
+    BOOST_ASIO_DEFINE_HANDLER_PTR(connection_op);
+
+    connection_op(io_uring_socket_accept_many_op* op, socket_type new_socket)
+      : operation(&connection_op::do_complete),
+        op_(op),
+        new_socket_(new_socket)
+    {
+    }
+
+    static void do_complete(void* owner, operation* base,
+        const boost::system::error_code& /*ec*/,
+        std::size_t /*bytes_transferred*/)
+    {
+      BOOST_ASIO_ASSUME(base != 0);
+      connection_op* c(static_cast<connection_op*>(base));
+      io_uring_socket_accept_many_op* o = c->op_;
+      ptr p = { boost::asio::detail::addressof(o->handler_), c, c };
+
+      if (!owner)
+      {
+        p.reset();
+        o->connection_finished(false);
+        return;
+      }
+
+      // Assign the new connection to a peer socket object. The connection is
+      // closed if this fails.
+      boost::system::error_code ec;
+      peer_socket_type peer(o->peer_io_ex_);
+      peer.assign(o->protocol_, c->new_socket_.get(), ec);
+      if (!ec)
+        c->new_socket_.release();
+      p.reset();
+
+      if (ec)
+      {
+        o->connection_finished(true);
+        return;
+      }
+
+      // Hand the connection over using the final handler's executor.
+      connection_invoker invoker(o, peer);
+      fenced_block b(fenced_block::half);
+      o->work_.complete(invoker, o->handler_);
+    }
+
+  private:
+    io_uring_socket_accept_many_op* op_;
+    socket_holder new_socket_;
+  };
+
+  // Function object used to invoke the connection handler.
+  class connection_invoker
+  {
+  public:
+    connection_invoker(io_uring_socket_accept_many_op* op,
+        peer_socket_type& peer)
+      : op_(op),
+        peer_(static_cast<peer_socket_type&&>(peer))
+    {
+    }
+
+    connection_invoker(connection_invoker&& other)
+      : op_(other.op_),
+        peer_(static_cast<peer_socket_type&&>(other.peer_))
+    {
+      other.op_ = 0;
+    }
+
+    ~connection_invoker()
+    {
+      if (op_)
+        op_->connection_finished(false);
+    }
+
+    void operator()()
+    {
+      op_->connection_handler_(static_cast<peer_socket_type&&>(peer_));
+      io_uring_socket_accept_many_op* op = op_;
+      op_ = 0;
+      op->connection_finished(true);
+    }
+
+  private:
+    io_uring_socket_accept_many_op* op_;
+    peer_socket_type peer_;
+  };
+
+  // Called once a connection has been handed over, or abandoned.
+  void connection_finished(bool invoke)
+  {
+    mutex::scoped_lock lock(mutex_);
+    if (--pending_ > 0)
+      return;
+
+    if (completed_)
+    {
+      lock.unlock();
+      complete_final(invoke);
+    }
+    else if (waiting_ && invoke)
+    {
+      waiting_ = false;
+      lock.unlock();
+      service_.restart_multishot_op(this);
+    }
+  }
+
+  // Invoke the final handler, if required, and free the operation.
+  void complete_final(bool invoke)
+  {
+    // Take ownership of the handler object.
+    ptr p = { boost::asio::detail::addressof(handler_), this, this };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*this));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(work_));
+
+    BOOST_ASIO_ERROR_LOCATION(ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder1<Handler, boost::system::error_code>
+      handler(handler_, ec_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (invoke)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+  io_uring_service& service_;
+  socket_type socket_;
+  Protocol protocol_;
+  PeerIoExecutor peer_io_ex_;
+  mutex mutex_;
+  std::size_t max_pending_;
+  std::size_t pending_;
+  bool pausing_;
+  bool waiting_;
+  bool completed_;
+  ConnectionHandler connection_handler_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
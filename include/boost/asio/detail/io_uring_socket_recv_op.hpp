@@ -19,13 +19,18 @@
 
 #if defined(BOOST_ASIO_HAS_IO_URING)
 
+#include <boost/asio/provided_buffer_pool.hpp>
 #include <boost/asio/detail/bind_handler.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
 #include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
 #include <boost/asio/detail/handler_work.hpp>
 #include <boost/asio/detail/io_uring_operation.hpp>
+#include <boost/asio/detail/io_uring_service.hpp>
 #include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/op_queue.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -196,6 +201,365 @@ private:
   handler_work<Handler, IoExecutor> work_;
 };
 
+template <typename DataHandler, typename Handler, typename IoExecutor>
+class io_uring_socket_recv_many_op : public io_uring_multishot_operation
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_recv_many_op);
+
+  io_uring_socket_recv_many_op(const boost::system::error_code& success_ec,
+      io_uring_service& service, socket_type socket,
+      provided_buffer_pool& pool, int buffer_group,
+      DataHandler& data_handler, Handler& handler, const IoExecutor& io_ex)
+    : io_uring_multishot_operation(success_ec,
+        &io_uring_socket_recv_many_op::do_prepare,
+        &io_uring_socket_recv_many_op::do_perform,
+        &io_uring_socket_recv_many_op::do_deliver,
+        &io_uring_socket_recv_many_op::do_discard,
+        &io_uring_socket_recv_many_op::do_complete),
+      service_(service),
+      socket_(socket),
+      pool_(pool),
+      buffer_group_(buffer_group),
+      max_pending_(service.max_pending_receive_results()),
+      pending_(0),
+      delivering_(false),
+      pausing_(false),
+      waiting_(false),
+      completed_(false),
+      data_handler_(static_cast<DataHandler&&>(data_handler)),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_many_op* o(
+        static_cast<io_uring_socket_recv_many_op*>(base));
+
+    mutex::scoped_lock lock(o->mutex_);
+    o->pausing_ = false;
+    lock.unlock();
+
+    // The kernel selects a buffer from the pool's group as data arrives.
+    ::io_uring_prep_recv(sqe, o->socket_, 0, 0, 0);
+    sqe->flags |= IOSQE_BUFFER_SELECT;
+    sqe->buf_group = static_cast<__u16>(o->buffer_group_);
+#if defined(IORING_RECV_MULTISHOT)
+    sqe->ioprio |= IORING_RECV_MULTISHOT;
+#endif // defined(IORING_RECV_MULTISHOT)
+  }
+
+  static bool do_perform(io_uring_operation* base, bool after_completion)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_many_op* o(
+        static_cast<io_uring_socket_recv_many_op*>(base));
+
+    // Data is normally delivered one completion at a time. The queue only asks
+    // the operation to perform when the submission could not be made, or when
+    // the operation was cancelled while waiting to be restarted.
+    return after_completion && !!o->ec_;
+  }
+
+  static action do_deliver(io_uring_multishot_operation* base,
+      int result, unsigned flags, bool cancel_requested, operation*& new_op)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_many_op* o(
+        static_cast<io_uring_socket_recv_many_op*>(base));
+
+    // Wrap the data in the selected buffer so that it can be handed over once
+    // the scheduler runs it.
+    data_op* d = 0;
+    if ((flags & IORING_CQE_F_BUFFER) != 0)
+    {
+      unsigned short id = static_cast<unsigned short>(
+          flags >> IORING_CQE_BUFFER_SHIFT);
+      if (result > 0)
+      {
+        typename data_op::ptr p = {
+          boost::asio::detail::addressof(o->handler_),
+          data_op::ptr::allocate(o->handler_), 0 };
+        p.p = new (p.v) data_op(o, id, static_cast<std::size_t>(result));
+        d = p.p;
+        p.v = p.p = 0;
+      }
+      else
+        provided_buffer_pool_access::release(o->pool_, id);
+    }
+
+    mutex::scoped_lock lock(o->mutex_);
+
+    // Only one buffer is handed over at a time, so that data is delivered in
+    // the order it was received.
+    if (d)
+    {
+      ++o->pending_;
+      if (o->delivering_)
+        o->queue_.push(d);
+      else
+      {
+        o->delivering_ = true;
+        new_op = d;
+      }
+    }
+
+    if ((flags & IORING_CQE_F_MORE) != 0)
+    {
+      if (o->pending_ >= o->max_pending_
+          && !o->pausing_ && !cancel_requested)
+      {
+        o->pausing_ = true;
+        return pause;
+      }
+      return keep_running;
+    }
+
+    // The submission has ended.
+    bool paused = o->pausing_;
+    o->pausing_ = false;
+
+    if (cancel_requested)
+    {
+      o->ec_ = boost::asio::error::operation_aborted;
+      return finish;
+    }
+
+    if (result > 0)
+      return restart;
+
+    if (result == 0)
+    {
+      o->ec_ = boost::asio::error::eof;
+      return finish;
+    }
+
+    if (result == -ECANCELED && paused)
+    {
+      if (o->pending_ == 0)
+        return restart;
+      o->waiting_ = true;
+      return wait;
+    }
+
+    // An error of ENOBUFS means that the pool ran out of buffers.
+    o->ec_.assign(-result, boost::asio::error::get_system_category());
+    return finish;
+  }
+
+  static int do_discard(io_uring_multishot_operation* base,
+      int result, unsigned flags)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_many_op* o(
+        static_cast<io_uring_socket_recv_many_op*>(base));
+
+    // No handler can take the data. The submission is restarted.
+    if ((flags & IORING_CQE_F_BUFFER) != 0)
+    {
+      provided_buffer_pool_access::release(o->pool_,
+          static_cast<unsigned short>(flags >> IORING_CQE_BUFFER_SHIFT));
+    }
+    return result >= 0 ? -ECANCELED : result;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_recv_many_op* o(
+        static_cast<io_uring_socket_recv_many_op*>(base));
+
+    // Leave the final upcall to the last buffer, if any remain.
+    mutex::scoped_lock lock(o->mutex_);
+    o->completed_ = true;
+    if (o->pending_ > 0)
+      return;
+    lock.unlock();
+
+    o->complete_final(owner != 0);
+  }
+
+private:
+  // Operation used to hand over a single buffer of received data.
+  class data_op : public operation
+  {
+  public:
+    BOOST_ASIO_DEFINE_HANDLER_PTR(data_op);
+
+    data_op(io_uring_socket_recv_many_op* op,
+        unsigned short id, std::size_t size)
+      : operation(&data_op::do_complete),
+        op_(op),
+        id_(id),
+        size_(size)
+    {
+    }
+
+    static void do_complete(void* owner, operation* base,
+        const boost::system::error_code& /*ec*/,
+        std::size_t /*bytes_transferred*/)
+    {
+      BOOST_ASIO_ASSUME(base != 0);
+      data_op* d(static_cast<data_op*>(base));
+      io_uring_socket_recv_many_op* o = d->op_;
+      ptr p = { boost::asio::detail::addressof(o->handler_), d, d };
+
+      // Take ownership of the buffer.
+      leased_buffer buffer(
+          provided_buffer_pool_access::lease(o->pool_, d->id_, d->size_));
+      p.reset();
+
+      if (!owner)
+      {
+        buffer.release();
+        o->data_finished(false);
+        return;
+      }
+
+      // Hand the buffer over using the final handler's executor.
+      data_invoker invoker(o, buffer);
+      fenced_block b(fenced_block::half);
+      o->work_.complete(invoker, o->handler_);
+    }
+
+  private:
+    io_uring_socket_recv_many_op* op_;
+    unsigned short id_;
+    std::size_t size_;
+  };
+
+  // Function object used to invoke the data handler.
+  class data_invoker
+  {
+  public:
+    data_invoker(io_uring_socket_recv_many_op* op, leased_buffer& buffer)
+      : op_(op),
+        buffer_(static_cast<leased_buffer&&>(buffer))
+    {
+    }
+
+    data_invoker(data_invoker&& other)
+      : op_(other.op_),
+        buffer_(static_cast<leased_buffer&&>(other.buffer_))
+    {
+      other.op_ = 0;
+    }
+
+    ~data_invoker()
+    {
+      if (op_)
+      {
+        buffer_.release();
+        op_->data_finished(false);
+      }
+    }
+
+    void operator()()
+    {
+      op_->data_handler_(static_cast<leased_buffer&&>(buffer_));
+      io_uring_socket_recv_many_op* op = op_;
+      op_ = 0;
+      op->data_finished(true);
+    }
+
+  private:
+    io_uring_socket_recv_many_op* op_;
+    leased_buffer buffer_;
+  };
+
+  // Called once a buffer has been handed over, or abandoned.
+  void data_finished(bool invoke)
+  {
+    mutex::scoped_lock lock(mutex_);
+    --pending_;
+
+    // Hand over the next buffer, if any. If the previous one was abandoned,
+    // then so are the rest.
+    if (data_op* next = queue_.front())
+    {
+      queue_.pop();
+      lock.unlock();
+      if (invoke)
+        service_.post_immediate_completion(next, true);
+      else
+        next->destroy();
+      return;
+    }
+
+    delivering_ = false;
+    if (pending_ > 0)
+      return;
+
+    if (completed_)
+    {
+      lock.unlock();
+      complete_final(invoke);
+    }
+    else if (waiting_ && invoke)
+    {
+      waiting_ = false;
+      lock.unlock();
+      service_.restart_multishot_op(this);
+    }
+  }
+
+  // Invoke the final handler, if required, and free the operation.
+  void complete_final(bool invoke)
+  {
+    // Take ownership of the handler object.
+    ptr p = { boost::asio::detail::addressof(handler_), this, this };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*this));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(work_));
+
+    BOOST_ASIO_ERROR_LOCATION(ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder1<Handler, boost::system::error_code>
+      handler(handler_, ec_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (invoke)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+  io_uring_service& service_;
+  socket_type socket_;
+  provided_buffer_pool& pool_;
+  int buffer_group_;
+  mutex mutex_;
+  std::size_t max_pending_;
+  std::size_t pending_;
+  op_queue<data_op> queue_;
+  bool delivering_;
+  bool pausing_;
+  bool waiting_;
+  bool completed_;
+  DataHandler data_handler_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
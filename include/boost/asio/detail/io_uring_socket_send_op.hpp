@@ -182,6 +182,204 @@ private:
   handler_work<Handler, IoExecutor> work_;
 };
 
+#if defined(IORING_CQE_F_NOTIF)
+
+// Sends data without copying it into the kernel. A successful submission
+// produces two completions: the first gives the result of the send, and the
+// second notifies that the kernel no longer needs the buffers. The handler is
+// not invoked until the notification arrives.
+template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+class io_uring_socket_send_zc_op : public io_uring_multishot_operation
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(io_uring_socket_send_zc_op);
+
+  io_uring_socket_send_zc_op(const boost::system::error_code& success_ec,
+      int socket, const ConstBufferSequence& buffers,
+      socket_base::message_flags flags, Handler& handler,
+      const IoExecutor& io_ex)
+    : io_uring_multishot_operation(success_ec,
+        &io_uring_socket_send_zc_op::do_prepare,
+        &io_uring_socket_send_zc_op::do_perform,
+        &io_uring_socket_send_zc_op::do_deliver,
+        &io_uring_socket_send_zc_op::do_discard,
+        &io_uring_socket_send_zc_op::do_complete),
+      socket_(socket),
+      flags_(flags),
+      bufs_(buffers),
+      msghdr_(),
+      copy_(false),
+      copy_pending_(false),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+    msghdr_.msg_iov = bufs_.buffers();
+    msghdr_.msg_iovlen = static_cast<int>(bufs_.count());
+  }
+
+  static void do_prepare(io_uring_operation* base, ::io_uring_sqe* sqe)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_send_zc_op* o(
+        static_cast<io_uring_socket_send_zc_op*>(base));
+
+    if (o->copy_)
+    {
+      ::io_uring_prep_sendmsg(sqe, o->socket_, &o->msghdr_, o->flags_);
+    }
+    else if (o->bufs_.is_single_buffer)
+    {
+      ::io_uring_prep_send_zc(sqe, o->socket_,
+          o->bufs_.buffers()->iov_base, o->bufs_.buffers()->iov_len,
+          o->flags_, 0);
+    }
+    else
+    {
+      ::io_uring_prep_sendmsg_zc(sqe, o->socket_, &o->msghdr_, o->flags_);
+    }
+  }
+
+  static bool do_perform(io_uring_operation*, bool after_completion)
+  {
+    // The result is normally delivered through do_deliver. The queue only
+    // asks the operation to perform when the submission ended while the
+    // context was forking.
+    return after_completion;
+  }
+
+  static action do_deliver(io_uring_multishot_operation* base,
+      int result, unsigned flags, bool cancel_requested,
+      operation*& /*new_op*/)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_send_zc_op* o(
+        static_cast<io_uring_socket_send_zc_op*>(base));
+
+    // The buffers have been released. If the zero-copy send was rejected then
+    // send the data again with copying, otherwise the recorded result is final.
+    if ((flags & IORING_CQE_F_NOTIF) != 0)
+    {
+      if (o->copy_pending_)
+      {
+        o->copy_pending_ = false;
+        if (cancel_requested)
+        {
+          o->ec_ = boost::asio::error::operation_aborted;
+          return finish;
+        }
+        o->copy_ = true;
+        return restart;
+      }
+      return finish;
+    }
+
+    o->record(result);
+
+    // Sockets that do not support zero-copy sends, such as AF_UNIX stream
+    // sockets, reject them with a notification still to follow. Older kernels
+    // reject them outright.
+    if (!o->copy_ && (result == -EINVAL || result == -EOPNOTSUPP))
+    {
+      if ((flags & IORING_CQE_F_MORE) != 0)
+      {
+        o->copy_pending_ = true;
+        return keep_running;
+      }
+      o->copy_ = true;
+      return restart;
+    }
+
+    if ((flags & IORING_CQE_F_MORE) != 0)
+      return keep_running;
+
+    return finish;
+  }
+
+  static int do_discard(io_uring_multishot_operation* base,
+      int result, unsigned flags)
+  {
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_send_zc_op* o(
+        static_cast<io_uring_socket_send_zc_op*>(base));
+
+    // The data may already have been sent, so the recorded result is used to
+    // end the submission rather than restarting it.
+    if ((flags & IORING_CQE_F_NOTIF) != 0)
+      return o->ec_ ? -o->ec_.value()
+        : static_cast<int>(o->bytes_transferred_);
+
+    o->record(result);
+    return result;
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the handler object.
+    BOOST_ASIO_ASSUME(base != 0);
+    io_uring_socket_send_zc_op* o
+      (static_cast<io_uring_socket_send_zc_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+    // Take ownership of the operation's outstanding work.
+    handler_work<Handler, IoExecutor> w(
+        static_cast<handler_work<Handler, IoExecutor>&&>(
+          o->work_));
+
+    BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+    // Make a copy of the handler so that the memory can be deallocated before
+    // the upcall is made. Even if we're not about to make an upcall, a
+    // sub-object of the handler may be the true owner of the memory associated
+    // with the handler. Consequently, a local copy of the handler is required
+    // to ensure that any owning sub-object remains valid until after we have
+    // deallocated the memory here.
+    detail::binder2<Handler, boost::system::error_code, std::size_t>
+      handler(o->handler_, o->ec_, o->bytes_transferred_);
+    p.h = boost::asio::detail::addressof(handler.handler_);
+    p.reset();
+
+    // Make the upcall if required.
+    if (owner)
+    {
+      fenced_block b(fenced_block::half);
+      BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_, handler.arg2_));
+      w.complete(handler, handler.handler_);
+      BOOST_ASIO_HANDLER_INVOCATION_END;
+    }
+  }
+
+private:
+  // Record the result of the send.
+  void record(int result)
+  {
+    if (result < 0)
+    {
+      ec_.assign(-result, boost::asio::error::get_system_category());
+      bytes_transferred_ = 0;
+    }
+    else
+    {
+      ec_.assign(0, ec_.category());
+      bytes_transferred_ = static_cast<std::size_t>(result);
+    }
+  }
+
+  socket_type socket_;
+  socket_base::message_flags flags_;
+  buffer_sequence_adapter<boost::asio::const_buffer, ConstBufferSequence> bufs_;
+  msghdr msghdr_;
+  bool copy_;
+  bool copy_pending_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+#endif // defined(IORING_CQE_F_NOTIF)
+
 } // namespace detail
 } // namespace asio
 } // namespace boost
@@ -284,8 +284,10 @@ public:
         endpoint_type, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.socket_, impl.state_,
         buffers, destination, flags, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -318,7 +320,9 @@ public:
     typedef io_uring_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.socket_, POLLOUT, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -407,8 +411,10 @@ public:
         endpoint_type, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.socket_, impl.state_,
         buffers, sender_endpoint, flags, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -454,7 +460,9 @@ public:
     typedef io_uring_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.socket_, poll_flags, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -522,8 +530,10 @@ public:
     typedef io_uring_socket_accept_op<Socket, Protocol, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.socket_, impl.state_,
         peer, impl.protocol_, peer_endpoint, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected() && !peer.is_open())
@@ -558,8 +568,10 @@ public:
         PeerIoExecutor, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, peer_io_ex, impl.socket_,
         impl.state_, impl.protocol_, peer_endpoint, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -576,6 +588,44 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous accept of a stream of connections. Each accepted
+  // connection is passed to the connection handler, and the handler is invoked
+  // once no more connections will be accepted.
+  template <typename PeerIoExecutor, typename ConnectionHandler,
+      typename Handler, typename IoExecutor>
+  void async_accept_many(implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex, ConnectionHandler& connection_handler,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_accept_many_op<Protocol, PeerIoExecutor,
+        ConnectionHandler, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, io_uring_service_, peer_io_ex,
+        impl.socket_, impl.protocol_, connection_handler, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_accept_many"));
+
+    start_op(impl, io_uring_service::read_op, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+
   // Connect the socket to the specified endpoint.
   boost::system::error_code connect(implementation_type& impl,
       const endpoint_type& peer_endpoint, boost::system::error_code& ec)
@@ -601,8 +651,10 @@ public:
     typedef io_uring_socket_connect_op<Protocol, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.socket_,
         peer_endpoint, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
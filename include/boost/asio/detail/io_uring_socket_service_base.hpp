@@ -26,16 +26,20 @@
 #include <boost/asio/execution_context.hpp>
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/io_uring_null_buffers_op.hpp>
 #include <boost/asio/detail/io_uring_service.hpp>
+#include <boost/asio/detail/io_uring_socket_close_op.hpp>
 #include <boost/asio/detail/io_uring_socket_recv_op.hpp>
 #include <boost/asio/detail/io_uring_socket_recvmsg_op.hpp>
 #include <boost/asio/detail/io_uring_socket_send_op.hpp>
+#include <boost/asio/detail/io_uring_socket_shutdown_op.hpp>
 #include <boost/asio/detail/io_uring_wait_op.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
 #include <boost/asio/detail/socket_types.hpp>
+#include <boost/asio/detail/timed_cancel_op.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -107,6 +111,27 @@ public:
   BOOST_ASIO_DECL boost::system::error_code cancel(
       base_implementation_type& impl, boost::system::error_code& ec);
 
+  // Move the socket to the calling thread's own set of descriptors. All
+  // threads share the io_uring instance, so there is nothing to move.
+  boost::system::error_code migrate(base_implementation_type& impl,
+      boost::system::error_code& ec)
+  {
+    if (!is_open(impl))
+      ec = boost::asio::error::bad_descriptor;
+    else
+      ec = boost::system::error_code();
+    return ec;
+  }
+
+  // Get the number of speculative operations on the socket that completed at
+  // once, and the number that would have blocked. Operations are not counted.
+  void speculative_counts(const base_implementation_type&,
+      uint64_t& hits, uint64_t& misses) const
+  {
+    hits = 0;
+    misses = 0;
+  }
+
   // Determine whether the socket is at the out-of-band data mark.
   bool at_mark(const base_implementation_type& impl,
       boost::system::error_code& ec) const
@@ -247,6 +272,63 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous close. The socket implementation is closed at once,
+  // and the descriptor is closed by the kernel.
+  template <typename Handler, typename IoExecutor>
+  void async_close(base_implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_close_op<Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_, handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_close"));
+
+    if (!is_open(impl))
+    {
+      io_uring_service_.post_immediate_completion(p.p, is_continuation);
+    }
+    else if (!io_uring_service_.start_close_op(impl.io_object_data_, p.p))
+    {
+      socket_ops::close(impl.socket_, impl.state_, false, p.p->ec_);
+      io_uring_service_.cleanup_io_object(impl.io_object_data_);
+      io_uring_service_.post_immediate_completion(p.p, is_continuation);
+    }
+    p.v = p.p = 0;
+
+    construct(impl);
+  }
+
+  // Start an asynchronous shutdown. The shutdown is performed by the kernel
+  // after any outstanding send operations.
+  template <typename Handler, typename IoExecutor>
+  void async_shutdown(base_implementation_type& impl,
+      socket_base::shutdown_type what, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_shutdown_op<Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        static_cast<int>(what), handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_shutdown"));
+
+    start_op(impl, io_uring_service::write_op, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+
   // Send the given data to the peer.
   template <typename ConstBufferSequence>
   size_t send(base_implementation_type& impl,
@@ -293,13 +375,29 @@ public:
     associated_cancellation_slot_t<Handler> slot
       = boost::asio::get_associated_cancellation_slot(handler);
 
+#if defined(IORING_CQE_F_NOTIF)
+    // Large sends on stream sockets are made without copying the data.
+    std::size_t zero_copy_threshold =
+      io_uring_service_.zero_copy_send_threshold();
+    if (zero_copy_threshold > 0
+        && (impl.state_ & socket_ops::stream_oriented) != 0
+        && (impl.state_ & socket_ops::internal_non_blocking) == 0
+        && boost::asio::buffer_size(buffers) >= zero_copy_threshold)
+    {
+      async_send_zero_copy(impl, buffers, flags, handler, io_ex);
+      return;
+    }
+#endif // defined(IORING_CQE_F_NOTIF)
+
     // Allocate and construct an operation to wrap the handler.
     typedef io_uring_socket_send_op<
         ConstBufferSequence, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.socket_,
         impl.state_, buffers, flags, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -319,6 +417,46 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(IORING_CQE_F_NOTIF)
+  // Start an asynchronous send that does not copy the data. The buffers must
+  // remain valid until the kernel has finished with them.
+  template <typename ConstBufferSequence, typename Handler, typename IoExecutor>
+  void async_send_zero_copy(base_implementation_type& impl,
+      const ConstBufferSequence& buffers, socket_base::message_flags flags,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_send_zc_op<
+        ConstBufferSequence, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
+    p.p = new (p.v) op(success_ec_, impl.socket_,
+        buffers, flags, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::write_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_send"));
+
+    start_op(impl, io_uring_service::write_op, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(IORING_CQE_F_NOTIF)
+
   // Start an asynchronous wait until data can be sent without blocking.
   template <typename Handler, typename IoExecutor>
   void async_send(base_implementation_type& impl, const null_buffers&,
@@ -334,7 +472,9 @@ public:
     typedef io_uring_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.socket_, POLLOUT, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -406,8 +546,10 @@ public:
         MutableBufferSequence, Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.socket_,
         impl.state_, buffers, flags, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -456,7 +598,9 @@ public:
     typedef io_uring_null_buffers_op<Handler, IoExecutor> op;
     typename op::ptr p = { boost::asio::detail::addressof(handler),
       op::ptr::allocate(handler), 0 };
+    timed_cancel_deadline deadline = take_timed_cancel_deadline(handler);
     p.p = new (p.v) op(success_ec_, impl.socket_, poll_flags, handler, io_ex);
+    p.p->deadline_offer_ = deadline;
 
     // Optionally register for per-operation cancellation.
     if (slot.is_connected())
@@ -473,6 +617,46 @@ public:
     p.v = p.p = 0;
   }
 
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  // Start an asynchronous receive of a stream of data. The kernel takes a
+  // buffer from the pool each time data arrives, and the buffer is passed to
+  // the data handler. Pools register their buffers with io_uring only when it
+  // is the default backend.
+  template <typename DataHandler, typename Handler, typename IoExecutor>
+  void async_receive_many(base_implementation_type& impl,
+      provided_buffer_pool& pool, DataHandler& data_handler,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    associated_cancellation_slot_t<Handler> slot
+      = boost::asio::get_associated_cancellation_slot(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef io_uring_socket_recv_many_op<DataHandler, Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, io_uring_service_, impl.socket_,
+        pool, provided_buffer_pool_access::group(pool),
+        data_handler, handler, io_ex);
+
+    // Optionally register for per-operation cancellation.
+    if (slot.is_connected())
+    {
+      p.p->cancellation_key_ =
+        &slot.template emplace<io_uring_op_cancellation>(&io_uring_service_,
+            &impl.io_object_data_, io_uring_service::read_op);
+    }
+
+    BOOST_ASIO_HANDLER_CREATION((io_uring_service_.context(), *p.p,
+          "socket", &impl, impl.socket_, "async_receive_many"));
+
+    start_op(impl, io_uring_service::read_op, p.p, is_continuation, false);
+    p.v = p.p = 0;
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
   // Receive some data with associated flags. Returns the number of bytes
   // received.
   template <typename MutableBufferSequence>
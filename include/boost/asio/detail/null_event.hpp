@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <cstddef>
 #include <boost/asio/detail/noncopyable.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -50,6 +51,12 @@ public:
   {
   }
 
+  // Signal up to the specified number of waiters.
+  template <typename Lock>
+  void signal_many(Lock&, std::size_t)
+  {
+  }
+
   // Unlock the mutex and signal one waiter.
   template <typename Lock>
   void unlock_and_signal_one(Lock&)
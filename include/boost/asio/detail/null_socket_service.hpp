@@ -23,8 +23,10 @@
 #include <boost/asio/error.hpp>
 #include <boost/asio/execution_context.hpp>
 #include <boost/asio/post.hpp>
+#include <boost/asio/provided_buffer_pool.hpp>
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -143,6 +145,23 @@ public:
     return ec;
   }
 
+  // Move the socket to the calling thread's own set of descriptors.
+  boost::system::error_code migrate(implementation_type&,
+      boost::system::error_code& ec)
+  {
+    ec = boost::asio::error::operation_not_supported;
+    return ec;
+  }
+
+  // Get the number of speculative operations on the socket that completed at
+  // once, and the number that would have blocked.
+  void speculative_counts(const implementation_type&,
+      uint64_t& hits, uint64_t& misses) const
+  {
+    hits = 0;
+    misses = 0;
+  }
+
   // Determine whether the socket is at the out-of-band data mark.
   bool at_mark(const implementation_type&,
       boost::system::error_code& ec) const
@@ -212,6 +231,24 @@ public:
     return ec;
   }
 
+  // Start an asynchronous close.
+  template <typename Handler, typename IoExecutor>
+  void async_close(implementation_type&,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    boost::system::error_code ec = boost::asio::error::operation_not_supported;
+    boost::asio::post(io_ex, detail::bind_handler(handler, ec));
+  }
+
+  // Start an asynchronous shutdown.
+  template <typename Handler, typename IoExecutor>
+  void async_shutdown(implementation_type&, socket_base::shutdown_type,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    boost::system::error_code ec = boost::asio::error::operation_not_supported;
+    boost::asio::post(io_ex, detail::bind_handler(handler, ec));
+  }
+
   // Bind the socket to the specified local endpoint.
   boost::system::error_code bind(implementation_type&,
       const endpoint_type&, boost::system::error_code& ec)
@@ -335,6 +372,15 @@ public:
           handler, ec, bytes_transferred));
   }
 
+  // Start an asynchronous receive of a stream of data.
+  template <typename DataHandler, typename Handler, typename IoExecutor>
+  void async_receive_many(implementation_type&, provided_buffer_pool&,
+      DataHandler&, Handler& handler, const IoExecutor& io_ex)
+  {
+    boost::system::error_code ec = boost::asio::error::operation_not_supported;
+    boost::asio::post(io_ex, detail::bind_handler(handler, ec));
+  }
+
   // Receive some data with associated flags. Returns the number of bytes
   // received.
   template <typename MutableBufferSequence>
@@ -492,6 +538,16 @@ public:
     boost::asio::post(io_ex, detail::bind_handler(handler, ec));
   }
 
+  // Start an asynchronous accept of a stream of connections.
+  template <typename PeerIoExecutor, typename ConnectionHandler,
+      typename Handler, typename IoExecutor>
+  void async_accept_many(implementation_type&, const PeerIoExecutor&,
+      ConnectionHandler&, Handler& handler, const IoExecutor& io_ex)
+  {
+    boost::system::error_code ec = boost::asio::error::operation_not_supported;
+    boost::asio::post(io_ex, detail::bind_handler(handler, ec));
+  }
+
   // Connect the socket to the specified endpoint.
   boost::system::error_code connect(implementation_type&,
       const endpoint_type&, boost::system::error_code& ec)
@@ -15,6 +15,7 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <new>
 #include <boost/asio/detail/noncopyable.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -41,12 +42,24 @@ public:
     return new Object(arg);
   }
 
+  template <typename Object, typename Arg>
+  static Object* construct(void* p, Arg arg)
+  {
+    return new (p) Object(arg);
+  }
+
   template <typename Object>
   static void destroy(Object* o)
   {
     delete o;
   }
 
+  template <typename Object>
+  static void destruct(Object* o)
+  {
+    o->~Object();
+  }
+
   template <typename Object>
   static Object*& next(Object* o)
   {
@@ -60,6 +60,26 @@ public:
     ::pthread_cond_broadcast(&cond_); // Ignore EINVAL.
   }
 
+  // Signal up to the specified number of waiters.
+  template <typename Lock>
+  void signal_many(Lock& lock, std::size_t n)
+  {
+    BOOST_ASIO_ASSERT(lock.locked());
+    (void)lock;
+    state_ |= 1;
+    std::size_t waiters = state_ >> 1;
+    if (n >= waiters)
+    {
+      if (waiters > 0)
+        ::pthread_cond_broadcast(&cond_); // Ignore EINVAL.
+    }
+    else
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        ::pthread_cond_signal(&cond_); // Ignore EINVAL.
+    }
+  }
+
   // Unlock the mutex and signal one waiter.
   template <typename Lock>
   void unlock_and_signal_one(Lock& lock)
@@ -24,6 +24,7 @@
 #include <boost/asio/error.hpp>
 #include <boost/asio/execution_context.hpp>
 #include <boost/asio/socket_base.hpp>
+#include <boost/asio/detail/accept_many_op.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/noncopyable.hpp>
@@ -171,6 +172,20 @@ public:
         option.level(impl.protocol_), option.name(impl.protocol_),
         option.data(impl.protocol_), option.size(impl.protocol_), ec);
 
+    // The reactor must change how the descriptor is registered.
+    if (!ec && option.level(impl.protocol_) == custom_socket_option_level
+        && option.name(impl.protocol_) == exclusive_wakeup_option)
+    {
+      bool value = (impl.state_ & socket_ops::exclusive_wakeup) != 0;
+      if (int err = reactor_.set_exclusive_wakeup(
+            impl.socket_, impl.reactor_data_, value))
+      {
+        ec = boost::system::error_code(err,
+            boost::asio::error::get_system_category());
+        impl.state_ ^= socket_ops::exclusive_wakeup;
+      }
+    }
+
     BOOST_ASIO_ERROR_LOCATION(ec);
     return ec;
   }
@@ -578,6 +593,20 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous accept of a stream of connections. Each accepted
+  // connection is passed to the connection handler, and the handler is invoked
+  // once no more connections will be accepted.
+  template <typename PeerIoExecutor, typename ConnectionHandler,
+      typename Handler, typename IoExecutor>
+  void async_accept_many(implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex, ConnectionHandler& connection_handler,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    accept_many_op<reactive_socket_service, PeerIoExecutor,
+      ConnectionHandler, Handler, IoExecutor>(*this, impl, peer_io_ex,
+        connection_handler, handler, io_ex).start();
+  }
+
   // Connect the socket to the specified endpoint.
   boost::system::error_code connect(implementation_type& impl,
       const endpoint_type& peer_endpoint, boost::system::error_code& ec)
@@ -28,14 +28,17 @@
 #include <boost/asio/execution_context.hpp>
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/reactive_null_buffers_op.hpp>
+#include <boost/asio/detail/receive_many_op.hpp>
 #include <boost/asio/detail/reactive_socket_recv_op.hpp>
 #include <boost/asio/detail/reactive_socket_recvmsg_op.hpp>
 #include <boost/asio/detail/reactive_socket_send_op.hpp>
 #include <boost/asio/detail/reactive_wait_op.hpp>
 #include <boost/asio/detail/reactor.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/socket_close_service.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
 #include <boost/asio/detail/socket_types.hpp>
@@ -110,6 +113,19 @@ public:
   BOOST_ASIO_DECL boost::system::error_code cancel(
       base_implementation_type& impl, boost::system::error_code& ec);
 
+  // Move the socket to the calling thread's own set of descriptors, if the
+  // reactor gives each thread its own.
+  BOOST_ASIO_DECL boost::system::error_code migrate(
+      base_implementation_type& impl, boost::system::error_code& ec);
+
+  // Get the number of speculative operations on the socket that completed at
+  // once, and the number that would have blocked.
+  void speculative_counts(const base_implementation_type& impl,
+      uint64_t& hits, uint64_t& misses) const
+  {
+    reactor_.speculative_counts(impl.reactor_data_, hits, misses);
+  }
+
   // Determine whether the socket is at the out-of-band data mark.
   bool at_mark(const base_implementation_type& impl,
       boost::system::error_code& ec) const
@@ -248,6 +264,70 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous close. The socket implementation is closed at once,
+  // and the descriptor is closed on a helper thread.
+  template <typename Handler, typename IoExecutor>
+  void async_close(base_implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    socket_close_service& close_service =
+      boost::asio::use_service<socket_close_service>(reactor_.context());
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef socket_close_op<Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, impl.state_,
+        close_service.scheduler(), handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_close"));
+
+    if (is_open(impl))
+    {
+      // The descriptor stays open until the helper thread closes it, so it
+      // must be removed from the reactor explicitly.
+      reactor_.deregister_descriptor(impl.socket_, impl.reactor_data_, false);
+      reactor_.cleanup_descriptor_data(impl.reactor_data_);
+      construct(impl);
+      close_service.start_close_op(p.p);
+    }
+    else
+    {
+      close_service.scheduler().post_immediate_completion(
+          p.p, is_continuation);
+    }
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous shutdown. A shutdown does not wait for the peer, and
+  // so it is performed immediately and only its completion is deferred.
+  template <typename Handler, typename IoExecutor>
+  void async_shutdown(base_implementation_type& impl,
+      socket_base::shutdown_type what, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef reactive_wait_op<Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(success_ec_, handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((reactor_.context(), *p.p, "socket",
+          &impl, impl.socket_, "async_shutdown"));
+
+    socket_ops::shutdown(impl.socket_, what, p.p->ec_);
+    start_op(impl, reactor::write_op, p.p,
+        is_continuation, false, true, false, &io_ex, 0);
+    p.v = p.p = 0;
+  }
+
   // Send the given data to the peer.
   template <typename ConstBufferSequence>
   size_t send(base_implementation_type& impl,
@@ -466,6 +546,18 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous receive of a stream of data. A buffer is taken from
+  // the pool each time data arrives, and is passed to the data handler.
+  template <typename DataHandler, typename Handler, typename IoExecutor>
+  void async_receive_many(base_implementation_type& impl,
+      provided_buffer_pool& pool, DataHandler& data_handler,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    receive_many_op<reactive_socket_service_base,
+      DataHandler, Handler, IoExecutor>(
+        *this, impl, pool, data_handler, handler, io_ex).start();
+  }
+
   // Receive some data with associated flags. Returns the number of bytes
   // received.
   template <typename MutableBufferSequence>
@@ -0,0 +1,180 @@
+//
+// detail/receive_many_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_RECEIVE_MANY_OP_HPP
+#define BOOST_ASIO_DETAIL_RECEIVE_MANY_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/associator.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/provided_buffer_pool.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/detail/handler_cont_helpers.hpp>
+#include <boost/system/error_code.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Receives a stream of data by waiting for the socket to become readable, and
+// only then taking a buffer from the pool to receive into. Used by socket
+// services that have no native way to select a buffer as data arrives. The
+// data handler is invoked before the next wait is started, so that data is
+// delivered in order.
+template <typename Service, typename DataHandler,
+    typename Handler, typename IoExecutor>
+class receive_many_op
+{
+public:
+  receive_many_op(Service& service,
+      typename Service::base_implementation_type& impl,
+      provided_buffer_pool& pool, DataHandler& data_handler,
+      Handler& handler, const IoExecutor& io_ex)
+    : service_(&service),
+      impl_(&impl),
+      pool_(&pool),
+      io_ex_(io_ex),
+      start_(1),
+      id_(0),
+      data_handler_(static_cast<DataHandler&&>(data_handler)),
+      handler_(static_cast<Handler&&>(handler))
+  {
+  }
+
+  receive_many_op(const receive_many_op& other)
+    : service_(other.service_),
+      impl_(other.impl_),
+      pool_(other.pool_),
+      io_ex_(other.io_ex_),
+      start_(other.start_),
+      id_(other.id_),
+      data_handler_(other.data_handler_),
+      handler_(other.handler_)
+  {
+  }
+
+  // The executor is copied rather than moved, as the operation is moved into
+  // the next wait or receive while it is still being used to start it.
+  receive_many_op(receive_many_op&& other)
+    : service_(other.service_),
+      impl_(other.impl_),
+      pool_(other.pool_),
+      io_ex_(other.io_ex_),
+      start_(other.start_),
+      id_(other.id_),
+      data_handler_(static_cast<DataHandler&&>(other.data_handler_)),
+      handler_(static_cast<Handler&&>(other.handler_))
+  {
+  }
+
+  // Start the first wait.
+  void start()
+  {
+    service_->async_wait(*impl_, socket_base::wait_read, *this, io_ex_);
+  }
+
+  // Called when the socket is ready to read.
+  void operator()(boost::system::error_code ec)
+  {
+    if (!ec)
+    {
+      if (provided_buffer_pool_access::acquire(*pool_, id_))
+      {
+        service_->async_receive(*impl_,
+            provided_buffer_pool_access::buffer(*pool_, id_),
+            0, *this, io_ex_);
+        return;
+      }
+      ec = boost::asio::error::no_buffer_space;
+    }
+
+    static_cast<Handler&&>(handler_)(ec);
+  }
+
+  // Called when data has been received into the buffer.
+  void operator()(boost::system::error_code ec, std::size_t bytes_transferred)
+  {
+    if (ec)
+    {
+      provided_buffer_pool_access::release(*pool_, id_);
+      static_cast<Handler&&>(handler_)(ec);
+      return;
+    }
+
+    start_ = 0;
+    data_handler_(provided_buffer_pool_access::lease(
+          *pool_, id_, bytes_transferred));
+    service_->async_wait(*impl_, socket_base::wait_read, *this, io_ex_);
+  }
+
+//private:
+  Service* service_;
+  typename Service::base_implementation_type* impl_;
+  provided_buffer_pool* pool_;
+  IoExecutor io_ex_;
+  int start_;
+  unsigned short id_;
+  DataHandler data_handler_;
+  Handler handler_;
+};
+
+template <typename Service, typename DataHandler,
+    typename Handler, typename IoExecutor>
+inline bool asio_handler_is_continuation(
+    receive_many_op<Service, DataHandler, Handler, IoExecutor>* this_handler)
+{
+  return this_handler->start_ == 0 ? true
+    : boost_asio_handler_cont_helpers::is_continuation(
+        this_handler->handler_);
+}
+
+} // namespace detail
+
+#if !defined(GENERATING_DOCUMENTATION)
+
+template <template <typename, typename> class Associator,
+    typename Service, typename DataHandler, typename Handler,
+    typename IoExecutor, typename DefaultCandidate>
+struct associator<Associator,
+    detail::receive_many_op<Service, DataHandler, Handler, IoExecutor>,
+    DefaultCandidate>
+  : Associator<Handler, DefaultCandidate>
+{
+  static typename Associator<Handler, DefaultCandidate>::type get(
+      const detail::receive_many_op<Service,
+        DataHandler, Handler, IoExecutor>& h) noexcept
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_);
+  }
+
+  static auto get(
+      const detail::receive_many_op<Service,
+        DataHandler, Handler, IoExecutor>& h,
+      const DefaultCandidate& c) noexcept
+    -> decltype(Associator<Handler, DefaultCandidate>::get(h.handler_, c))
+  {
+    return Associator<Handler, DefaultCandidate>::get(h.handler_, c);
+  }
+};
+
+#endif // !defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_RECEIVE_MANY_OP_HPP
@@ -18,15 +18,21 @@
 #include <boost/asio/detail/config.hpp>
 
 #include <boost/system/error_code.hpp>
+#include <boost/asio/context_metrics.hpp>
+#include <boost/asio/context_options.hpp>
 #include <boost/asio/execution_context.hpp>
 #include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/atomic_op_queue.hpp>
 #include <boost/asio/detail/conditionally_enabled_event.hpp>
 #include <boost/asio/detail/conditionally_enabled_mutex.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 #include <boost/asio/detail/scheduler_operation.hpp>
 #include <boost/asio/detail/scheduler_task.hpp>
+#include <boost/asio/detail/stealable_op_queue.hpp>
 #include <boost/asio/detail/thread.hpp>
 #include <boost/asio/detail/thread_context.hpp>
+#include <boost/asio/detail/thread_metrics.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
 
@@ -53,6 +59,12 @@ public:
       int concurrency_hint = 0, bool own_thread = true,
       get_task_func_type get_task = &scheduler::get_default_task);
 
+  // Constructor. Specifies the number of concurrent threads that are likely to
+  // run the scheduler, and additional options that control its behaviour.
+  BOOST_ASIO_DECL scheduler(boost::asio::execution_context& ctx,
+      int concurrency_hint, bool own_thread, const context_options& options,
+      get_task_func_type get_task = &scheduler::get_default_task);
+
   // Destructor.
   BOOST_ASIO_DECL ~scheduler();
 
@@ -120,6 +132,11 @@ public:
   BOOST_ASIO_DECL void post_immediate_completions(std::size_t n,
       op_queue<operation>& ops, bool is_continuation);
 
+  // Request invocation of the given operation ahead of (if high is true) or
+  // behind other queued operations, and return immediately. Assumes that
+  // work_started() has not yet been called for the operation.
+  BOOST_ASIO_DECL void post_prioritised_completion(operation* op, bool high);
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   BOOST_ASIO_DECL void post_deferred_completion(operation* op);
@@ -142,6 +159,26 @@ public:
     return concurrency_hint_;
   }
 
+  // Get the options that were used to initialise the scheduler.
+  const context_options& options() const
+  {
+    return options_;
+  }
+
+  // Get a snapshot of the scheduler's activity.
+  BOOST_ASIO_DECL context_metrics metrics() const;
+
+  // Whether each thread running the scheduler has its own instance of the
+  // task.
+  bool per_thread_tasks() const
+  {
+    return per_thread_tasks_;
+  }
+
+  // Get the calling thread's own instance of the task, or 0 if the thread is
+  // not running the scheduler or does not have one.
+  BOOST_ASIO_DECL void* current_local_task();
+
 private:
   // The mutex type used by this scheduler.
   typedef conditionally_enabled_mutex mutex;
@@ -156,6 +193,11 @@ private:
   BOOST_ASIO_DECL std::size_t do_run_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const boost::system::error_code& ec);
 
+  // Run the operations that the thread took from the shared queue along with
+  // the last operation it dequeued. Returns the number of operations run.
+  BOOST_ASIO_DECL std::size_t do_run_batch(mutex::scoped_lock& lock,
+      thread_info& this_thread, const boost::system::error_code& ec);
+
   // Run at most one operation with a timeout. May block.
   BOOST_ASIO_DECL std::size_t do_wait_one(mutex::scoped_lock& lock,
       thread_info& this_thread, long usec, const boost::system::error_code& ec);
@@ -164,6 +206,131 @@ private:
   BOOST_ASIO_DECL std::size_t do_poll_one(mutex::scoped_lock& lock,
       thread_info& this_thread, const boost::system::error_code& ec);
 
+  // Run at most one operation, preferring the thread's local queue and
+  // stealing from other threads when it is empty. May block.
+  BOOST_ASIO_DECL std::size_t do_run_one_stealing(mutex::scoped_lock& lock,
+      thread_info& this_thread, const boost::system::error_code& ec);
+
+  // Run operations using the thread's own instance of the task, until the
+  // limit is reached or there is nothing more to run. Returns the number of
+  // operations run.
+  BOOST_ASIO_DECL std::size_t run_local(thread_info& this_thread,
+      thread_info* outer_thread, long usec, std::size_t limit,
+      const boost::system::error_code& ec);
+
+  // Run at most one operation, preferring those completed by the thread's own
+  // instance of the task. Blocks for at most usec microseconds, unless usec
+  // is negative.
+  BOOST_ASIO_DECL std::size_t do_run_one_local(mutex::scoped_lock& lock,
+      thread_info& this_thread, long usec, const boost::system::error_code& ec);
+
+  // Give the thread its own instance of the task.
+  BOOST_ASIO_DECL void acquire_local_task(thread_info& this_thread);
+
+  // Move the operations completed by the thread's own instance of the task to
+  // the shared queue, and give the instance up.
+  BOOST_ASIO_DECL void release_local_task(thread_info& this_thread);
+
+  // Give the thread a local queue of operations that other threads may steal.
+  BOOST_ASIO_DECL void acquire_local_op_queue(thread_info& this_thread);
+
+  // Move operations out of the thread's local queue and give it up.
+  BOOST_ASIO_DECL void release_local_op_queue(thread_info& this_thread);
+
+  // Move as many operations as will fit on to the thread's local queue.
+  BOOST_ASIO_DECL void push_local_op_queue(
+      thread_info& this_thread, op_queue<operation>& ops);
+
+  // Steal an operation from another thread's local queue.
+  BOOST_ASIO_DECL operation* steal_operation(thread_info& this_thread);
+
+  // Enqueue an operation on to the calling thread's local queue, or on to the
+  // injection queue if called from outside the scheduler, without locking the
+  // mutex. Returns false if the operation must go on the shared queue.
+  BOOST_ASIO_DECL bool enqueue_lock_free(operation* op);
+
+  // Enqueue operations without locking the mutex. Returns false if any
+  // operations remain that must go on the shared queue.
+  BOOST_ASIO_DECL bool enqueue_lock_free(op_queue<operation>& ops);
+
+  // Send an operation to the task, using the task of the scheduler that the
+  // calling thread is running. Returns false if the operation cannot be sent.
+  BOOST_ASIO_DECL bool send_to_task(operation* op);
+
+  // Determine whether there are operations that were enqueued without locking
+  // the mutex, optionally including those on threads' local queues.
+  BOOST_ASIO_DECL bool has_lock_free_work(bool include_local_queues) const;
+
+  // Record that the calling thread is about to block. Must be called with the
+  // mutex locked. Returns false, without recording the thread as idle, if
+  // there are lock-free operations that it should run instead.
+  BOOST_ASIO_DECL bool begin_idle(bool include_local_queues);
+
+  // Wake an idle thread, or the task, if any threads are blocked.
+  BOOST_ASIO_DECL void wake_one_idle_thread();
+
+  // Record that the calling thread has no work to do. Must be called with the
+  // mutex locked. Returns true if the thread should spin, rather than block,
+  // while waiting for more work.
+  BOOST_ASIO_DECL bool begin_spin(thread_info& this_thread);
+
+  // Record that the calling thread has stopped waiting for work, either
+  // because it found some or because it is leaving the scheduler.
+  BOOST_ASIO_DECL void end_spin(thread_info& this_thread, bool found_work);
+
+  // Spin until more work may be available or the thread's spin budget is
+  // exhausted. Must be called with the mutex locked, which is released while
+  // spinning and locked again on return.
+  BOOST_ASIO_DECL void spin_wait(mutex::scoped_lock& lock,
+      thread_info& this_thread, bool include_local_queues);
+
+  // Get the current time, in nanoseconds, for spin accounting.
+  BOOST_ASIO_DECL static uint64_t spin_clock();
+
+  // Whether there are operations waiting in the high or low priority queues.
+  // Must be called with the mutex locked.
+  bool has_prioritised_operations() const
+  {
+    return !high_priority_op_queue_.empty()
+      || !low_priority_op_queue_.empty();
+  }
+
+  // Move the task to the front of the queue if handlers have used up the
+  // poll budget. Must be called with the mutex locked.
+  BOOST_ASIO_DECL void enforce_poll_budget();
+
+  // Whether handlers have used up the poll budget. May be called without the
+  // mutex locked.
+  BOOST_ASIO_DECL bool poll_budget_exhausted() const;
+
+  // Give the thread a set of counters to update, if metrics are collected.
+  BOOST_ASIO_DECL void acquire_thread_metrics(thread_info& this_thread);
+
+  // Record that an operation has been queued for execution.
+  BOOST_ASIO_DECL void record_enqueued(operation* op);
+
+  // Record that operations have been queued for execution.
+  BOOST_ASIO_DECL void record_enqueued(op_queue<operation>& ops);
+
+  // Complete an operation taken from a queue, recording how long it waited
+  // and ran if metrics are collected. May throw an exception.
+  BOOST_ASIO_DECL void complete_operation(thread_info& this_thread,
+      operation* o, const boost::system::error_code& ec,
+      std::size_t task_result);
+
+  // Run the task, adding its completed operations to the thread's private
+  // queue. May throw an exception.
+  BOOST_ASIO_DECL void run_task(thread_info& this_thread, long usec);
+
+  // Block until woken or, if usec is non-negative, until the timeout expires.
+  BOOST_ASIO_DECL void wait_for_wakeup(mutex::scoped_lock& lock,
+      thread_info& this_thread, long usec);
+
+  // Move the next high or low priority operation to the front of the queue,
+  // if it is due to run before the operation currently at the front. Must be
+  // called with the mutex locked.
+  BOOST_ASIO_DECL void promote_prioritised_operation();
+
   // Stop the task and all idle threads.
   BOOST_ASIO_DECL void stop_all_threads(mutex::scoped_lock& lock);
 
@@ -187,6 +354,35 @@ private:
   struct work_cleanup;
   friend struct work_cleanup;
 
+  // Helper class to return a thread's unrun batch to the queue on block exit.
+  struct batch_cleanup;
+  friend struct batch_cleanup;
+
+  // Helper class to give up a thread's local queue on block exit.
+  struct local_op_queue_cleanup;
+  friend struct local_op_queue_cleanup;
+
+  // Helper class to clear a thread's idle state on block exit.
+  struct idle_cleanup;
+  friend struct idle_cleanup;
+
+  // Helper class to give up a thread's own instance of the task on block exit.
+  struct local_task_cleanup;
+  friend struct local_task_cleanup;
+
+  // Helper class to stop a thread waiting in its own instance of the task on
+  // block exit.
+  struct local_idle_cleanup;
+  friend struct local_idle_cleanup;
+
+  // Helper class to give up a thread's counters on block exit.
+  struct thread_metrics_cleanup;
+  friend struct thread_metrics_cleanup;
+
+  // Helper class to clear a thread's spin state on block exit.
+  struct spin_cleanup;
+  friend struct spin_cleanup;
+
   // Whether to optimise for single-threaded use cases.
   const bool one_thread_;
 
@@ -228,6 +424,120 @@ private:
 
   // The thread that is running the scheduler.
   boost::asio::detail::thread* thread_;
+
+  // The options used to initialise the scheduler.
+  const context_options options_;
+
+  // Whether each thread running the scheduler has its own instance of the
+  // task, rather than taking turns to run a single one.
+  const bool per_thread_tasks_;
+
+  // The threads that are waiting in their own instance of the task.
+  thread_info* idle_local_threads_;
+
+  // Whether threads running the scheduler have local, stealable queues.
+  const bool work_stealing_;
+
+  // Whether operations enqueued from outside the scheduler bypass the mutex.
+  const bool lock_free_injection_;
+
+  // Copy of stopped_ that may be read without locking the mutex.
+  std::atomic<bool> lock_free_stopped_;
+
+  // Whether operations posted from threads running other schedulers are sent
+  // to the task by those schedulers' tasks.
+  const bool task_messages_;
+
+  // The task, if it may send and receive operations directly. May be read
+  // without locking the mutex.
+  std::atomic<scheduler_task*> message_task_;
+
+  // Copy of task_ that may be read without locking the mutex, so that the
+  // metrics can be scraped without contending with the running threads.
+  std::atomic<scheduler_task*> metrics_task_;
+
+  // The number of threads that are blocked waiting for work.
+  atomic_count idle_threads_;
+
+  // Operations enqueued from outside the scheduler without locking.
+  atomic_op_queue<operation> injection_queue_;
+
+  // The list of local queues used by threads in work-stealing mode.
+  std::atomic<stealable_op_queue<operation>*> local_op_queues_;
+
+  // The longest time, in nanoseconds, that an idle thread may spin. Threads
+  // that busy poll while idle have no limit.
+  const uint64_t spin_limit_;
+
+  // Whether the time that idle threads spin adapts to the arrival rate.
+  const bool adaptive_spin_;
+
+  // Moving average of the time, in nanoseconds, that threads wait for work.
+  std::atomic<uint64_t> average_wait_time_;
+
+  // The number of threads that are spinning rather than blocking.
+  atomic_count spinning_threads_;
+
+  // Incremented to tell spinning threads that work has been queued.
+  atomic_count spin_generation_;
+
+  // The most operations a thread running run() may dequeue at once.
+  const std::size_t batch_size_;
+
+  // The longest time, in nanoseconds, that a thread may spend on a batch.
+  const uint64_t batch_time_limit_;
+
+  // Operations submitted through executors with high or low priority.
+  op_queue<operation> high_priority_op_queue_;
+  op_queue<operation> low_priority_op_queue_;
+
+  // The most times that waiting operations may be passed over in favour of
+  // higher priority ones.
+  const std::size_t priority_starvation_limit_;
+
+  // The number of high priority operations run while other work waited.
+  std::size_t high_priority_run_;
+
+  // The number of times low priority operations have been passed over.
+  std::size_t low_priority_skips_;
+
+  // Whether high priority operations are waiting. May be read without locking
+  // the mutex, so that in work-stealing mode threads can look for them before
+  // taking handlers from the lock-free queues.
+  std::atomic<bool> high_priority_waiting_;
+
+  // The number of handlers that may run between polls of the task.
+  const std::size_t poll_budget_handlers_;
+
+  // The time, in nanoseconds, that handlers may run between polls of the
+  // task.
+  const uint64_t poll_budget_time_;
+
+  // The number of handlers run since the task was last polled.
+  std::atomic<std::size_t> handlers_since_poll_;
+
+  // The time at which the task was last polled.
+  std::atomic<uint64_t> last_poll_time_;
+
+  // Counters reported by metrics().
+  std::atomic<uint64_t> spin_count_;
+  std::atomic<uint64_t> spin_hits_;
+  std::atomic<uint64_t> spin_misses_;
+  std::atomic<uint64_t> spin_time_;
+  std::atomic<uint64_t> poll_budget_handler_hits_;
+  std::atomic<uint64_t> poll_budget_time_hits_;
+
+  // Whether the completions harvested by the task wake several threads.
+  const bool spread_reactor_completions_;
+
+  // Whether threads running the scheduler collect the counters below.
+  const bool collect_metrics_;
+
+  // The list of counters used by threads running the scheduler.
+  std::atomic<thread_metrics*> thread_metrics_;
+
+  // The number of operations queued by threads outside the scheduler.
+  std::atomic<uint64_t> external_enqueued_;
 };
 
 } // namespace detail
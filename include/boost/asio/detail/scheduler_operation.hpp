@@ -16,6 +16,7 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/system/error_code.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/handler_tracking.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 
@@ -53,7 +54,8 @@ protected:
   scheduler_operation(func_type func)
     : next_(0),
       func_(func),
-      task_result_(0)
+      task_result_(0),
+      enqueue_time_(0)
   {
   }
 
@@ -69,6 +71,7 @@ private:
 protected:
   friend class scheduler;
   unsigned int task_result_; // Passed into bytes transferred.
+  uint32_t enqueue_time_; // In microseconds, modulo 2^32. Zero if unknown.
 };
 
 } // namespace detail
@@ -15,6 +15,8 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <cstddef>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/op_queue.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -35,6 +37,56 @@ public:
   // Interrupt the task.
   virtual void interrupt() = 0;
 
+  // Get an instance of the task for the exclusive use of the calling thread.
+  // Returns 0 if the task does not support per-thread instances.
+  virtual void* acquire_local_task()
+  {
+    return 0;
+  }
+
+  // Give up an instance of the task obtained from acquire_local_task.
+  virtual void release_local_task(void*)
+  {
+  }
+
+  // Run a per-thread instance of the task once until interrupted or events
+  // are ready to be dispatched.
+  virtual void run_local_task(void*, long, op_queue<scheduler_operation>&)
+  {
+  }
+
+  // Interrupt a per-thread instance of the task.
+  virtual void interrupt_local_task(void*)
+  {
+  }
+
+  // Report the memory used for the state of registered descriptors.
+  virtual void descriptor_usage(std::size_t& descriptors,
+      std::size_t& bytes_per_descriptor, std::size_t& reserved_bytes) const
+  {
+    descriptors = 0;
+    bytes_per_descriptor = 0;
+    reserved_bytes = 0;
+  }
+
+  // Report the activity of the task's submission and completion queues.
+  virtual void ring_usage(uint64_t& cq_overflows, uint64_t& sq_full_flushes,
+      uint64_t& submits, uint64_t& submitted_entries) const
+  {
+    cq_overflows = 0;
+    sq_full_flushes = 0;
+    submits = 0;
+    submitted_entries = 0;
+  }
+
+  // Send an operation to another task of the same type, so that it is
+  // returned by that task's run(). Returns false if the operation cannot be
+  // sent, in which case the caller remains responsible for it.
+  virtual bool send_operation(scheduler_task&, scheduler_operation*)
+  {
+    return false;
+  }
+
 protected:
   // Prevent deletion through this type.
   ~scheduler_task()
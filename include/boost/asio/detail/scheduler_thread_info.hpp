@@ -15,7 +15,9 @@
 # pragma once
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/stealable_op_queue.hpp>
 #include <boost/asio/detail/thread_info_base.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -26,11 +28,41 @@ namespace detail {
 
 class scheduler;
 class scheduler_operation;
+class thread_metrics;
 
 struct scheduler_thread_info : public thread_info_base
 {
+  scheduler_thread_info()
+    : private_outstanding_work(0),
+      local_op_queue(0),
+      idle_start(0),
+      spin_deadline(0),
+      spinning(false),
+      batch_limit(1),
+      metrics(0),
+      local_task(0),
+      owns_local_task(false),
+      next_idle_local(0),
+      idle_local(false),
+      priority_bypasses(0)
+  {
+  }
+
   op_queue<scheduler_operation> private_op_queue;
   long private_outstanding_work;
+  stealable_op_queue<scheduler_operation>* local_op_queue;
+  uint64_t idle_start;
+  uint64_t spin_deadline;
+  bool spinning;
+  op_queue<scheduler_operation> batch_op_queue;
+  std::size_t batch_limit;
+  thread_metrics* metrics;
+  void* local_task;
+  bool owns_local_task;
+  op_queue<scheduler_operation> local_task_op_queue;
+  scheduler_thread_info* next_idle_local;
+  bool idle_local;
+  std::size_t priority_bypasses;
 };
 
 } // namespace detail
@@ -0,0 +1,285 @@
+//
+// detail/slab_object_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_SLAB_OBJECT_POOL_HPP
+#define BOOST_ASIO_DETAIL_SLAB_OBJECT_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/object_pool.hpp>
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <sys/mman.h>
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+#ifndef BOOST_ASIO_CACHE_LINE_SIZE
+# define BOOST_ASIO_CACHE_LINE_SIZE 64
+#endif // BOOST_ASIO_CACHE_LINE_SIZE
+
+#ifndef BOOST_ASIO_HUGE_PAGE_SIZE
+# define BOOST_ASIO_HUGE_PAGE_SIZE (2 * 1024 * 1024)
+#endif // BOOST_ASIO_HUGE_PAGE_SIZE
+
+// An object pool with the same interface as object_pool, but which carves its
+// objects out of large, cache-line-aligned slabs. Each object occupies a whole
+// number of cache lines, so that no two objects share a line. The slabs may
+// optionally be backed by huge pages.
+//
+// Like object_pool, the pool must be externally synchronised. The exception is
+// live_count() and reserved_bytes(), which may be read concurrently with
+// allocations, so that statistics can be gathered without taking the owner's
+// lock.
+template <typename Object>
+class slab_object_pool
+  : private noncopyable
+{
+public:
+  // Constructor.
+  slab_object_pool(std::size_t objects_per_slab, bool huge_pages)
+    : live_list_(0),
+      free_list_(0),
+      slabs_(0),
+      next_slot_(0),
+      end_slot_(0),
+      slab_size_(header_size + object_size
+          * (objects_per_slab > 0 ? objects_per_slab : 1)),
+      huge_pages_(huge_pages),
+      live_count_(0),
+      reserved_bytes_(0)
+  {
+    if (huge_pages_)
+    {
+      slab_size_ = (slab_size_ + BOOST_ASIO_HUGE_PAGE_SIZE - 1)
+        / BOOST_ASIO_HUGE_PAGE_SIZE * BOOST_ASIO_HUGE_PAGE_SIZE;
+    }
+  }
+
+  // Destructor destroys all objects and releases the slabs.
+  ~slab_object_pool()
+  {
+    destroy_list(live_list_);
+    destroy_list(free_list_);
+    while (slab_header* slab = slabs_)
+    {
+      slabs_ = slab->next_;
+      deallocate_slab(slab);
+    }
+  }
+
+  // The number of bytes occupied by each object.
+  static constexpr std::size_t object_size =
+    (sizeof(Object) + BOOST_ASIO_CACHE_LINE_SIZE - 1)
+      / BOOST_ASIO_CACHE_LINE_SIZE * BOOST_ASIO_CACHE_LINE_SIZE;
+
+  // Get the object at the start of the live list.
+  Object* first()
+  {
+    return live_list_;
+  }
+
+  // Get the number of live objects.
+  std::size_t live_count() const
+  {
+    return live_count_.load(std::memory_order_relaxed);
+  }
+
+  // Get the total number of bytes obtained for slabs.
+  std::size_t reserved_bytes() const
+  {
+    return reserved_bytes_.load(std::memory_order_relaxed);
+  }
+
+  // Allocate a new object with an argument.
+  template <typename Arg>
+  Object* alloc(Arg arg)
+  {
+    Object* o = free_list_;
+    if (o)
+      free_list_ = object_pool_access::next(free_list_);
+    else
+    {
+      if (next_slot_ == end_slot_)
+        add_slab();
+      o = object_pool_access::construct<Object>(next_slot_, arg);
+      next_slot_ += object_size;
+    }
+
+    object_pool_access::next(o) = live_list_;
+    object_pool_access::prev(o) = 0;
+    if (live_list_)
+      object_pool_access::prev(live_list_) = o;
+    live_list_ = o;
+    add(live_count_, 1);
+
+    return o;
+  }
+
+  // Free an object. Moves it to the free list. No destructors are run.
+  void free(Object* o)
+  {
+    if (live_list_ == o)
+      live_list_ = object_pool_access::next(o);
+
+    if (object_pool_access::prev(o))
+    {
+      object_pool_access::next(object_pool_access::prev(o))
+        = object_pool_access::next(o);
+    }
+
+    if (object_pool_access::next(o))
+    {
+      object_pool_access::prev(object_pool_access::next(o))
+        = object_pool_access::prev(o);
+    }
+
+    object_pool_access::next(o) = free_list_;
+    object_pool_access::prev(o) = 0;
+    free_list_ = o;
+    add(live_count_, static_cast<std::size_t>(-1));
+  }
+
+private:
+  // The bookkeeping stored at the start of each slab.
+  struct slab_header
+  {
+    slab_header* next_;
+    std::size_t size_;
+    bool mapped_;
+  };
+
+  // The space reserved for the header, so that objects start on a new line.
+  static constexpr std::size_t header_size =
+    (sizeof(slab_header) + BOOST_ASIO_CACHE_LINE_SIZE - 1)
+      / BOOST_ASIO_CACHE_LINE_SIZE * BOOST_ASIO_CACHE_LINE_SIZE;
+
+  // Update a counter. There is only ever one writer at a time, so a plain
+  // store suffices and the counter only needs to be atomic for its readers.
+  static void add(std::atomic<std::size_t>& counter, std::size_t n)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+        std::memory_order_relaxed);
+  }
+
+  // Helper function to destroy all elements in a list.
+  void destroy_list(Object* list)
+  {
+    while (list)
+    {
+      Object* o = list;
+      list = object_pool_access::next(o);
+      object_pool_access::destruct(o);
+    }
+  }
+
+  // Obtain a new slab and make its slots available for allocation.
+  void add_slab()
+  {
+    void* p = 0;
+    bool mapped = false;
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    if (huge_pages_)
+    {
+# if defined(MAP_HUGETLB)
+      p = ::mmap(0, slab_size_, PROT_READ | PROT_WRITE,
+          MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (p == MAP_FAILED)
+# endif // defined(MAP_HUGETLB)
+      {
+        // Fall back to ordinary pages, which the kernel may still merge into
+        // transparent huge pages.
+        p = ::mmap(0, slab_size_, PROT_READ | PROT_WRITE,
+            MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+# if defined(MADV_HUGEPAGE)
+        if (p != MAP_FAILED)
+          ::madvise(p, slab_size_, MADV_HUGEPAGE);
+# endif // defined(MADV_HUGEPAGE)
+      }
+      if (p == MAP_FAILED)
+        p = 0;
+      mapped = (p != 0);
+    }
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+    if (!p)
+      p = boost::asio::aligned_new(BOOST_ASIO_CACHE_LINE_SIZE, slab_size_);
+
+    slab_header* slab = static_cast<slab_header*>(p);
+    slab->next_ = slabs_;
+    slab->size_ = slab_size_;
+    slab->mapped_ = mapped;
+    slabs_ = slab;
+    add(reserved_bytes_, slab_size_);
+
+    unsigned char* base = static_cast<unsigned char*>(p);
+    next_slot_ = base + header_size;
+    end_slot_ = base + header_size
+      + (slab_size_ - header_size) / object_size * object_size;
+  }
+
+  // Release a slab obtained by add_slab.
+  static void deallocate_slab(slab_header* slab)
+  {
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    if (slab->mapped_)
+    {
+      ::munmap(slab, slab->size_);
+      return;
+    }
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+    boost::asio::aligned_delete(slab);
+  }
+
+  // The list of live objects.
+  Object* live_list_;
+
+  // The free list.
+  Object* free_list_;
+
+  // The list of slabs.
+  slab_header* slabs_;
+
+  // The unused part of the most recently added slab.
+  unsigned char* next_slot_;
+  unsigned char* end_slot_;
+
+  // The size of each slab, in bytes.
+  std::size_t slab_size_;
+
+  // Whether slabs should be backed by huge pages.
+  const bool huge_pages_;
+
+  // The number of live objects.
+  std::atomic<std::size_t> live_count_;
+
+  // The total size of all slabs, in bytes.
+  std::atomic<std::size_t> reserved_bytes_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_SLAB_OBJECT_POOL_HPP
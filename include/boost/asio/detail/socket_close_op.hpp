@@ -0,0 +1,167 @@
+//
+// detail/socket_close_op.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_SOCKET_CLOSE_OP_HPP
+#define BOOST_ASIO_DETAIL_SOCKET_CLOSE_OP_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/detail/bind_handler.hpp>
+#include <boost/asio/detail/fenced_block.hpp>
+#include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/handler_work.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/operation.hpp>
+#include <boost/asio/detail/socket_ops.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+
+#if defined(BOOST_ASIO_HAS_IOCP)
+# include <boost/asio/detail/win_iocp_io_context.hpp>
+#else // defined(BOOST_ASIO_HAS_IOCP)
+# include <boost/asio/detail/scheduler.hpp>
+#endif // defined(BOOST_ASIO_HAS_IOCP)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+class socket_close_op_base : public operation
+{
+public:
+  // The error code to be passed to the completion handler.
+  boost::system::error_code ec_;
+
+  // Close the socket. The close may block if the socket has been set to
+  // linger.
+  void perform()
+  {
+    socket_ops::close(socket_, state_, false, ec_);
+    socket_ = invalid_socket;
+  }
+
+protected:
+  socket_close_op_base(socket_type socket,
+      socket_ops::state_type state, func_type complete_func)
+    : operation(complete_func),
+      socket_(socket),
+      state_(state)
+  {
+  }
+
+  // A socket that is never closed by perform() must still not be leaked, but
+  // it is closed without lingering, as when a socket object is destroyed.
+  ~socket_close_op_base()
+  {
+    if (socket_ != invalid_socket)
+    {
+      boost::system::error_code ignored_ec;
+      socket_ops::close(socket_, state_, true, ignored_ec);
+    }
+  }
+
+private:
+  socket_type socket_;
+  socket_ops::state_type state_;
+};
+
+template <typename Handler, typename IoExecutor>
+class socket_close_op : public socket_close_op_base
+{
+public:
+  BOOST_ASIO_DEFINE_HANDLER_PTR(socket_close_op);
+
+#if defined(BOOST_ASIO_HAS_IOCP)
+  typedef class win_iocp_io_context scheduler_impl;
+#else
+  typedef class scheduler scheduler_impl;
+#endif
+
+  socket_close_op(socket_type socket, socket_ops::state_type state,
+      scheduler_impl& sched, Handler& handler, const IoExecutor& io_ex)
+    : socket_close_op_base(socket, state, &socket_close_op::do_complete),
+      scheduler_(sched),
+      handler_(static_cast<Handler&&>(handler)),
+      work_(handler_, io_ex)
+  {
+  }
+
+  static void do_complete(void* owner, operation* base,
+      const boost::system::error_code& /*ec*/,
+      std::size_t /*bytes_transferred*/)
+  {
+    // Take ownership of the operation object.
+    BOOST_ASIO_ASSUME(base != 0);
+    socket_close_op* o(static_cast<socket_close_op*>(base));
+    ptr p = { boost::asio::detail::addressof(o->handler_), o, o };
+
+    if (owner && owner != &o->scheduler_)
+    {
+      // The operation is being run on the helper thread. Time to close the
+      // socket.
+      o->perform();
+
+      // Pass operation back to main scheduler for completion.
+      o->scheduler_.post_deferred_completion(o);
+      p.v = p.p = 0;
+    }
+    else
+    {
+      // The operation has been returned to the main scheduler. The completion
+      // handler is ready to be delivered.
+
+      BOOST_ASIO_HANDLER_COMPLETION((*o));
+
+      // Take ownership of the operation's outstanding work.
+      handler_work<Handler, IoExecutor> w(
+          static_cast<handler_work<Handler, IoExecutor>&&>(
+            o->work_));
+
+      BOOST_ASIO_ERROR_LOCATION(o->ec_);
+
+      // Make a copy of the handler so that the memory can be deallocated
+      // before the upcall is made. Even if we're not about to make an upcall,
+      // a sub-object of the handler may be the true owner of the memory
+      // associated with the handler. Consequently, a local copy of the handler
+      // is required to ensure that any owning sub-object remains valid until
+      // after we have deallocated the memory here.
+      detail::binder1<Handler, boost::system::error_code>
+        handler(o->handler_, o->ec_);
+      p.h = boost::asio::detail::addressof(handler.handler_);
+      p.reset();
+
+      if (owner)
+      {
+        fenced_block b(fenced_block::half);
+        BOOST_ASIO_HANDLER_INVOCATION_BEGIN((handler.arg1_));
+        w.complete(handler, handler.handler_);
+        BOOST_ASIO_HANDLER_INVOCATION_END;
+      }
+    }
+  }
+
+private:
+  scheduler_impl& scheduler_;
+  Handler handler_;
+  handler_work<Handler, IoExecutor> work_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_SOCKET_CLOSE_OP_HPP
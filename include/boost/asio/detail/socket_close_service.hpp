@@ -0,0 +1,103 @@
+//
+// detail/socket_close_service.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_SOCKET_CLOSE_SERVICE_HPP
+#define BOOST_ASIO_DETAIL_SOCKET_CLOSE_SERVICE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/scoped_ptr.hpp>
+#include <boost/asio/detail/socket_close_op.hpp>
+#include <boost/asio/detail/thread.hpp>
+
+#if defined(BOOST_ASIO_HAS_IOCP)
+# include <boost/asio/detail/win_iocp_io_context.hpp>
+#else // defined(BOOST_ASIO_HAS_IOCP)
+# include <boost/asio/detail/scheduler.hpp>
+#endif // defined(BOOST_ASIO_HAS_IOCP)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Closes sockets on a helper thread, so that a close that lingers does not
+// block a thread running the execution context.
+class socket_close_service
+  : public execution_context_service_base<socket_close_service>
+{
+public:
+  // The scheduler implementation used to post completions.
+#if defined(BOOST_ASIO_HAS_IOCP)
+  typedef class win_iocp_io_context scheduler_impl;
+#else
+  typedef class scheduler scheduler_impl;
+#endif
+
+  // Constructor.
+  BOOST_ASIO_DECL socket_close_service(execution_context& context);
+
+  // Destructor.
+  BOOST_ASIO_DECL ~socket_close_service();
+
+  // Destroy all user-defined handler objects owned by the service.
+  BOOST_ASIO_DECL void shutdown();
+
+  // Perform any fork-related housekeeping.
+  BOOST_ASIO_DECL void notify_fork(execution_context::fork_event fork_ev);
+
+  // Get the scheduler used to deliver completions.
+  scheduler_impl& scheduler()
+  {
+    return scheduler_;
+  }
+
+  // Start an operation that closes a socket. The socket is closed on the
+  // helper thread, unless the scheduler is not used by more than one thread,
+  // in which case it is closed immediately.
+  BOOST_ASIO_DECL void start_close_op(socket_close_op_base* op);
+
+private:
+  // Helper class to run the work scheduler in a thread.
+  class work_scheduler_runner;
+
+  // Start the work scheduler if it's not already running.
+  BOOST_ASIO_DECL void start_work_thread();
+
+  // The scheduler used to post completions.
+  scheduler_impl& scheduler_;
+
+  // Mutex to protect access to internal data.
+  boost::asio::detail::mutex mutex_;
+
+  // Private scheduler used for closing sockets.
+  boost::asio::detail::scoped_ptr<scheduler_impl> work_scheduler_;
+
+  // Thread used for running the work scheduler's run loop.
+  boost::asio::detail::scoped_ptr<boost::asio::detail::thread> work_thread_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/detail/impl/socket_close_service.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_DETAIL_SOCKET_CLOSE_SERVICE_HPP
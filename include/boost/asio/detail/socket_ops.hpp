@@ -53,7 +53,10 @@ enum
   datagram_oriented = 32,
 
   // The socket may have been dup()-ed.
-  possible_dup = 64
+  possible_dup = 64,
+
+  // User wants only one waiting reactor to wake when the socket is ready.
+  exclusive_wakeup = 128
 };
 
 typedef unsigned char state_type;
@@ -419,6 +419,7 @@ const int max_iov_len = 16;
 const int custom_socket_option_level = 0xA5100000;
 const int enable_connection_aborted_option = 1;
 const int always_fail_option = 2;
+const int exclusive_wakeup_option = 3;
 
 } // namespace detail
 } // namespace asio
@@ -59,6 +59,26 @@ public:
     cond_.notify_all();
   }
 
+  // Signal up to the specified number of waiters.
+  template <typename Lock>
+  void signal_many(Lock& lock, std::size_t n)
+  {
+    BOOST_ASIO_ASSERT(lock.locked());
+    (void)lock;
+    state_ |= 1;
+    std::size_t waiters = state_ >> 1;
+    if (n >= waiters)
+    {
+      if (waiters > 0)
+        cond_.notify_all();
+    }
+    else
+    {
+      for (std::size_t i = 0; i < n; ++i)
+        cond_.notify_one();
+    }
+  }
+
   // Unlock the mutex and signal one waiter.
   template <typename Lock>
   void unlock_and_signal_one(Lock& lock)
@@ -0,0 +1,161 @@
+//
+// detail/stealable_op_queue.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_STEALABLE_OP_QUEUE_HPP
+#define BOOST_ASIO_DETAIL_STEALABLE_OP_QUEUE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A bounded queue of operations that belongs to a single thread at a time.
+// Only the owning thread may push operations on to the back of the queue, but
+// any thread may pop operations from the front. Operations are not destroyed
+// by the queue, so it must be emptied by its owner before it is released.
+template <typename Operation>
+class stealable_op_queue
+  : private noncopyable
+{
+public:
+  // Constructor. The capacity is rounded up to a power of two.
+  explicit stealable_op_queue(std::size_t capacity)
+    : buffer_(0),
+      mask_(0),
+      top_(0),
+      bottom_(0),
+      owned_(false),
+      next_(0)
+  {
+    std::size_t size = 2;
+    while (size < capacity && size < (std::size_t(1) << 30))
+      size <<= 1;
+    buffer_ = new std::atomic<Operation*>[size];
+    mask_ = size - 1;
+  }
+
+  // Destructor.
+  ~stealable_op_queue()
+  {
+    delete[] buffer_;
+  }
+
+  // Attempt to take ownership of the queue.
+  bool try_acquire()
+  {
+    bool expected = false;
+    return owned_.compare_exchange_strong(expected, true,
+        std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  // Give up ownership of the queue.
+  void release()
+  {
+    owned_.store(false, std::memory_order_release);
+  }
+
+  // Push an operation on to the back of the queue. Must only be called by the
+  // owning thread. Returns false if the queue is full.
+  bool push(Operation* h)
+  {
+    std::size_t bottom = bottom_.load(std::memory_order_relaxed);
+    std::size_t top = top_.load(std::memory_order_acquire);
+    if (bottom - top > mask_)
+      return false;
+    buffer_[bottom & mask_].store(h, std::memory_order_relaxed);
+    bottom_.store(bottom + 1, std::memory_order_release);
+    return true;
+  }
+
+  // Pop an operation from the front of the queue. May be called from any
+  // thread. Returns 0 if the queue is empty.
+  Operation* pop()
+  {
+    std::size_t top = top_.load(std::memory_order_acquire);
+    for (;;)
+    {
+      std::size_t bottom = bottom_.load(std::memory_order_acquire);
+      if (bottom == top)
+        return 0;
+
+      // The slot may be overwritten by the owner once another thread has
+      // advanced the top of the queue, but in that case the exchange fails.
+      Operation* h = buffer_[top & mask_].load(std::memory_order_relaxed);
+      if (top_.compare_exchange_weak(top, top + 1,
+            std::memory_order_acq_rel, std::memory_order_acquire))
+        return h;
+    }
+  }
+
+  // Whether the queue is full. When called by the owning thread, a false
+  // result guarantees that the next push will succeed.
+  bool full() const
+  {
+    return bottom_.load(std::memory_order_relaxed)
+      - top_.load(std::memory_order_acquire) > mask_;
+  }
+
+  // Whether the queue is empty.
+  bool empty() const
+  {
+    return bottom_.load(std::memory_order_acquire)
+      == top_.load(std::memory_order_acquire);
+  }
+
+  // Get the next queue in the owning scheduler's list of queues.
+  stealable_op_queue* next() const
+  {
+    return next_;
+  }
+
+  // Set the next queue in the owning scheduler's list of queues. Must be
+  // called before the queue is made visible to other threads.
+  void next(stealable_op_queue* q)
+  {
+    next_ = q;
+  }
+
+private:
+  // The ring buffer of operations.
+  std::atomic<Operation*>* buffer_;
+
+  // Mask used to map positions to ring buffer slots.
+  std::size_t mask_;
+
+  // The position of the front of the queue.
+  std::atomic<std::size_t> top_;
+
+  // The position of the back of the queue.
+  std::atomic<std::size_t> bottom_;
+
+  // Whether the queue is currently owned by a thread.
+  std::atomic<bool> owned_;
+
+  // The next queue in the owning scheduler's list of queues.
+  stealable_op_queue* next_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_STEALABLE_OP_QUEUE_HPP
@@ -103,8 +103,9 @@ public:
   enum { max_mem_index = timed_cancel_tag::end_mem_index };
 
   thread_info_base()
+    : memory_node_(unknown_node)
 #if !defined(BOOST_ASIO_NO_EXCEPTIONS)
-    : has_pending_exception_(0)
+    , has_pending_exception_(0)
 #endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
   {
     for (int i = 0; i < max_mem_index; ++i)
@@ -123,6 +124,14 @@ public:
     }
   }
 
+  // Set the NUMA node on which the thread allocates memory. Recycled memory
+  // that was allocated on another node is not kept in the thread's cache.
+  void memory_node(std::size_t node)
+  {
+    memory_node_ = static_cast<unsigned char>(
+        node < unknown_node ? node : std::size_t(unknown_node));
+  }
+
   static void* allocate(thread_info_base* this_thread,
       std::size_t size, std::size_t align = BOOST_ASIO_DEFAULT_ALIGN)
   {
@@ -173,9 +182,13 @@ public:
       }
     }
 
-    void* const pointer = aligned_new(align, chunks * chunk_size + 1);
+    // The byte after the chunks records the size, and the one after that the
+    // node on which the memory was allocated.
+    void* const pointer = aligned_new(align, chunks * chunk_size + 2);
     unsigned char* const mem = static_cast<unsigned char*>(pointer);
     mem[size] = (chunks <= UCHAR_MAX) ? static_cast<unsigned char>(chunks) : 0;
+    mem[chunks * chunk_size + 1] = this_thread
+      ? this_thread->memory_node_ : static_cast<unsigned char>(unknown_node);
     return pointer;
   }
 
@@ -185,14 +198,15 @@ public:
   {
     if (size <= chunk_size * UCHAR_MAX)
     {
-      if (this_thread)
+      unsigned char* const mem = static_cast<unsigned char*>(pointer);
+      if (this_thread && mem[mem[size] * chunk_size + 1]
+          == this_thread->memory_node_)
       {
         for (int mem_index = Purpose::begin_mem_index;
             mem_index < Purpose::end_mem_index; ++mem_index)
         {
           if (this_thread->reusable_memory_[mem_index] == 0)
           {
-            unsigned char* const mem = static_cast<unsigned char*>(pointer);
             mem[0] = mem[size];
             this_thread->reusable_memory_[mem_index] = pointer;
             return;
@@ -245,7 +259,9 @@ private:
 #else // defined(BOOST_ASIO_HAS_IO_URING)
   enum { chunk_size = 4 };
 #endif // defined(BOOST_ASIO_HAS_IO_URING)
+  enum { unknown_node = UCHAR_MAX };
   void* reusable_memory_[max_mem_index];
+  unsigned char memory_node_;
 
 #if !defined(BOOST_ASIO_NO_EXCEPTIONS)
   int has_pending_exception_;
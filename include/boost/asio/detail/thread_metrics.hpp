@@ -0,0 +1,192 @@
+//
+// detail/thread_metrics.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_THREAD_METRICS_HPP
+#define BOOST_ASIO_DETAIL_THREAD_METRICS_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+#include <boost/asio/context_metrics.hpp>
+#include <boost/asio/detail/cstdint.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// Counters kept by a thread that is running a scheduler. A set of counters
+// belongs to a single thread at a time, and only the owning thread updates
+// them, so that updates need no read-modify-write operations. Any thread may
+// read the counters at any time.
+class thread_metrics
+  : private noncopyable
+{
+public:
+  enum { histogram_buckets = context_metrics::histogram_buckets };
+
+  // Constructor.
+  thread_metrics()
+    : enqueued_(0),
+      handlers_run_(0),
+      busy_time_(0),
+      idle_time_(0),
+      reactor_polls_(0),
+      reactor_events_(0),
+      owned_(false),
+      next_(0)
+  {
+    for (int i = 0; i < histogram_buckets; ++i)
+    {
+      queue_wait_histogram_[i].store(0, std::memory_order_relaxed);
+      poll_events_histogram_[i].store(0, std::memory_order_relaxed);
+    }
+  }
+
+  // Attempt to take ownership of the counters.
+  bool try_acquire()
+  {
+    bool expected = false;
+    return owned_.compare_exchange_strong(expected, true,
+        std::memory_order_acquire, std::memory_order_relaxed);
+  }
+
+  // Give up ownership of the counters.
+  void release()
+  {
+    owned_.store(false, std::memory_order_release);
+  }
+
+  // Record that operations were added to the scheduler's queues.
+  void operations_enqueued(uint64_t n)
+  {
+    add(enqueued_, n);
+  }
+
+  // Record that a handler is about to be run after waiting in the queue for
+  // the specified number of microseconds.
+  void handler_started(uint64_t wait_usec)
+  {
+    add(handlers_run_, 1);
+    add(queue_wait_histogram_[bucket(wait_usec)], 1);
+  }
+
+  // Record that a handler is about to be run after waiting for an unknown
+  // time.
+  void handler_started()
+  {
+    add(handlers_run_, 1);
+  }
+
+  // Record the time spent running a handler.
+  void handler_finished(uint64_t busy_nsec)
+  {
+    add(busy_time_, busy_nsec);
+  }
+
+  // Record the time spent blocked waiting for work.
+  void idle(uint64_t idle_nsec)
+  {
+    add(idle_time_, idle_nsec);
+  }
+
+  // Record a poll of the reactor and the number of events it returned.
+  void reactor_polled(uint64_t events)
+  {
+    add(reactor_polls_, 1);
+    add(reactor_events_, events);
+    add(poll_events_histogram_[bucket(events)], 1);
+  }
+
+  // Add the counters to a snapshot.
+  void merge_into(context_metrics& m) const
+  {
+    m.enqueued_ += enqueued_.load(std::memory_order_relaxed);
+    m.handlers_run_ += handlers_run_.load(std::memory_order_relaxed);
+    m.busy_time_ += load_nsec(busy_time_);
+    m.idle_time_ += load_nsec(idle_time_);
+    m.reactor_polls_ += reactor_polls_.load(std::memory_order_relaxed);
+    m.reactor_events_ += reactor_events_.load(std::memory_order_relaxed);
+    for (int i = 0; i < histogram_buckets; ++i)
+    {
+      m.queue_wait_histogram_[i] +=
+        queue_wait_histogram_[i].load(std::memory_order_relaxed);
+      m.poll_events_histogram_[i] +=
+        poll_events_histogram_[i].load(std::memory_order_relaxed);
+    }
+
+    context_metrics::thread_times t;
+    t.busy = load_nsec(busy_time_);
+    t.idle = load_nsec(idle_time_);
+    m.threads_.push_back(t);
+  }
+
+  // Get the next set of counters in the scheduler's list.
+  thread_metrics* next() const
+  {
+    return next_;
+  }
+
+  // Set the next set of counters in the scheduler's list.
+  void next(thread_metrics* n)
+  {
+    next_ = n;
+  }
+
+private:
+  static void add(std::atomic<uint64_t>& counter, uint64_t n)
+  {
+    counter.store(counter.load(std::memory_order_relaxed) + n,
+        std::memory_order_relaxed);
+  }
+
+  static chrono::nanoseconds load_nsec(const std::atomic<uint64_t>& counter)
+  {
+    return chrono::nanoseconds(static_cast<chrono::nanoseconds::rep>(
+          counter.load(std::memory_order_relaxed)));
+  }
+
+  // Values in [2^(i-1), 2^i) go in bucket i. The last bucket is unbounded.
+  static std::size_t bucket(uint64_t value)
+  {
+    std::size_t i = 0;
+    while (value && i < histogram_buckets - 1)
+    {
+      value >>= 1;
+      ++i;
+    }
+    return i;
+  }
+
+  std::atomic<uint64_t> enqueued_;
+  std::atomic<uint64_t> handlers_run_;
+  std::atomic<uint64_t> busy_time_;
+  std::atomic<uint64_t> idle_time_;
+  std::atomic<uint64_t> reactor_polls_;
+  std::atomic<uint64_t> reactor_events_;
+  std::atomic<uint64_t> queue_wait_histogram_[histogram_buckets];
+  std::atomic<uint64_t> poll_events_histogram_[histogram_buckets];
+  std::atomic<bool> owned_;
+  thread_metrics* next_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_THREAD_METRICS_HPP
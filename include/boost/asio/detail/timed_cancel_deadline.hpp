@@ -0,0 +1,88 @@
+//
+// detail/timed_cancel_deadline.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_DETAIL_TIMED_CANCEL_DEADLINE_HPP
+#define BOOST_ASIO_DETAIL_TIMED_CANCEL_DEADLINE_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/chrono.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+namespace detail {
+
+// A deadline offered by a timed cancellation to the operation that it starts.
+// Before the operation can complete, it must either claim the deadline, and
+// then cancel itself when the deadline expires, or decline it, in which case
+// the timed cancellation arms its timer.
+class timed_cancel_deadline
+{
+public:
+  typedef void (*resolve_func_type)(void*, chrono::nanoseconds*);
+
+  timed_cancel_deadline()
+    : owner_(0),
+      resolve_func_(0)
+  {
+  }
+
+  timed_cancel_deadline(void* owner, resolve_func_type resolve_func)
+    : owner_(owner),
+      resolve_func_(resolve_func)
+  {
+  }
+
+  // Whether a deadline has been offered and not yet claimed or declined.
+  bool is_offered() const
+  {
+    return owner_ != 0;
+  }
+
+  // Claim the deadline, obtaining the time remaining until it expires.
+  // Returns false if no deadline was offered.
+  bool claim(chrono::nanoseconds& timeout)
+  {
+    if (!owner_)
+      return false;
+    void* owner = owner_;
+    owner_ = 0;
+    resolve_func_(owner, &timeout);
+    return true;
+  }
+
+  // Decline the deadline, if one was offered, so that the timer is used.
+  void decline()
+  {
+    if (owner_)
+    {
+      void* owner = owner_;
+      owner_ = 0;
+      resolve_func_(owner, 0);
+    }
+  }
+
+private:
+  void* owner_;
+  resolve_func_type resolve_func_;
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_DETAIL_TIMED_CANCEL_DEADLINE_HPP
@@ -21,9 +21,11 @@
 #include <boost/asio/basic_waitable_timer.hpp>
 #include <boost/asio/cancellation_signal.hpp>
 #include <boost/asio/detail/atomic_count.hpp>
+#include <boost/asio/detail/chrono.hpp>
 #include <boost/asio/detail/completion_payload.hpp>
 #include <boost/asio/detail/completion_payload_handler.hpp>
 #include <boost/asio/detail/handler_alloc_helpers.hpp>
+#include <boost/asio/detail/timed_cancel_deadline.hpp>
 #include <boost/asio/detail/type_traits.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -38,6 +40,24 @@ class timed_cancel_op_handler;
 template <typename Op>
 class timed_cancel_timer_handler;
 
+// Initiations whose operations are able to cancel themselves at a deadline,
+// without the timer, declare the nested type accepts_timed_cancel_deadline.
+// Only the io_uring backend does so. The deadline is offered to the operation
+// before it is started, and the operation then either claims the deadline or
+// declines it. The timer is armed only if the deadline is declined.
+template <typename T, typename = void>
+struct accepts_timed_cancel_deadline : false_type
+{
+};
+
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+template <typename T>
+struct accepts_timed_cancel_deadline<T,
+    void_t<typename T::accepts_timed_cancel_deadline>> : true_type
+{
+};
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
 template <typename Handler, typename Timer, typename... Signatures>
 class timed_cancel_op
 {
@@ -55,7 +75,8 @@ public:
       cancellation_type_(cancel_type),
       cancel_proxy_(nullptr),
       has_payload_(false),
-      has_pending_timer_wait_(true)
+      has_pending_timer_wait_(true),
+      deadline_offered_(false)
   {
   }
 
@@ -86,16 +107,75 @@ public:
     if (slot.is_connected())
       cancel_proxy_ = &slot.template emplace<cancel_proxy>(this);
 
-    timer_.async_wait(static_cast<timer_handler_type&&>(timer_handler));
+    deadline_offered_ = accepts_timed_cancel_deadline<
+        decay_t<Initiation>>::value && (cancellation_type_
+          & (cancellation_type::terminal | cancellation_type::partial
+            | cancellation_type::total)) != cancellation_type::none;
+
+    // An offered deadline takes over the timer's reference to the state.
+    if (deadline_offered_)
+      timer_handler.op_ = nullptr;
+    else
+      timer_.async_wait(static_cast<timer_handler_type&&>(timer_handler));
+
     async_initiate<op_handler_type, Signatures...>(
         static_cast<Initiation&&>(initiation),
         static_cast<op_handler_type&>(op_handler),
         static_cast<Args&&>(args)...);
   }
 
+  // Take the deadline offered to the operation being started. The operation
+  // must claim or decline the deadline before it completes.
+  timed_cancel_deadline take_deadline()
+  {
+    if (!deadline_offered_)
+      return timed_cancel_deadline();
+    deadline_offered_ = false;
+    return timed_cancel_deadline(this, &timed_cancel_op::resolve_deadline);
+  }
+
+  static void resolve_deadline(void* owner, chrono::nanoseconds* timeout)
+  {
+    timed_cancel_op* o = static_cast<timed_cancel_op*>(owner);
+    if (timeout)
+    {
+      typedef typename remove_reference_t<Timer>::traits_type traits_type;
+      *timeout = chrono::duration_cast<chrono::nanoseconds>(
+          traits_type::to_wait_duration(o->timer_.expiry()));
+      o->drop_timer();
+    }
+    else
+    {
+      o->timer_.async_wait(timed_cancel_timer_handler<timed_cancel_op>(o));
+    }
+  }
+
+  // Discard a deadline that was offered but never taken, as happens when the
+  // operation fails before it is started. The offer is only made and taken
+  // while the operation is being started, before it is able to complete.
+  void discard_deadline()
+  {
+    if (deadline_offered_)
+    {
+      deadline_offered_ = false;
+      drop_timer();
+    }
+  }
+
+  // Give up the timer, which is never armed, along with its reference to the
+  // state. The operation still holds a reference, so the count cannot reach
+  // zero here.
+  void drop_timer()
+  {
+    has_pending_timer_wait_ = false;
+    --ref_count_;
+  }
+
   template <typename Message>
   void handle_op(Message&& message)
   {
+    discard_deadline();
+
     if (cancel_proxy_)
       cancel_proxy_->op_ = nullptr;
 
@@ -203,6 +283,10 @@ public:
 
   // Whether the asynchronous wait on the timer is still pending
   bool has_pending_timer_wait_;
+
+  // Whether the deadline is offered to the operation being started. Used only
+  // by the thread that starts the operation.
+  bool deadline_offered_;
 };
 
 template <typename Op, typename R, typename... Args>
@@ -225,7 +309,10 @@ public:
   ~timed_cancel_op_handler()
   {
     if (op_)
+    {
+      op_->discard_deadline();
       op_->release();
+    }
   }
 
   cancellation_slot_type get_cancellation_slot() const noexcept
@@ -307,6 +394,23 @@ public:
   Op* op_;
 };
 
+// Operations that are able to cancel themselves at a deadline call this
+// function with their handler before they are started. If the handler belongs
+// to a timed cancellation, such as one created by cancel_after, it returns the
+// deadline offered to the operation.
+template <typename Handler>
+inline timed_cancel_deadline take_timed_cancel_deadline(Handler&)
+{
+  return timed_cancel_deadline();
+}
+
+template <typename Op, typename... Signatures>
+inline timed_cancel_deadline take_timed_cancel_deadline(
+    timed_cancel_op_handler<Op, Signatures...>& handler)
+{
+  return handler.op_ ? handler.op_->take_deadline() : timed_cancel_deadline();
+}
+
 } // namespace detail
 
 template <template <typename, typename> class Associator,
@@ -57,6 +57,20 @@ public:
     ::SetEvent(events_[0]);
   }
 
+  // Signal up to the specified number of waiters. An auto-reset event cannot
+  // count signals, so all waiters are woken unless only one is wanted.
+  template <typename Lock>
+  void signal_many(Lock& lock, std::size_t n)
+  {
+    BOOST_ASIO_ASSERT(lock.locked());
+    (void)lock;
+    state_ |= 1;
+    if (n > 1)
+      ::SetEvent(events_[0]);
+    else if (n == 1 && state_ > 1)
+      ::SetEvent(events_[1]);
+  }
+
   // Unlock the mutex and signal one waiter.
   template <typename Lock>
   void unlock_and_signal_one(Lock& lock)
@@ -19,6 +19,8 @@
 
 #if defined(BOOST_ASIO_HAS_IOCP)
 
+#include <boost/asio/context_metrics.hpp>
+#include <boost/asio/context_options.hpp>
 #include <boost/asio/detail/limits.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/op_queue.hpp>
@@ -51,6 +53,10 @@ public:
   BOOST_ASIO_DECL win_iocp_io_context(boost::asio::execution_context& ctx,
       int concurrency_hint = -1, bool own_thread = true);
 
+  // Constructor. The scheduling options are not used by this implementation.
+  BOOST_ASIO_DECL win_iocp_io_context(boost::asio::execution_context& ctx,
+      int concurrency_hint, bool own_thread, const context_options& options);
+
   // Destructor.
   BOOST_ASIO_DECL ~win_iocp_io_context();
 
@@ -123,6 +129,14 @@ public:
     post_deferred_completion(op);
   }
 
+  // Request invocation of the given operation ahead of, or behind, other
+  // queued operations and return immediately. The completion port does not
+  // support priorities, so the operation is queued in the usual way.
+  void post_prioritised_completion(win_iocp_operation* op, bool)
+  {
+    post_immediate_completion(op, false);
+  }
+
   // Request invocation of the given operation and return immediately. Assumes
   // that work_started() was previously called for the operation.
   BOOST_ASIO_DECL void post_deferred_completion(win_iocp_operation* op);
@@ -216,6 +230,13 @@ public:
     return concurrency_hint_;
   }
 
+  // Get a snapshot of the io_context's activity. The spin-then-block idle
+  // policy is not used with I/O completion ports, so all counts are zero.
+  context_metrics metrics() const
+  {
+    return context_metrics();
+  }
+
 private:
 #if defined(WINVER) && (WINVER < 0x0500)
   typedef DWORD dword_ptr_t;
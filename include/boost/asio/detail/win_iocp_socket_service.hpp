@@ -23,6 +23,7 @@
 #include <boost/asio/error.hpp>
 #include <boost/asio/execution_context.hpp>
 #include <boost/asio/socket_base.hpp>
+#include <boost/asio/detail/accept_many_op.hpp>
 #include <boost/asio/detail/bind_handler.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
 #include <boost/asio/detail/fenced_block.hpp>
@@ -620,6 +621,20 @@ public:
     p.v = p.p = 0;
   }
 
+  // Start an asynchronous accept of a stream of connections. Each accepted
+  // connection is passed to the connection handler, and the handler is invoked
+  // once no more connections will be accepted.
+  template <typename PeerIoExecutor, typename ConnectionHandler,
+      typename Handler, typename IoExecutor>
+  void async_accept_many(implementation_type& impl,
+      const PeerIoExecutor& peer_io_ex, ConnectionHandler& connection_handler,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    accept_many_op<win_iocp_socket_service, PeerIoExecutor,
+      ConnectionHandler, Handler, IoExecutor>(*this, impl, peer_io_ex,
+        connection_handler, handler, io_ex).start();
+  }
+
   // Connect the socket to the specified endpoint.
   boost::system::error_code connect(implementation_type& impl,
       const endpoint_type& peer_endpoint, boost::system::error_code& ec)
@@ -25,13 +25,16 @@
 #include <boost/asio/socket_base.hpp>
 #include <boost/asio/detail/bind_handler.hpp>
 #include <boost/asio/detail/buffer_sequence_adapter.hpp>
+#include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/fenced_block.hpp>
 #include <boost/asio/detail/handler_alloc_helpers.hpp>
 #include <boost/asio/detail/memory.hpp>
 #include <boost/asio/detail/mutex.hpp>
 #include <boost/asio/detail/operation.hpp>
 #include <boost/asio/detail/reactor_op.hpp>
+#include <boost/asio/detail/receive_many_op.hpp>
 #include <boost/asio/detail/select_reactor.hpp>
+#include <boost/asio/detail/socket_close_service.hpp>
 #include <boost/asio/detail/socket_holder.hpp>
 #include <boost/asio/detail/socket_ops.hpp>
 #include <boost/asio/detail/socket_types.hpp>
@@ -124,6 +127,27 @@ public:
   BOOST_ASIO_DECL boost::system::error_code cancel(
       base_implementation_type& impl, boost::system::error_code& ec);
 
+  // Move the socket to the calling thread's own set of descriptors. All
+  // threads share the completion port, so there is nothing to move.
+  boost::system::error_code migrate(base_implementation_type& impl,
+      boost::system::error_code& ec)
+  {
+    if (!is_open(impl))
+      ec = boost::asio::error::bad_descriptor;
+    else
+      ec = boost::system::error_code();
+    return ec;
+  }
+
+  // Get the number of speculative operations on the socket that completed at
+  // once, and the number that would have blocked. Operations are not counted.
+  void speculative_counts(const base_implementation_type&,
+      uint64_t& hits, uint64_t& misses) const
+  {
+    hits = 0;
+    misses = 0;
+  }
+
   // Determine whether the socket is at the out-of-band data mark.
   bool at_mark(const base_implementation_type& impl,
       boost::system::error_code& ec) const
@@ -268,6 +292,81 @@ public:
     }
   }
 
+  // Start an asynchronous close. The socket implementation is closed at once,
+  // and the socket is closed on a helper thread.
+  template <typename Handler, typename IoExecutor>
+  void async_close(base_implementation_type& impl,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    socket_close_service& close_service =
+      boost::asio::use_service<socket_close_service>(context_);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef socket_close_op<Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.socket_, impl.state_,
+        close_service.scheduler(), handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((context_, *p.p, "socket",
+          &impl, impl.socket_, "async_close"));
+
+    if (is_open(impl))
+    {
+      // Check if the reactor was created, in which case the socket must be
+      // removed from it before the socket is closed.
+      select_reactor* r = static_cast<select_reactor*>(
+            interlocked_compare_exchange_pointer(
+              reinterpret_cast<void**>(&reactor_), 0, 0));
+      if (r)
+      {
+        r->deregister_descriptor(impl.socket_, impl.reactor_data_, false);
+        r->cleanup_descriptor_data(impl.reactor_data_);
+      }
+
+      impl.socket_ = invalid_socket;
+      impl.state_ = 0;
+      impl.cancel_token_.reset();
+#if defined(BOOST_ASIO_ENABLE_CANCELIO)
+      impl.safe_cancellation_thread_id_ = 0;
+#endif // defined(BOOST_ASIO_ENABLE_CANCELIO)
+
+      close_service.start_close_op(p.p);
+    }
+    else
+    {
+      iocp_service_.post_immediate_completion(p.p, is_continuation);
+    }
+    p.v = p.p = 0;
+  }
+
+  // Start an asynchronous shutdown. A shutdown does not wait for the peer, and
+  // so it is performed immediately and only its completion is deferred.
+  template <typename Handler, typename IoExecutor>
+  void async_shutdown(base_implementation_type& impl,
+      socket_base::shutdown_type what, Handler& handler,
+      const IoExecutor& io_ex)
+  {
+    bool is_continuation =
+      boost_asio_handler_cont_helpers::is_continuation(handler);
+
+    // Allocate and construct an operation to wrap the handler.
+    typedef win_iocp_wait_op<Handler, IoExecutor> op;
+    typename op::ptr p = { boost::asio::detail::addressof(handler),
+      op::ptr::allocate(handler), 0 };
+    p.p = new (p.v) op(impl.cancel_token_, handler, io_ex);
+
+    BOOST_ASIO_HANDLER_CREATION((context_, *p.p, "socket",
+          &impl, impl.socket_, "async_shutdown"));
+
+    socket_ops::shutdown(impl.socket_, what, p.p->ec_);
+    iocp_service_.post_immediate_completion(p.p, is_continuation);
+    p.v = p.p = 0;
+  }
+
   // Send the given data to the peer. Returns the number of bytes sent.
   template <typename ConstBufferSequence>
   size_t send(base_implementation_type& impl,
@@ -439,6 +538,18 @@ public:
     }
   }
 
+  // Start an asynchronous receive of a stream of data. A buffer is taken from
+  // the pool each time data arrives, and is passed to the data handler.
+  template <typename DataHandler, typename Handler, typename IoExecutor>
+  void async_receive_many(base_implementation_type& impl,
+      provided_buffer_pool& pool, DataHandler& data_handler,
+      Handler& handler, const IoExecutor& io_ex)
+  {
+    receive_many_op<win_iocp_socket_service_base,
+      DataHandler, Handler, IoExecutor>(
+        *this, impl, pool, data_handler, handler, io_ex).start();
+  }
+
   // Receive some data with associated flags. Returns the number of bytes
   // received.
   template <typename MutableBufferSequence>
@@ -28,6 +28,7 @@
 #include <boost/asio/execution/occupancy.hpp>
 #include <boost/asio/execution/outstanding_work.hpp>
 #include <boost/asio/execution/prefer_only.hpp>
+#include <boost/asio/execution/priority.hpp>
 #include <boost/asio/execution/relationship.hpp>
 
 #endif // BOOST_ASIO_EXECUTION_HPP
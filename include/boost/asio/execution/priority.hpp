@@ -0,0 +1,1004 @@
+//
+// execution/priority.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_EXECUTION_PRIORITY_HPP
+#define BOOST_ASIO_EXECUTION_PRIORITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+#include <boost/asio/execution/executor.hpp>
+#include <boost/asio/is_applicable_property.hpp>
+#include <boost/asio/query.hpp>
+#include <boost/asio/traits/query_free.hpp>
+#include <boost/asio/traits/query_member.hpp>
+#include <boost/asio/traits/query_static_constexpr_member.hpp>
+#include <boost/asio/traits/static_query.hpp>
+#include <boost/asio/traits/static_require.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+#if defined(GENERATING_DOCUMENTATION)
+
+namespace execution {
+
+/// A property to describe the priority with which an executor's submitted
+/// functions are scheduled relative to other work in the same context.
+struct priority_t
+{
+  /// The priority_t property applies to executors.
+  template <typename T>
+  static constexpr bool is_applicable_property_v = is_executor_v<T>;
+
+  /// The top-level priority_t property cannot be required.
+  static constexpr bool is_requirable = false;
+
+  /// The top-level priority_t property cannot be preferred.
+  static constexpr bool is_preferable = false;
+
+  /// The type returned by queries against an @c any_executor.
+  typedef priority_t polymorphic_query_result_type;
+
+  /// A sub-property that indicates that submitted functions are scheduled in
+  /// the order in which they are submitted, alongside other normal work.
+  struct normal_t
+  {
+    /// The priority_t::normal_t property applies to executors.
+    template <typename T>
+    static constexpr bool is_applicable_property_v = is_executor_v<T>;
+
+    /// The priority_t::normal_t property can be required.
+    static constexpr bool is_requirable = true;
+
+    /// The priority_t::normal_t property can be preferred.
+    static constexpr bool is_preferable = true;
+
+    /// The type returned by queries against an @c any_executor.
+    typedef priority_t polymorphic_query_result_type;
+
+    /// Default constructor.
+    constexpr normal_t();
+
+    /// Get the value associated with a property object.
+    /**
+     * @returns normal_t();
+     */
+    static constexpr priority_t value();
+  };
+
+  /// A sub-property that indicates that submitted functions are scheduled
+  /// ahead of normal and low priority work.
+  struct high_t
+  {
+    /// The priority_t::high_t property applies to executors.
+    template <typename T>
+    static constexpr bool is_applicable_property_v = is_executor_v<T>;
+
+    /// The priority_t::high_t property can be required.
+    static constexpr bool is_requirable = true;
+
+    /// The priority_t::high_t property can be preferred.
+    static constexpr bool is_preferable = true;
+
+    /// The type returned by queries against an @c any_executor.
+    typedef priority_t polymorphic_query_result_type;
+
+    /// Default constructor.
+    constexpr high_t();
+
+    /// Get the value associated with a property object.
+    /**
+     * @returns high_t();
+     */
+    static constexpr priority_t value();
+  };
+
+  /// A sub-property that indicates that submitted functions are scheduled
+  /// after high and normal priority work.
+  struct low_t
+  {
+    /// The priority_t::low_t property applies to executors.
+    template <typename T>
+    static constexpr bool is_applicable_property_v = is_executor_v<T>;
+
+    /// The priority_t::low_t property can be required.
+    static constexpr bool is_requirable = true;
+
+    /// The priority_t::low_t property can be preferred.
+    static constexpr bool is_preferable = true;
+
+    /// The type returned by queries against an @c any_executor.
+    typedef priority_t polymorphic_query_result_type;
+
+    /// Default constructor.
+    constexpr low_t();
+
+    /// Get the value associated with a property object.
+    /**
+     * @returns low_t();
+     */
+    static constexpr priority_t value();
+  };
+
+  /// A special value used for accessing the priority_t::normal_t property.
+  static constexpr normal_t normal;
+
+  /// A special value used for accessing the priority_t::high_t property.
+  static constexpr high_t high;
+
+  /// A special value used for accessing the priority_t::low_t property.
+  static constexpr low_t low;
+
+  /// Default constructor.
+  constexpr priority_t();
+
+  /// Construct from a sub-property value.
+  constexpr priority_t(normal_t);
+
+  /// Construct from a sub-property value.
+  constexpr priority_t(high_t);
+
+  /// Construct from a sub-property value.
+  constexpr priority_t(low_t);
+
+  /// Compare property values for equality.
+  friend constexpr bool operator==(
+      const priority_t& a, const priority_t& b) noexcept;
+
+  /// Compare property values for inequality.
+  friend constexpr bool operator!=(
+      const priority_t& a, const priority_t& b) noexcept;
+};
+
+/// A special value used for accessing the priority_t property.
+constexpr priority_t priority;
+
+} // namespace execution
+
+#else // defined(GENERATING_DOCUMENTATION)
+
+namespace execution {
+namespace detail {
+namespace priority {
+
+template <int I> struct normal_t;
+template <int I> struct high_t;
+template <int I> struct low_t;
+
+} // namespace priority
+
+template <int I = 0>
+struct priority_t
+{
+#if defined(BOOST_ASIO_HAS_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr bool is_applicable_property_v = is_executor<T>::value;
+#endif // defined(BOOST_ASIO_HAS_VARIABLE_TEMPLATES)
+
+  static constexpr bool is_requirable = false;
+  static constexpr bool is_preferable = false;
+  typedef priority_t polymorphic_query_result_type;
+
+  typedef detail::priority::normal_t<I> normal_t;
+  typedef detail::priority::high_t<I> high_t;
+  typedef detail::priority::low_t<I> low_t;
+
+  constexpr priority_t()
+    : value_(-1)
+  {
+  }
+
+  constexpr priority_t(normal_t)
+    : value_(0)
+  {
+  }
+
+  constexpr priority_t(high_t)
+    : value_(1)
+  {
+  }
+
+  constexpr priority_t(low_t)
+    : value_(2)
+  {
+  }
+
+  template <typename T>
+  struct proxy
+  {
+#if defined(BOOST_ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+    struct type
+    {
+      template <typename P>
+      auto query(P&& p) const
+        noexcept(
+          noexcept(
+            declval<conditional_t<true, T, P>>().query(static_cast<P&&>(p))
+          )
+        )
+        -> decltype(
+          declval<conditional_t<true, T, P>>().query(static_cast<P&&>(p))
+        );
+    };
+#else // defined(BOOST_ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+    typedef T type;
+#endif // defined(BOOST_ASIO_HAS_DEDUCED_QUERY_MEMBER_TRAIT)
+  };
+
+  template <typename T>
+  struct static_proxy
+  {
+#if defined(BOOST_ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+    struct type
+    {
+      template <typename P>
+      static constexpr auto query(P&& p)
+        noexcept(
+          noexcept(
+            conditional_t<true, T, P>::query(static_cast<P&&>(p))
+          )
+        )
+        -> decltype(
+          conditional_t<true, T, P>::query(static_cast<P&&>(p))
+        )
+      {
+        return T::query(static_cast<P&&>(p));
+      }
+    };
+#else // defined(BOOST_ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+    typedef T type;
+#endif // defined(BOOST_ASIO_HAS_DEDUCED_QUERY_STATIC_CONSTEXPR_MEMBER_TRAIT)
+  };
+
+  template <typename T>
+  struct query_member :
+    traits::query_member<typename proxy<T>::type, priority_t> {};
+
+  template <typename T>
+  struct query_static_constexpr_member :
+    traits::query_static_constexpr_member<
+      typename static_proxy<T>::type, priority_t> {};
+
+#if defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr
+  typename query_static_constexpr_member<T>::result_type
+  static_query()
+    noexcept(query_static_constexpr_member<T>::is_noexcept)
+  {
+    return query_static_constexpr_member<T>::value();
+  }
+
+  template <typename T>
+  static constexpr
+  typename traits::static_query<T, normal_t>::result_type
+  static_query(
+      enable_if_t<
+        !query_static_constexpr_member<T>::is_valid
+      >* = 0,
+      enable_if_t<
+        !query_member<T>::is_valid
+      >* = 0,
+      enable_if_t<
+        traits::static_query<T, normal_t>::is_valid
+      >* = 0) noexcept
+  {
+    return traits::static_query<T, normal_t>::value();
+  }
+
+  template <typename T>
+  static constexpr
+  typename traits::static_query<T, high_t>::result_type
+  static_query(
+      enable_if_t<
+        !query_static_constexpr_member<T>::is_valid
+      >* = 0,
+      enable_if_t<
+        !query_member<T>::is_valid
+      >* = 0,
+      enable_if_t<
+        !traits::static_query<T, normal_t>::is_valid
+      >* = 0,
+      enable_if_t<
+        traits::static_query<T, high_t>::is_valid
+      >* = 0) noexcept
+  {
+    return traits::static_query<T, high_t>::value();
+  }
+
+  template <typename T>
+  static constexpr
+  typename traits::static_query<T, low_t>::result_type
+  static_query(
+      enable_if_t<
+        !query_static_constexpr_member<T>::is_valid
+      >* = 0,
+      enable_if_t<
+        !query_member<T>::is_valid
+      >* = 0,
+      enable_if_t<
+        !traits::static_query<T, normal_t>::is_valid
+      >* = 0,
+      enable_if_t<
+        !traits::static_query<T, high_t>::is_valid
+      >* = 0,
+      enable_if_t<
+        traits::static_query<T, low_t>::is_valid
+      >* = 0) noexcept
+  {
+    return traits::static_query<T, low_t>::value();
+  }
+
+  template <typename E, typename T = decltype(priority_t::static_query<E>())>
+  static constexpr const T static_query_v
+    = priority_t::static_query<E>();
+#endif // defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+  friend constexpr bool operator==(
+      const priority_t& a, const priority_t& b)
+  {
+    return a.value_ == b.value_;
+  }
+
+  friend constexpr bool operator!=(
+      const priority_t& a, const priority_t& b)
+  {
+    return a.value_ != b.value_;
+  }
+
+  struct convertible_from_priority_t
+  {
+    constexpr convertible_from_priority_t(priority_t) {}
+  };
+
+  template <typename Executor>
+  friend constexpr priority_t query(
+      const Executor& ex, convertible_from_priority_t,
+      enable_if_t<
+        can_query<const Executor&, normal_t>::value
+      >* = 0)
+#if !defined(__clang__) // Clang crashes if noexcept is used here.
+#if defined(BOOST_ASIO_MSVC) // Visual C++ wants the type to be qualified.
+    noexcept(is_nothrow_query<const Executor&, priority_t<>::normal_t>::value)
+#else // defined(BOOST_ASIO_MSVC)
+    noexcept(is_nothrow_query<const Executor&, normal_t>::value)
+#endif // defined(BOOST_ASIO_MSVC)
+#endif // !defined(__clang__)
+  {
+    return boost::asio::query(ex, normal_t());
+  }
+
+  template <typename Executor>
+  friend constexpr priority_t query(
+      const Executor& ex, convertible_from_priority_t,
+      enable_if_t<
+        !can_query<const Executor&, normal_t>::value
+      >* = 0,
+      enable_if_t<
+        can_query<const Executor&, high_t>::value
+      >* = 0)
+#if !defined(__clang__) // Clang crashes if noexcept is used here.
+#if defined(BOOST_ASIO_MSVC) // Visual C++ wants the type to be qualified.
+    noexcept(
+      is_nothrow_query<const Executor&, priority_t<>::high_t>::value)
+#else // defined(BOOST_ASIO_MSVC)
+    noexcept(is_nothrow_query<const Executor&, high_t>::value)
+#endif // defined(BOOST_ASIO_MSVC)
+#endif // !defined(__clang__)
+  {
+    return boost::asio::query(ex, high_t());
+  }
+
+  template <typename Executor>
+  friend constexpr priority_t query(
+      const Executor& ex, convertible_from_priority_t,
+      enable_if_t<
+        !can_query<const Executor&, normal_t>::value
+      >* = 0,
+      enable_if_t<
+        !can_query<const Executor&, high_t>::value
+      >* = 0,
+      enable_if_t<
+        can_query<const Executor&, low_t>::value
+      >* = 0)
+#if !defined(__clang__) // Clang crashes if noexcept is used here.
+#if defined(BOOST_ASIO_MSVC) // Visual C++ wants the type to be qualified.
+    noexcept(is_nothrow_query<const Executor&, priority_t<>::low_t>::value)
+#else // defined(BOOST_ASIO_MSVC)
+    noexcept(is_nothrow_query<const Executor&, low_t>::value)
+#endif // defined(BOOST_ASIO_MSVC)
+#endif // !defined(__clang__)
+  {
+    return boost::asio::query(ex, low_t());
+  }
+
+  BOOST_ASIO_STATIC_CONSTEXPR_DEFAULT_INIT(normal_t, normal);
+  BOOST_ASIO_STATIC_CONSTEXPR_DEFAULT_INIT(high_t, high);
+  BOOST_ASIO_STATIC_CONSTEXPR_DEFAULT_INIT(low_t, low);
+
+private:
+  int value_;
+};
+
+#if defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+template <int I> template <typename E, typename T>
+const T priority_t<I>::static_query_v;
+#endif // defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+template <int I>
+const typename priority_t<I>::normal_t priority_t<I>::normal;
+
+template <int I>
+const typename priority_t<I>::high_t priority_t<I>::high;
+
+template <int I>
+const typename priority_t<I>::low_t priority_t<I>::low;
+
+namespace priority {
+
+template <int I = 0>
+struct normal_t
+{
+#if defined(BOOST_ASIO_HAS_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr bool is_applicable_property_v = is_executor<T>::value;
+#endif // defined(BOOST_ASIO_HAS_VARIABLE_TEMPLATES)
+
+  static constexpr bool is_requirable = true;
+  static constexpr bool is_preferable = true;
+  typedef priority_t<I> polymorphic_query_result_type;
+
+  constexpr normal_t()
+  {
+  }
+
+  template <typename T>
+  struct query_member :
+    traits::query_member<
+      typename priority_t<I>::template proxy<T>::type, normal_t> {};
+
+  template <typename T>
+  struct query_static_constexpr_member :
+    traits::query_static_constexpr_member<
+      typename priority_t<I>::template static_proxy<T>::type, normal_t> {};
+
+#if defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr
+  typename query_static_constexpr_member<T>::result_type
+  static_query()
+    noexcept(query_static_constexpr_member<T>::is_noexcept)
+  {
+    return query_static_constexpr_member<T>::value();
+  }
+
+  template <typename T>
+  static constexpr normal_t static_query(
+      enable_if_t<
+        !query_static_constexpr_member<T>::is_valid
+      >* = 0,
+      enable_if_t<
+        !query_member<T>::is_valid
+      >* = 0,
+      enable_if_t<
+        !traits::query_free<T, normal_t>::is_valid
+      >* = 0,
+      enable_if_t<
+        !can_query<T, high_t<I>>::value
+      >* = 0,
+      enable_if_t<
+        !can_query<T, low_t<I>>::value
+      >* = 0) noexcept
+  {
+    return normal_t();
+  }
+
+  template <typename E, typename T = decltype(normal_t::static_query<E>())>
+  static constexpr const T static_query_v
+    = normal_t::static_query<E>();
+#endif // defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+  static constexpr priority_t<I> value()
+  {
+    return normal_t();
+  }
+
+  friend constexpr bool operator==(const normal_t&, const normal_t&)
+  {
+    return true;
+  }
+
+  friend constexpr bool operator!=(const normal_t&, const normal_t&)
+  {
+    return false;
+  }
+
+  friend constexpr bool operator==(const normal_t&, const high_t<I>&)
+  {
+    return false;
+  }
+
+  friend constexpr bool operator!=(const normal_t&, const high_t<I>&)
+  {
+    return true;
+  }
+
+  friend constexpr bool operator==(const normal_t&, const low_t<I>&)
+  {
+    return false;
+  }
+
+  friend constexpr bool operator!=(const normal_t&, const low_t<I>&)
+  {
+    return true;
+  }
+};
+
+#if defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+template <int I> template <typename E, typename T>
+const T normal_t<I>::static_query_v;
+#endif // defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+template <int I = 0>
+struct high_t
+{
+#if defined(BOOST_ASIO_HAS_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr bool is_applicable_property_v = is_executor<T>::value;
+#endif // defined(BOOST_ASIO_HAS_VARIABLE_TEMPLATES)
+
+  static constexpr bool is_requirable = true;
+  static constexpr bool is_preferable = true;
+  typedef priority_t<I> polymorphic_query_result_type;
+
+  constexpr high_t()
+  {
+  }
+
+  template <typename T>
+  struct query_member :
+    traits::query_member<
+      typename priority_t<I>::template proxy<T>::type, high_t> {};
+
+  template <typename T>
+  struct query_static_constexpr_member :
+    traits::query_static_constexpr_member<
+      typename priority_t<I>::template static_proxy<T>::type, high_t> {};
+
+#if defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr typename query_static_constexpr_member<T>::result_type
+  static_query()
+    noexcept(query_static_constexpr_member<T>::is_noexcept)
+  {
+    return query_static_constexpr_member<T>::value();
+  }
+
+  template <typename E, typename T = decltype(high_t::static_query<E>())>
+  static constexpr const T static_query_v = high_t::static_query<E>();
+#endif // defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+  static constexpr priority_t<I> value()
+  {
+    return high_t();
+  }
+
+  friend constexpr bool operator==(const high_t&, const high_t&)
+  {
+    return true;
+  }
+
+  friend constexpr bool operator!=(const high_t&, const high_t&)
+  {
+    return false;
+  }
+
+  friend constexpr bool operator==(const high_t&, const normal_t<I>&)
+  {
+    return false;
+  }
+
+  friend constexpr bool operator!=(const high_t&, const normal_t<I>&)
+  {
+    return true;
+  }
+
+  friend constexpr bool operator==(const high_t&, const low_t<I>&)
+  {
+    return false;
+  }
+
+  friend constexpr bool operator!=(const high_t&, const low_t<I>&)
+  {
+    return true;
+  }
+};
+
+#if defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+template <int I> template <typename E, typename T>
+const T high_t<I>::static_query_v;
+#endif // defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+template <int I>
+struct low_t
+{
+#if defined(BOOST_ASIO_HAS_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr bool is_applicable_property_v = is_executor<T>::value;
+#endif // defined(BOOST_ASIO_HAS_VARIABLE_TEMPLATES)
+
+  static constexpr bool is_requirable = true;
+  static constexpr bool is_preferable = true;
+  typedef priority_t<I> polymorphic_query_result_type;
+
+  constexpr low_t()
+  {
+  }
+
+  template <typename T>
+  struct query_member :
+    traits::query_member<
+      typename priority_t<I>::template proxy<T>::type, low_t> {};
+
+  template <typename T>
+  struct query_static_constexpr_member :
+    traits::query_static_constexpr_member<
+      typename priority_t<I>::template static_proxy<T>::type, low_t> {};
+
+#if defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+  template <typename T>
+  static constexpr
+  typename query_static_constexpr_member<T>::result_type
+  static_query()
+    noexcept(query_static_constexpr_member<T>::is_noexcept)
+  {
+    return query_static_constexpr_member<T>::value();
+  }
+
+  template <typename E, typename T = decltype(low_t::static_query<E>())>
+  static constexpr const T static_query_v = low_t::static_query<E>();
+#endif // defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+  static constexpr priority_t<I> value()
+  {
+    return low_t();
+  }
+
+  friend constexpr bool operator==(const low_t&, const low_t&)
+  {
+    return true;
+  }
+
+  friend constexpr bool operator!=(const low_t&, const low_t&)
+  {
+    return false;
+  }
+
+  friend constexpr bool operator==(const low_t&, const normal_t<I>&)
+  {
+    return false;
+  }
+
+  friend constexpr bool operator!=(const low_t&, const normal_t<I>&)
+  {
+    return true;
+  }
+
+  friend constexpr bool operator==(const low_t&, const high_t<I>&)
+  {
+    return false;
+  }
+
+  friend constexpr bool operator!=(const low_t&, const high_t<I>&)
+  {
+    return true;
+  }
+};
+
+#if defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+template <int I> template <typename E, typename T>
+const T low_t<I>::static_query_v;
+#endif // defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   && defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+} // namespace priority
+} // namespace detail
+
+typedef detail::priority_t<> priority_t;
+
+constexpr priority_t priority;
+
+} // namespace execution
+
+#if !defined(BOOST_ASIO_HAS_VARIABLE_TEMPLATES)
+
+template <typename T>
+struct is_applicable_property<T, execution::priority_t>
+  : integral_constant<bool, execution::is_executor<T>::value>
+{
+};
+
+template <typename T>
+struct is_applicable_property<T, execution::priority_t::normal_t>
+  : integral_constant<bool, execution::is_executor<T>::value>
+{
+};
+
+template <typename T>
+struct is_applicable_property<T, execution::priority_t::high_t>
+  : integral_constant<bool, execution::is_executor<T>::value>
+{
+};
+
+template <typename T>
+struct is_applicable_property<T, execution::priority_t::low_t>
+  : integral_constant<bool, execution::is_executor<T>::value>
+{
+};
+
+#endif // !defined(BOOST_ASIO_HAS_VARIABLE_TEMPLATES)
+
+namespace traits {
+
+#if !defined(BOOST_ASIO_HAS_DEDUCED_QUERY_FREE_TRAIT)
+
+template <typename T>
+struct query_free_default<T, execution::priority_t,
+  enable_if_t<
+    can_query<T, execution::priority_t::normal_t>::value
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_query<T, execution::priority_t::normal_t>::value;
+
+  typedef execution::priority_t result_type;
+};
+
+template <typename T>
+struct query_free_default<T, execution::priority_t,
+  enable_if_t<
+    !can_query<T, execution::priority_t::normal_t>::value
+      && can_query<T, execution::priority_t::high_t>::value
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_query<T, execution::priority_t::high_t>::value;
+
+  typedef execution::priority_t result_type;
+};
+
+template <typename T>
+struct query_free_default<T, execution::priority_t,
+  enable_if_t<
+    !can_query<T, execution::priority_t::normal_t>::value
+      && !can_query<T, execution::priority_t::high_t>::value
+      && can_query<T, execution::priority_t::low_t>::value
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept =
+    is_nothrow_query<T, execution::priority_t::low_t>::value;
+
+  typedef execution::priority_t result_type;
+};
+
+#endif // !defined(BOOST_ASIO_HAS_DEDUCED_QUERY_FREE_TRAIT)
+
+#if !defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT) \
+  || !defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+template <typename T>
+struct static_query<T, execution::priority_t,
+  enable_if_t<
+    execution::detail::priority_t<0>::
+      query_static_constexpr_member<T>::is_valid
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+
+  typedef typename execution::detail::priority_t<0>::
+    query_static_constexpr_member<T>::result_type result_type;
+
+  static constexpr result_type value()
+  {
+    return execution::detail::priority_t<0>::
+      query_static_constexpr_member<T>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t,
+  enable_if_t<
+    !execution::detail::priority_t<0>::
+        query_static_constexpr_member<T>::is_valid
+      && !execution::detail::priority_t<0>::
+        query_member<T>::is_valid
+      && traits::static_query<T, execution::priority_t::normal_t>::is_valid
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+
+  typedef typename traits::static_query<T,
+    execution::priority_t::normal_t>::result_type result_type;
+
+  static constexpr result_type value()
+  {
+    return traits::static_query<T, execution::priority_t::normal_t>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t,
+  enable_if_t<
+    !execution::detail::priority_t<0>::
+        query_static_constexpr_member<T>::is_valid
+      && !execution::detail::priority_t<0>::
+        query_member<T>::is_valid
+      && !traits::static_query<T, execution::priority_t::normal_t>::is_valid
+      && traits::static_query<T, execution::priority_t::high_t>::is_valid
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+
+  typedef typename traits::static_query<T,
+    execution::priority_t::high_t>::result_type result_type;
+
+  static constexpr result_type value()
+  {
+    return traits::static_query<T, execution::priority_t::high_t>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t,
+  enable_if_t<
+    !execution::detail::priority_t<0>::
+        query_static_constexpr_member<T>::is_valid
+      && !execution::detail::priority_t<0>::
+        query_member<T>::is_valid
+      && !traits::static_query<T, execution::priority_t::normal_t>::is_valid
+      && !traits::static_query<T, execution::priority_t::high_t>::is_valid
+      && traits::static_query<T, execution::priority_t::low_t>::is_valid
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+
+  typedef typename traits::static_query<T,
+    execution::priority_t::low_t>::result_type result_type;
+
+  static constexpr result_type value()
+  {
+    return traits::static_query<T, execution::priority_t::low_t>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t::normal_t,
+  enable_if_t<
+    execution::detail::priority::normal_t<0>::
+      query_static_constexpr_member<T>::is_valid
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+
+  typedef typename execution::detail::priority::normal_t<0>::
+    query_static_constexpr_member<T>::result_type result_type;
+
+  static constexpr result_type value()
+  {
+    return execution::detail::priority::normal_t<0>::
+      query_static_constexpr_member<T>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t::normal_t,
+  enable_if_t<
+    !execution::detail::priority::normal_t<0>::
+        query_static_constexpr_member<T>::is_valid
+      && !execution::detail::priority::normal_t<0>::
+        query_member<T>::is_valid
+      && !traits::query_free<T, execution::priority_t::normal_t>::is_valid
+      && !can_query<T, execution::priority_t::high_t>::value
+      && !can_query<T, execution::priority_t::low_t>::value
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+
+  typedef execution::priority_t::normal_t result_type;
+
+  static constexpr result_type value()
+  {
+    return result_type();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t::high_t,
+  enable_if_t<
+    execution::detail::priority::high_t<0>::
+      query_static_constexpr_member<T>::is_valid
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+
+  typedef typename execution::detail::priority::high_t<0>::
+    query_static_constexpr_member<T>::result_type result_type;
+
+  static constexpr result_type value()
+  {
+    return execution::detail::priority::high_t<0>::
+      query_static_constexpr_member<T>::value();
+  }
+};
+
+template <typename T>
+struct static_query<T, execution::priority_t::low_t,
+  enable_if_t<
+    execution::detail::priority::low_t<0>::
+      query_static_constexpr_member<T>::is_valid
+  >>
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+
+  typedef typename execution::detail::priority::low_t<0>::
+    query_static_constexpr_member<T>::result_type result_type;
+
+  static constexpr result_type value()
+  {
+    return execution::detail::priority::low_t<0>::
+      query_static_constexpr_member<T>::value();
+  }
+};
+
+#endif // !defined(BOOST_ASIO_HAS_DEDUCED_STATIC_QUERY_TRAIT)
+       //   || !defined(BOOST_ASIO_HAS_SFINAE_VARIABLE_TEMPLATES)
+
+} // namespace traits
+
+#endif // defined(GENERATING_DOCUMENTATION)
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_EXECUTION_PRIORITY_HPP
@@ -0,0 +1,59 @@
+//
+// impl/current_processor.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_CURRENT_PROCESSOR_IPP
+#define BOOST_ASIO_IMPL_CURRENT_PROCESSOR_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/current_processor.hpp>
+#include <boost/asio/detail/cpu_affinity.hpp>
+#include <boost/asio/detail/throw_error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+std::size_t current_processor()
+{
+  boost::system::error_code ec;
+  std::size_t processor = detail::cpu_affinity::current_processor(ec);
+  boost::asio::detail::throw_error(ec, "current_processor");
+  return processor;
+}
+
+std::size_t current_processor(boost::system::error_code& ec)
+{
+  return detail::cpu_affinity::current_processor(ec);
+}
+
+std::size_t current_numa_node()
+{
+  boost::system::error_code ec;
+  std::size_t node = detail::cpu_affinity::current_node(ec);
+  boost::asio::detail::throw_error(ec, "current_numa_node");
+  return node;
+}
+
+std::size_t current_numa_node(boost::system::error_code& ec)
+{
+  return detail::cpu_affinity::current_node(ec);
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_CURRENT_PROCESSOR_IPP
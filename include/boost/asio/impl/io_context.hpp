@@ -303,8 +303,16 @@ void io_context::basic_executor_type<Allocator, Bits>::execute(
   BOOST_ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "execute"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p,
-      (bits() & relationship_continuation) != 0);
+  if (Bits & priority_bits)
+  {
+    context_ptr()->impl_.post_prioritised_completion(
+        p.p, (Bits & priority_high) != 0);
+  }
+  else
+  {
+    context_ptr()->impl_.post_immediate_completion(p.p,
+        (bits() & relationship_continuation) != 0);
+  }
   p.v = p.p = 0;
 }
 
@@ -357,7 +365,15 @@ void io_context::basic_executor_type<Allocator, Bits>::dispatch(
   BOOST_ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "dispatch"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p, false);
+  if (Bits & priority_bits)
+  {
+    context_ptr()->impl_.post_prioritised_completion(
+        p.p, (Bits & priority_high) != 0);
+  }
+  else
+  {
+    context_ptr()->impl_.post_immediate_completion(p.p, false);
+  }
   p.v = p.p = 0;
 }
 
@@ -375,7 +391,15 @@ void io_context::basic_executor_type<Allocator, Bits>::post(
   BOOST_ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "post"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p, false);
+  if (Bits & priority_bits)
+  {
+    context_ptr()->impl_.post_prioritised_completion(
+        p.p, (Bits & priority_high) != 0);
+  }
+  else
+  {
+    context_ptr()->impl_.post_immediate_completion(p.p, false);
+  }
   p.v = p.p = 0;
 }
 
@@ -393,7 +417,15 @@ void io_context::basic_executor_type<Allocator, Bits>::defer(
   BOOST_ASIO_HANDLER_CREATION((*context_ptr(), *p.p,
         "io_context", context_ptr(), 0, "defer"));
 
-  context_ptr()->impl_.post_immediate_completion(p.p, true);
+  if (Bits & priority_bits)
+  {
+    context_ptr()->impl_.post_prioritised_completion(
+        p.p, (Bits & priority_high) != 0);
+  }
+  else
+  {
+    context_ptr()->impl_.post_immediate_completion(p.p, true);
+  }
   p.v = p.p = 0;
 }
 #endif // !defined(BOOST_ASIO_NO_TS_EXECUTORS)
@@ -46,6 +46,12 @@ io_context::io_context(int concurrency_hint)
 {
 }
 
+io_context::io_context(int concurrency_hint, const context_options& options)
+  : impl_(add_impl(new impl_type(*this, concurrency_hint == 1
+          ? BOOST_ASIO_CONCURRENCY_HINT_1 : concurrency_hint, false, options)))
+{
+}
+
 io_context::impl_type& io_context::add_impl(io_context::impl_type* impl)
 {
   boost::asio::detail::scoped_ptr<impl_type> scoped_impl(impl);
@@ -133,6 +139,11 @@ void io_context::restart()
   impl_.restart();
 }
 
+context_metrics io_context::metrics() const
+{
+  return impl_.metrics();
+}
+
 io_context::service::service(boost::asio::io_context& owner)
   : execution_context::service(owner)
 {
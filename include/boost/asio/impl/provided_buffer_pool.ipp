@@ -0,0 +1,105 @@
+//
+// impl/provided_buffer_pool.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_PROVIDED_BUFFER_POOL_IPP
+#define BOOST_ASIO_IMPL_PROVIDED_BUFFER_POOL_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <boost/asio/provided_buffer_pool.hpp>
+#include <boost/asio/detail/throw_error.hpp>
+#include <boost/asio/error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+provided_buffer_pool::~provided_buffer_pool()
+{
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  service_->unregister_buffer_ring(ring_,
+      static_cast<unsigned>(buffer_count_), group_);
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+void provided_buffer_pool::init(execution_context& ctx)
+{
+  // Buffers are identified by 16-bit values, and the io_uring buffer ring
+  // requires a power-of-two number of entries.
+  if (buffer_size_ == 0 || buffer_size_ > 0x7FFFFFFF
+      || buffer_count_ == 0 || buffer_count_ > 32768
+      || (buffer_count_ & (buffer_count_ - 1)) != 0)
+  {
+    boost::system::error_code ec(boost::asio::error::invalid_argument);
+    boost::asio::detail::throw_error(ec, "provided_buffer_pool");
+  }
+
+  storage_.reset(new unsigned char[buffer_size_ * buffer_count_]);
+
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  service_ = &use_service<detail::io_uring_service>(ctx);
+  ring_ = service_->register_buffer_ring(
+      static_cast<unsigned>(buffer_count_), group_);
+
+  int mask = ::io_uring_buf_ring_mask(static_cast<unsigned>(buffer_count_));
+  for (std::size_t i = 0; i < buffer_count_; ++i)
+  {
+    ::io_uring_buf_ring_add(ring_, storage_.get() + i * buffer_size_,
+        static_cast<unsigned>(buffer_size_), static_cast<unsigned short>(i),
+        mask, static_cast<int>(i));
+  }
+  ::io_uring_buf_ring_advance(ring_, static_cast<int>(buffer_count_));
+#else // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  (void)ctx;
+  available_.reserve(buffer_count_);
+  for (std::size_t i = buffer_count_; i > 0; --i)
+    available_.push_back(static_cast<unsigned short>(i - 1));
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+bool provided_buffer_pool::acquire(unsigned short& id)
+{
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  // The kernel selects the buffers.
+  (void)id;
+  return false;
+#else // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  detail::mutex::scoped_lock lock(mutex_);
+  if (available_.empty())
+    return false;
+  id = available_.back();
+  available_.pop_back();
+  return true;
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+void provided_buffer_pool::release(unsigned short id) noexcept
+{
+  detail::mutex::scoped_lock lock(mutex_);
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  ::io_uring_buf_ring_add(ring_, storage_.get() + id * buffer_size_,
+      static_cast<unsigned>(buffer_size_), id,
+      ::io_uring_buf_ring_mask(static_cast<unsigned>(buffer_count_)), 0);
+  ::io_uring_buf_ring_advance(ring_, 1);
+#else // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  available_.push_back(id);
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_PROVIDED_BUFFER_POOL_IPP
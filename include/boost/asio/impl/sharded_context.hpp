@@ -0,0 +1,67 @@
+//
+// impl/sharded_context.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_SHARDED_CONTEXT_HPP
+#define BOOST_ASIO_IMPL_SHARDED_CONTEXT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <memory>
+#include <boost/asio/post.hpp>
+#include <boost/asio/detail/executor_op.hpp>
+#include <boost/asio/detail/handler_tracking.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/type_traits.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+template <typename Function>
+void sharded_context::submit(std::size_t index, Function&& f)
+{
+  shard& s = *shards_[index];
+
+  // A shard submitting to itself can use its io_context's private queue.
+  if (shard_call_stack::contains(this) == &s)
+  {
+    boost::asio::post(s.io_context_, static_cast<Function&&>(f));
+    return;
+  }
+
+  // Allocate and construct an operation to wrap the function.
+  typedef std::allocator<void> allocator_type;
+  typedef detail::executor_op<decay_t<Function>,
+      allocator_type, detail::operation> op;
+  allocator_type allocator;
+  typename op::ptr p = { detail::addressof(allocator),
+      op::ptr::allocate(allocator), 0 };
+  p.p = new (p.v) op(static_cast<Function&&>(f), allocator);
+
+  BOOST_ASIO_HANDLER_CREATION((s.io_context_, *p.p,
+        "sharded_context", this, 0, "submit"));
+
+  // Only the first function added to an empty inbox needs to wake the shard.
+  bool was_empty = s.inbox_.push(p.p);
+  p.v = p.p = 0;
+  if (was_empty)
+    start_drain(s);
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_SHARDED_CONTEXT_HPP
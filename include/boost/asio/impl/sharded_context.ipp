@@ -0,0 +1,183 @@
+//
+// impl/sharded_context.ipp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_IMPL_SHARDED_CONTEXT_IPP
+#define BOOST_ASIO_IMPL_SHARDED_CONTEXT_IPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <exception>
+#include <boost/asio/post.hpp>
+#include <boost/asio/sharded_context.hpp>
+#include <boost/asio/detail/cpu_affinity.hpp>
+#include <boost/asio/detail/thread.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+struct sharded_context::thread_function
+{
+  sharded_context* this_;
+  shard* shard_;
+  context_options options_;
+
+  void operator()()
+  {
+    if (detail::cpu_affinity::binds_threads(options_))
+    {
+      // Binding is best-effort. The shard still runs if it fails.
+      boost::system::error_code ec;
+      detail::cpu_affinity::bind_current_thread(
+          options_, shard_->index_, ec);
+    }
+
+    shard_call_stack::context ctx(this_, *shard_);
+
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    try
+    {
+#endif// !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      shard_->io_context_.run();
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    }
+    catch (...)
+    {
+      std::terminate();
+    }
+#endif// !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  }
+};
+
+struct sharded_context::drain_function
+{
+  sharded_context* this_;
+  shard* shard_;
+
+  void operator()()
+  {
+    this_->drain(*shard_);
+  }
+};
+
+struct sharded_context::drain_cleanup
+{
+  ~drain_cleanup()
+  {
+    // A function exited by throwing, so the remaining ones must be run by
+    // another drain.
+    if (!shard_->pending_.empty())
+      this_->start_drain(*shard_);
+  }
+
+  sharded_context* this_;
+  shard* shard_;
+};
+
+sharded_context::sharded_context()
+  : next_shard_(0)
+{
+  std::size_t num_shards = detail::cpu_affinity::available_cpu_count();
+  if (num_shards == 0)
+    num_shards = detail::thread::hardware_concurrency();
+  start(num_shards == 0 ? 1 : num_shards, context_options());
+}
+
+sharded_context::sharded_context(std::size_t num_shards)
+  : next_shard_(0)
+{
+  start(num_shards, context_options());
+}
+
+sharded_context::sharded_context(std::size_t num_shards,
+    const context_options& options)
+  : next_shard_(0)
+{
+  start(num_shards, options);
+}
+
+sharded_context::~sharded_context()
+{
+  stop();
+  join();
+}
+
+io_context& sharded_context::get_io_context()
+{
+  std::size_t n = next_shard_.fetch_add(1, std::memory_order_relaxed);
+  return shards_[n % shards_.size()]->io_context_;
+}
+
+std::size_t sharded_context::current_shard() const
+{
+  if (shard* s = shard_call_stack::contains(
+        const_cast<sharded_context*>(this)))
+    return s->index_;
+  return shards_.size();
+}
+
+void sharded_context::stop()
+{
+  for (std::size_t i = 0; i < shards_.size(); ++i)
+    shards_[i]->io_context_.stop();
+}
+
+void sharded_context::join()
+{
+  threads_.join();
+}
+
+void sharded_context::start(std::size_t num_shards,
+    const context_options& options)
+{
+  if (num_shards == 0)
+    num_shards = 1;
+
+  shards_.reserve(num_shards);
+  for (std::size_t i = 0; i < num_shards; ++i)
+    shards_.emplace_back(new shard(i, options));
+
+  for (std::size_t i = 0; i < num_shards; ++i)
+  {
+    thread_function f = { this, shards_[i].get(), options };
+    threads_.create_thread(f);
+  }
+}
+
+void sharded_context::start_drain(shard& s)
+{
+  drain_function f = { this, &s };
+  boost::asio::post(s.io_context_, f);
+}
+
+void sharded_context::drain(shard& s)
+{
+  s.inbox_.pop_all(s.pending_);
+
+  drain_cleanup on_exit = { this, &s };
+  (void)on_exit;
+
+  while (detail::operation* o = s.pending_.front())
+  {
+    s.pending_.pop();
+    o->complete(&s, boost::system::error_code(), 0);
+  }
+}
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_IMPL_SHARDED_CONTEXT_IPP
@@ -23,15 +23,19 @@
 #include <boost/asio/impl/any_io_executor.ipp>
 #include <boost/asio/impl/cancellation_signal.ipp>
 #include <boost/asio/impl/connect_pipe.ipp>
+#include <boost/asio/impl/current_processor.ipp>
 #include <boost/asio/impl/error.ipp>
 #include <boost/asio/impl/execution_context.ipp>
 #include <boost/asio/impl/executor.ipp>
 #include <boost/asio/impl/io_context.ipp>
 #include <boost/asio/impl/multiple_exceptions.ipp>
+#include <boost/asio/impl/provided_buffer_pool.ipp>
 #include <boost/asio/impl/serial_port_base.ipp>
+#include <boost/asio/impl/sharded_context.ipp>
 #include <boost/asio/impl/system_context.ipp>
 #include <boost/asio/impl/thread_pool.ipp>
 #include <boost/asio/detail/impl/buffer_sequence_adapter.ipp>
+#include <boost/asio/detail/impl/cpu_affinity.ipp>
 #include <boost/asio/detail/impl/descriptor_ops.ipp>
 #include <boost/asio/detail/impl/dev_poll_reactor.ipp>
 #include <boost/asio/detail/impl/epoll_reactor.ipp>
@@ -56,6 +60,7 @@
 #include <boost/asio/detail/impl/select_reactor.ipp>
 #include <boost/asio/detail/impl/service_registry.ipp>
 #include <boost/asio/detail/impl/signal_set_service.ipp>
+#include <boost/asio/detail/impl/socket_close_service.ipp>
 #include <boost/asio/detail/impl/socket_ops.ipp>
 #include <boost/asio/detail/impl/socket_select_interrupter.ipp>
 #include <boost/asio/detail/impl/strand_executor_service.ipp>
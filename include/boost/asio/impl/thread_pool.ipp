@@ -16,8 +16,17 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <climits>
 #include <stdexcept>
+#include <boost/asio/post.hpp>
 #include <boost/asio/thread_pool.hpp>
+#include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/cpu_affinity.hpp>
+#include <boost/asio/detail/event.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/scoped_ptr.hpp>
+#include <boost/asio/detail/thread.hpp>
 #include <boost/asio/detail/throw_exception.hpp>
 
 #include <boost/asio/detail/push_options.hpp>
@@ -47,6 +56,343 @@ struct thread_pool::thread_function
   }
 };
 
+struct thread_pool::bound_thread_function
+{
+  detail::scheduler* scheduler_;
+  context_options options_;
+  std::size_t index_;
+
+  void operator()()
+  {
+    // Binding is best-effort. The thread still runs if it fails.
+    boost::system::error_code ec;
+    detail::cpu_affinity::bind_current_thread(options_, index_, ec);
+
+    thread_function f = { scheduler_ };
+    f();
+  }
+};
+
+struct thread_pool::elastic_pool
+{
+  // A thread added by the pool in response to load.
+  struct worker
+  {
+    detail::thread* thread_;
+    bool retired_;
+    bool ran_probe_;
+    worker* next_;
+  };
+
+  // Used to find the worker that is running the calling thread.
+  typedef detail::call_stack<elastic_pool, worker> worker_call_stack;
+
+  elastic_pool(const thread_pool_elasticity& elasticity,
+      const context_options& options, std::size_t min_threads,
+      std::size_t max_threads)
+    : options_(options),
+      policy_(elasticity.policy()),
+      min_threads_(min_threads),
+      max_threads_(max_threads),
+      target_latency_(elasticity.target_latency()),
+      idle_timeout_(elasticity.idle_timeout()),
+      sample_usec_(to_usec(elasticity.sample_interval())),
+      idle_usec_(to_usec(elasticity.idle_timeout())),
+      shutdown_(false),
+      threads_(min_threads),
+      workers_(0),
+      supervisor_(0),
+      probe_start_(0),
+      queue_latency_(0)
+  {
+    if (!policy_)
+      policy_.reset(new thread_pool_resize_policy);
+  }
+
+  // Get the current time, in nanoseconds.
+  static uint64_t now()
+  {
+    return static_cast<uint64_t>(
+        chrono::duration_cast<chrono::nanoseconds>(
+          chrono::steady_clock::now().time_since_epoch()).count());
+  }
+
+  // Convert a duration to a timeout that the scheduler can wait for.
+  static long to_usec(chrono::nanoseconds d)
+  {
+    long long usec = chrono::duration_cast<chrono::microseconds>(d).count();
+    return usec < 1 ? 1 : usec > LONG_MAX ? LONG_MAX : static_cast<long>(usec);
+  }
+
+  // Describe the pool's load to the policy. Must be called with the mutex
+  // locked.
+  thread_pool_load load(uint64_t queue_latency) const
+  {
+    thread_pool_load l;
+    l.threads = threads_;
+    l.min_threads = min_threads_;
+    l.max_threads = max_threads_;
+    l.queue_latency = chrono::nanoseconds(
+        static_cast<chrono::nanoseconds::rep>(queue_latency));
+    l.target_latency = target_latency_;
+    l.idle_timeout = idle_timeout_;
+    return l;
+  }
+
+  // Ask the policy whether an idle thread may retire, and record the change
+  // if it does.
+  bool try_retire(worker* w, chrono::nanoseconds idle_time)
+  {
+    detail::mutex::scoped_lock lock(mutex_);
+    if (shutdown_ || threads_ <= min_threads_)
+      return false;
+
+    uint64_t latency = queue_latency_.load(std::memory_order_relaxed);
+    if (!policy_->should_retire(load(latency), idle_time))
+      return false;
+
+    thread_pool_resize_event event;
+    event.previous_threads = threads_;
+    event.threads = --threads_;
+    event.queue_latency = chrono::nanoseconds(
+        static_cast<chrono::nanoseconds::rep>(latency));
+    w->retired_ = true;
+    policy_->resized(event);
+    return true;
+  }
+
+  // Remove the threads that have retired from the list of workers. Must be
+  // called with the mutex locked.
+  worker* take_retired()
+  {
+    worker* retired = 0;
+    worker** p = &workers_;
+    while (worker* w = *p)
+    {
+      if (w->retired_)
+      {
+        *p = w->next_;
+        w->next_ = retired;
+        retired = w;
+      }
+      else
+      {
+        p = &w->next_;
+      }
+    }
+    return retired;
+  }
+
+  // Join and destroy a list of workers.
+  static void join_workers(worker* w)
+  {
+    while (w)
+    {
+      worker* next = w->next_;
+      w->thread_->join();
+      delete w->thread_;
+      delete w;
+      w = next;
+    }
+  }
+
+  // Options used to bind the threads to processors.
+  const context_options options_;
+
+  // Decides when the pool grows and shrinks.
+  std::shared_ptr<thread_pool_resize_policy> policy_;
+
+  // The limits on the number of threads.
+  const std::size_t min_threads_;
+  const std::size_t max_threads_;
+
+  // Values passed to the policy.
+  const chrono::nanoseconds target_latency_;
+  const chrono::nanoseconds idle_timeout_;
+
+  // How long the supervisor sleeps between measurements.
+  const long sample_usec_;
+
+  // How long an added thread waits for work before checking whether to
+  // retire.
+  const long idle_usec_;
+
+  // Protects the state below, and serialises calls to the policy.
+  detail::mutex mutex_;
+
+  // Used to wake the supervisor when the pool is joined.
+  detail::event wakeup_event_;
+
+  // Whether the supervisor should exit.
+  bool shutdown_;
+
+  // The number of threads that have not retired.
+  std::size_t threads_;
+
+  // The threads added by the pool.
+  worker* workers_;
+
+  // The thread that measures the load and adds threads.
+  detail::thread* supervisor_;
+
+  // The time at which the outstanding latency probe was posted, or zero.
+  std::atomic<uint64_t> probe_start_;
+
+  // The queue latency measured by the last probe to run.
+  std::atomic<uint64_t> queue_latency_;
+};
+
+struct thread_pool::elastic_thread_function
+{
+  thread_pool* pool_;
+  elastic_pool::worker* worker_;
+  std::size_t index_;
+
+  void operator()()
+  {
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    try
+    {
+#endif// !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      elastic_pool& e = *pool_->elastic_;
+
+      // Binding is best-effort. The thread still runs if it fails.
+      boost::system::error_code ec;
+      if (detail::cpu_affinity::binds_threads(e.options_))
+        detail::cpu_affinity::bind_current_thread(e.options_, index_, ec);
+
+      elastic_pool::worker_call_stack::context ctx(&e, *worker_);
+
+      uint64_t idle_start = elastic_pool::now();
+      for (;;)
+      {
+        // Running the supervisor's probe does not make a thread busy.
+        std::size_t n = pool_->scheduler_.wait_one(e.idle_usec_, ec);
+        bool ran_probe = worker_->ran_probe_;
+        worker_->ran_probe_ = false;
+        if (n && !ran_probe)
+        {
+          idle_start = elastic_pool::now();
+          continue;
+        }
+
+        if (pool_->scheduler_.stopped())
+          break;
+
+        chrono::nanoseconds idle_time(static_cast<chrono::nanoseconds::rep>(
+              elastic_pool::now() - idle_start));
+        if (e.try_retire(worker_, idle_time))
+          break;
+      }
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    }
+    catch (...)
+    {
+      std::terminate();
+    }
+#endif// !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  }
+};
+
+struct thread_pool::supervisor_function
+{
+  thread_pool* pool_;
+
+  // Measures the time that a function waits in the pool's queue.
+  struct probe
+  {
+    elastic_pool* pool_;
+    uint64_t start_;
+
+    void operator()()
+    {
+      pool_->queue_latency_.store(elastic_pool::now() - start_,
+          std::memory_order_relaxed);
+      pool_->probe_start_.store(0, std::memory_order_relaxed);
+      if (elastic_pool::worker* w =
+          elastic_pool::worker_call_stack::contains(pool_))
+        w->ran_probe_ = true;
+    }
+  };
+
+  void operator()()
+  {
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    try
+    {
+#endif// !defined(BOOST_ASIO_NO_EXCEPTIONS)
+      elastic_pool& e = *pool_->elastic_;
+      detail::mutex::scoped_lock lock(e.mutex_);
+      while (!e.shutdown_)
+      {
+        e.wakeup_event_.clear(lock);
+        e.wakeup_event_.wait_for_usec(lock, e.sample_usec_);
+        if (e.shutdown_)
+          break;
+
+        if (elastic_pool::worker* retired = e.take_retired())
+        {
+          lock.unlock();
+          elastic_pool::join_workers(retired);
+          lock.lock();
+          if (e.shutdown_)
+            break;
+        }
+
+        if (pool_->scheduler_.stopped())
+          continue;
+
+        // A probe that has not yet run has waited at least this long.
+        uint64_t now = elastic_pool::now();
+        uint64_t latency = e.queue_latency_.load(std::memory_order_relaxed);
+        uint64_t start = e.probe_start_.load(std::memory_order_relaxed);
+        if (start != 0)
+        {
+          if (now - start > latency)
+            latency = now - start;
+        }
+        else
+        {
+          e.probe_start_.store(now, std::memory_order_relaxed);
+          probe p = { &e, now };
+          boost::asio::post(*pool_, p);
+        }
+
+        std::size_t n = e.policy_->threads_to_add(e.load(latency));
+        if (n > e.max_threads_ - e.threads_)
+          n = e.max_threads_ - e.threads_;
+        if (n == 0)
+          continue;
+
+        thread_pool_resize_event event;
+        event.previous_threads = e.threads_;
+        for (std::size_t i = 0; i < n; ++i)
+        {
+          elastic_pool::worker* w = new elastic_pool::worker;
+          detail::scoped_ptr<elastic_pool::worker> scoped_worker(w);
+          w->retired_ = false;
+          w->ran_probe_ = false;
+          w->next_ = e.workers_;
+          elastic_thread_function f = { pool_, w, e.threads_ };
+          w->thread_ = new detail::thread(f);
+          e.workers_ = scoped_worker.release();
+          ++e.threads_;
+        }
+        event.threads = e.threads_;
+        event.queue_latency = chrono::nanoseconds(
+            static_cast<chrono::nanoseconds::rep>(latency));
+        e.policy_->resized(event);
+      }
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+    }
+    catch (...)
+    {
+      std::terminate();
+    }
+#endif// !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  }
+};
+
 #if !defined(BOOST_ASIO_NO_TS_EXECUTORS)
 namespace detail {
 
@@ -61,7 +407,8 @@ inline long default_thread_pool_size()
 
 thread_pool::thread_pool()
   : scheduler_(add_scheduler(new detail::scheduler(*this, 0, false))),
-    num_threads_(detail::default_thread_pool_size())
+    num_threads_(detail::default_thread_pool_size()),
+    elastic_(0)
 {
   scheduler_.work_started();
 
@@ -87,7 +434,8 @@ inline long clamp_thread_pool_size(std::size_t n)
 thread_pool::thread_pool(std::size_t num_threads)
   : scheduler_(add_scheduler(new detail::scheduler(
           *this, num_threads == 1 ? 1 : 0, false))),
-    num_threads_(detail::clamp_thread_pool_size(num_threads))
+    num_threads_(detail::clamp_thread_pool_size(num_threads)),
+    elastic_(0)
 {
   scheduler_.work_started();
 
@@ -95,11 +443,77 @@ thread_pool::thread_pool(std::size_t num_threads)
   threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
 }
 
+thread_pool::thread_pool(std::size_t num_threads,
+    const context_options& options)
+  : scheduler_(add_scheduler(new detail::scheduler(
+          *this, num_threads == 1 ? 1 : 0, false, options))),
+    num_threads_(detail::clamp_thread_pool_size(num_threads)),
+    elastic_(0)
+{
+  scheduler_.work_started();
+
+  if (detail::cpu_affinity::binds_threads(options))
+  {
+    for (std::size_t i = 0; i < num_threads; ++i)
+    {
+      bound_thread_function f = { &scheduler_, options, i };
+      threads_.create_thread(f);
+    }
+  }
+  else
+  {
+    thread_function f = { &scheduler_ };
+    threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
+  }
+}
+
+thread_pool::thread_pool(const thread_pool_elasticity& elasticity)
+  : scheduler_(add_scheduler(new detail::scheduler(*this, 0, false))),
+    num_threads_(detail::clamp_thread_pool_size(
+          elasticity.min_threads() ? elasticity.min_threads() : 1)),
+    elastic_(0)
+{
+  scheduler_.work_started();
+
+  thread_function f = { &scheduler_ };
+  threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
+
+  start_elastic_pool(elasticity, context_options());
+}
+
+thread_pool::thread_pool(const thread_pool_elasticity& elasticity,
+    const context_options& options)
+  : scheduler_(add_scheduler(new detail::scheduler(*this, 0, false, options))),
+    num_threads_(detail::clamp_thread_pool_size(
+          elasticity.min_threads() ? elasticity.min_threads() : 1)),
+    elastic_(0)
+{
+  scheduler_.work_started();
+
+  if (detail::cpu_affinity::binds_threads(options))
+  {
+    for (long i = 0; i < num_threads_; ++i)
+    {
+      bound_thread_function f = { &scheduler_, options,
+        static_cast<std::size_t>(i) };
+      threads_.create_thread(f);
+    }
+  }
+  else
+  {
+    thread_function f = { &scheduler_ };
+    threads_.create_threads(f, static_cast<std::size_t>(num_threads_));
+  }
+
+  start_elastic_pool(elasticity, options);
+}
+
 thread_pool::~thread_pool()
 {
   stop();
   join();
   shutdown();
+  delete elastic_;
 }
 
 void thread_pool::stop()
@@ -121,6 +535,49 @@ void thread_pool::join()
 
   if (!threads_.empty())
     threads_.join();
+
+  join_elastic_pool();
+}
+
+void thread_pool::start_elastic_pool(const thread_pool_elasticity& elasticity,
+    const context_options& options)
+{
+  std::size_t min_threads = static_cast<std::size_t>(num_threads_);
+  std::size_t max_threads = elasticity.max_threads();
+  if (max_threads == 0)
+    max_threads = detail::thread::hardware_concurrency() * 2;
+  if (max_threads < min_threads)
+    max_threads = min_threads;
+
+  elastic_ = new elastic_pool(elasticity, options, min_threads, max_threads);
+  if (max_threads > min_threads)
+  {
+    supervisor_function f = { this };
+    elastic_->supervisor_ = new detail::thread(f);
+  }
+}
+
+void thread_pool::join_elastic_pool()
+{
+  if (!elastic_)
+    return;
+
+  detail::mutex::scoped_lock lock(elastic_->mutex_);
+  elastic_->shutdown_ = true;
+  elastic_->wakeup_event_.signal(lock);
+  lock.unlock();
+
+  if (elastic_->supervisor_)
+  {
+    elastic_->supervisor_->join();
+    delete elastic_->supervisor_;
+    elastic_->supervisor_ = 0;
+  }
+
+  // The supervisor has exited, so the list of workers no longer changes.
+  elastic_pool::worker* workers = elastic_->workers_;
+  elastic_->workers_ = 0;
+  elastic_pool::join_workers(workers);
 }
 
 detail::scheduler& thread_pool::add_scheduler(detail::scheduler* s)
@@ -134,6 +591,12 @@ void thread_pool::wait()
 {
   scheduler_.work_finished();
   threads_.join();
+  join_elastic_pool();
+}
+
+context_metrics thread_pool::metrics() const
+{
+  return scheduler_.metrics();
 }
 
 } // namespace asio
@@ -25,6 +25,8 @@
 #include <boost/asio/detail/cstdint.hpp>
 #include <boost/asio/detail/wrapped_handler.hpp>
 #include <boost/system/error_code.hpp>
+#include <boost/asio/context_metrics.hpp>
+#include <boost/asio/context_options.hpp>
 #include <boost/asio/execution.hpp>
 #include <boost/asio/execution_context.hpp>
 
@@ -59,6 +61,9 @@ namespace detail {
     static constexpr uintptr_t blocking_never = 1;
     static constexpr uintptr_t relationship_continuation = 2;
     static constexpr uintptr_t outstanding_work_tracked = 4;
+    static constexpr uintptr_t priority_high = 8;
+    static constexpr uintptr_t priority_low = 16;
+    static constexpr uintptr_t priority_bits = 24;
     static constexpr uintptr_t runtime_bits = 3;
   };
 } // namespace detail
@@ -241,6 +246,20 @@ public:
    */
   BOOST_ASIO_DECL explicit io_context(int concurrency_hint);
 
+  /// Constructor.
+  /**
+   * Construct with a hint about the required level of concurrency, and
+   * options that control how the io_context schedules handlers.
+   *
+   * @param concurrency_hint A suggestion to the implementation on how many
+   * threads it should allow to run simultaneously.
+   *
+   * @param options The scheduling options. Some options may not be supported
+   * on all platforms, in which case they are ignored.
+   */
+  BOOST_ASIO_DECL io_context(int concurrency_hint,
+      const context_options& options);
+
   /// Destructor.
   /**
    * On destruction, the io_context performs the following sequence of
@@ -517,6 +536,13 @@ public:
    */
   BOOST_ASIO_DECL void restart();
 
+  /// Obtain a snapshot of the io_context object's scheduling activity.
+  /**
+   * This function returns the values of the io_context object's activity
+   * counters at the time of the call. It may be called from any thread.
+   */
+  BOOST_ASIO_DECL context_metrics metrics() const;
+
 #if !defined(BOOST_ASIO_NO_DEPRECATED)
   /// (Deprecated: Use restart().) Reset the io_context in preparation for a
   /// subsequent run() invocation.
@@ -789,6 +815,73 @@ private:
         context_ptr(), *this, bits());
   }
 
+  /// Obtain an executor with the @c priority.normal property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * boost::asio::require customisation point.
+   *
+   * For example:
+   * @code auto ex1 = my_io_context.get_executor();
+   * auto ex2 = boost::asio::require(ex1,
+   *     boost::asio::execution::priority.normal); @endcode
+   */
+  constexpr basic_executor_type<Allocator,
+      BOOST_ASIO_UNSPECIFIED(Bits & ~priority_bits)>
+  require(execution::priority_t::normal_t) const
+  {
+    return basic_executor_type<Allocator, Bits & ~priority_bits>(
+        context_ptr(), *this, bits());
+  }
+
+  /// Obtain an executor with the @c priority.high property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * boost::asio::require customisation point.
+   *
+   * Functions submitted through the resulting executor are run ahead of
+   * functions and completion handlers of normal and low priority that are
+   * waiting in the same io_context. To prevent starvation, the io_context
+   * still runs waiting normal priority work, and polls for I/O, after every
+   * context_options::priority_starvation_limit() high priority functions.
+   *
+   * For example:
+   * @code auto ex1 = my_io_context.get_executor();
+   * auto ex2 = boost::asio::require(ex1,
+   *     boost::asio::execution::priority.high); @endcode
+   */
+  constexpr basic_executor_type<Allocator,
+      BOOST_ASIO_UNSPECIFIED((Bits & ~priority_bits) | priority_high)>
+  require(execution::priority_t::high_t) const
+  {
+    return basic_executor_type<Allocator,
+        (Bits & ~priority_bits) | priority_high>(
+          context_ptr(), *this, bits());
+  }
+
+  /// Obtain an executor with the @c priority.low property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * boost::asio::require customisation point.
+   *
+   * Functions submitted through the resulting executor are run only when no
+   * higher priority work is waiting, or once every
+   * context_options::priority_starvation_limit() scheduling decisions that
+   * pass them over.
+   *
+   * For example:
+   * @code auto ex1 = my_io_context.get_executor();
+   * auto ex2 = boost::asio::require(ex1,
+   *     boost::asio::execution::priority.low); @endcode
+   */
+  constexpr basic_executor_type<Allocator,
+      BOOST_ASIO_UNSPECIFIED((Bits & ~priority_bits) | priority_low)>
+  require(execution::priority_t::low_t) const
+  {
+    return basic_executor_type<Allocator,
+        (Bits & ~priority_bits) | priority_low>(
+          context_ptr(), *this, bits());
+  }
+
   /// Obtain an executor with the specified @c allocator property.
   /**
    * Do not call this function directly. It is intended for use with the
@@ -829,6 +922,7 @@ private:
   friend struct boost_asio_query_fn::impl;
   friend struct boost::asio::execution::detail::mapping_t<0>;
   friend struct boost::asio::execution::detail::outstanding_work_t<0>;
+  friend struct boost::asio::execution::detail::priority_t<0>;
 #endif // !defined(GENERATING_DOCUMENTATION)
 
   /// Query the current value of the @c mapping property.
@@ -918,6 +1012,27 @@ private:
       : execution::outstanding_work_t(execution::outstanding_work.untracked);
   }
 
+  /// Query the current value of the @c priority property.
+  /**
+   * Do not call this function directly. It is intended for use with the
+   * boost::asio::query customisation point.
+   *
+   * For example:
+   * @code auto ex = my_io_context.get_executor();
+   * if (boost::asio::query(ex, boost::asio::execution::priority)
+   *       == boost::asio::execution::priority.high)
+   *   ... @endcode
+   */
+  static constexpr execution::priority_t query(
+      execution::priority_t) noexcept
+  {
+    return (Bits & priority_high)
+      ? execution::priority_t(execution::priority.high)
+      : (Bits & priority_low)
+        ? execution::priority_t(execution::priority.low)
+        : execution::priority_t(execution::priority.normal);
+  }
+
   /// Query the current value of the @c allocator property.
   /**
    * Do not call this function directly. It is intended for use with the
@@ -1325,6 +1440,42 @@ struct require_member<
       Allocator, Bits & ~outstanding_work_tracked> result_type;
 };
 
+template <typename Allocator, uintptr_t Bits>
+struct require_member<
+    boost::asio::io_context::basic_executor_type<Allocator, Bits>,
+    boost::asio::execution::priority_t::normal_t
+  > : boost::asio::detail::io_context_bits
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = false;
+  typedef boost::asio::io_context::basic_executor_type<
+      Allocator, Bits & ~priority_bits> result_type;
+};
+
+template <typename Allocator, uintptr_t Bits>
+struct require_member<
+    boost::asio::io_context::basic_executor_type<Allocator, Bits>,
+    boost::asio::execution::priority_t::high_t
+  > : boost::asio::detail::io_context_bits
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = false;
+  typedef boost::asio::io_context::basic_executor_type<
+      Allocator, (Bits & ~priority_bits) | priority_high> result_type;
+};
+
+template <typename Allocator, uintptr_t Bits>
+struct require_member<
+    boost::asio::io_context::basic_executor_type<Allocator, Bits>,
+    boost::asio::execution::priority_t::low_t
+  > : boost::asio::detail::io_context_bits
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = false;
+  typedef boost::asio::io_context::basic_executor_type<
+      Allocator, (Bits & ~priority_bits) | priority_low> result_type;
+};
+
 template <typename Allocator, uintptr_t Bits>
 struct require_member<
     boost::asio::io_context::basic_executor_type<Allocator, Bits>,
@@ -1378,6 +1529,32 @@ struct query_static_constexpr_member<
   }
 };
 
+template <typename Allocator, uintptr_t Bits, typename Property>
+struct query_static_constexpr_member<
+    boost::asio::io_context::basic_executor_type<Allocator, Bits>,
+    Property,
+    typename boost::asio::enable_if<
+      boost::asio::is_convertible<
+        Property,
+        boost::asio::execution::priority_t
+      >::value
+    >::type
+  > : boost::asio::detail::io_context_bits
+{
+  static constexpr bool is_valid = true;
+  static constexpr bool is_noexcept = true;
+  typedef boost::asio::execution::priority_t result_type;
+
+  static constexpr result_type value() noexcept
+  {
+    return (Bits & priority_high)
+      ? execution::priority_t(execution::priority.high)
+      : (Bits & priority_low)
+        ? execution::priority_t(execution::priority.low)
+        : execution::priority_t(execution::priority.normal);
+  }
+};
+
 template <typename Allocator, uintptr_t Bits, typename Property>
 struct query_static_constexpr_member<
     boost::asio::io_context::basic_executor_type<Allocator, Bits>,
@@ -486,6 +486,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_write_some(basic_stream_descriptor* self)
       : self_(self)
@@ -519,6 +520,7 @@ private:
   {
   public:
     typedef Executor executor_type;
+    typedef void accepts_timed_cancel_deadline;
 
     explicit initiate_async_read_some(basic_stream_descriptor* self)
       : self_(self)
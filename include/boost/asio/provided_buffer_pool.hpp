@@ -0,0 +1,347 @@
+//
+// provided_buffer_pool.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_PROVIDED_BUFFER_POOL_HPP
+#define BOOST_ASIO_PROVIDED_BUFFER_POOL_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <vector>
+#include <boost/asio/buffer.hpp>
+#include <boost/asio/detail/memory.hpp>
+#include <boost/asio/detail/mutex.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/execution/context.hpp>
+#include <boost/asio/execution/executor.hpp>
+#include <boost/asio/execution_context.hpp>
+#include <boost/asio/is_executor.hpp>
+#include <boost/asio/query.hpp>
+
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+# include <boost/asio/detail/io_uring_service.hpp>
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+class provided_buffer_pool;
+
+namespace detail {
+
+class provided_buffer_pool_access;
+
+} // namespace detail
+
+/// A buffer of received data, leased from a provided_buffer_pool.
+/**
+ * The buffer is returned to its pool when the lease is destroyed, or when
+ * release() is called. The pool must outlive all of its leases.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ */
+class leased_buffer
+{
+public:
+  /// Construct a lease that holds no buffer.
+  leased_buffer() noexcept
+    : pool_(0),
+      id_(0),
+      size_(0)
+  {
+  }
+
+  /// Move constructor.
+  leased_buffer(leased_buffer&& other) noexcept
+    : pool_(other.pool_),
+      id_(other.id_),
+      size_(other.size_)
+  {
+    other.pool_ = 0;
+    other.size_ = 0;
+  }
+
+  /// Return the buffer to its pool.
+  ~leased_buffer()
+  {
+    release();
+  }
+
+  /// Move assignment. Any buffer held by the lease is returned to its pool.
+  leased_buffer& operator=(leased_buffer&& other) noexcept
+  {
+    if (this != &other)
+    {
+      release();
+      pool_ = other.pool_;
+      id_ = other.id_;
+      size_ = other.size_;
+      other.pool_ = 0;
+      other.size_ = 0;
+    }
+    return *this;
+  }
+
+  /// Get the received data.
+  mutable_buffer data() const noexcept;
+
+  /// Get the number of bytes of received data.
+  std::size_t size() const noexcept
+  {
+    return size_;
+  }
+
+  /// Return the buffer to its pool before the lease is destroyed.
+  void release() noexcept;
+
+private:
+  friend class detail::provided_buffer_pool_access;
+
+  // Disallow copying and assignment.
+  leased_buffer(const leased_buffer&) = delete;
+  leased_buffer& operator=(const leased_buffer&) = delete;
+
+  leased_buffer(provided_buffer_pool* pool,
+      unsigned short id, std::size_t size) noexcept
+    : pool_(pool),
+      id_(id),
+      size_(size)
+  {
+  }
+
+  provided_buffer_pool* pool_;
+  unsigned short id_;
+  std::size_t size_;
+};
+
+/// A pool of equally sized buffers that receive operations take buffers from
+/// only when data arrives.
+/**
+ * An ordinary receive operation must be given a buffer when it is started, and
+ * the buffer is held for as long as the operation waits for data. A stream
+ * socket's async_receive_many operation instead takes a buffer from a pool
+ * each time data arrives, and passes it to the data handler as a
+ * leased_buffer. Many mostly idle connections may then share a small number of
+ * buffers.
+ *
+ * With the io_uring backend, the pool's buffers are registered with the
+ * execution context as a ring of provided buffers, and the kernel selects a
+ * buffer as data arrives. For portability, applications should assume that
+ * the number of pools registered with an execution context is limited.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Safe.
+ */
+class provided_buffer_pool
+  : private noncopyable
+{
+public:
+  /// Create a pool of buffers for an executor's execution context.
+  /**
+   * @param ex The executor whose execution context will receive data into the
+   * buffers.
+   *
+   * @param buffer_size The size of each buffer, in bytes.
+   *
+   * @param buffer_count The number of buffers. Must be a power of two that is
+   * no greater than 32768.
+   *
+   * @throws boost::system::system_error Thrown on failure. An error code of
+   * boost::asio::error::invalid_argument indicates that the buffer size or
+   * buffer count is not supported.
+   */
+  template <typename Executor>
+  provided_buffer_pool(const Executor& ex,
+      std::size_t buffer_size, std::size_t buffer_count,
+      constraint_t<
+        is_executor<Executor>::value || execution::is_executor<Executor>::value
+      > = 0)
+    : buffer_size_(buffer_size),
+      buffer_count_(buffer_count)
+  {
+    init(provided_buffer_pool::get_context(ex));
+  }
+
+  /// Create a pool of buffers for an execution context.
+  /**
+   * @param ctx The execution context that will receive data into the buffers.
+   *
+   * @param buffer_size The size of each buffer, in bytes.
+   *
+   * @param buffer_count The number of buffers. Must be a power of two that is
+   * no greater than 32768.
+   *
+   * @throws boost::system::system_error Thrown on failure. An error code of
+   * boost::asio::error::invalid_argument indicates that the buffer size or
+   * buffer count is not supported.
+   */
+  template <typename ExecutionContext>
+  provided_buffer_pool(ExecutionContext& ctx,
+      std::size_t buffer_size, std::size_t buffer_count,
+      constraint_t<
+        is_convertible<ExecutionContext&, execution_context&>::value
+      > = 0)
+    : buffer_size_(buffer_size),
+      buffer_count_(buffer_count)
+  {
+    init(ctx);
+  }
+
+  /// Destroys the pool, unregistering its buffers.
+  /**
+   * No receive operations using the pool may be outstanding, and no leases of
+   * its buffers may remain.
+   */
+  BOOST_ASIO_DECL ~provided_buffer_pool();
+
+  /// Get the size of each buffer, in bytes.
+  std::size_t buffer_size() const noexcept
+  {
+    return buffer_size_;
+  }
+
+  /// Get the number of buffers in the pool.
+  std::size_t buffer_count() const noexcept
+  {
+    return buffer_count_;
+  }
+
+private:
+  friend class leased_buffer;
+  friend class detail::provided_buffer_pool_access;
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<execution::is_executor<T>::value>* = 0)
+  {
+    return boost::asio::query(t, execution::context);
+  }
+
+  // Helper function to get an executor's context.
+  template <typename T>
+  static execution_context& get_context(const T& t,
+      enable_if_t<!execution::is_executor<T>::value>* = 0)
+  {
+    return t.context();
+  }
+
+  // Allocate the buffers and make them available for receiving.
+  BOOST_ASIO_DECL void init(execution_context& ctx);
+
+  // Take a buffer from the pool. Returns false if no buffer is available.
+  BOOST_ASIO_DECL bool acquire(unsigned short& id);
+
+  // Return a buffer to the pool.
+  BOOST_ASIO_DECL void release(unsigned short id) noexcept;
+
+  // Get the memory of the buffer with the given identifier.
+  mutable_buffer buffer(unsigned short id, std::size_t size) const noexcept
+  {
+    return mutable_buffer(storage_.get() + id * buffer_size_, size);
+  }
+
+  // The size of each buffer.
+  std::size_t buffer_size_;
+
+  // The number of buffers.
+  std::size_t buffer_count_;
+
+  // The memory for all buffers.
+  std::unique_ptr<unsigned char[]> storage_;
+
+  // Mutex to protect access to the available buffers.
+  detail::mutex mutex_;
+
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  // The io_uring service the buffers are registered with.
+  detail::io_uring_service* service_;
+
+  // The ring of buffers available to the kernel.
+  ::io_uring_buf_ring* ring_;
+
+  // The buffer group identifier of the ring.
+  int group_;
+#else // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  // The identifiers of the available buffers.
+  std::vector<unsigned short> available_;
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+};
+
+inline mutable_buffer leased_buffer::data() const noexcept
+{
+  return pool_ ? pool_->buffer(id_, size_) : mutable_buffer();
+}
+
+inline void leased_buffer::release() noexcept
+{
+  if (pool_)
+  {
+    pool_->release(id_);
+    pool_ = 0;
+    size_ = 0;
+  }
+}
+
+namespace detail {
+
+// Gives the implementation of receive operations access to a pool's buffers.
+class provided_buffer_pool_access
+{
+public:
+  static bool acquire(provided_buffer_pool& pool, unsigned short& id)
+  {
+    return pool.acquire(id);
+  }
+
+  static void release(provided_buffer_pool& pool, unsigned short id) noexcept
+  {
+    pool.release(id);
+  }
+
+  static mutable_buffer buffer(provided_buffer_pool& pool,
+      unsigned short id) noexcept
+  {
+    return pool.buffer(id, pool.buffer_size_);
+  }
+
+  static leased_buffer lease(provided_buffer_pool& pool,
+      unsigned short id, std::size_t size) noexcept
+  {
+    return leased_buffer(&pool, id, size);
+  }
+
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  static int group(const provided_buffer_pool& pool) noexcept
+  {
+    return pool.group_;
+  }
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+};
+
+} // namespace detail
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/provided_buffer_pool.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_PROVIDED_BUFFER_POOL_HPP
@@ -0,0 +1,390 @@
+//
+// sharded_acceptor.hpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_SHARDED_ACCEPTOR_HPP
+#define BOOST_ASIO_SHARDED_ACCEPTOR_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <boost/asio/basic_socket_acceptor.hpp>
+#include <boost/asio/error.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <boost/asio/sharded_context.hpp>
+#include <boost/asio/socket_base.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/socket_option.hpp>
+#include <boost/asio/detail/socket_types.hpp>
+#include <boost/asio/detail/throw_error.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// Accepts connections on behalf of all shards of a sharded_context.
+/**
+ * The sharded_acceptor class template spreads incoming connections across the
+ * shards of a sharded_context. Each accepted socket belongs to the io_context
+ * of the shard that receives it, and the connection handler is invoked on
+ * that shard's thread.
+ *
+ * Where the operating system supports load-balanced @c SO_REUSEPORT, every
+ * shard listens on its own socket bound to the same endpoint, and the kernel
+ * distributes connections between them. Otherwise, or if requested, a single
+ * socket owned by the first shard accepts all connections and hands them to
+ * the shards in round-robin order.
+ *
+ * @par Thread Safety
+ * @e Distinct @e objects: Safe.@n
+ * @e Shared @e objects: Unsafe.
+ *
+ * @par Example
+ * @code typedef boost::asio::sharded_acceptor<boost::asio::ip::tcp> acceptor;
+ *
+ * boost::asio::sharded_context shards(4);
+ * acceptor a(shards);
+ * a.listen(boost::asio::ip::tcp::endpoint(boost::asio::ip::tcp::v4(), 80));
+ * a.accept(
+ *     [](boost::system::error_code ec, acceptor::socket_type peer)
+ *     {
+ *       if (!ec)
+ *         std::make_shared<connection>(std::move(peer))->start();
+ *     }); @endcode
+ */
+template <typename Protocol>
+class sharded_acceptor
+  : private noncopyable
+{
+public:
+  /// The protocol type.
+  typedef Protocol protocol_type;
+
+  /// The endpoint type.
+  typedef typename Protocol::endpoint endpoint_type;
+
+  /// The type of the listening sockets.
+  typedef basic_socket_acceptor<Protocol,
+      io_context::executor_type> acceptor_type;
+
+  /// The type of the accepted sockets.
+  typedef typename Protocol::socket::template rebind_executor<
+      io_context::executor_type>::other socket_type;
+
+  /// Construct an acceptor that is not yet listening.
+  /**
+   * @param context The sharded context whose shards will receive the accepted
+   * connections.
+   *
+   * @param reuse_port If @c true, each shard listens on its own socket when
+   * the operating system supports it. If @c false, a single socket is always
+   * used.
+   */
+  explicit sharded_acceptor(sharded_context& context, bool reuse_port = true)
+    : impl_(std::make_shared<impl>(context)),
+      reuse_port_(reuse_port)
+  {
+  }
+
+  /// Destructor.
+  /**
+   * Closes the listening sockets. Connections that have already been accepted
+   * are still delivered to the handler.
+   */
+  ~sharded_acceptor()
+  {
+    close();
+  }
+
+  /// Open the listening sockets and start listening on an endpoint.
+  /**
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  void listen(const endpoint_type& endpoint,
+      int backlog = socket_base::max_listen_connections)
+  {
+    boost::system::error_code ec;
+    listen(endpoint, backlog, ec);
+    boost::asio::detail::throw_error(ec, "listen");
+  }
+
+  /// Open the listening sockets and start listening on an endpoint.
+  /**
+   * If the endpoint's port is zero, the port chosen for the first listening
+   * socket is used for all others.
+   *
+   * @param ec Set to indicate what error occurred, if any.
+   */
+  BOOST_ASIO_SYNC_OP_VOID listen(const endpoint_type& endpoint,
+      int backlog, boost::system::error_code& ec)
+  {
+    if (!impl_->acceptors_.empty())
+    {
+      ec = boost::asio::error::already_open;
+      BOOST_ASIO_SYNC_OP_VOID_RETURN(ec);
+    }
+
+    std::size_t num_acceptors = 1;
+#if defined(__linux__) && defined(SO_REUSEPORT)
+    // Only Linux load-balances connections between sockets that share a port.
+    if (reuse_port_)
+      num_acceptors = impl_->context_.size();
+#endif // defined(__linux__) && defined(SO_REUSEPORT)
+
+    endpoint_type bind_endpoint(endpoint);
+    for (std::size_t i = 0; i < num_acceptors; ++i)
+    {
+      std::unique_ptr<acceptor_type> a(
+          new acceptor_type(impl_->context_.get_io_context(i)));
+
+      a->open(bind_endpoint.protocol(), ec);
+      if (!ec)
+        a->set_option(socket_base::reuse_address(true), ec);
+#if defined(__linux__) && defined(SO_REUSEPORT)
+      if (!ec && num_acceptors > 1)
+        a->set_option(reuse_port_option(true), ec);
+#endif // defined(__linux__) && defined(SO_REUSEPORT)
+      if (!ec)
+        a->bind(bind_endpoint, ec);
+      if (!ec)
+        a->listen(backlog, ec);
+      if (!ec && i == 0)
+        bind_endpoint = a->local_endpoint(ec);
+      if (ec)
+      {
+        impl_->acceptors_.clear();
+        impl_->retry_timers_.clear();
+        BOOST_ASIO_SYNC_OP_VOID_RETURN(ec);
+      }
+
+      impl_->acceptors_.push_back(std::move(a));
+      impl_->retry_timers_.push_back(std::unique_ptr<steady_timer>(
+            new steady_timer(impl_->context_.get_io_context(i))));
+    }
+
+    BOOST_ASIO_SYNC_OP_VOID_RETURN(ec);
+  }
+
+  /// Get the number of listening sockets.
+  std::size_t size() const noexcept
+  {
+    return impl_->acceptors_.size();
+  }
+
+  /// Get the local endpoint of the listening sockets.
+  /**
+   * @throws boost::system::system_error Thrown on failure.
+   */
+  endpoint_type local_endpoint() const
+  {
+    if (impl_->acceptors_.empty())
+    {
+      boost::asio::detail::throw_error(boost::asio::error::bad_descriptor,
+          "local_endpoint");
+    }
+    return impl_->acceptors_[0]->local_endpoint();
+  }
+
+  /// Start accepting connections.
+  /**
+   * This function starts an accept loop for each listening socket. The loops
+   * run until close() is called or the sharded context is stopped.
+   *
+   * When an accept operation fails, the handler is called with the error and
+   * the loop waits for retry_delay() before accepting again. Errors such as
+   * running out of file descriptors persist until resources are released, and
+   * the loop would otherwise fail repeatedly without pause.
+   *
+   * @param handler The handler to be called for each accepted connection, or
+   * when an accept operation fails. A copy of the handler is made for each
+   * listening socket, and it is invoked on the thread of the shard that owns
+   * the accepted socket. The function signature of the handler must be:
+   * @code void handler(
+   *   const boost::system::error_code& error, // Result of operation.
+   *   socket_type peer // The accepted socket.
+   * ); @endcode
+   */
+  template <typename Handler>
+  void accept(Handler handler)
+  {
+    for (std::size_t i = 0; i < impl_->acceptors_.size(); ++i)
+    {
+      // The round-robin target is advanced before each accept, so the first
+      // connection goes to the first shard.
+      accept_loop<Handler> loop = { impl_, i, handler,
+        impl_->acceptors_.size() == 1 ? impl_->context_.size() - 1 : i };
+      boost::asio::post(impl_->acceptors_[i]->get_executor(),
+          start_function<Handler>{ std::move(loop) });
+    }
+  }
+
+  /// Close the listening sockets.
+  /**
+   * Each socket is closed on the thread of the shard that owns it, and any
+   * outstanding accept operation or retry delay on it is cancelled.
+   */
+  void close()
+  {
+    for (std::size_t i = 0; i < impl_->acceptors_.size(); ++i)
+    {
+      close_function f = { impl_, i };
+      boost::asio::post(impl_->acceptors_[i]->get_executor(), f);
+    }
+  }
+
+  /// The time an accept loop waits after a failed accept operation.
+  static constexpr chrono::milliseconds retry_delay() noexcept
+  {
+    return chrono::milliseconds(100);
+  }
+
+private:
+#if defined(__linux__) && defined(SO_REUSEPORT)
+  typedef boost::asio::detail::socket_option::boolean<
+    BOOST_ASIO_OS_DEF(SOL_SOCKET), SO_REUSEPORT> reuse_port_option;
+#endif // defined(__linux__) && defined(SO_REUSEPORT)
+
+  // State shared with the accept loops, which may outlive the acceptor.
+  struct impl
+  {
+    explicit impl(sharded_context& context)
+      : context_(context)
+    {
+    }
+
+    sharded_context& context_;
+    std::vector<std::unique_ptr<acceptor_type>> acceptors_;
+    std::vector<std::unique_ptr<steady_timer>> retry_timers_;
+  };
+
+  // Delivers an accepted socket to the handler on the socket's own shard.
+  template <typename Handler>
+  struct deliver_function
+  {
+    Handler handler_;
+    socket_type peer_;
+
+    void operator()()
+    {
+      handler_(boost::system::error_code(), std::move(peer_));
+    }
+  };
+
+  // Repeatedly accepts connections on a single listening socket.
+  template <typename Handler>
+  struct accept_loop
+  {
+    std::shared_ptr<impl> impl_;
+    std::size_t index_;
+    Handler handler_;
+    std::size_t target_;
+
+    void start()
+    {
+      acceptor_type& a = *impl_->acceptors_[index_];
+      if (!a.is_open())
+        return;
+
+      // With a single listening socket, accepted connections are handed to
+      // the shards in turn. Otherwise each socket's shard keeps its own.
+      if (impl_->acceptors_.size() == 1)
+        target_ = (target_ + 1) % impl_->context_.size();
+
+      io_context& ctx = impl_->context_.get_io_context(target_);
+      a.async_accept(ctx, std::move(*this));
+    }
+
+    void operator()(const boost::system::error_code& ec, socket_type peer)
+    {
+      if (ec == boost::asio::error::operation_aborted)
+        return;
+
+      if (ec)
+      {
+        handler_(ec, std::move(peer));
+
+        // Wait before accepting again, so that a persistent error does not
+        // make the loop spin.
+        steady_timer& timer = *impl_->retry_timers_[index_];
+        timer.expires_after(retry_delay());
+        timer.async_wait(retry_function<Handler>{ std::move(*this) });
+        return;
+      }
+
+      if (target_ == index_)
+      {
+        handler_(ec, std::move(peer));
+      }
+      else
+      {
+        deliver_function<Handler> d = { handler_, std::move(peer) };
+        impl_->context_.submit(target_, std::move(d));
+      }
+
+      start();
+    }
+  };
+
+  // Starts an accept loop on the listening socket's own shard.
+  template <typename Handler>
+  struct start_function
+  {
+    accept_loop<Handler> loop_;
+
+    void operator()()
+    {
+      loop_.start();
+    }
+  };
+
+  // Resumes an accept loop after a failed accept operation.
+  template <typename Handler>
+  struct retry_function
+  {
+    accept_loop<Handler> loop_;
+
+    void operator()(const boost::system::error_code& ec)
+    {
+      if (!ec)
+        loop_.start();
+    }
+  };
+
+  // Closes a listening socket on its own shard.
+  struct close_function
+  {
+    std::shared_ptr<impl> impl_;
+    std::size_t index_;
+
+    void operator()()
+    {
+      boost::system::error_code ignored_ec;
+      impl_->acceptors_[index_]->close(ignored_ec);
+      impl_->retry_timers_[index_]->cancel();
+    }
+  };
+
+  std::shared_ptr<impl> impl_;
+  bool reuse_port_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_SHARDED_ACCEPTOR_HPP
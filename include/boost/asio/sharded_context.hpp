@@ -0,0 +1,243 @@
+//
+// sharded_context.hpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_SHARDED_CONTEXT_HPP
+#define BOOST_ASIO_SHARDED_CONTEXT_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <atomic>
+#include <cstddef>
+#include <memory>
+#include <vector>
+#include <boost/asio/context_options.hpp>
+#include <boost/asio/executor_work_guard.hpp>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/detail/atomic_op_queue.hpp>
+#include <boost/asio/detail/call_stack.hpp>
+#include <boost/asio/detail/noncopyable.hpp>
+#include <boost/asio/detail/op_queue.hpp>
+#include <boost/asio/detail/operation.hpp>
+#include <boost/asio/detail/thread_group.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// A set of single-threaded io_context objects, each run by its own thread.
+/**
+ * The sharded_context class implements a thread-per-core, shared-nothing
+ * execution model. It owns a fixed number of shards, each of which consists of
+ * an io_context and a thread that runs it. I/O objects are created on a
+ * particular shard's io_context and are then only used from that shard's
+ * thread, so the shards do not need to lock their I/O state.
+ *
+ * Each shard's io_context is constructed with the
+ * @c BOOST_ASIO_CONCURRENCY_HINT_UNSAFE_IO concurrency hint. Functions may be
+ * posted to a shard's io_context from any thread, but I/O objects must only be
+ * used from within the shard's own thread.
+ *
+ * @par Submitting work to another shard
+ *
+ * The submit() function runs a function on a given shard. Functions submitted
+ * from other threads are added to a lock-free queue that belongs to the
+ * target shard, and the shard is woken only when that queue goes from empty to
+ * non-empty. When many functions are submitted to a shard in quick
+ * succession, each costs a single atomic operation rather than the lock and
+ * wakeup performed by @ref boost::asio::post.
+ *
+ * @par Example
+ * @code boost::asio::context_options options;
+ * options.pin_threads(true);
+ * boost::asio::sharded_context shards(4, options);
+ *
+ * // Run a function on shard 2.
+ * shards.submit(2,
+ *     []()
+ *     {
+ *       ...
+ *     });
+ *
+ * // Create a timer that belongs to the next shard in turn.
+ * boost::asio::steady_timer timer(shards.get_io_context());
+ * ...
+ *
+ * // Stop the shards and wait for their threads to exit.
+ * shards.stop();
+ * shards.join(); @endcode
+ */
+class sharded_context
+  : private noncopyable
+{
+public:
+  /// Constructs a sharded context with one shard per available processor.
+  BOOST_ASIO_DECL sharded_context();
+
+  /// Constructs a sharded context with the specified number of shards.
+  /**
+   * If @c num_shards is zero, a single shard is created.
+   */
+  BOOST_ASIO_DECL explicit sharded_context(std::size_t num_shards);
+
+  /// Constructs a sharded context with the specified number of shards and
+  /// options.
+  /**
+   * The options are used to construct each shard's io_context. If
+   * context_options::pin_threads() is set, each shard's thread is bound to a
+   * different processor. The shard threads may instead be bound to chosen
+   * processors or NUMA nodes using context_options::processors() or
+   * context_options::numa_nodes().
+   */
+  BOOST_ASIO_DECL sharded_context(std::size_t num_shards,
+      const context_options& options);
+
+  /// Destructor.
+  /**
+   * Stops the shards and joins their threads.
+   */
+  BOOST_ASIO_DECL ~sharded_context();
+
+  /// Get the number of shards.
+  std::size_t size() const noexcept
+  {
+    return shards_.size();
+  }
+
+  /// Get the io_context of a shard.
+  /**
+   * @param index The index of the shard. Must be less than size().
+   */
+  io_context& get_io_context(std::size_t index)
+  {
+    return shards_[index]->io_context_;
+  }
+
+  /// Get the io_context of the next shard in turn.
+  /**
+   * Successive calls return the shards' io_context objects in round-robin
+   * order. This function may be called from any thread.
+   */
+  BOOST_ASIO_DECL io_context& get_io_context();
+
+  /// Get the index of the shard that is running the calling thread.
+  /**
+   * @returns The index of the shard whose thread is calling the function, or
+   * size() if the function is called from any other thread.
+   */
+  BOOST_ASIO_DECL std::size_t current_shard() const;
+
+  /// Run a function on a shard.
+  /**
+   * The function is never invoked from within submit(). Functions submitted to
+   * the same shard from a single thread are invoked in the order in which they
+   * were submitted.
+   *
+   * @param index The index of the shard. Must be less than size().
+   *
+   * @param f The function to be run. It must be callable as @c f(), and is
+   * decay-copied into storage owned by the target shard.
+   */
+  template <typename Function>
+  void submit(std::size_t index, Function&& f);
+
+  /// Stop all shards.
+  /**
+   * This function stops each shard's io_context as soon as possible. Functions
+   * that have been submitted but not yet run may never be invoked.
+   */
+  BOOST_ASIO_DECL void stop();
+
+  /// Join the shards' threads.
+  /**
+   * This function blocks until the threads have completed. The shards keep
+   * running, even when they have no work, until stop() is called, since any
+   * shard may be given more work by another. A call to join() that is not
+   * preceded by a call to stop() therefore blocks until some other thread, or
+   * a function running on one of the shards, calls stop().
+   */
+  BOOST_ASIO_DECL void join();
+
+private:
+  // The state of a single shard.
+  struct shard
+  {
+    shard(std::size_t index, const context_options& options)
+      : index_(index),
+        io_context_(BOOST_ASIO_CONCURRENCY_HINT_UNSAFE_IO, options),
+        work_(io_context_.get_executor())
+    {
+    }
+
+    // The position of the shard within the context.
+    std::size_t index_;
+
+    // The io_context that is run by the shard's thread.
+    io_context io_context_;
+
+    // Keeps the io_context running until it is stopped.
+    executor_work_guard<io_context::executor_type> work_;
+
+    // Functions submitted from other threads.
+    detail::atomic_op_queue<detail::operation> inbox_;
+
+    // Functions taken from the inbox that have not yet been run.
+    detail::op_queue<detail::operation> pending_;
+  };
+
+  // Used to find the shard that is running the calling thread.
+  typedef detail::call_stack<sharded_context, shard> shard_call_stack;
+
+  // Helper class to run a shard's io_context in its own thread.
+  struct thread_function;
+  friend struct thread_function;
+
+  // Function object that runs the functions in a shard's inbox.
+  struct drain_function;
+  friend struct drain_function;
+
+  // Helper class to schedule another drain if one exits early.
+  struct drain_cleanup;
+  friend struct drain_cleanup;
+
+  // Create the shards and start their threads.
+  BOOST_ASIO_DECL void start(std::size_t num_shards,
+      const context_options& options);
+
+  // Schedule the running of the functions in a shard's inbox.
+  BOOST_ASIO_DECL void start_drain(shard& s);
+
+  // Run the functions in a shard's inbox. Called on the shard's thread.
+  BOOST_ASIO_DECL void drain(shard& s);
+
+  // The shards.
+  std::vector<std::unique_ptr<shard>> shards_;
+
+  // The threads that run the shards.
+  detail::thread_group threads_;
+
+  // The next shard to be returned by get_io_context().
+  std::atomic<std::size_t> next_shard_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#include <boost/asio/impl/sharded_context.hpp>
+#if defined(BOOST_ASIO_HEADER_ONLY)
+# include <boost/asio/impl/sharded_context.ipp>
+#endif // defined(BOOST_ASIO_HEADER_ONLY)
+
+#endif // BOOST_ASIO_SHARDED_CONTEXT_HPP
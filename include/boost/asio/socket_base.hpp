@@ -504,6 +504,139 @@ public:
     enable_connection_aborted;
 #endif
 
+  /// Socket option to wake only one waiting context when a connection arrives.
+  /**
+   * Implements a custom socket option that determines whether, when several
+   * io_context objects wait on the same listening socket (for example, on
+   * descriptors obtained with @c dup() and passed to assign()), an incoming
+   * connection wakes only one of them. By default the option is false, and
+   * every waiting context is woken.
+   *
+   * The option must be set on each acceptor after it is opened. It is
+   * implemented using @c EPOLLEXCLUSIVE on Linux. With I/O completion ports,
+   * or when io_uring is the default backend, each completion already wakes a
+   * single thread and the option is only recorded. With other reactors,
+   * setting the option to true fails with
+   * boost::asio::error::operation_not_supported.
+   *
+   * An exclusive epoll registration cannot include @c EPOLLPRI. While the
+   * option is set, the socket is not monitored for exceptional conditions, and
+   * operations that wait for them, such as an async_wait() for
+   * socket_base::wait_error or a receive of out-of-band data, are not woken.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * boost::asio::socket_base::exclusive_wakeup option(true);
+   * acceptor.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::tcp::acceptor acceptor(my_context);
+   * ...
+   * boost::asio::socket_base::exclusive_wakeup option;
+   * acceptor.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined exclusive_wakeup;
+#else
+  typedef boost::asio::detail::socket_option::boolean<
+    boost::asio::detail::custom_socket_option_level,
+    boost::asio::detail::exclusive_wakeup_option>
+    exclusive_wakeup;
+#endif
+
+  /// Socket option for the time to busy poll the device queue on receive.
+  /**
+   * Implements the SOL_SOCKET/SO_BUSY_POLL socket option. The value is the
+   * approximate time in microseconds to busy poll the network device's receive
+   * queue when no data is available. Raising the value above the system
+   * default usually requires elevated privileges. Where the option is not
+   * supported, setting or getting it fails with
+   * boost::asio::error::invalid_argument.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::udp::socket socket(my_context);
+   * ...
+   * boost::asio::socket_base::busy_poll option(50);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::udp::socket socket(my_context);
+   * ...
+   * boost::asio::socket_base::busy_poll option;
+   * socket.get_option(option);
+   * int usec = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Integer_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined busy_poll;
+#elif defined(SO_BUSY_POLL)
+  typedef boost::asio::detail::socket_option::integer<
+    BOOST_ASIO_OS_DEF(SOL_SOCKET), SO_BUSY_POLL> busy_poll;
+#else
+  typedef boost::asio::detail::socket_option::integer<
+    boost::asio::detail::custom_socket_option_level,
+    boost::asio::detail::always_fail_option> busy_poll;
+#endif
+
+  /// Socket option to prefer busy polling over interrupt-driven processing.
+  /**
+   * Implements the SOL_SOCKET/SO_PREFER_BUSY_POLL socket option. When set,
+   * the kernel defers the device's interrupt processing while the socket is
+   * being busy polled. Where the option is not supported, setting or getting
+   * it fails with boost::asio::error::invalid_argument.
+   *
+   * @par Examples
+   * Setting the option:
+   * @code
+   * boost::asio::ip::udp::socket socket(my_context);
+   * ...
+   * boost::asio::socket_base::prefer_busy_poll option(true);
+   * socket.set_option(option);
+   * @endcode
+   *
+   * @par
+   * Getting the current option value:
+   * @code
+   * boost::asio::ip::udp::socket socket(my_context);
+   * ...
+   * boost::asio::socket_base::prefer_busy_poll option;
+   * socket.get_option(option);
+   * bool is_set = option.value();
+   * @endcode
+   *
+   * @par Concepts:
+   * Socket_Option, Boolean_Socket_Option.
+   */
+#if defined(GENERATING_DOCUMENTATION)
+  typedef implementation_defined prefer_busy_poll;
+#elif defined(SO_PREFER_BUSY_POLL)
+  typedef boost::asio::detail::socket_option::boolean<
+    BOOST_ASIO_OS_DEF(SOL_SOCKET), SO_PREFER_BUSY_POLL> prefer_busy_poll;
+#else
+  typedef boost::asio::detail::socket_option::boolean<
+    boost::asio::detail::custom_socket_option_level,
+    boost::asio::detail::always_fail_option> prefer_busy_poll;
+#endif
+
   /// IO control command to get the amount of data that can be read without
   /// blocking.
   /**
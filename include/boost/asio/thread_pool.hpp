@@ -16,6 +16,9 @@
 #endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
 
 #include <boost/asio/detail/config.hpp>
+#include <boost/asio/context_metrics.hpp>
+#include <boost/asio/context_options.hpp>
+#include <boost/asio/thread_pool_elasticity.hpp>
 #include <boost/asio/detail/atomic_count.hpp>
 #include <boost/asio/detail/scheduler.hpp>
 #include <boost/asio/detail/thread_group.hpp>
@@ -40,7 +43,9 @@ namespace detail {
 /// A simple fixed-size thread pool.
 /**
  * The thread pool class is an execution context where functions are permitted
- * to run on one of a fixed number of threads.
+ * to run on one of a fixed number of threads. A pool constructed with a
+ * thread_pool_elasticity object instead adds and retires threads as its load
+ * changes.
  *
  * @par Submitting tasks to the pool
  *
@@ -93,6 +98,37 @@ public:
   /// Constructs a pool with a specified number of threads.
   BOOST_ASIO_DECL thread_pool(std::size_t num_threads);
 
+  /// Constructs a pool with a specified number of threads and options that
+  /// control how the pool schedules submitted functions.
+  /**
+   * If the options set context_options::processors(),
+   * context_options::numa_nodes() or context_options::pin_threads(), each of
+   * the pool's threads is bound accordingly before it starts running
+   * submitted functions. Threads that join the pool by calling attach() are
+   * not bound.
+   */
+  BOOST_ASIO_DECL thread_pool(std::size_t num_threads,
+      const context_options& options);
+
+  /// Constructs a pool whose number of threads follows its load.
+  /**
+   * The pool starts thread_pool_elasticity::min_threads() threads, and adds
+   * and retires threads as described by @c elasticity. Threads that the pool
+   * adds in response to load run submitted functions one at a time from the
+   * shared queue.
+   */
+  BOOST_ASIO_DECL explicit thread_pool(
+      const thread_pool_elasticity& elasticity);
+
+  /// Constructs a pool whose number of threads follows its load, with options
+  /// that control how the pool schedules submitted functions.
+  /**
+   * If the options bind threads to processors, each thread is bound according
+   * to its position among the pool's threads when it starts.
+   */
+  BOOST_ASIO_DECL thread_pool(const thread_pool_elasticity& elasticity,
+      const context_options& options);
+
   /// Destructor.
   /**
    * Automatically stops and joins the pool, if not explicitly done beforehand.
@@ -136,15 +172,42 @@ public:
    */
   BOOST_ASIO_DECL void wait();
 
+  /// Obtain a snapshot of the pool's scheduling activity.
+  /**
+   * This function returns the values of the pool's activity counters at the
+   * time of the call. It may be called from any thread.
+   */
+  BOOST_ASIO_DECL context_metrics metrics() const;
+
 private:
   thread_pool(const thread_pool&) = delete;
   thread_pool& operator=(const thread_pool&) = delete;
 
   struct thread_function;
 
+  // Helper class to bind a thread to processors before running the pool.
+  struct bound_thread_function;
+
   // Helper function to create the underlying scheduler.
   BOOST_ASIO_DECL detail::scheduler& add_scheduler(detail::scheduler* s);
 
+  // The state of an elastic pool.
+  struct elastic_pool;
+
+  // Helper class to run a thread that the elastic pool may retire.
+  struct elastic_thread_function;
+
+  // Helper class to run the elastic pool's supervisor thread.
+  struct supervisor_function;
+
+  // Start the elastic pool's supervisor thread.
+  BOOST_ASIO_DECL void start_elastic_pool(
+      const thread_pool_elasticity& elasticity,
+      const context_options& options);
+
+  // Stop the elastic pool's supervisor and join the threads it added.
+  BOOST_ASIO_DECL void join_elastic_pool();
+
   // The underlying scheduler.
   detail::scheduler& scheduler_;
 
@@ -153,6 +216,9 @@ private:
 
   // The current number of threads in the pool.
   detail::atomic_count num_threads_;
+
+  // The state used to grow and shrink the pool, if it is elastic.
+  elastic_pool* elastic_;
 };
 
 /// Executor implementation type used to submit functions to a thread pool.
@@ -0,0 +1,243 @@
+//
+// thread_pool_elasticity.hpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#ifndef BOOST_ASIO_THREAD_POOL_ELASTICITY_HPP
+#define BOOST_ASIO_THREAD_POOL_ELASTICITY_HPP
+
+#if defined(_MSC_VER) && (_MSC_VER >= 1200)
+# pragma once
+#endif // defined(_MSC_VER) && (_MSC_VER >= 1200)
+
+#include <boost/asio/detail/config.hpp>
+#include <cstddef>
+#include <memory>
+#include <boost/asio/detail/chrono.hpp>
+
+#include <boost/asio/detail/push_options.hpp>
+
+namespace boost {
+namespace asio {
+
+/// The load on an elastic thread pool, as seen by its resize policy.
+struct thread_pool_load
+{
+  /// The number of threads that the pool has started and not yet retired.
+  std::size_t threads;
+
+  /// The fewest threads that the pool may have.
+  std::size_t min_threads;
+
+  /// The most threads that the pool may have.
+  std::size_t max_threads;
+
+  /// The time that a function recently waited in the pool's queue before it
+  /// was run.
+  chrono::nanoseconds queue_latency;
+
+  /// The queue latency above which the pool should grow.
+  chrono::nanoseconds target_latency;
+
+  /// The time after which an idle thread should retire.
+  chrono::nanoseconds idle_timeout;
+};
+
+/// Describes a change in the number of threads in an elastic thread pool.
+struct thread_pool_resize_event
+{
+  /// The number of threads before the change.
+  std::size_t previous_threads;
+
+  /// The number of threads after the change.
+  std::size_t threads;
+
+  /// The queue latency that was last measured before the change.
+  chrono::nanoseconds queue_latency;
+};
+
+/// Decides when an elastic thread pool grows and shrinks.
+/**
+ * The default implementation adds one thread each time the measured queue
+ * latency exceeds the target, and retires a thread once it has been idle for
+ * the idle timeout. Derived classes may override any of the virtual functions
+ * to change the policy, or to observe the pool's resize events.
+ *
+ * The pool never grows beyond thread_pool_load::max_threads, or shrinks
+ * below thread_pool_load::min_threads, whatever the policy returns. The pool
+ * serialises calls to the policy, which are made from the pool's own
+ * threads. The policy must not call any function that blocks until the pool's
+ * threads have finished, such as thread_pool::join().
+ */
+class thread_pool_resize_policy
+{
+public:
+  /// Destructor.
+  virtual ~thread_pool_resize_policy()
+  {
+  }
+
+  /// Get the number of threads to add to the pool.
+  /**
+   * Called once per sample interval, after the queue latency is measured.
+   */
+  virtual std::size_t threads_to_add(const thread_pool_load& load)
+  {
+    return load.queue_latency > load.target_latency ? 1 : 0;
+  }
+
+  /// Determine whether an idle thread should retire.
+  /**
+   * Called by a thread that has not run a function for the specified time.
+   */
+  virtual bool should_retire(const thread_pool_load& load,
+      chrono::nanoseconds idle_time)
+  {
+    return idle_time >= load.idle_timeout;
+  }
+
+  /// Called after threads have been added to, or retired from, the pool.
+  virtual void resized(const thread_pool_resize_event& event)
+  {
+    (void)event;
+  }
+};
+
+/// Settings for a thread pool whose number of threads follows its load.
+/**
+ * An elastic thread pool keeps min_threads() threads running at all times.
+ * Once per sample_interval(), the pool measures how long a function waits in
+ * its queue before it is run. When this queue latency exceeds
+ * target_latency(), the pool adds threads, up to max_threads(). A thread
+ * added in this way retires when it has been idle for idle_timeout().
+ *
+ * @par Example
+ * @code boost::asio::thread_pool_elasticity elasticity;
+ * elasticity.min_threads(2);
+ * elasticity.max_threads(32);
+ * elasticity.target_latency(boost::asio::chrono::microseconds(500));
+ * boost::asio::thread_pool pool(elasticity); @endcode
+ */
+class thread_pool_elasticity
+{
+public:
+  /// Default constructor.
+  thread_pool_elasticity() noexcept
+    : min_threads_(1),
+      max_threads_(0),
+      target_latency_(chrono::milliseconds(1)),
+      idle_timeout_(chrono::seconds(10)),
+      sample_interval_(chrono::milliseconds(10))
+  {
+  }
+
+  /// Get the fewest threads that the pool may have.
+  std::size_t min_threads() const noexcept
+  {
+    return min_threads_;
+  }
+
+  /// Set the fewest threads that the pool may have.
+  /**
+   * These threads are started when the pool is constructed and never retire.
+   * A value of zero is treated as one, so that the pool can always make
+   * progress. The default is one.
+   */
+  void min_threads(std::size_t value) noexcept
+  {
+    min_threads_ = value;
+  }
+
+  /// Get the most threads that the pool may have.
+  std::size_t max_threads() const noexcept
+  {
+    return max_threads_;
+  }
+
+  /// Set the most threads that the pool may have.
+  /**
+   * A value less than min_threads() is treated as min_threads(). The default
+   * value of zero selects twice the number of processors.
+   */
+  void max_threads(std::size_t value) noexcept
+  {
+    max_threads_ = value;
+  }
+
+  /// Get the queue latency above which the pool grows.
+  chrono::nanoseconds target_latency() const noexcept
+  {
+    return target_latency_;
+  }
+
+  /// Set the queue latency above which the pool grows.
+  void target_latency(chrono::nanoseconds value) noexcept
+  {
+    target_latency_ = value;
+  }
+
+  /// Get the time after which an idle thread retires.
+  chrono::nanoseconds idle_timeout() const noexcept
+  {
+    return idle_timeout_;
+  }
+
+  /// Set the time after which an idle thread retires.
+  void idle_timeout(chrono::nanoseconds value) noexcept
+  {
+    idle_timeout_ = value;
+  }
+
+  /// Get the interval at which the queue latency is measured.
+  chrono::nanoseconds sample_interval() const noexcept
+  {
+    return sample_interval_;
+  }
+
+  /// Set the interval at which the queue latency is measured.
+  /**
+   * Each measurement posts a function to the pool, so a shorter interval lets
+   * the pool react to bursts sooner at the cost of more wakeups while it is
+   * idle.
+   */
+  void sample_interval(chrono::nanoseconds value) noexcept
+  {
+    sample_interval_ = value;
+  }
+
+  /// Get the policy that decides when the pool grows and shrinks.
+  const std::shared_ptr<thread_pool_resize_policy>& policy() const noexcept
+  {
+    return policy_;
+  }
+
+  /// Set the policy that decides when the pool grows and shrinks.
+  /**
+   * If no policy is set, a default-constructed thread_pool_resize_policy is
+   * used.
+   */
+  void policy(std::shared_ptr<thread_pool_resize_policy> value) noexcept
+  {
+    policy_ = static_cast<std::shared_ptr<thread_pool_resize_policy>&&>(value);
+  }
+
+private:
+  std::size_t min_threads_;
+  std::size_t max_threads_;
+  chrono::nanoseconds target_latency_;
+  chrono::nanoseconds idle_timeout_;
+  chrono::nanoseconds sample_interval_;
+  std::shared_ptr<thread_pool_resize_policy> policy_;
+};
+
+} // namespace asio
+} // namespace boost
+
+#include <boost/asio/detail/pop_options.hpp>
+
+#endif // BOOST_ASIO_THREAD_POOL_ELASTICITY_HPP
@@ -18,7 +18,10 @@
 
 #include <functional>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/steady_timer.hpp>
+#include <boost/asio/write.hpp>
 #include "unit_test.hpp"
 
 using namespace boost::asio;
@@ -505,6 +508,125 @@ void partial_cancel_after_timer_test()
   BOOST_ASIO_CHECK(count == 1);
 }
 
+struct immediate_initiation
+{
+  typedef io_context::executor_type executor_type;
+
+  executor_type get_executor() const noexcept
+  {
+    return ex_;
+  }
+
+  template <typename Handler>
+  void operator()(Handler&& handler) const
+  {
+    static_cast<Handler&&>(handler)(boost::system::error_code());
+  }
+
+  executor_type ex_;
+};
+
+void increment_on_success(int* count, const boost::system::error_code& error)
+{
+  if (!error)
+    ++(*count);
+}
+
+template <typename CompletionToken>
+void async_immediate(io_context& ioc, CompletionToken&& token)
+{
+  immediate_initiation initiation = { ioc.get_executor() };
+  async_initiate<CompletionToken, void(boost::system::error_code)>(
+      initiation, token);
+}
+
+void cancel_after_immediate_completion_test()
+{
+  io_context ioc;
+  int count = 0;
+
+  async_immediate(ioc,
+      cancel_after(chronons::seconds(5),
+        bindns::bind(&increment_on_success,
+          &count, bindns::placeholders::_1)));
+
+  // The handler is called once the timer has been cancelled.
+  BOOST_ASIO_CHECK(count == 0);
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+}
+
+void cancel_after_socket_test()
+{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  io_context ioc;
+  int count = 0;
+
+  local::stream_protocol::socket s1(ioc);
+  local::stream_protocol::socket s2(ioc);
+  local::connect_pair(s1, s2);
+
+  char data[16];
+  s2.async_receive(buffer(data),
+      cancel_after(chronons::milliseconds(100),
+        bindns::bind(&increment_on_cancel,
+          &count, bindns::placeholders::_1)));
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+
+  write(s1, buffer("hello", 5));
+  s2.async_receive(buffer(data),
+      cancel_after(chronons::seconds(5),
+        bindns::bind(&increment_on_success,
+          &count, bindns::placeholders::_1)));
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 2);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void cancel_after_queued_socket_test()
+{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  io_context ioc;
+  int count = 0;
+
+  local::stream_protocol::socket s1(ioc);
+  local::stream_protocol::socket s2(ioc);
+  local::connect_pair(s1, s2);
+
+  // The second receive waits behind the first, and must still be cancelled at
+  // its own deadline.
+  char data1[16];
+  s2.async_receive(buffer(data1),
+      cancel_after(chronons::seconds(5),
+        bindns::bind(&increment_on_cancel,
+          &count, bindns::placeholders::_1)));
+
+  char data2[16];
+  s2.async_receive(buffer(data2),
+      cancel_after(chronons::milliseconds(100),
+        bindns::bind(&increment_on_cancel,
+          &count, bindns::placeholders::_1)));
+
+  ioc.run_for(chronons::seconds(2));
+
+  BOOST_ASIO_CHECK(count == 1);
+
+  s2.cancel();
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(count == 2);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
 BOOST_ASIO_TEST_SUITE
 (
   "cancel_after",
@@ -516,4 +638,7 @@ BOOST_ASIO_TEST_SUITE
   BOOST_ASIO_TEST_CASE(cancel_after_timer_completion_token_v2_test)
   BOOST_ASIO_TEST_CASE(partial_cancel_after_test)
   BOOST_ASIO_TEST_CASE(partial_cancel_after_timer_test)
+  BOOST_ASIO_TEST_CASE(cancel_after_immediate_completion_test)
+  BOOST_ASIO_TEST_CASE(cancel_after_socket_test)
+  BOOST_ASIO_TEST_CASE(cancel_after_queued_socket_test)
 )
@@ -0,0 +1,62 @@
+//
+// context_metrics.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/context_metrics.hpp>
+
+#include "unit_test.hpp"
+
+void context_metrics_test()
+{
+  boost::asio::context_metrics m;
+
+  BOOST_ASIO_CHECK(m.spin_count() == 0);
+  BOOST_ASIO_CHECK(m.spin_hits() == 0);
+  BOOST_ASIO_CHECK(m.spin_misses() == 0);
+  BOOST_ASIO_CHECK(m.spin_time() == boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(m.poll_budget_handler_hits() == 0);
+  BOOST_ASIO_CHECK(m.poll_budget_time_hits() == 0);
+  BOOST_ASIO_CHECK(m.handlers_run() == 0);
+  BOOST_ASIO_CHECK(m.queue_depth() == 0);
+  BOOST_ASIO_CHECK(m.busy_time() == boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(m.idle_time() == boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(m.reactor_polls() == 0);
+  BOOST_ASIO_CHECK(m.reactor_events() == 0);
+  BOOST_ASIO_CHECK(m.registered_descriptors() == 0);
+  BOOST_ASIO_CHECK(m.descriptor_state_size() == 0);
+  BOOST_ASIO_CHECK(m.descriptor_state_memory() == 0);
+  BOOST_ASIO_CHECK(m.io_uring_cq_overflows() == 0);
+  BOOST_ASIO_CHECK(m.io_uring_sq_full_flushes() == 0);
+  BOOST_ASIO_CHECK(m.io_uring_submits() == 0);
+  BOOST_ASIO_CHECK(m.io_uring_submitted_entries() == 0);
+  BOOST_ASIO_CHECK(m.threads().empty());
+
+  const std::size_t buckets = boost::asio::context_metrics::histogram_buckets;
+  for (std::size_t i = 0; i < buckets; ++i)
+  {
+    BOOST_ASIO_CHECK(m.queue_wait_histogram(i) == 0);
+    BOOST_ASIO_CHECK(m.poll_events_histogram(i) == 0);
+  }
+  BOOST_ASIO_CHECK(m.queue_wait_histogram(buckets) == 0);
+
+  boost::asio::context_metrics m2(m);
+  BOOST_ASIO_CHECK(m2.spin_count() == 0);
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "context_metrics",
+  BOOST_ASIO_TEST_CASE(context_metrics_test)
+)
@@ -0,0 +1,238 @@
+//
+// context_options.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/context_options.hpp>
+
+#include <vector>
+#include "unit_test.hpp"
+
+void context_options_test()
+{
+  boost::asio::context_options options;
+
+  BOOST_ASIO_CHECK(!options.work_stealing());
+  BOOST_ASIO_CHECK(!options.lock_free_injection());
+  BOOST_ASIO_CHECK(options.local_queue_capacity() > 0);
+  BOOST_ASIO_CHECK(
+      options.spin_duration() == boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(options.adaptive_spin());
+  BOOST_ASIO_CHECK(!options.busy_poll_idle());
+  BOOST_ASIO_CHECK(options.dequeue_batch_size() == 1);
+  BOOST_ASIO_CHECK(
+      options.dequeue_batch_time() == boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(options.priority_starvation_limit() > 0);
+  BOOST_ASIO_CHECK(options.poll_budget_handlers() == 0);
+  BOOST_ASIO_CHECK(
+      options.poll_budget_time() == boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(options.reactor_batch_size() == 128);
+  BOOST_ASIO_CHECK(!options.adaptive_reactor_batch());
+  BOOST_ASIO_CHECK(!options.spread_reactor_completions());
+  BOOST_ASIO_CHECK(
+      options.reactor_busy_poll() == boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(options.reactor_busy_poll_budget() == 0);
+  BOOST_ASIO_CHECK(!options.prefer_busy_poll());
+  BOOST_ASIO_CHECK(!options.per_thread_reactors());
+  BOOST_ASIO_CHECK(options.descriptor_slab_size() == 256);
+  BOOST_ASIO_CHECK(!options.huge_page_descriptors());
+  BOOST_ASIO_CHECK(!options.adaptive_speculation());
+  BOOST_ASIO_CHECK(options.max_pending_accepts() == 64);
+  BOOST_ASIO_CHECK(options.max_pending_receives() == 16);
+  BOOST_ASIO_CHECK(options.zero_copy_send_threshold() == 0);
+  BOOST_ASIO_CHECK(options.io_uring_entries() == 16384);
+  BOOST_ASIO_CHECK(options.io_uring_cq_entries() == 0);
+  BOOST_ASIO_CHECK(!options.io_uring_sq_poll());
+  BOOST_ASIO_CHECK(options.io_uring_sq_poll_cpu() == -1);
+  BOOST_ASIO_CHECK(
+      options.io_uring_sq_poll_idle() == boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(!options.io_uring_coop_taskrun());
+  BOOST_ASIO_CHECK(!options.io_uring_single_issuer());
+  BOOST_ASIO_CHECK(!options.io_uring_defer_taskrun());
+  BOOST_ASIO_CHECK(options.io_uring_registered_files() == 0);
+  BOOST_ASIO_CHECK(!options.io_uring_msg_ring());
+  BOOST_ASIO_CHECK(options.processors().empty());
+  BOOST_ASIO_CHECK(options.numa_nodes().empty());
+  BOOST_ASIO_CHECK(!options.collect_metrics());
+
+  options.work_stealing(true);
+  BOOST_ASIO_CHECK(options.work_stealing());
+
+  options.lock_free_injection(true);
+  BOOST_ASIO_CHECK(options.lock_free_injection());
+
+  options.local_queue_capacity(1024);
+  BOOST_ASIO_CHECK(options.local_queue_capacity() == 1024);
+
+  options.spin_duration(boost::asio::chrono::microseconds(50));
+  BOOST_ASIO_CHECK(
+      options.spin_duration() == boost::asio::chrono::microseconds(50));
+
+  options.adaptive_spin(false);
+  BOOST_ASIO_CHECK(!options.adaptive_spin());
+
+  options.busy_poll_idle(true);
+  BOOST_ASIO_CHECK(options.busy_poll_idle());
+
+  options.dequeue_batch_size(64);
+  BOOST_ASIO_CHECK(options.dequeue_batch_size() == 64);
+
+  options.dequeue_batch_time(boost::asio::chrono::microseconds(20));
+  BOOST_ASIO_CHECK(
+      options.dequeue_batch_time() == boost::asio::chrono::microseconds(20));
+
+  options.priority_starvation_limit(4);
+  BOOST_ASIO_CHECK(options.priority_starvation_limit() == 4);
+
+  options.poll_budget_handlers(32);
+  BOOST_ASIO_CHECK(options.poll_budget_handlers() == 32);
+
+  options.poll_budget_time(boost::asio::chrono::microseconds(100));
+  BOOST_ASIO_CHECK(
+      options.poll_budget_time() == boost::asio::chrono::microseconds(100));
+
+  options.reactor_batch_size(1024);
+  BOOST_ASIO_CHECK(options.reactor_batch_size() == 1024);
+
+  options.adaptive_reactor_batch(true);
+  BOOST_ASIO_CHECK(options.adaptive_reactor_batch());
+
+  options.spread_reactor_completions(true);
+  BOOST_ASIO_CHECK(options.spread_reactor_completions());
+
+  options.reactor_busy_poll(boost::asio::chrono::microseconds(50));
+  BOOST_ASIO_CHECK(
+      options.reactor_busy_poll() == boost::asio::chrono::microseconds(50));
+
+  options.reactor_busy_poll_budget(16);
+  BOOST_ASIO_CHECK(options.reactor_busy_poll_budget() == 16);
+
+  options.prefer_busy_poll(true);
+  BOOST_ASIO_CHECK(options.prefer_busy_poll());
+
+  options.per_thread_reactors(true);
+  BOOST_ASIO_CHECK(options.per_thread_reactors());
+
+  options.descriptor_slab_size(1024);
+  BOOST_ASIO_CHECK(options.descriptor_slab_size() == 1024);
+
+  options.huge_page_descriptors(true);
+  BOOST_ASIO_CHECK(options.huge_page_descriptors());
+
+  options.adaptive_speculation(true);
+  BOOST_ASIO_CHECK(options.adaptive_speculation());
+
+  options.max_pending_accepts(16);
+  BOOST_ASIO_CHECK(options.max_pending_accepts() == 16);
+
+  options.max_pending_receives(4);
+  BOOST_ASIO_CHECK(options.max_pending_receives() == 4);
+
+  options.zero_copy_send_threshold(65536);
+  BOOST_ASIO_CHECK(options.zero_copy_send_threshold() == 65536);
+
+  options.io_uring_entries(1024);
+  BOOST_ASIO_CHECK(options.io_uring_entries() == 1024);
+
+  options.io_uring_cq_entries(8192);
+  BOOST_ASIO_CHECK(options.io_uring_cq_entries() == 8192);
+
+  options.io_uring_sq_poll(true);
+  BOOST_ASIO_CHECK(options.io_uring_sq_poll());
+
+  options.io_uring_sq_poll_cpu(3);
+  BOOST_ASIO_CHECK(options.io_uring_sq_poll_cpu() == 3);
+
+  options.io_uring_sq_poll_idle(boost::asio::chrono::milliseconds(10));
+  BOOST_ASIO_CHECK(
+      options.io_uring_sq_poll_idle() == boost::asio::chrono::milliseconds(10));
+
+  options.io_uring_coop_taskrun(true);
+  BOOST_ASIO_CHECK(options.io_uring_coop_taskrun());
+
+  options.io_uring_single_issuer(true);
+  BOOST_ASIO_CHECK(options.io_uring_single_issuer());
+
+  options.io_uring_defer_taskrun(true);
+  BOOST_ASIO_CHECK(options.io_uring_defer_taskrun());
+
+  options.io_uring_registered_files(4096);
+  BOOST_ASIO_CHECK(options.io_uring_registered_files() == 4096);
+
+  options.io_uring_msg_ring(true);
+  BOOST_ASIO_CHECK(options.io_uring_msg_ring());
+
+  std::vector<std::size_t> processors;
+  processors.push_back(2);
+  processors.push_back(3);
+  options.processors(processors);
+  BOOST_ASIO_CHECK(options.processors() == processors);
+
+  options.numa_nodes(std::vector<std::size_t>(1, 1));
+  BOOST_ASIO_CHECK(options.numa_nodes().size() == 1);
+  BOOST_ASIO_CHECK(options.numa_nodes()[0] == 1);
+
+  options.collect_metrics(true);
+  BOOST_ASIO_CHECK(options.collect_metrics());
+
+  boost::asio::context_options options2(options);
+  BOOST_ASIO_CHECK(options2.work_stealing());
+  BOOST_ASIO_CHECK(options2.lock_free_injection());
+  BOOST_ASIO_CHECK(options2.local_queue_capacity() == 1024);
+  BOOST_ASIO_CHECK(
+      options2.spin_duration() == boost::asio::chrono::microseconds(50));
+  BOOST_ASIO_CHECK(!options2.adaptive_spin());
+  BOOST_ASIO_CHECK(options2.busy_poll_idle());
+  BOOST_ASIO_CHECK(options2.dequeue_batch_size() == 64);
+  BOOST_ASIO_CHECK(
+      options2.dequeue_batch_time() == boost::asio::chrono::microseconds(20));
+  BOOST_ASIO_CHECK(options2.priority_starvation_limit() == 4);
+  BOOST_ASIO_CHECK(options2.poll_budget_handlers() == 32);
+  BOOST_ASIO_CHECK(
+      options2.poll_budget_time() == boost::asio::chrono::microseconds(100));
+  BOOST_ASIO_CHECK(options2.reactor_batch_size() == 1024);
+  BOOST_ASIO_CHECK(options2.adaptive_reactor_batch());
+  BOOST_ASIO_CHECK(options2.spread_reactor_completions());
+  BOOST_ASIO_CHECK(
+      options2.reactor_busy_poll() == boost::asio::chrono::microseconds(50));
+  BOOST_ASIO_CHECK(options2.reactor_busy_poll_budget() == 16);
+  BOOST_ASIO_CHECK(options2.prefer_busy_poll());
+  BOOST_ASIO_CHECK(options2.per_thread_reactors());
+  BOOST_ASIO_CHECK(options2.descriptor_slab_size() == 1024);
+  BOOST_ASIO_CHECK(options2.huge_page_descriptors());
+  BOOST_ASIO_CHECK(options2.adaptive_speculation());
+  BOOST_ASIO_CHECK(options2.max_pending_accepts() == 16);
+  BOOST_ASIO_CHECK(options2.max_pending_receives() == 4);
+  BOOST_ASIO_CHECK(options2.zero_copy_send_threshold() == 65536);
+  BOOST_ASIO_CHECK(options2.io_uring_entries() == 1024);
+  BOOST_ASIO_CHECK(options2.io_uring_cq_entries() == 8192);
+  BOOST_ASIO_CHECK(options2.io_uring_sq_poll());
+  BOOST_ASIO_CHECK(options2.io_uring_sq_poll_cpu() == 3);
+  BOOST_ASIO_CHECK(options2.io_uring_sq_poll_idle()
+      == boost::asio::chrono::milliseconds(10));
+  BOOST_ASIO_CHECK(options2.io_uring_coop_taskrun());
+  BOOST_ASIO_CHECK(options2.io_uring_single_issuer());
+  BOOST_ASIO_CHECK(options2.io_uring_defer_taskrun());
+  BOOST_ASIO_CHECK(options2.io_uring_registered_files() == 4096);
+  BOOST_ASIO_CHECK(options2.io_uring_msg_ring());
+  BOOST_ASIO_CHECK(options2.processors() == processors);
+  BOOST_ASIO_CHECK(options2.numa_nodes() == options.numa_nodes());
+  BOOST_ASIO_CHECK(options2.collect_metrics());
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "context_options",
+  BOOST_ASIO_TEST_CASE(context_options_test)
+)
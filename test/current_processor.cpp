@@ -0,0 +1,56 @@
+//
+// current_processor.cpp
+// ~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/current_processor.hpp>
+
+#include <boost/asio/error.hpp>
+#include "unit_test.hpp"
+
+void current_processor_test()
+{
+  boost::system::error_code ec;
+  std::size_t processor = boost::asio::current_processor(ec);
+  if (ec == boost::asio::error::operation_not_supported)
+    return;
+
+  BOOST_ASIO_CHECK(!ec);
+  (void)processor;
+
+  std::size_t node = boost::asio::current_numa_node(ec);
+  if (ec == boost::asio::error::operation_not_supported)
+    return;
+
+  BOOST_ASIO_CHECK(!ec);
+  (void)node;
+
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  try
+  {
+    (void)boost::asio::current_processor();
+    (void)boost::asio::current_numa_node();
+  }
+  catch (...)
+  {
+    BOOST_ASIO_ERROR("unexpected exception");
+  }
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "current_processor",
+  BOOST_ASIO_TEST_CASE(current_processor_test)
+)
@@ -16,11 +16,18 @@
 // Test that header file is self-contained.
 #include <boost/asio/io_context.hpp>
 
+#include <chrono>
 #include <functional>
 #include <sstream>
+#include <thread>
+#include <vector>
 #include <boost/asio/bind_executor.hpp>
+#include <boost/asio/buffer.hpp>
 #include <boost/asio/dispatch.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
 #include <boost/asio/post.hpp>
+#include <boost/asio/write.hpp>
 #include <boost/asio/detail/thread.hpp>
 #include "unit_test.hpp"
 
@@ -103,6 +110,29 @@ void io_context_run(io_context* ioc)
   ioc->run();
 }
 
+void atomic_increment(boost::asio::detail::atomic_count* count)
+{
+  ++(*count);
+}
+
+void repost_increment(io_context* ioc,
+    boost::asio::detail::atomic_count* count, int times)
+{
+  ++(*count);
+  if (times > 1)
+    boost::asio::post(*ioc,
+        bindns::bind(repost_increment, ioc, count, times - 1));
+}
+
+void fan_out(io_context* ioc,
+    boost::asio::detail::atomic_count* count, int depth)
+{
+  ++(*count);
+  if (depth > 0)
+    for (int i = 0; i < 4; ++i)
+      boost::asio::post(*ioc, bindns::bind(fan_out, ioc, count, depth - 1));
+}
+
 void io_context_test()
 {
   io_context ioc;
@@ -274,6 +304,1135 @@ void io_context_test()
   BOOST_ASIO_CHECK(exception_count == 2);
 }
 
+void io_context_work_stealing_test()
+{
+  boost::asio::context_options options;
+  options.work_stealing(true);
+  options.local_queue_capacity(16); // Small enough to overflow.
+
+  io_context ioc(4, options);
+  boost::asio::detail::atomic_count count(0);
+
+  for (int i = 0; i < 100; ++i)
+    boost::asio::post(ioc, bindns::bind(atomic_increment, &count));
+  boost::asio::post(ioc, bindns::bind(fan_out, &ioc, &count, 6));
+
+  // No handlers can be called until run() is called.
+  BOOST_ASIO_CHECK(!ioc.stopped());
+  BOOST_ASIO_CHECK(count == 0);
+
+  boost::asio::detail::thread thread1(bindns::bind(io_context_run, &ioc));
+  boost::asio::detail::thread thread2(bindns::bind(io_context_run, &ioc));
+  boost::asio::detail::thread thread3(bindns::bind(io_context_run, &ioc));
+  ioc.run();
+  thread1.join();
+  thread2.join();
+  thread3.join();
+
+  // The run() calls will not return until all work has finished.
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 100 + 5461);
+
+  count = 0;
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  boost::asio::detail::thread thread4(bindns::bind(io_context_run, &ioc));
+  boost::asio::detail::thread thread5(bindns::bind(io_context_run, &ioc));
+
+  // Handlers posted from outside the io_context must wake an idle thread.
+  for (int i = 0; i < 100; ++i)
+    boost::asio::post(ioc, bindns::bind(atomic_increment, &count));
+  boost::asio::post(ioc, bindns::bind(fan_out, &ioc, &count, 4));
+  w.reset();
+  thread4.join();
+  thread5.join();
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 100 + 341);
+
+  count = 0;
+  ioc.restart();
+  executor_work_guard<io_context::executor_type> w2 = make_work_guard(ioc);
+  boost::asio::post(ioc, bindns::bind(&io_context::stop, &ioc));
+  ioc.run();
+
+  // The only operation executed should have been to stop run().
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 0);
+  w2.reset();
+
+  int int_count = 10;
+  ioc.restart();
+  boost::asio::post(ioc,
+      bindns::bind(decrement_to_zero, &ioc, &int_count));
+  ioc.run();
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(int_count == 0);
+
+  int_count = 10;
+  ioc.restart();
+  boost::asio::post(ioc,
+      bindns::bind(nested_decrement_to_zero, &ioc, &int_count));
+  ioc.run();
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(int_count == 0);
+
+  count = 0;
+  int exception_count = 0;
+  ioc.restart();
+  boost::asio::post(ioc, &throw_exception);
+  boost::asio::post(ioc, bindns::bind(atomic_increment, &count));
+  boost::asio::post(ioc, bindns::bind(atomic_increment, &count));
+  boost::asio::post(ioc, &throw_exception);
+  boost::asio::post(ioc, bindns::bind(atomic_increment, &count));
+
+  for (;;)
+  {
+    try
+    {
+      ioc.run();
+      break;
+    }
+    catch (int)
+    {
+      ++exception_count;
+    }
+  }
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 3);
+  BOOST_ASIO_CHECK(exception_count == 2);
+
+  count = 0;
+  ioc.restart();
+  boost::asio::post(ioc, bindns::bind(fan_out, &ioc, &count, 2));
+  while (ioc.run_one())
+    ;
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 21);
+
+  count = 0;
+  ioc.restart();
+  boost::asio::post(ioc, bindns::bind(fan_out, &ioc, &count, 2));
+  ioc.poll();
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 21);
+}
+
+void timer_increment(boost::asio::detail::atomic_count* count,
+    const boost::system::error_code&)
+{
+  ++(*count);
+}
+
+void post_increments(io_context* ioc,
+    boost::asio::detail::atomic_count* count, int n)
+{
+  for (int i = 0; i < n; ++i)
+    boost::asio::post(*ioc, bindns::bind(atomic_increment, count));
+}
+
+void cancel_timer(timer* t, boost::asio::detail::atomic_count* count)
+{
+  ++(*count);
+  t->cancel();
+}
+
+void io_context_lock_free_injection_test()
+{
+  boost::asio::context_options options;
+  options.lock_free_injection(true);
+
+  // Handlers posted from many threads are all run.
+  io_context ioc(1, options);
+  boost::asio::detail::atomic_count count(0);
+  executor_work_guard<io_context::executor_type> w = make_work_guard(ioc);
+  boost::asio::detail::thread thread1(bindns::bind(io_context_run, &ioc));
+  boost::asio::detail::thread thread2(
+      bindns::bind(post_increments, &ioc, &count, 1000));
+  boost::asio::detail::thread thread3(
+      bindns::bind(post_increments, &ioc, &count, 1000));
+  post_increments(&ioc, &count, 1000);
+  thread2.join();
+  thread3.join();
+  boost::asio::post(ioc, bindns::bind(fan_out, &ioc, &count, 4));
+  w.reset();
+  thread1.join();
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 3000 + 341);
+
+  // A handler posted from outside wakes a thread that is blocked in the
+  // reactor.
+  count = 0;
+  ioc.restart();
+  timer t(ioc, chronons::seconds(60));
+  t.async_wait(bindns::bind(timer_increment,
+        &count, bindns::placeholders::_1));
+  boost::asio::detail::thread thread4(bindns::bind(io_context_run, &ioc));
+  boost::asio::post(ioc, bindns::bind(cancel_timer, &t, &count));
+  thread4.join();
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 2);
+
+  // Handlers waiting in the injection queue are run by poll() and run_one().
+  count = 0;
+  ioc.restart();
+  post_increments(&ioc, &count, 10);
+  ioc.poll();
+
+  BOOST_ASIO_CHECK(count == 10);
+
+  count = 0;
+  ioc.restart();
+  post_increments(&ioc, &count, 10);
+  while (ioc.run_one())
+    ;
+
+  BOOST_ASIO_CHECK(count == 10);
+
+  // Several threads may run a context that uses the injection queue.
+  count = 0;
+  io_context ioc2(4, options);
+  executor_work_guard<io_context::executor_type> w2 = make_work_guard(ioc2);
+  boost::asio::detail::thread thread5(bindns::bind(io_context_run, &ioc2));
+  boost::asio::detail::thread thread6(bindns::bind(io_context_run, &ioc2));
+  post_increments(&ioc2, &count, 1000);
+  boost::asio::post(ioc2, bindns::bind(fan_out, &ioc2, &count, 4));
+  w2.reset();
+  thread5.join();
+  thread6.join();
+
+  BOOST_ASIO_CHECK(ioc2.stopped());
+  BOOST_ASIO_CHECK(count == 1000 + 341);
+}
+
+void io_context_spin_test()
+{
+  io_context ioc;
+  boost::asio::context_metrics m = ioc.metrics();
+  BOOST_ASIO_CHECK(m.spin_count() == 0);
+  BOOST_ASIO_CHECK(m.spin_hits() == 0);
+  BOOST_ASIO_CHECK(m.spin_misses() == 0);
+  BOOST_ASIO_CHECK(m.spin_time() == boost::asio::chrono::nanoseconds(0));
+
+  // A budget long enough that the handlers always arrive while spinning.
+  boost::asio::context_options options;
+  options.spin_duration(boost::asio::chrono::seconds(10));
+  options.adaptive_spin(false);
+
+  io_context sleep_ioc;
+  boost::asio::detail::atomic_count count(0);
+
+  io_context ioc1(2, options);
+  executor_work_guard<io_context::executor_type> w1 = make_work_guard(ioc1);
+  boost::asio::detail::thread thread1(bindns::bind(io_context_run, &ioc1));
+
+  // Give the thread a chance to run out of work and start spinning.
+  timer t1(sleep_ioc, chronons::milliseconds(50));
+  t1.wait();
+
+  boost::asio::post(ioc1, bindns::bind(atomic_increment, &count));
+  w1.reset();
+  thread1.join();
+
+  BOOST_ASIO_CHECK(ioc1.stopped());
+  BOOST_ASIO_CHECK(count == 1);
+  m = ioc1.metrics();
+  BOOST_ASIO_CHECK(m.spin_count() > 0);
+  BOOST_ASIO_CHECK(m.spin_hits() > 0);
+  BOOST_ASIO_CHECK(m.spin_misses() == 0);
+  BOOST_ASIO_CHECK(m.spin_time() > boost::asio::chrono::nanoseconds(0));
+
+  // A thread running the reactor task polls it while spinning.
+  count = 0;
+  io_context ioc2(2, options);
+  timer t2(ioc2, chronons::milliseconds(50));
+  t2.async_wait(bindns::bind(timer_increment,
+        &count, bindns::placeholders::_1));
+  ioc2.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+  m = ioc2.metrics();
+  BOOST_ASIO_CHECK(m.spin_count() > 0);
+  BOOST_ASIO_CHECK(m.spin_hits() > 0);
+  BOOST_ASIO_CHECK(m.spin_misses() == 0);
+
+  // Threads that exhaust their spin budget must still be woken.
+  count = 0;
+  options.spin_duration(boost::asio::chrono::microseconds(1));
+  io_context ioc3(2, options);
+  executor_work_guard<io_context::executor_type> w3 = make_work_guard(ioc3);
+  boost::asio::detail::thread thread3(bindns::bind(io_context_run, &ioc3));
+
+  timer t3(sleep_ioc, chronons::milliseconds(50));
+  t3.wait();
+
+  boost::asio::post(ioc3, bindns::bind(atomic_increment, &count));
+  w3.reset();
+  thread3.join();
+
+  BOOST_ASIO_CHECK(count == 1);
+  m = ioc3.metrics();
+  BOOST_ASIO_CHECK(m.spin_misses() > 0);
+  BOOST_ASIO_CHECK(m.spin_hits() + m.spin_misses() <= m.spin_count());
+
+  // Spinning combined with work stealing.
+  count = 0;
+  options.spin_duration(boost::asio::chrono::microseconds(100));
+  options.adaptive_spin(true);
+  options.work_stealing(true);
+  io_context ioc4(4, options);
+  for (int i = 0; i < 100; ++i)
+    boost::asio::post(ioc4, bindns::bind(atomic_increment, &count));
+  boost::asio::post(ioc4, bindns::bind(fan_out, &ioc4, &count, 5));
+
+  boost::asio::detail::thread thread4(bindns::bind(io_context_run, &ioc4));
+  boost::asio::detail::thread thread5(bindns::bind(io_context_run, &ioc4));
+  ioc4.run();
+  thread4.join();
+  thread5.join();
+
+  BOOST_ASIO_CHECK(ioc4.stopped());
+  BOOST_ASIO_CHECK(count == 100 + 1365);
+}
+
+void record_order(std::vector<int>* order, int value)
+{
+  order->push_back(value);
+}
+
+void post_normal_then_high(io_context* ioc, std::vector<int>* order)
+{
+  for (int i = 0; i < 3; ++i)
+    boost::asio::post(*ioc, bindns::bind(record_order, order, i));
+  boost::asio::post(
+      boost::asio::require(ioc->get_executor(), execution::priority.high),
+      bindns::bind(record_order, order, 100));
+}
+
+void io_context_batch_test()
+{
+  boost::asio::context_options options;
+  options.dequeue_batch_size(32);
+
+  io_context ioc(4, options);
+  boost::asio::detail::atomic_count count(0);
+
+  for (int i = 0; i < 1000; ++i)
+    boost::asio::post(ioc, bindns::bind(atomic_increment, &count));
+  boost::asio::post(ioc, bindns::bind(fan_out, &ioc, &count, 6));
+
+  boost::asio::detail::thread thread1(bindns::bind(io_context_run, &ioc));
+  boost::asio::detail::thread thread2(bindns::bind(io_context_run, &ioc));
+  boost::asio::detail::thread thread3(bindns::bind(io_context_run, &ioc));
+  ioc.run();
+  thread1.join();
+  thread2.join();
+  thread3.join();
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 1000 + 5461);
+
+  // A single thread runs batched handlers in the order they were posted.
+  std::vector<int> order;
+  ioc.restart();
+  for (int i = 0; i < 100; ++i)
+    boost::asio::post(ioc, bindns::bind(record_order, &order, i));
+  ioc.run();
+
+  BOOST_ASIO_CHECK(order.size() == 100);
+  for (std::size_t i = 0; i < order.size(); ++i)
+    BOOST_ASIO_CHECK(order[i] == static_cast<int>(i));
+
+  // Stopping the io_context abandons the rest of the batch, which is run in
+  // the original order once the io_context is restarted.
+  order.clear();
+  ioc.restart();
+  for (int i = 0; i < 10; ++i)
+  {
+    boost::asio::post(ioc, bindns::bind(record_order, &order, i));
+    if (i == 3)
+      boost::asio::post(ioc, bindns::bind(&io_context::stop, &ioc));
+  }
+  std::size_t n = ioc.run();
+
+  BOOST_ASIO_CHECK(n == 5);
+  BOOST_ASIO_CHECK(order.size() == 4);
+
+  ioc.restart();
+  n = ioc.run();
+
+  BOOST_ASIO_CHECK(n == 6);
+  BOOST_ASIO_CHECK(order.size() == 10);
+  for (std::size_t i = 0; i < order.size(); ++i)
+    BOOST_ASIO_CHECK(order[i] == static_cast<int>(i));
+
+  // Handlers in a batch are not lost when an earlier one throws.
+  count = 0;
+  int exception_count = 0;
+  ioc.restart();
+  boost::asio::post(ioc, &throw_exception);
+  boost::asio::post(ioc, bindns::bind(atomic_increment, &count));
+  boost::asio::post(ioc, bindns::bind(atomic_increment, &count));
+  boost::asio::post(ioc, &throw_exception);
+  boost::asio::post(ioc, bindns::bind(atomic_increment, &count));
+
+  for (;;)
+  {
+    try
+    {
+      ioc.run();
+      break;
+    }
+    catch (int)
+    {
+      ++exception_count;
+    }
+  }
+
+  BOOST_ASIO_CHECK(ioc.stopped());
+  BOOST_ASIO_CHECK(count == 3);
+  BOOST_ASIO_CHECK(exception_count == 2);
+
+  // A time limit short enough to cut every batch short.
+  count = 0;
+  options.dequeue_batch_time(boost::asio::chrono::nanoseconds(1));
+  io_context ioc2(2, options);
+  for (int i = 0; i < 1000; ++i)
+    boost::asio::post(ioc2, bindns::bind(atomic_increment, &count));
+  boost::asio::post(ioc2, bindns::bind(fan_out, &ioc2, &count, 4));
+
+  boost::asio::detail::thread thread4(bindns::bind(io_context_run, &ioc2));
+  ioc2.run();
+  thread4.join();
+
+  BOOST_ASIO_CHECK(ioc2.stopped());
+  BOOST_ASIO_CHECK(count == 1000 + 341);
+
+  // Batches never skip past the reactor, so timers still fire while handlers
+  // are continually being posted.
+  count = 0;
+  int int_count = 0;
+  io_context ioc3(1, options);
+  timer t(ioc3, chronons::milliseconds(0));
+  t.async_wait(bindns::bind(timer_increment, &count, bindns::placeholders::_1));
+  boost::asio::post(ioc3, bindns::bind(decrement_to_zero, &ioc3, &int_count));
+  for (int i = 0; i < 100; ++i)
+    boost::asio::post(ioc3, bindns::bind(increment, &int_count));
+  ioc3.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+  BOOST_ASIO_CHECK(int_count == 100);
+}
+
+void io_context_priority_test()
+{
+  io_context ioc;
+  std::vector<int> order;
+
+  io_context::executor_type ex = ioc.get_executor();
+  BOOST_ASIO_CHECK(boost::asio::query(ex, execution::priority)
+      == execution::priority.normal);
+
+  auto high_ex = boost::asio::require(ex, execution::priority.high);
+  BOOST_ASIO_CHECK(boost::asio::query(high_ex, execution::priority)
+      == execution::priority.high);
+
+  auto low_ex = boost::asio::require(ex, execution::priority.low);
+  BOOST_ASIO_CHECK(boost::asio::query(low_ex, execution::priority)
+      == execution::priority.low);
+
+  auto normal_ex = boost::asio::require(high_ex, execution::priority.normal);
+  BOOST_ASIO_CHECK(boost::asio::query(normal_ex, execution::priority)
+      == execution::priority.normal);
+
+  // High priority functions run ahead of waiting normal priority ones, and
+  // low priority functions run after them.
+  for (int i = 0; i < 3; ++i)
+    boost::asio::post(ioc, bindns::bind(record_order, &order, i));
+  boost::asio::post(low_ex, bindns::bind(record_order, &order, 200));
+  boost::asio::post(high_ex, bindns::bind(record_order, &order, 100));
+  ioc.run();
+
+  BOOST_ASIO_CHECK(order.size() == 5);
+  BOOST_ASIO_CHECK(order[0] == 100);
+  BOOST_ASIO_CHECK(order[1] == 0);
+  BOOST_ASIO_CHECK(order[2] == 1);
+  BOOST_ASIO_CHECK(order[3] == 2);
+  BOOST_ASIO_CHECK(order[4] == 200);
+
+  // A backlog of high priority functions does not starve normal priority
+  // work, and a backlog of normal priority work does not starve low priority
+  // functions.
+  boost::asio::context_options options;
+  options.priority_starvation_limit(4);
+  io_context ioc2(1, options);
+  order.clear();
+
+  auto high_ex2 = boost::asio::require(
+      ioc2.get_executor(), execution::priority.high);
+  auto low_ex2 = boost::asio::require(
+      ioc2.get_executor(), execution::priority.low);
+  for (int i = 0; i < 10; ++i)
+    boost::asio::post(ioc2, bindns::bind(record_order, &order, i));
+  for (int i = 0; i < 10; ++i)
+    boost::asio::post(high_ex2, bindns::bind(record_order, &order, 100 + i));
+  boost::asio::post(low_ex2, bindns::bind(record_order, &order, 200));
+  ioc2.run();
+
+  BOOST_ASIO_CHECK(order.size() == 21);
+  std::size_t first_normal = order.size();
+  std::size_t low = order.size();
+  for (std::size_t i = 0; i < order.size(); ++i)
+  {
+    if (order[i] < 100 && first_normal == order.size())
+      first_normal = i;
+    if (order[i] == 200)
+      low = i;
+  }
+  BOOST_ASIO_CHECK(order[0] == 100);
+  BOOST_ASIO_CHECK(first_normal == 4);
+  BOOST_ASIO_CHECK(low < 20);
+
+  // Each lane keeps its own functions in order.
+  int next_normal = 0, next_high = 100;
+  for (std::size_t i = 0; i < order.size(); ++i)
+  {
+    if (order[i] < 100)
+      BOOST_ASIO_CHECK(order[i] == next_normal++);
+    else if (order[i] < 200)
+      BOOST_ASIO_CHECK(order[i] == next_high++);
+  }
+
+  // In work-stealing mode, high priority functions also run ahead of normal
+  // priority ones waiting in the thread's local queue.
+  boost::asio::context_options stealing_options;
+  stealing_options.work_stealing(true);
+  io_context ioc5(2, stealing_options);
+  order.clear();
+
+  boost::asio::post(ioc5, bindns::bind(post_normal_then_high, &ioc5, &order));
+  ioc5.run();
+
+  BOOST_ASIO_CHECK(order.size() == 4);
+  BOOST_ASIO_CHECK(order[0] == 100);
+  BOOST_ASIO_CHECK(order[1] == 0);
+  BOOST_ASIO_CHECK(order[2] == 1);
+  BOOST_ASIO_CHECK(order[3] == 2);
+
+  // Prioritised functions are run by a multithreaded io_context.
+  boost::asio::detail::atomic_count count(0);
+  io_context ioc3(4);
+  auto high_ex3 = boost::asio::require(
+      ioc3.get_executor(), execution::priority.high);
+  auto low_ex3 = boost::asio::require(
+      ioc3.get_executor(), execution::priority.low);
+  for (int i = 0; i < 100; ++i)
+  {
+    boost::asio::post(ioc3, bindns::bind(atomic_increment, &count));
+    boost::asio::post(high_ex3, bindns::bind(atomic_increment, &count));
+    boost::asio::post(low_ex3, bindns::bind(atomic_increment, &count));
+  }
+  boost::asio::post(high_ex3, bindns::bind(fan_out, &ioc3, &count, 4));
+
+  boost::asio::detail::thread thread1(bindns::bind(io_context_run, &ioc3));
+  boost::asio::detail::thread thread2(bindns::bind(io_context_run, &ioc3));
+  ioc3.run();
+  thread1.join();
+  thread2.join();
+
+  BOOST_ASIO_CHECK(ioc3.stopped());
+  BOOST_ASIO_CHECK(count == 300 + 341);
+
+  // Functions that never run are destroyed along with the io_context.
+  {
+    io_context ioc4;
+    boost::asio::post(boost::asio::require(ioc4.get_executor(),
+          execution::priority.high), bindns::bind(atomic_increment, &count));
+    boost::asio::post(boost::asio::require(ioc4.get_executor(),
+          execution::priority.low), bindns::bind(atomic_increment, &count));
+  }
+}
+
+void io_context_metrics_test()
+{
+  boost::asio::detail::atomic_count count(0);
+
+  // Detailed metrics are not collected by default.
+  io_context ioc1;
+  boost::asio::post(ioc1, bindns::bind(atomic_increment, &count));
+  ioc1.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+  boost::asio::context_metrics m = ioc1.metrics();
+  BOOST_ASIO_CHECK(m.handlers_run() == 0);
+  BOOST_ASIO_CHECK(m.queue_depth() == 0);
+  BOOST_ASIO_CHECK(m.reactor_polls() == 0);
+  BOOST_ASIO_CHECK(m.threads().empty());
+
+  boost::asio::context_options options;
+  options.collect_metrics(true);
+
+  count = 0;
+  io_context ioc2(1, options);
+  for (int i = 0; i < 10; ++i)
+    boost::asio::post(ioc2, bindns::bind(atomic_increment, &count));
+  timer t(ioc2, chronons::milliseconds(10));
+  t.async_wait(bindns::bind(timer_increment,
+        &count, bindns::placeholders::_1));
+
+  m = ioc2.metrics();
+  BOOST_ASIO_CHECK(m.queue_depth() == 10);
+  BOOST_ASIO_CHECK(m.handlers_run() == 0);
+
+  ioc2.run();
+
+  BOOST_ASIO_CHECK(count == 11);
+  m = ioc2.metrics();
+  BOOST_ASIO_CHECK(m.handlers_run() >= 11);
+  BOOST_ASIO_CHECK(m.queue_depth() == 0);
+  BOOST_ASIO_CHECK(m.reactor_polls() > 0);
+  BOOST_ASIO_CHECK(m.reactor_events() > 0);
+  BOOST_ASIO_CHECK(m.idle_time() > boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(m.threads().size() == 1);
+  BOOST_ASIO_CHECK(m.threads()[0].busy == m.busy_time());
+  BOOST_ASIO_CHECK(m.threads()[0].idle == m.idle_time());
+
+  const std::size_t buckets = boost::asio::context_metrics::histogram_buckets;
+  boost::asio::uint64_t waits = 0, polls = 0;
+  for (std::size_t i = 0; i < buckets; ++i)
+  {
+    waits += m.queue_wait_histogram(i);
+    polls += m.poll_events_histogram(i);
+  }
+  BOOST_ASIO_CHECK(waits == m.handlers_run());
+  BOOST_ASIO_CHECK(polls == m.reactor_polls());
+
+  // Counters from several threads are merged.
+  count = 0;
+  io_context ioc3(3, options);
+  boost::asio::post(ioc3, bindns::bind(fan_out, &ioc3, &count, 5));
+  boost::asio::detail::thread thread1(bindns::bind(io_context_run, &ioc3));
+  boost::asio::detail::thread thread2(bindns::bind(io_context_run, &ioc3));
+  ioc3.run();
+  thread1.join();
+  thread2.join();
+
+  BOOST_ASIO_CHECK(count == 1365);
+  m = ioc3.metrics();
+  BOOST_ASIO_CHECK(m.handlers_run() == 1365);
+  BOOST_ASIO_CHECK(m.queue_depth() == 0);
+  BOOST_ASIO_CHECK(!m.threads().empty());
+  BOOST_ASIO_CHECK(m.threads().size() <= 3);
+}
+
+void io_context_poll_budget_test()
+{
+  boost::asio::detail::atomic_count count(0);
+  boost::asio::detail::atomic_count timer_count(0);
+
+  // Without a budget, the reactor is polled once per pass over the queue.
+  boost::asio::context_options options;
+  options.collect_metrics(true);
+  io_context ioc1(1, options);
+  for (int i = 0; i < 100; ++i)
+    boost::asio::post(ioc1, bindns::bind(repost_increment, &ioc1, &count, 5));
+  timer t1(ioc1, chronons::milliseconds(0));
+  t1.async_wait(bindns::bind(timer_increment,
+        &timer_count, bindns::placeholders::_1));
+  ioc1.run();
+
+  BOOST_ASIO_CHECK(count == 500);
+  BOOST_ASIO_CHECK(timer_count == 1);
+  boost::asio::context_metrics m = ioc1.metrics();
+  BOOST_ASIO_CHECK(m.poll_budget_handler_hits() == 0);
+  BOOST_ASIO_CHECK(m.poll_budget_time_hits() == 0);
+  BOOST_ASIO_CHECK(m.reactor_polls() < 20);
+
+  // A handler budget polls the reactor after every few handlers.
+  count = 0;
+  timer_count = 0;
+  options.poll_budget_handlers(10);
+  io_context ioc2(1, options);
+  for (int i = 0; i < 100; ++i)
+    boost::asio::post(ioc2, bindns::bind(repost_increment, &ioc2, &count, 5));
+  timer t2(ioc2, chronons::milliseconds(0));
+  t2.async_wait(bindns::bind(timer_increment,
+        &timer_count, bindns::placeholders::_1));
+  ioc2.run();
+
+  BOOST_ASIO_CHECK(count == 500);
+  BOOST_ASIO_CHECK(timer_count == 1);
+  m = ioc2.metrics();
+  BOOST_ASIO_CHECK(m.poll_budget_handler_hits() > 0);
+  BOOST_ASIO_CHECK(m.poll_budget_time_hits() == 0);
+  BOOST_ASIO_CHECK(m.reactor_polls() >= 40);
+
+  // A time budget short enough to poll the reactor between any two handlers.
+  count = 0;
+  options.poll_budget_handlers(0);
+  options.poll_budget_time(boost::asio::chrono::nanoseconds(1));
+  options.dequeue_batch_size(16);
+  io_context ioc3(2, options);
+  for (int i = 0; i < 100; ++i)
+    boost::asio::post(ioc3, bindns::bind(repost_increment, &ioc3, &count, 5));
+  timer t3(ioc3, chronons::milliseconds(0));
+  t3.async_wait(bindns::bind(timer_increment,
+        &timer_count, bindns::placeholders::_1));
+  boost::asio::detail::thread thread1(bindns::bind(io_context_run, &ioc3));
+  ioc3.run();
+  thread1.join();
+
+  BOOST_ASIO_CHECK(timer_count == 2);
+  m = ioc3.metrics();
+  BOOST_ASIO_CHECK(m.poll_budget_handler_hits() == 0);
+  BOOST_ASIO_CHECK(m.poll_budget_time_hits() > 0);
+}
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+void read_increment(boost::asio::detail::atomic_count* count,
+    const boost::system::error_code& ec, std::size_t n)
+{
+  if (!ec && n == 1)
+    ++(*count);
+}
+
+void run_reactor_batch(const boost::asio::context_options& options,
+    int num_threads)
+{
+  typedef boost::asio::local::stream_protocol::socket socket_type;
+  const int num_pairs = 40;
+
+  io_context ioc(num_threads, options);
+  boost::asio::detail::atomic_count count(0);
+
+  std::vector<socket_type*> sockets;
+  char read_data[num_pairs];
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    sockets.push_back(new socket_type(ioc));
+    sockets.push_back(new socket_type(ioc));
+    boost::asio::local::connect_pair(*sockets[2 * i], *sockets[2 * i + 1]);
+    sockets[2 * i]->async_read_some(
+        boost::asio::buffer(&read_data[i], 1),
+        bindns::bind(read_increment, &count,
+          bindns::placeholders::_1, bindns::placeholders::_2));
+  }
+
+  // Make all of the sockets ready at once.
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    char c = 'x';
+    boost::asio::write(*sockets[2 * i + 1], boost::asio::buffer(&c, 1));
+  }
+
+  std::vector<boost::asio::detail::thread*> threads;
+  for (int i = 1; i < num_threads; ++i)
+    threads.push_back(new boost::asio::detail::thread(
+          bindns::bind(io_context_run, &ioc)));
+  ioc.run();
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+
+  BOOST_ASIO_CHECK(count == num_pairs);
+
+  for (std::size_t i = 0; i < sockets.size(); ++i)
+    delete sockets[i];
+}
+
+void check_owner_thread(std::thread::id* owner,
+    boost::asio::detail::atomic_count* count,
+    const boost::system::error_code& ec, std::size_t n)
+{
+  if (!ec && n == 1 && *owner == std::this_thread::get_id())
+    ++(*count);
+}
+
+void migrate_and_read(boost::asio::local::stream_protocol::socket* reader,
+    boost::asio::local::stream_protocol::socket* writer, char* data,
+    std::thread::id* owner, boost::asio::detail::atomic_count* count)
+{
+  boost::system::error_code ec;
+  reader->migrate(ec);
+  if (ec)
+    return;
+
+  *owner = std::this_thread::get_id();
+  reader->async_read_some(boost::asio::buffer(data, 1),
+      bindns::bind(check_owner_thread, owner, count,
+        bindns::placeholders::_1, bindns::placeholders::_2));
+
+  char c = 'x';
+  boost::asio::write(*writer, boost::asio::buffer(&c, 1));
+}
+
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+
+void io_context_reactor_batch_test()
+{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  boost::asio::context_options options;
+
+  // A batch smaller than the number of ready sockets.
+  options.reactor_batch_size(4);
+  run_reactor_batch(options, 1);
+
+  // A batch that adapts to the number of ready sockets.
+  options.reactor_batch_size(1024);
+  options.adaptive_reactor_batch(true);
+  run_reactor_batch(options, 1);
+
+  // A batch that is spread across several threads.
+  options.spread_reactor_completions(true);
+  run_reactor_batch(options, 4);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void io_context_busy_poll_test()
+{
+  boost::asio::detail::atomic_count count(0);
+
+  // An idle thread polls the reactor until the timer expires, without ever
+  // running out of spin budget.
+  boost::asio::context_options options;
+  options.busy_poll_idle(true);
+
+  io_context ioc1(1, options);
+  timer t1(ioc1, chronons::milliseconds(50));
+  t1.async_wait(bindns::bind(timer_increment,
+        &count, bindns::placeholders::_1));
+  ioc1.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+  boost::asio::context_metrics m = ioc1.metrics();
+  BOOST_ASIO_CHECK(m.spin_count() > 0);
+  BOOST_ASIO_CHECK(m.spin_misses() == 0);
+
+  // A reactor that busy polls before it blocks still delivers timers and
+  // descriptor events.
+  count = 0;
+  options.busy_poll_idle(false);
+  options.reactor_busy_poll(boost::asio::chrono::microseconds(200));
+
+  io_context ioc2(1, options);
+  timer t2(ioc2, chronons::milliseconds(50));
+  t2.async_wait(bindns::bind(timer_increment,
+        &count, bindns::placeholders::_1));
+  ioc2.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  run_reactor_batch(options, 2);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void io_context_per_thread_reactors_test()
+{
+  boost::asio::context_options options;
+  options.per_thread_reactors(true);
+
+  // Timers and posted handlers are still shared by all threads.
+  boost::asio::detail::atomic_count count(0);
+  io_context ioc1(4, options);
+  timer t1(ioc1, chronons::milliseconds(20));
+  t1.async_wait(bindns::bind(timer_increment,
+        &count, bindns::placeholders::_1));
+  for (int i = 0; i < 100; ++i)
+    boost::asio::post(ioc1, bindns::bind(atomic_increment, &count));
+
+  std::vector<boost::asio::detail::thread*> threads;
+  for (int i = 1; i < 4; ++i)
+    threads.push_back(new boost::asio::detail::thread(
+          bindns::bind(io_context_run, &ioc1)));
+  ioc1.run();
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+  threads.clear();
+
+  BOOST_ASIO_CHECK(count == 101);
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  // Sockets opened before the threads start are spread over the threads.
+  run_reactor_batch(options, 4);
+  run_reactor_batch(options, 1);
+
+  // A socket migrated by a handler completes on that handler's thread.
+  typedef boost::asio::local::stream_protocol::socket socket_type;
+  const int num_pairs = 16;
+
+  io_context ioc2(4, options);
+  count = 0;
+
+  std::vector<socket_type*> sockets;
+  std::vector<std::thread::id> owners(num_pairs);
+  char read_data[num_pairs];
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    sockets.push_back(new socket_type(ioc2));
+    sockets.push_back(new socket_type(ioc2));
+    boost::asio::local::connect_pair(*sockets[2 * i], *sockets[2 * i + 1]);
+    boost::asio::post(ioc2, bindns::bind(migrate_and_read, sockets[2 * i],
+          sockets[2 * i + 1], &read_data[i], &owners[i], &count));
+  }
+
+  for (int i = 1; i < 4; ++i)
+    threads.push_back(new boost::asio::detail::thread(
+          bindns::bind(io_context_run, &ioc2)));
+  ioc2.run();
+  for (std::size_t i = 0; i < threads.size(); ++i)
+  {
+    threads[i]->join();
+    delete threads[i];
+  }
+
+  BOOST_ASIO_CHECK(count == num_pairs);
+
+  for (std::size_t i = 0; i < sockets.size(); ++i)
+    delete sockets[i];
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void io_context_descriptor_memory_test()
+{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  typedef boost::asio::local::stream_protocol::socket socket_type;
+
+  boost::asio::context_options options;
+  options.descriptor_slab_size(4);
+
+  io_context ioc(1, options);
+  boost::asio::context_metrics m = ioc.metrics();
+  BOOST_ASIO_CHECK(m.registered_descriptors() == 0);
+  BOOST_ASIO_CHECK(m.descriptor_state_memory() == 0);
+
+  std::vector<socket_type*> sockets;
+  for (int i = 0; i < 10; ++i)
+  {
+    sockets.push_back(new socket_type(ioc));
+    sockets.push_back(new socket_type(ioc));
+    boost::asio::local::connect_pair(*sockets[2 * i], *sockets[2 * i + 1]);
+  }
+
+  m = ioc.metrics();
+# if defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  BOOST_ASIO_CHECK(m.registered_descriptors() == 20);
+  BOOST_ASIO_CHECK(m.descriptor_state_size() > 0);
+  BOOST_ASIO_CHECK(m.descriptor_state_size() % 64 == 0);
+  BOOST_ASIO_CHECK(m.descriptor_state_memory()
+      >= m.registered_descriptors() * m.descriptor_state_size());
+# endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  // Closed sockets give their state back for reuse.
+  uint64_t memory = m.descriptor_state_memory();
+  for (std::size_t i = 0; i < sockets.size(); ++i)
+    delete sockets[i];
+  sockets.clear();
+
+  m = ioc.metrics();
+  BOOST_ASIO_CHECK(m.registered_descriptors() == 0);
+  BOOST_ASIO_CHECK(m.descriptor_state_memory() == memory);
+
+  for (int i = 0; i < 4; ++i)
+    sockets.push_back(
+        new socket_type(ioc, boost::asio::local::stream_protocol()));
+  m = ioc.metrics();
+  BOOST_ASIO_CHECK(m.descriptor_state_memory() == memory);
+  for (std::size_t i = 0; i < sockets.size(); ++i)
+    delete sockets[i];
+
+  // Slabs backed by huge pages, or by ordinary pages if none are available.
+  options.huge_page_descriptors(true);
+  run_reactor_batch(options, 2);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void io_context_adaptive_speculation_test()
+{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  typedef boost::asio::local::stream_protocol::socket socket_type;
+  const int num_pairs = 8;
+
+  boost::asio::context_options options;
+  options.adaptive_speculation(true);
+
+  io_context ioc(1, options);
+  boost::asio::detail::atomic_count count(0);
+
+  // Reads started before any data arrives would block. Once the first reads
+  // on new sockets have mostly failed, they are no longer attempted at once,
+  // yet the reads still complete when the data arrives.
+  std::vector<socket_type*> sockets;
+  char read_data[num_pairs];
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    sockets.push_back(new socket_type(ioc));
+    sockets.push_back(new socket_type(ioc));
+    boost::asio::local::connect_pair(*sockets[2 * i], *sockets[2 * i + 1]);
+    sockets[2 * i]->async_read_some(
+        boost::asio::buffer(&read_data[i], 1),
+        bindns::bind(read_increment, &count,
+          bindns::placeholders::_1, bindns::placeholders::_2));
+  }
+
+# if defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  BOOST_ASIO_CHECK(sockets[0]->speculative_misses() == 1);
+  BOOST_ASIO_CHECK(sockets[2 * (num_pairs - 1)]->speculative_misses() == 0);
+# endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  for (int i = 0; i < num_pairs; ++i)
+  {
+    char c = 'x';
+    boost::asio::write(*sockets[2 * i + 1], boost::asio::buffer(&c, 1));
+  }
+
+  ioc.run();
+  BOOST_ASIO_CHECK(count == num_pairs);
+
+  // Reads on a socket that always has data waiting complete at once.
+  char data[4] = { 'a', 'b', 'c', 'd' };
+  boost::asio::write(*sockets[1], boost::asio::buffer(data));
+  count = 0;
+  for (int i = 0; i < 4; ++i)
+  {
+    sockets[0]->async_read_some(boost::asio::buffer(&read_data[0], 1),
+        bindns::bind(read_increment, &count,
+          bindns::placeholders::_1, bindns::placeholders::_2));
+    ioc.restart();
+    ioc.run();
+  }
+
+  BOOST_ASIO_CHECK(count == 4);
+# if defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  BOOST_ASIO_CHECK(sockets[0]->speculative_hits() >= 3);
+# endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  for (std::size_t i = 0; i < sockets.size(); ++i)
+    delete sockets[i];
+
+  // The adaptive policy still delivers every completion under load.
+  run_reactor_batch(options, 2);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+void ping_pong(io_context* from, io_context* to,
+    boost::asio::detail::atomic_count* count, int n)
+{
+  ++(*count);
+  if (n > 0)
+    boost::asio::post(*to, bindns::bind(ping_pong, to, from, count, n - 1));
+  else
+  {
+    from->stop();
+    to->stop();
+  }
+}
+
+void post_and_wait(io_context* to, boost::asio::detail::atomic_count* count)
+{
+  boost::asio::post(*to, bindns::bind(atomic_increment, count));
+
+  // The sending context does not run again until the handler has run, so the
+  // handler must be delivered without the sending context's help.
+  for (int i = 0; i < 1000 && *count == 0; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(10));
+}
+
+void post_and_stop(io_context* from, io_context* to,
+    boost::asio::detail::atomic_count* count)
+{
+  boost::asio::post(*to, bindns::bind(atomic_increment, count));
+  from->stop();
+}
+
+void io_context_msg_ring_test()
+{
+  boost::asio::context_options options;
+  options.io_uring_msg_ring(true);
+
+  // Handlers posted back and forth between contexts, from threads that are
+  // running the other context, are all run.
+  io_context ioc1(1, options);
+  io_context ioc2(1, options);
+  boost::asio::detail::atomic_count count(0);
+  executor_work_guard<io_context::executor_type> w1 = make_work_guard(ioc1);
+  executor_work_guard<io_context::executor_type> w2 = make_work_guard(ioc2);
+  boost::asio::detail::thread thread1(bindns::bind(io_context_run, &ioc2));
+  boost::asio::post(ioc1, bindns::bind(ping_pong, &ioc1, &ioc2, &count, 1000));
+  ioc1.run();
+  thread1.join();
+
+  BOOST_ASIO_CHECK(ioc1.stopped());
+  BOOST_ASIO_CHECK(ioc2.stopped());
+  BOOST_ASIO_CHECK(count == 1001);
+#if defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  // Each context sent half of the handlers as entries on its own ring.
+  BOOST_ASIO_CHECK(ioc1.metrics().io_uring_submitted_entries() >= 500);
+  BOOST_ASIO_CHECK(ioc2.metrics().io_uring_submitted_entries() >= 500);
+#endif // defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  // Handlers sent to a context that several threads are running are also
+  // run, as are those posted from threads that are not running a context.
+  count = 0;
+  io_context ioc3(1, options);
+  io_context ioc4(4, options);
+  executor_work_guard<io_context::executor_type> w3 = make_work_guard(ioc3);
+  executor_work_guard<io_context::executor_type> w4 = make_work_guard(ioc4);
+  boost::asio::detail::thread thread2(bindns::bind(io_context_run, &ioc4));
+  boost::asio::detail::thread thread3(bindns::bind(io_context_run, &ioc4));
+  boost::asio::post(ioc3, bindns::bind(post_increments, &ioc4, &count, 1000));
+  post_increments(&ioc4, &count, 1000);
+  w3.reset();
+  ioc3.run();
+  w4.reset();
+  thread2.join();
+  thread3.join();
+
+  BOOST_ASIO_CHECK(ioc4.stopped());
+  BOOST_ASIO_CHECK(count == 2000);
+
+  // A handler is delivered even if the sending context blocks, or stops,
+  // straight after sending it.
+  count = 0;
+  io_context ioc5(1, options);
+  io_context ioc6(1, options);
+  executor_work_guard<io_context::executor_type> w6 = make_work_guard(ioc6);
+  boost::asio::detail::thread thread4(bindns::bind(io_context_run, &ioc6));
+  boost::asio::post(ioc5, bindns::bind(post_and_wait, &ioc6, &count));
+  ioc5.run();
+
+  BOOST_ASIO_CHECK(count == 1);
+
+  executor_work_guard<io_context::executor_type> w5 = make_work_guard(ioc5);
+  boost::asio::post(ioc5, bindns::bind(post_and_stop, &ioc5, &ioc6, &count));
+  ioc5.restart();
+  ioc5.run();
+  w6.reset();
+  thread4.join();
+
+  BOOST_ASIO_CHECK(ioc5.stopped());
+  BOOST_ASIO_CHECK(count == 2);
+}
+
 class test_service : public boost::asio::io_context::service
 {
 public:
@@ -560,6 +1719,19 @@ BOOST_ASIO_TEST_SUITE
 (
   "io_context",
   BOOST_ASIO_TEST_CASE(io_context_test)
+  BOOST_ASIO_TEST_CASE(io_context_work_stealing_test)
+  BOOST_ASIO_TEST_CASE(io_context_lock_free_injection_test)
+  BOOST_ASIO_TEST_CASE(io_context_spin_test)
+  BOOST_ASIO_TEST_CASE(io_context_batch_test)
+  BOOST_ASIO_TEST_CASE(io_context_priority_test)
+  BOOST_ASIO_TEST_CASE(io_context_metrics_test)
+  BOOST_ASIO_TEST_CASE(io_context_poll_budget_test)
+  BOOST_ASIO_TEST_CASE(io_context_reactor_batch_test)
+  BOOST_ASIO_TEST_CASE(io_context_busy_poll_test)
+  BOOST_ASIO_TEST_CASE(io_context_per_thread_reactors_test)
+  BOOST_ASIO_TEST_CASE(io_context_descriptor_memory_test)
+  BOOST_ASIO_TEST_CASE(io_context_adaptive_speculation_test)
+  BOOST_ASIO_TEST_CASE(io_context_msg_ring_test)
   BOOST_ASIO_TEST_CASE(io_context_service_test)
   BOOST_ASIO_TEST_CASE(io_context_executor_query_test)
   BOOST_ASIO_TEST_CASE(io_context_executor_execute_test)
@@ -189,6 +189,15 @@ private:
   read_some_handler(const read_some_handler&);
 };
 
+struct data_handler
+{
+  data_handler() {}
+  void operator()(boost::asio::leased_buffer) {}
+  data_handler(data_handler&&) {}
+private:
+  data_handler(const data_handler&);
+};
+
 void test()
 {
 #if defined(BOOST_ASIO_HAS_BOOST_ARRAY)
@@ -290,6 +299,11 @@ void test()
     socket1.close();
     socket1.close(ec);
 
+    socket1.async_close(wait_handler());
+    socket1.async_close(immediate);
+    int i29 = socket1.async_close(lazy);
+    (void)i29;
+
     socket1.release();
     socket1.release(ec);
 
@@ -300,6 +314,14 @@ void test()
     socket1.cancel();
     socket1.cancel(ec);
 
+    socket1.migrate();
+    socket1.migrate(ec);
+
+    uint64_t speculative_hits1 = socket1.speculative_hits();
+    (void)speculative_hits1;
+    uint64_t speculative_misses1 = socket1.speculative_misses();
+    (void)speculative_misses1;
+
     bool at_mark1 = socket1.at_mark();
     (void)at_mark1;
     bool at_mark2 = socket1.at_mark(ec);
@@ -371,6 +393,11 @@ void test()
     socket1.shutdown(socket_base::shutdown_both);
     socket1.shutdown(socket_base::shutdown_both, ec);
 
+    socket1.async_shutdown(socket_base::shutdown_send, wait_handler());
+    socket1.async_shutdown(socket_base::shutdown_send, immediate);
+    int i30 = socket1.async_shutdown(socket_base::shutdown_send, lazy);
+    (void)i30;
+
     socket1.wait(socket_base::wait_read);
     socket1.wait(socket_base::wait_write, ec);
 
@@ -526,6 +553,12 @@ void test()
     (void)i26;
     int i27 = socket1.async_read_some(null_buffers(), lazy);
     (void)i27;
+
+    provided_buffer_pool pool(ioc, 128, 4);
+    socket1.async_receive_many(pool, data_handler(), wait_handler());
+    socket1.async_receive_many(pool, data_handler(), immediate);
+    int i28 = socket1.async_receive_many(pool, data_handler(), lazy);
+    (void)i28;
   }
   catch (std::exception&)
   {
@@ -593,6 +626,18 @@ void handle_read_eof(const boost::system::error_code& err,
   BOOST_ASIO_CHECK(bytes_transferred == 0);
 }
 
+void handle_shutdown(const boost::system::error_code& err, bool* called)
+{
+  *called = true;
+  BOOST_ASIO_CHECK(!err);
+}
+
+void handle_close(const boost::system::error_code& err, bool* called)
+{
+  *called = true;
+  BOOST_ASIO_CHECK(!err);
+}
+
 void test()
 {
   using namespace std; // For memcmp.
@@ -690,6 +735,59 @@ void test()
   ioc.restart();
   ioc.run();
   BOOST_ASIO_CHECK(read_eof_completed);
+
+  // An asynchronous shutdown of the send side is seen by the peer as eof.
+
+  client_side_socket.close();
+  client_side_socket.connect(server_endpoint);
+  acceptor.accept(server_side_socket);
+
+  read_eof_completed = false;
+  boost::asio::async_read(client_side_socket,
+      boost::asio::buffer(read_buffer),
+      bindns::bind(handle_read_eof,
+        _1, _2, &read_eof_completed));
+
+  bool shutdown_completed = false;
+  server_side_socket.async_shutdown(ip::tcp::socket::shutdown_send,
+      bindns::bind(handle_shutdown, _1, &shutdown_completed));
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(shutdown_completed);
+  BOOST_ASIO_CHECK(read_eof_completed);
+
+  // An asynchronous close cancels outstanding operations at once.
+
+  read_cancel_completed = false;
+  boost::asio::async_read(server_side_socket,
+      boost::asio::buffer(read_buffer),
+      bindns::bind(handle_read_cancel,
+        _1, _2, &read_cancel_completed));
+
+  ioc.restart();
+  ioc.poll();
+  BOOST_ASIO_CHECK(!read_cancel_completed);
+
+  bool close_completed = false;
+  server_side_socket.async_close(
+      bindns::bind(handle_close, _1, &close_completed));
+  BOOST_ASIO_CHECK(!server_side_socket.is_open());
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(read_cancel_completed);
+  BOOST_ASIO_CHECK(close_completed);
+
+  // An asynchronous close of a closed socket succeeds.
+
+  close_completed = false;
+  server_side_socket.async_close(
+      bindns::bind(handle_close, _1, &close_completed));
+
+  ioc.restart();
+  ioc.run();
+  BOOST_ASIO_CHECK(close_completed);
 }
 
 } // namespace ip_tcp_socket_runtime
@@ -731,6 +829,15 @@ private:
   move_accept_handler(const move_accept_handler&) {}
 };
 
+struct connection_handler
+{
+  connection_handler() {}
+  void operator()(boost::asio::ip::tcp::socket) {}
+  connection_handler(connection_handler&&) {}
+private:
+  connection_handler(const connection_handler&);
+};
+
 struct move_accept_ioc_handler
 {
   move_accept_ioc_handler() {}
@@ -834,6 +941,9 @@ void test()
     acceptor1.cancel();
     acceptor1.cancel(ec);
 
+    acceptor1.migrate();
+    acceptor1.migrate(ec);
+
     acceptor1.bind(ip::tcp::endpoint(ip::tcp::v4(), 0));
     acceptor1.bind(ip::tcp::endpoint(ip::tcp::v6(), 0));
     acceptor1.bind(ip::tcp::endpoint(ip::tcp::v4(), 0), ec);
@@ -935,6 +1045,11 @@ void test()
     acceptor1.async_accept(peer_endpoint, immediate);
     acceptor1.async_accept(ioc, peer_endpoint, immediate);
     acceptor1.async_accept(ioc_ex, peer_endpoint, immediate);
+
+    acceptor1.async_accept_many(connection_handler(), wait_handler());
+    acceptor1.async_accept_many(connection_handler(), immediate);
+    int i6 = acceptor1.async_accept_many(connection_handler(), lazy);
+    (void)i6;
   }
   catch (std::exception&)
   {
@@ -962,10 +1077,38 @@ void handle_connect(const boost::system::error_code& err)
   BOOST_ASIO_CHECK(!err);
 }
 
+struct count_connections
+{
+  void operator()(boost::asio::ip::tcp::socket peer)
+  {
+    BOOST_ASIO_CHECK(peer.is_open());
+    if (++*count_ == limit_)
+      acceptor_->cancel();
+  }
+
+  boost::asio::ip::tcp::acceptor* acceptor_;
+  int* count_;
+  int limit_;
+};
+
+void handle_accept_many(const boost::system::error_code& err,
+    boost::system::error_code* result)
+{
+  *result = err;
+}
+
+void handle_wait(const boost::system::error_code& err, bool* called)
+{
+  BOOST_ASIO_CHECK(!err);
+  *called = true;
+}
+
 void test()
 {
   using namespace boost::asio;
   namespace ip = boost::asio::ip;
+  namespace bindns = std;
+  using bindns::placeholders::_1;
 
   io_context ioc;
 
@@ -1018,6 +1161,69 @@ void test()
   server_side_remote_endpoint = server_side_socket.remote_endpoint();
   BOOST_ASIO_CHECK(server_side_remote_endpoint.port()
       == client_endpoint.port());
+
+  // A single accept-many operation accepts every connection until it is
+  // cancelled.
+  client_side_socket.close();
+  server_side_socket.close();
+
+  ip::tcp::socket client_side_socket2(ioc);
+  ip::tcp::socket client_side_socket3(ioc);
+  client_side_socket.connect(server_endpoint);
+  client_side_socket2.connect(server_endpoint);
+  client_side_socket3.connect(server_endpoint);
+
+  int connection_count = 0;
+  boost::system::error_code accept_many_ec;
+  count_connections connection_handler = { &acceptor, &connection_count, 3 };
+  acceptor.async_accept_many(connection_handler,
+      bindns::bind(handle_accept_many, _1, &accept_many_ec));
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(connection_count == 3);
+  BOOST_ASIO_CHECK(accept_many_ec == boost::asio::error::operation_aborted);
+
+#if defined(BOOST_ASIO_HAS_EPOLL) \
+  && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  // Connections are still accepted after the listener is registered again
+  // for exclusive wakeups.
+  client_side_socket.close();
+  server_side_socket.close();
+
+  boost::system::error_code ec;
+  acceptor.set_option(socket_base::exclusive_wakeup(true), ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  acceptor.async_accept(server_side_socket, &handle_accept);
+  client_side_socket.async_connect(server_endpoint, &handle_connect);
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(server_side_socket.is_open());
+
+  // A wait, which is never performed speculatively, arms the exclusive
+  // registration again and so sees a connection that is already pending.
+  client_side_socket.close();
+  server_side_socket.close();
+
+  client_side_socket.async_connect(server_endpoint, &handle_connect);
+
+  ioc.restart();
+  ioc.run();
+
+  bool wait_completed = false;
+  acceptor.async_wait(socket_base::wait_read,
+      bindns::bind(handle_wait, _1, &wait_completed));
+
+  ioc.restart();
+  ioc.run();
+
+  BOOST_ASIO_CHECK(wait_completed);
+#endif // defined(BOOST_ASIO_HAS_EPOLL)
+       //   && !defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
 }
 
 } // namespace ip_tcp_acceptor_runtime
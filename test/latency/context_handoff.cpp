@@ -0,0 +1,125 @@
+//
+// context_handoff.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/post.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+
+// Measures the round trip time of handlers posted back and forth between two
+// contexts, each run by its own thread, with and without handlers being sent
+// directly to the target context's ring. Handlers are only sent this way by
+// the io_uring backend, so with other backends both modes should perform
+// alike.
+
+class shard
+{
+public:
+  shard(const boost::asio::context_options& options)
+    : io_context_(1, options),
+      peer_(0),
+      remaining_(0)
+  {
+  }
+
+  void start(shard* peer, long round_trips)
+  {
+    peer_ = peer;
+    remaining_ = round_trips;
+  }
+
+  void ping()
+  {
+    if (remaining_-- > 0)
+      boost::asio::post(peer_->io_context_, handler(peer_));
+    else
+    {
+      io_context_.stop();
+      peer_->io_context_.stop();
+    }
+  }
+
+  boost::asio::io_context io_context_;
+
+private:
+  struct handler
+  {
+    explicit handler(shard* s) : s_(s) {}
+
+    void operator()()
+    {
+      s_->ping();
+    }
+
+    shard* s_;
+  };
+
+  shard* peer_;
+  long remaining_;
+};
+
+void run_shard(shard* s)
+{
+  s->io_context_.run();
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 3)
+  {
+    std::fprintf(stderr,
+        "Usage: context_handoff <nroundtrips> {queue|msgring}\n");
+    return 1;
+  }
+
+  long round_trips = std::atol(argv[1]);
+  bool msg_ring = (std::strcmp(argv[2], "msgring") == 0);
+
+  boost::asio::context_options options;
+  options.io_uring_msg_ring(msg_ring);
+
+  shard s1(options);
+  shard s2(options);
+  s1.start(&s2, round_trips);
+  s2.start(&s1, round_trips);
+
+  boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+    w1 = boost::asio::make_work_guard(s1.io_context_);
+  boost::asio::executor_work_guard<boost::asio::io_context::executor_type>
+    w2 = boost::asio::make_work_guard(s2.io_context_);
+
+  std::clock_t cpu_start = std::clock();
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+
+  std::thread t(run_shard, &s2);
+  boost::asio::post(s1.io_context_, [&]{ s1.ping(); });
+  s1.io_context_.run();
+  t.join();
+
+  std::chrono::steady_clock::time_point stop
+    = std::chrono::steady_clock::now();
+  std::clock_t cpu_stop = std::clock();
+
+  double elapsed = std::chrono::duration<double>(stop - start).count();
+  double cpu = static_cast<double>(cpu_stop - cpu_start) / CLOCKS_PER_SEC;
+  double total = static_cast<double>(round_trips);
+
+  std::printf("       mode: %s\n", msg_ring ? "msgring" : "queue");
+  std::printf("round trips: %.0f\n", total);
+  std::printf("    elapsed: %.3f s\n", elapsed);
+  std::printf(" round trip: %.0f ns\n", elapsed * 1e9 / total);
+  std::printf("   cpu time: %.3f s\n", cpu);
+  std::printf("   cpu/trip: %.0f ns\n", cpu * 1e9 / total);
+}
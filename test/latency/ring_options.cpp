@@ -0,0 +1,196 @@
+//
+// ring_options.cpp
+// ~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <memory>
+#include <vector>
+
+using boost::asio::ip::tcp;
+
+// Measures the rate of small round trips over many connections on a single
+// threaded context, for each of the io_uring ring configurations. The ring
+// options are only used by the io_uring backend, so with other backends all
+// configurations should perform alike.
+
+class echo_pair
+{
+public:
+  echo_pair(boost::asio::io_context& io_context,
+      tcp::acceptor& acceptor, long round_trips)
+    : client_(io_context),
+      server_(io_context),
+      remaining_(round_trips)
+  {
+    client_.connect(acceptor.local_endpoint());
+    acceptor.accept(server_);
+    client_.set_option(tcp::no_delay(true));
+    server_.set_option(tcp::no_delay(true));
+    std::memset(client_data_, 'x', sizeof(client_data_));
+  }
+
+  void start()
+  {
+    boost::asio::async_write(client_, boost::asio::buffer(client_data_),
+        client_write_handler(this));
+    boost::asio::async_read(server_, boost::asio::buffer(server_data_),
+        server_read_handler(this));
+  }
+
+private:
+  struct client_write_handler
+  {
+    explicit client_write_handler(echo_pair* p) : p_(p) {}
+
+    void operator()(boost::system::error_code ec, std::size_t)
+    {
+      if (!ec)
+      {
+        boost::asio::async_read(p_->client_,
+            boost::asio::buffer(p_->client_data_),
+            client_read_handler(p_));
+      }
+    }
+
+    echo_pair* p_;
+  };
+
+  struct client_read_handler
+  {
+    explicit client_read_handler(echo_pair* p) : p_(p) {}
+
+    void operator()(boost::system::error_code ec, std::size_t)
+    {
+      if (!ec && --p_->remaining_ > 0)
+      {
+        boost::asio::async_write(p_->client_,
+            boost::asio::buffer(p_->client_data_),
+            client_write_handler(p_));
+      }
+      else
+      {
+        p_->client_.close(ec);
+      }
+    }
+
+    echo_pair* p_;
+  };
+
+  struct server_read_handler
+  {
+    explicit server_read_handler(echo_pair* p) : p_(p) {}
+
+    void operator()(boost::system::error_code ec, std::size_t)
+    {
+      if (!ec)
+      {
+        boost::asio::async_write(p_->server_,
+            boost::asio::buffer(p_->server_data_),
+            server_write_handler(p_));
+      }
+    }
+
+    echo_pair* p_;
+  };
+
+  struct server_write_handler
+  {
+    explicit server_write_handler(echo_pair* p) : p_(p) {}
+
+    void operator()(boost::system::error_code ec, std::size_t)
+    {
+      if (!ec)
+      {
+        boost::asio::async_read(p_->server_,
+            boost::asio::buffer(p_->server_data_),
+            server_read_handler(p_));
+      }
+    }
+
+    echo_pair* p_;
+  };
+
+  tcp::socket client_;
+  tcp::socket server_;
+  char client_data_[64];
+  char server_data_[64];
+  long remaining_;
+};
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: ring_options <nconns> <nroundtrips> <config>\n"
+        "where <config> is one of: default, sqpoll, coop_taskrun,"
+        " single_issuer, defer_taskrun\n");
+    return 1;
+  }
+
+  int num_connections = std::atoi(argv[1]);
+  long round_trips = std::atol(argv[2]);
+  const char* config = argv[3];
+
+  boost::asio::context_options options;
+  if (std::strcmp(config, "sqpoll") == 0)
+    options.io_uring_sq_poll(true);
+  else if (std::strcmp(config, "coop_taskrun") == 0)
+    options.io_uring_coop_taskrun(true);
+  else if (std::strcmp(config, "single_issuer") == 0)
+    options.io_uring_single_issuer(true);
+  else if (std::strcmp(config, "defer_taskrun") == 0)
+    options.io_uring_defer_taskrun(true);
+  else if (std::strcmp(config, "default") != 0)
+  {
+    std::fprintf(stderr, "Unknown config: %s\n", config);
+    return 1;
+  }
+
+  // A single issuer ring requires that the context is not used concurrently.
+  boost::asio::io_context io_context(
+      BOOST_ASIO_CONCURRENCY_HINT_UNSAFE, options);
+  tcp::acceptor acceptor(io_context,
+      tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+  std::vector<std::unique_ptr<echo_pair>> pairs;
+  for (int i = 0; i < num_connections; ++i)
+    pairs.emplace_back(new echo_pair(io_context, acceptor, round_trips));
+
+  std::clock_t cpu_start = std::clock();
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+
+  for (int i = 0; i < num_connections; ++i)
+    pairs[i]->start();
+  io_context.run();
+
+  std::chrono::steady_clock::time_point stop
+    = std::chrono::steady_clock::now();
+  std::clock_t cpu_stop = std::clock();
+
+  double elapsed = std::chrono::duration<double>(stop - start).count();
+  double cpu = static_cast<double>(cpu_stop - cpu_start) / CLOCKS_PER_SEC;
+  double total = static_cast<double>(round_trips) * num_connections;
+
+  std::printf("     config: %s\n", config);
+  std::printf("round trips: %.0f\n", total);
+  std::printf("    elapsed: %.3f s\n", elapsed);
+  std::printf("       rate: %.0f round trips/s\n", total / elapsed);
+  std::printf("   cpu time: %.3f s\n", cpu);
+  std::printf("   cpu/trip: %.0f ns\n", cpu * 1e9 / total);
+}
@@ -0,0 +1,180 @@
+//
+// tcp_accept.cpp
+// ~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/shared_ptr.hpp>
+#include <atomic>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <vector>
+#include <unistd.h>
+
+using boost::asio::ip::tcp;
+
+// Measures the rate at which many io_context objects, each waiting on its own
+// descriptor for one shared listening socket, accept connections. Without the
+// exclusive_wakeup option every connection wakes all of the contexts.
+
+std::atomic<long> total_accepted(0);
+
+class accept_context
+{
+public:
+  accept_context(int listener, bool exclusive) :
+    io_context_(1),
+    acceptor_(io_context_),
+    socket_(io_context_),
+    accepted_(0)
+  {
+    acceptor_.assign(tcp::v4(), ::dup(listener));
+    if (exclusive)
+      acceptor_.set_option(tcp::acceptor::exclusive_wakeup(true));
+  }
+
+  void start()
+  {
+    acceptor_.async_accept(socket_, handler(this));
+  }
+
+  void run()
+  {
+    io_context_.run();
+  }
+
+  void stop()
+  {
+    io_context_.stop();
+  }
+
+  long accepted() const
+  {
+    return accepted_;
+  }
+
+private:
+  struct handler
+  {
+    explicit handler(accept_context* c)
+      : c_(c)
+    {
+    }
+
+    void operator()(boost::system::error_code ec)
+    {
+      if (!ec)
+      {
+        ++c_->accepted_;
+        ++total_accepted;
+        c_->socket_.close();
+      }
+      c_->start();
+    }
+
+    accept_context* c_;
+  };
+
+  boost::asio::io_context io_context_;
+  tcp::acceptor acceptor_;
+  tcp::socket socket_;
+  long accepted_;
+};
+
+void connect_loop(tcp::endpoint endpoint, int num_connections)
+{
+  boost::asio::io_context io_context;
+  for (int i = 0; i < num_connections; ++i)
+  {
+    tcp::socket socket(io_context);
+    socket.connect(endpoint);
+  }
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 6)
+  {
+    std::fprintf(stderr,
+        "Usage: tcp_accept <port> <ncontexts> <nclients> "
+        "<nconns> {exclusive|shared}\n");
+    return 1;
+  }
+
+  unsigned short port = static_cast<unsigned short>(std::atoi(argv[1]));
+  int num_contexts = std::atoi(argv[2]);
+  int num_clients = std::atoi(argv[3]);
+  int num_connections = std::atoi(argv[4]);
+  bool exclusive = (std::strcmp(argv[5], "exclusive") == 0);
+
+  boost::asio::io_context io_context;
+  tcp::acceptor listener(io_context, tcp::endpoint(tcp::v4(), port));
+  tcp::endpoint endpoint(boost::asio::ip::address_v4::loopback(),
+      listener.local_endpoint().port());
+
+  std::vector<boost::shared_ptr<accept_context> > contexts;
+  for (int i = 0; i < num_contexts; ++i)
+  {
+    boost::shared_ptr<accept_context> c(
+        new accept_context(listener.native_handle(), exclusive));
+    contexts.push_back(c);
+    c->start();
+  }
+
+  std::vector<std::thread> threads;
+  for (int i = 0; i < num_contexts; ++i)
+    threads.push_back(std::thread(&accept_context::run, contexts[i].get()));
+
+  std::clock_t cpu_start = std::clock();
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+
+  int per_client = num_connections / num_clients;
+  std::vector<std::thread> clients;
+  for (int i = 0; i < num_clients; ++i)
+    clients.push_back(std::thread(connect_loop, endpoint, per_client));
+  for (int i = 0; i < num_clients; ++i)
+    clients[i].join();
+
+  long expected = static_cast<long>(per_client) * num_clients;
+  while (total_accepted < expected)
+    std::this_thread::sleep_for(std::chrono::microseconds(100));
+
+  std::chrono::steady_clock::time_point stop
+    = std::chrono::steady_clock::now();
+  std::clock_t cpu_stop = std::clock();
+
+  for (int i = 0; i < num_contexts; ++i)
+    contexts[i]->stop();
+  for (int i = 0; i < num_contexts; ++i)
+    threads[i].join();
+
+  double elapsed = std::chrono::duration<double>(stop - start).count();
+  double cpu = static_cast<double>(cpu_stop - cpu_start) / CLOCKS_PER_SEC;
+
+  long min_accepted = expected, max_accepted = 0;
+  for (int i = 0; i < num_contexts; ++i)
+  {
+    long n = contexts[i]->accepted();
+    if (n < min_accepted) min_accepted = n;
+    if (n > max_accepted) max_accepted = n;
+  }
+
+  std::printf("     mode: %s\n", exclusive ? "exclusive" : "shared");
+  std::printf(" contexts: %d\n", num_contexts);
+  std::printf(" accepted: %ld\n", expected);
+  std::printf("  elapsed: %.3f s\n", elapsed);
+  std::printf("     rate: %.0f conns/s\n", expected / elapsed);
+  std::printf(" cpu time: %.3f s\n", cpu);
+  std::printf("  per ctx: min %ld, max %ld\n", min_accepted, max_accepted);
+}
@@ -0,0 +1,131 @@
+//
+// tcp_send.cpp
+// ~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/write.hpp>
+#include <chrono>
+#include <cstdio>
+#include <cstdlib>
+#include <cstring>
+#include <ctime>
+#include <thread>
+#include <vector>
+
+using boost::asio::ip::tcp;
+
+// Measures the throughput and CPU cost of large writes to a stream socket,
+// with and without zero-copy sends. Zero-copy sends are only made by the
+// io_uring backend, and only where the kernel supports them.
+
+class sender
+{
+public:
+  sender(tcp::socket& socket, std::size_t write_size, long num_writes)
+    : socket_(socket),
+      data_(write_size, 'x'),
+      remaining_(num_writes)
+  {
+  }
+
+  void start()
+  {
+    boost::asio::async_write(socket_, boost::asio::buffer(data_),
+        handler(this));
+  }
+
+private:
+  struct handler
+  {
+    explicit handler(sender* s)
+      : s_(s)
+    {
+    }
+
+    void operator()(boost::system::error_code ec, std::size_t)
+    {
+      if (!ec && --s_->remaining_ > 0)
+        s_->start();
+      else
+        s_->socket_.shutdown(tcp::socket::shutdown_send, ec);
+    }
+
+    sender* s_;
+  };
+
+  tcp::socket& socket_;
+  std::vector<char> data_;
+  long remaining_;
+};
+
+void receive_loop(tcp::socket* socket, std::size_t* received)
+{
+  std::vector<char> buf(1024 * 1024);
+  boost::system::error_code ec;
+  while (!ec)
+    *received += socket->read_some(boost::asio::buffer(buf), ec);
+}
+
+int main(int argc, char* argv[])
+{
+  if (argc != 4)
+  {
+    std::fprintf(stderr,
+        "Usage: tcp_send <writesize> <nwrites> {copy|zerocopy}\n");
+    return 1;
+  }
+
+  std::size_t write_size = std::atoi(argv[1]);
+  long num_writes = std::atol(argv[2]);
+  bool zero_copy = (std::strcmp(argv[3], "zerocopy") == 0);
+
+  boost::asio::context_options options;
+  if (zero_copy)
+    options.zero_copy_send_threshold(write_size);
+
+  boost::asio::io_context io_context(1, options);
+  tcp::acceptor acceptor(io_context,
+      tcp::endpoint(boost::asio::ip::address_v4::loopback(), 0));
+
+  boost::asio::io_context receive_context;
+  tcp::socket receive_socket(receive_context);
+  receive_socket.connect(acceptor.local_endpoint());
+
+  tcp::socket send_socket(io_context);
+  acceptor.accept(send_socket);
+
+  std::size_t received = 0;
+  std::thread receiver(receive_loop, &receive_socket, &received);
+
+  std::clock_t cpu_start = std::clock();
+  std::chrono::steady_clock::time_point start
+    = std::chrono::steady_clock::now();
+
+  sender s(send_socket, write_size, num_writes);
+  s.start();
+  io_context.run();
+  receiver.join();
+
+  std::chrono::steady_clock::time_point stop
+    = std::chrono::steady_clock::now();
+  std::clock_t cpu_stop = std::clock();
+
+  double elapsed = std::chrono::duration<double>(stop - start).count();
+  double cpu = static_cast<double>(cpu_stop - cpu_start) / CLOCKS_PER_SEC;
+  double megabytes = static_cast<double>(received) / (1024 * 1024);
+
+  std::printf("      mode: %s\n", zero_copy ? "zerocopy" : "copy");
+  std::printf("write size: %lu\n", static_cast<unsigned long>(write_size));
+  std::printf("  received: %.1f MB\n", megabytes);
+  std::printf("   elapsed: %.3f s\n", elapsed);
+  std::printf("throughput: %.1f MB/s\n", megabytes / elapsed);
+  std::printf("  cpu time: %.3f s\n", cpu);
+  std::printf("    cpu/GB: %.3f s\n", cpu * 1024 / megabytes);
+}
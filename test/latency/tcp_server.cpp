@@ -25,10 +25,11 @@ using boost::asio::ip::tcp;
 class tcp_server : boost::asio::coroutine
 {
 public:
-  tcp_server(tcp::acceptor& acceptor, std::size_t buf_size) :
+  tcp_server(tcp::acceptor& acceptor, std::size_t buf_size, bool busy_poll) :
     acceptor_(acceptor),
     socket_(acceptor_.get_executor()),
-    buffer_(buf_size)
+    buffer_(buf_size),
+    busy_poll_(busy_poll)
   {
   }
 
@@ -38,6 +39,14 @@ public:
     {
       yield acceptor_.async_accept(socket_, ref(this));
 
+      if (!ec && busy_poll_)
+      {
+        // Raising the busy poll time may need privileges, so ignore failures.
+        boost::system::error_code option_ec;
+        socket_.set_option(tcp::socket::busy_poll(50), option_ec);
+        socket_.set_option(tcp::socket::prefer_busy_poll(true), option_ec);
+      }
+
       while (!ec)
       {
         yield boost::asio::async_read(socket_,
@@ -77,6 +86,7 @@ private:
   tcp::socket socket_;
   std::vector<unsigned char> buffer_;
   tcp::endpoint sender_;
+  bool busy_poll_;
 };
 
 #include <boost/asio/unyield.hpp>
@@ -87,7 +97,7 @@ int main(int argc, char* argv[])
   {
     std::fprintf(stderr,
         "Usage: tcp_server <port> <nconns> "
-        "<bufsize> {spin|block}\n");
+        "<bufsize> {spin|block|busy}\n");
     return 1;
   }
 
@@ -95,14 +105,24 @@ int main(int argc, char* argv[])
   int max_connections = std::atoi(argv[2]);
   std::size_t buf_size = std::atoi(argv[3]);
   bool spin = (std::strcmp(argv[4], "spin") == 0);
+  bool busy = (std::strcmp(argv[4], "busy") == 0);
+
+  boost::asio::context_options options;
+  if (busy)
+  {
+    options.busy_poll_idle(true);
+    options.reactor_busy_poll(boost::asio::chrono::microseconds(50));
+    options.prefer_busy_poll(true);
+  }
 
-  boost::asio::io_context io_context(1);
+  boost::asio::io_context io_context(1, options);
   tcp::acceptor acceptor(io_context, tcp::endpoint(tcp::v4(), port));
   std::vector<boost::shared_ptr<tcp_server> > servers;
 
   for (int i = 0; i < max_connections; ++i)
   {
-    boost::shared_ptr<tcp_server> s(new tcp_server(acceptor, buf_size));
+    boost::shared_ptr<tcp_server> s(
+        new tcp_server(acceptor, buf_size, busy));
     servers.push_back(s);
     (*s)(boost::system::error_code());
   }
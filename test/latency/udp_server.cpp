@@ -25,10 +25,17 @@ class udp_server : boost::asio::coroutine
 {
 public:
   udp_server(boost::asio::io_context& io_context,
-      unsigned short port, std::size_t buf_size) :
+      unsigned short port, std::size_t buf_size, bool busy_poll) :
     socket_(io_context, udp::endpoint(udp::v4(), port)),
     buffer_(buf_size)
   {
+    if (busy_poll)
+    {
+      // Raising the busy poll time may need privileges, so ignore failures.
+      boost::system::error_code ec;
+      socket_.set_option(udp::socket::busy_poll(50), ec);
+      socket_.set_option(udp::socket::prefer_busy_poll(true), ec);
+    }
   }
 
   void operator()(boost::system::error_code ec, std::size_t n = 0)
@@ -98,7 +105,7 @@ int main(int argc, char* argv[])
   {
     std::fprintf(stderr,
         "Usage: udp_server <port1> <nports> "
-        "<bufsize> {spin|block}\n");
+        "<bufsize> {spin|block|busy}\n");
     return 1;
   }
 
@@ -106,14 +113,24 @@ int main(int argc, char* argv[])
   unsigned short num_ports = static_cast<unsigned short>(std::atoi(argv[2]));
   std::size_t buf_size = std::atoi(argv[3]);
   bool spin = (std::strcmp(argv[4], "spin") == 0);
+  bool busy = (std::strcmp(argv[4], "busy") == 0);
+
+  boost::asio::context_options options;
+  if (busy)
+  {
+    options.busy_poll_idle(true);
+    options.reactor_busy_poll(boost::asio::chrono::microseconds(50));
+    options.prefer_busy_poll(true);
+  }
 
-  boost::asio::io_context io_context(1);
+  boost::asio::io_context io_context(1, options);
   std::vector<boost::shared_ptr<udp_server> > servers;
 
   for (unsigned short i = 0; i < num_ports; ++i)
   {
     unsigned short port = first_port + i;
-    boost::shared_ptr<udp_server> s(new udp_server(io_context, port, buf_size));
+    boost::shared_ptr<udp_server> s(
+        new udp_server(io_context, port, buf_size, busy));
     servers.push_back(s);
     (*s)(boost::system::error_code());
   }
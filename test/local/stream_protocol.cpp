@@ -17,7 +17,12 @@
 #include <boost/asio/local/stream_protocol.hpp>
 
 #include <cstring>
+#include <vector>
+#include <boost/asio/context_options.hpp>
 #include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/read.hpp>
+#include <boost/asio/write.hpp>
 #include "../unit_test.hpp"
 
 //------------------------------------------------------------------------------
@@ -212,8 +217,69 @@ void test()
 
 //------------------------------------------------------------------------------
 
+// local_stream_protocol_zero_copy_send test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks that writes above the zero-copy send threshold
+// succeed on a socket that does not support zero-copy sends, by falling back
+// to copying the data.
+
+namespace local_stream_protocol_zero_copy_send {
+
+void test()
+{
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  using namespace boost::asio;
+  namespace local = boost::asio::local;
+  typedef local::stream_protocol::socket socket_type;
+
+  context_options options;
+  options.zero_copy_send_threshold(4096);
+  io_context ioc(1, options);
+
+  socket_type socket1(ioc);
+  socket_type socket2(ioc);
+  local::connect_pair(socket1, socket2);
+
+  std::vector<char> send_data(65536);
+  for (std::size_t i = 0; i < send_data.size(); ++i)
+    send_data[i] = static_cast<char>(i % 251);
+  std::vector<char> recv_data(send_data.size());
+
+  boost::system::error_code write_ec = error::would_block;
+  std::size_t bytes_written = 0;
+  async_write(socket1, buffer(send_data),
+      [&](const boost::system::error_code& ec, std::size_t n)
+      {
+        write_ec = ec;
+        bytes_written = n;
+      });
+
+  boost::system::error_code read_ec = error::would_block;
+  std::size_t bytes_read = 0;
+  async_read(socket2, buffer(recv_data),
+      [&](const boost::system::error_code& ec, std::size_t n)
+      {
+        read_ec = ec;
+        bytes_read = n;
+      });
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(!write_ec);
+  BOOST_ASIO_CHECK(bytes_written == send_data.size());
+  BOOST_ASIO_CHECK(!read_ec);
+  BOOST_ASIO_CHECK(bytes_read == recv_data.size());
+  BOOST_ASIO_CHECK(send_data == recv_data);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace local_stream_protocol_zero_copy_send
+
+//------------------------------------------------------------------------------
+
 BOOST_ASIO_TEST_SUITE
 (
   "local/stream_protocol",
   BOOST_ASIO_COMPILE_TEST_CASE(local_stream_protocol_socket_compile::test)
+  BOOST_ASIO_TEST_CASE(local_stream_protocol_zero_copy_send::test)
 )
@@ -0,0 +1,122 @@
+//
+// provided_buffer_pool.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/provided_buffer_pool.hpp>
+
+#include <cstring>
+#include <string>
+#include <boost/asio/io_context.hpp>
+#include <boost/asio/local/connect_pair.hpp>
+#include <boost/asio/local/stream_protocol.hpp>
+#include <boost/asio/write.hpp>
+#include "unit_test.hpp"
+
+//------------------------------------------------------------------------------
+
+// provided_buffer_pool_runtime test
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~~
+// The following test checks the runtime operation of the provided_buffer_pool
+// class and the async_receive_many function.
+
+namespace provided_buffer_pool_runtime {
+
+struct collect_data
+{
+  std::string* data_;
+  int* count_;
+
+  void operator()(boost::asio::leased_buffer buffer)
+  {
+    BOOST_ASIO_CHECK(buffer.size() > 0);
+    BOOST_ASIO_CHECK(buffer.data().size() == buffer.size());
+    data_->append(static_cast<const char*>(buffer.data().data()),
+        buffer.size());
+    ++*count_;
+  }
+};
+
+void handle_receive_many(const boost::system::error_code& err,
+    boost::system::error_code* result)
+{
+  *result = err;
+}
+
+void test()
+{
+  using namespace boost::asio;
+  namespace bindns = std;
+  using bindns::placeholders::_1;
+
+  io_context ioc;
+
+  provided_buffer_pool pool(ioc, 16, 4);
+  BOOST_ASIO_CHECK(pool.buffer_size() == 16);
+  BOOST_ASIO_CHECK(pool.buffer_count() == 4);
+
+  provided_buffer_pool pool2(ioc.get_executor(), 32, 8);
+  BOOST_ASIO_CHECK(pool2.buffer_size() == 32);
+  BOOST_ASIO_CHECK(pool2.buffer_count() == 8);
+
+#if !defined(BOOST_ASIO_NO_EXCEPTIONS)
+  try
+  {
+    provided_buffer_pool pool3(ioc, 16, 3);
+    BOOST_ASIO_ERROR("expected exception");
+  }
+  catch (boost::system::system_error& e)
+  {
+    BOOST_ASIO_CHECK(e.code() == error::invalid_argument);
+  }
+#endif // !defined(BOOST_ASIO_NO_EXCEPTIONS)
+
+  leased_buffer empty;
+  BOOST_ASIO_CHECK(empty.size() == 0);
+  BOOST_ASIO_CHECK(empty.data().size() == 0);
+
+#if defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+  local::stream_protocol::socket s1(ioc);
+  local::stream_protocol::socket s2(ioc);
+  local::connect_pair(s1, s2);
+
+  const char message[] = "the quick brown fox jumps over the lazy dog";
+  const std::size_t message_size = std::strlen(message);
+  write(s1, buffer(message, message_size));
+  s1.close();
+
+  std::string data;
+  int count = 0;
+  collect_data handler = { &data, &count };
+  boost::system::error_code result;
+  s2.async_receive_many(pool, handler,
+      bindns::bind(handle_receive_many, _1, &result));
+
+  ioc.run();
+
+  BOOST_ASIO_CHECK(result == error::eof);
+  BOOST_ASIO_CHECK(data == message);
+  BOOST_ASIO_CHECK(count >= 3);
+#endif // defined(BOOST_ASIO_HAS_LOCAL_SOCKETS)
+}
+
+} // namespace provided_buffer_pool_runtime
+
+//------------------------------------------------------------------------------
+
+BOOST_ASIO_TEST_SUITE
+(
+  "provided_buffer_pool",
+  BOOST_ASIO_TEST_CASE(provided_buffer_pool_runtime::test)
+)
@@ -0,0 +1,188 @@
+//
+// sharded_acceptor.cpp
+// ~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/sharded_acceptor.hpp>
+
+#include <chrono>
+#include <thread>
+#include <boost/asio/ip/tcp.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include "unit_test.hpp"
+
+#if !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+# include <sys/resource.h>
+# include <unistd.h>
+#endif // !defined(BOOST_ASIO_WINDOWS) && !defined(__CYGWIN__)
+
+using namespace boost::asio;
+
+typedef sharded_acceptor<ip::tcp> acceptor_type;
+
+struct connection_handler
+{
+  sharded_context* ctx_;
+  boost::asio::detail::atomic_count* count_;
+  boost::asio::detail::atomic_count* mismatches_;
+  boost::asio::detail::atomic_count* shard_counts_;
+
+  void operator()(const boost::system::error_code& ec,
+      acceptor_type::socket_type peer)
+  {
+    std::size_t shard = ctx_->current_shard();
+    if (ec || shard == ctx_->size()
+        || peer.get_executor() != ctx_->get_io_context(shard).get_executor())
+      ++(*mismatches_);
+    else
+      ++shard_counts_[shard];
+    ++(*count_);
+  }
+};
+
+void wait_for_count(boost::asio::detail::atomic_count* count, long expected)
+{
+  io_context ioc;
+  for (int i = 0; i < 10000 && *count < expected; ++i)
+  {
+    steady_timer t(ioc, boost::asio::chrono::milliseconds(1));
+    t.wait();
+  }
+}
+
+void test_accept(bool reuse_port)
+{
+  const int num_connections = 16;
+
+  sharded_context ctx(4);
+  boost::asio::detail::atomic_count count(0);
+  boost::asio::detail::atomic_count mismatches(0);
+  boost::asio::detail::atomic_count shard_counts[4] = { {0}, {0}, {0}, {0} };
+
+  acceptor_type a(ctx, reuse_port);
+  a.listen(ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+  BOOST_ASIO_CHECK(a.size() >= 1);
+  BOOST_ASIO_CHECK(a.size() <= ctx.size());
+  if (!reuse_port)
+    BOOST_ASIO_CHECK(a.size() == 1);
+
+  boost::system::error_code ec;
+  a.listen(a.local_endpoint(), socket_base::max_listen_connections, ec);
+  BOOST_ASIO_CHECK(ec == boost::asio::error::already_open);
+
+  connection_handler handler = { &ctx, &count, &mismatches, shard_counts };
+  a.accept(handler);
+
+  io_context client_ioc;
+  for (int i = 0; i < num_connections; ++i)
+  {
+    ip::tcp::socket client(client_ioc);
+    client.connect(a.local_endpoint());
+  }
+
+  wait_for_count(&count, num_connections);
+
+  BOOST_ASIO_CHECK(count == num_connections);
+  BOOST_ASIO_CHECK(mismatches == 0);
+
+  // A single listening socket hands connections to the shards in turn.
+  if (a.size() == 1)
+    for (std::size_t i = 0; i < ctx.size(); ++i)
+      BOOST_ASIO_CHECK(shard_counts[i] == num_connections / 4);
+
+  a.close();
+}
+
+struct error_counting_handler
+{
+  boost::asio::detail::atomic_count* errors_;
+  boost::asio::detail::atomic_count* accepted_;
+
+  void operator()(const boost::system::error_code& ec,
+      acceptor_type::socket_type)
+  {
+    if (ec)
+      ++(*errors_);
+    else
+      ++(*accepted_);
+  }
+};
+
+void test_accept_error()
+{
+#if defined(RLIMIT_NOFILE)
+  sharded_context ctx(2);
+  boost::asio::detail::atomic_count errors(0);
+  boost::asio::detail::atomic_count accepted(0);
+
+  acceptor_type a(ctx, false);
+  a.listen(ip::tcp::endpoint(ip::address_v4::loopback(), 0));
+
+  io_context client_ioc;
+  ip::tcp::socket client(client_ioc);
+  client.connect(a.local_endpoint());
+
+  // Create each shard's socket services, which need descriptors of their own,
+  // before any are accepted into them.
+  for (std::size_t i = 0; i < ctx.size(); ++i)
+    ip::tcp::socket(ctx.get_io_context(i));
+
+  // Lower the descriptor limit to the lowest free descriptor, so that every
+  // attempt to accept the pending connection fails.
+  ::rlimit old_limit;
+  BOOST_ASIO_CHECK(::getrlimit(RLIMIT_NOFILE, &old_limit) == 0);
+  int lowest_free = ::dup(client.native_handle());
+  BOOST_ASIO_CHECK(lowest_free != -1);
+  ::close(lowest_free);
+  ::rlimit new_limit = old_limit;
+  new_limit.rlim_cur = lowest_free;
+  BOOST_ASIO_CHECK(::setrlimit(RLIMIT_NOFILE, &new_limit) == 0);
+
+  error_counting_handler handler = { &errors, &accepted };
+  a.accept(handler);
+
+  // Nothing that needs a new descriptor may be done until the limit is
+  // restored, so the test waits by sleeping.
+  for (int i = 0; i < 5000 && errors == 0; ++i)
+    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+  std::this_thread::sleep_for(3 * acceptor_type::retry_delay());
+  long errors_while_limited = errors;
+
+  BOOST_ASIO_CHECK(::setrlimit(RLIMIT_NOFILE, &old_limit) == 0);
+
+  // The loop retries after a delay rather than failing without pause.
+  BOOST_ASIO_CHECK(errors_while_limited >= 1);
+  BOOST_ASIO_CHECK(errors_while_limited <= 5);
+
+  // The connection is accepted once descriptors are available again.
+  wait_for_count(&accepted, 1);
+  BOOST_ASIO_CHECK(accepted == 1);
+
+  a.close();
+#endif // defined(RLIMIT_NOFILE)
+}
+
+void sharded_acceptor_test()
+{
+  test_accept(true);
+  test_accept(false);
+  test_accept_error();
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "sharded_acceptor",
+  BOOST_ASIO_TEST_CASE(sharded_acceptor_test)
+)
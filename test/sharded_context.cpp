@@ -0,0 +1,143 @@
+//
+// sharded_context.cpp
+// ~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/sharded_context.hpp>
+
+#include <functional>
+#include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
+#include <boost/asio/detail/atomic_count.hpp>
+#include "unit_test.hpp"
+
+using namespace boost::asio;
+namespace bindns = std;
+
+void record_shard(sharded_context* ctx, std::size_t expected,
+    boost::asio::detail::atomic_count* count,
+    boost::asio::detail::atomic_count* mismatches)
+{
+  if (ctx->current_shard() != expected)
+    ++(*mismatches);
+  ++(*count);
+}
+
+void ping(sharded_context* ctx, int hops,
+    boost::asio::detail::atomic_count* count,
+    boost::asio::detail::atomic_count* mismatches)
+{
+  ++(*count);
+  if (hops > 0)
+  {
+    // Submit to the next shard, or to ourselves when there is only one.
+    std::size_t next = (ctx->current_shard() + 1) % ctx->size();
+    ctx->submit(next, bindns::bind(ping, ctx, hops - 1, count, mismatches));
+  }
+  else if (ctx->current_shard() == ctx->size())
+  {
+    ++(*mismatches);
+  }
+}
+
+
+void wait_for_count(boost::asio::detail::atomic_count* count, long expected)
+{
+  io_context ioc;
+  for (int i = 0; i < 10000 && *count < expected; ++i)
+  {
+    steady_timer t(ioc, boost::asio::chrono::milliseconds(1));
+    t.wait();
+  }
+}
+
+void sharded_context_test()
+{
+  boost::asio::detail::atomic_count count(0);
+  boost::asio::detail::atomic_count mismatches(0);
+
+  {
+    sharded_context ctx(4);
+    BOOST_ASIO_CHECK(ctx.size() == 4);
+    BOOST_ASIO_CHECK(ctx.current_shard() == ctx.size());
+
+    // Successive calls visit every shard.
+    io_context* seen[4] = { 0, 0, 0, 0 };
+    for (int i = 0; i < 4; ++i)
+      seen[i] = &ctx.get_io_context();
+    for (int i = 0; i < 4; ++i)
+      for (int j = i + 1; j < 4; ++j)
+        BOOST_ASIO_CHECK(seen[i] != seen[j]);
+
+    for (std::size_t i = 0; i < ctx.size(); ++i)
+    {
+      for (int j = 0; j < 100; ++j)
+      {
+        ctx.submit(i, bindns::bind(record_shard,
+              &ctx, i, &count, &mismatches));
+      }
+
+      boost::asio::post(ctx.get_io_context(i),
+          bindns::bind(record_shard, &ctx, i, &count, &mismatches));
+    }
+
+    ctx.submit(0, bindns::bind(ping, &ctx, 1000, &count, &mismatches));
+
+    wait_for_count(&count, 400 + 4 + 1001);
+    ctx.stop();
+    ctx.join();
+  }
+
+  BOOST_ASIO_CHECK(count == 400 + 4 + 1001);
+  BOOST_ASIO_CHECK(mismatches == 0);
+
+  count = 0;
+  {
+    sharded_context ctx(1);
+    ctx.submit(0, bindns::bind(ping, &ctx, 10, &count, &mismatches));
+    wait_for_count(&count, 11);
+  }
+
+  BOOST_ASIO_CHECK(count == 11);
+  BOOST_ASIO_CHECK(mismatches == 0);
+
+  count = 0;
+  {
+    boost::asio::context_options options;
+    options.pin_threads(true);
+
+    sharded_context ctx(2, options);
+    for (std::size_t i = 0; i < ctx.size(); ++i)
+      ctx.submit(i, bindns::bind(record_shard, &ctx, i, &count, &mismatches));
+    wait_for_count(&count, 2);
+  }
+
+  BOOST_ASIO_CHECK(count == 2);
+  BOOST_ASIO_CHECK(mismatches == 0);
+
+  // Functions that are never run are destroyed with the context.
+  {
+    sharded_context ctx(2);
+    ctx.stop();
+    ctx.submit(1, bindns::bind(record_shard, &ctx, 1, &count, &mismatches));
+  }
+
+  BOOST_ASIO_CHECK(count == 2);
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "sharded_context",
+  BOOST_ASIO_TEST_CASE(sharded_context_test)
+)
@@ -177,6 +177,37 @@ void test()
     (void)static_cast<bool>(!enable_connection_aborted1);
     (void)static_cast<bool>(enable_connection_aborted1.value());
 
+    // exclusive_wakeup class.
+
+    socket_base::exclusive_wakeup exclusive_wakeup1(true);
+    sock.set_option(exclusive_wakeup1);
+    socket_base::exclusive_wakeup exclusive_wakeup2;
+    sock.get_option(exclusive_wakeup2);
+    exclusive_wakeup1 = true;
+    (void)static_cast<bool>(exclusive_wakeup1);
+    (void)static_cast<bool>(!exclusive_wakeup1);
+    (void)static_cast<bool>(exclusive_wakeup1.value());
+
+    // busy_poll class.
+
+    socket_base::busy_poll busy_poll1(0);
+    sock.set_option(busy_poll1);
+    socket_base::busy_poll busy_poll2;
+    sock.get_option(busy_poll2);
+    busy_poll1 = 1;
+    (void)static_cast<int>(busy_poll1.value());
+
+    // prefer_busy_poll class.
+
+    socket_base::prefer_busy_poll prefer_busy_poll1(true);
+    sock.set_option(prefer_busy_poll1);
+    socket_base::prefer_busy_poll prefer_busy_poll2;
+    sock.get_option(prefer_busy_poll2);
+    prefer_busy_poll1 = true;
+    (void)static_cast<bool>(prefer_busy_poll1);
+    (void)static_cast<bool>(!prefer_busy_poll1);
+    (void)static_cast<bool>(prefer_busy_poll1.value());
+
     // bytes_readable class.
 
     socket_base::bytes_readable bytes_readable;
@@ -631,6 +662,70 @@ void test()
   BOOST_ASIO_CHECK(!static_cast<bool>(enable_connection_aborted4));
   BOOST_ASIO_CHECK(!enable_connection_aborted4);
 
+  // exclusive_wakeup class.
+
+#if defined(BOOST_ASIO_HAS_EPOLL) || defined(BOOST_ASIO_HAS_IOCP) \
+  || defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+  socket_base::exclusive_wakeup exclusive_wakeup1(true);
+  BOOST_ASIO_CHECK(exclusive_wakeup1.value());
+  BOOST_ASIO_CHECK(static_cast<bool>(exclusive_wakeup1));
+  BOOST_ASIO_CHECK(!!exclusive_wakeup1);
+  tcp_acceptor.set_option(exclusive_wakeup1, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::exclusive_wakeup exclusive_wakeup2;
+  tcp_acceptor.get_option(exclusive_wakeup2, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  BOOST_ASIO_CHECK(exclusive_wakeup2.value());
+  BOOST_ASIO_CHECK(static_cast<bool>(exclusive_wakeup2));
+  BOOST_ASIO_CHECK(!!exclusive_wakeup2);
+#endif // defined(BOOST_ASIO_HAS_EPOLL) || defined(BOOST_ASIO_HAS_IOCP)
+       //   || defined(BOOST_ASIO_HAS_IO_URING_AS_DEFAULT)
+
+  socket_base::exclusive_wakeup exclusive_wakeup3(false);
+  BOOST_ASIO_CHECK(!exclusive_wakeup3.value());
+  BOOST_ASIO_CHECK(!static_cast<bool>(exclusive_wakeup3));
+  BOOST_ASIO_CHECK(!exclusive_wakeup3);
+  tcp_acceptor.set_option(exclusive_wakeup3, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::exclusive_wakeup exclusive_wakeup4;
+  tcp_acceptor.get_option(exclusive_wakeup4, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  BOOST_ASIO_CHECK(!exclusive_wakeup4.value());
+  BOOST_ASIO_CHECK(!static_cast<bool>(exclusive_wakeup4));
+  BOOST_ASIO_CHECK(!exclusive_wakeup4);
+
+#if defined(SO_BUSY_POLL) && defined(SO_PREFER_BUSY_POLL)
+  // busy_poll class.
+
+  socket_base::busy_poll busy_poll1(0);
+  BOOST_ASIO_CHECK(busy_poll1.value() == 0);
+  udp_sock.set_option(busy_poll1, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::busy_poll busy_poll2;
+  udp_sock.get_option(busy_poll2, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  BOOST_ASIO_CHECK(busy_poll2.value() == 0);
+
+  // prefer_busy_poll class.
+
+  socket_base::prefer_busy_poll prefer_busy_poll1(true);
+  BOOST_ASIO_CHECK(prefer_busy_poll1.value());
+  BOOST_ASIO_CHECK(static_cast<bool>(prefer_busy_poll1));
+  BOOST_ASIO_CHECK(!!prefer_busy_poll1);
+  udp_sock.set_option(prefer_busy_poll1, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+
+  socket_base::prefer_busy_poll prefer_busy_poll2;
+  udp_sock.get_option(prefer_busy_poll2, ec);
+  BOOST_ASIO_CHECK_MESSAGE(!ec, ec.value() << ", " << ec.message());
+  BOOST_ASIO_CHECK(prefer_busy_poll2.value());
+  BOOST_ASIO_CHECK(static_cast<bool>(prefer_busy_poll2));
+  BOOST_ASIO_CHECK(!!prefer_busy_poll2);
+#endif // defined(SO_BUSY_POLL) && defined(SO_PREFER_BUSY_POLL)
+
   // bytes_readable class.
 
   socket_base::bytes_readable bytes_readable;
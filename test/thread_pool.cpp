@@ -16,9 +16,15 @@
 // Test that header file is self-contained.
 #include <boost/asio/thread_pool.hpp>
 
+#include <atomic>
 #include <functional>
+#include <memory>
+#include <vector>
+#include <boost/asio/current_processor.hpp>
 #include <boost/asio/dispatch.hpp>
+#include <boost/asio/io_context.hpp>
 #include <boost/asio/post.hpp>
+#include <boost/asio/steady_timer.hpp>
 #include "unit_test.hpp"
 
 using namespace boost::asio;
@@ -77,6 +83,234 @@ void thread_pool_test()
   BOOST_ASIO_CHECK(count3 == 0);
 }
 
+void atomic_increment(boost::asio::detail::atomic_count* count)
+{
+  ++(*count);
+}
+
+void fan_out(thread_pool* pool,
+    boost::asio::detail::atomic_count* count, int depth)
+{
+  ++(*count);
+  if (depth > 0)
+    for (int i = 0; i < 4; ++i)
+      boost::asio::post(*pool, bindns::bind(fan_out, pool, count, depth - 1));
+}
+
+void thread_pool_work_stealing_test()
+{
+  boost::asio::context_options options;
+  options.work_stealing(true);
+
+  thread_pool pool(4, options);
+  boost::asio::detail::atomic_count count(0);
+
+  for (int i = 0; i < 100; ++i)
+    boost::asio::post(pool, bindns::bind(atomic_increment, &count));
+  boost::asio::post(pool, bindns::bind(fan_out, &pool, &count, 6));
+
+  int count2 = 10;
+  boost::asio::post(pool, bindns::bind(decrement_to_zero, &pool, &count2));
+
+  pool.wait();
+
+  BOOST_ASIO_CHECK(count == 100 + 5461);
+  BOOST_ASIO_CHECK(count2 == 0);
+}
+
+void thread_pool_spin_test()
+{
+  boost::asio::context_options options;
+  options.spin_duration(boost::asio::chrono::microseconds(100));
+
+  thread_pool pool(2, options);
+  boost::asio::detail::atomic_count count(0);
+
+  boost::asio::post(pool, bindns::bind(fan_out, &pool, &count, 5));
+
+  pool.wait();
+
+  BOOST_ASIO_CHECK(count == 1365);
+
+  boost::asio::context_metrics m = pool.metrics();
+  BOOST_ASIO_CHECK(m.spin_hits() + m.spin_misses() <= m.spin_count());
+}
+
+void thread_pool_batch_test()
+{
+  boost::asio::context_options options;
+  options.dequeue_batch_size(16);
+
+  thread_pool pool(4, options);
+  boost::asio::detail::atomic_count count(0);
+
+  boost::asio::post(pool, bindns::bind(fan_out, &pool, &count, 6));
+
+  pool.wait();
+
+  BOOST_ASIO_CHECK(count == 5461);
+}
+
+void thread_pool_metrics_test()
+{
+  boost::asio::context_options options;
+  options.collect_metrics(true);
+
+  thread_pool pool(2, options);
+  boost::asio::detail::atomic_count count(0);
+
+  boost::asio::post(pool, bindns::bind(fan_out, &pool, &count, 5));
+
+  pool.wait();
+
+  BOOST_ASIO_CHECK(count == 1365);
+
+  boost::asio::context_metrics m = pool.metrics();
+  BOOST_ASIO_CHECK(m.handlers_run() == 1365);
+  BOOST_ASIO_CHECK(m.queue_depth() == 0);
+  BOOST_ASIO_CHECK(!m.threads().empty());
+  BOOST_ASIO_CHECK(m.threads().size() <= 2);
+}
+
+void check_processor(std::size_t expected,
+    boost::asio::detail::atomic_count* mismatches)
+{
+  boost::system::error_code ec;
+  if (boost::asio::current_processor(ec) != expected || ec)
+    ++(*mismatches);
+}
+
+void thread_pool_affinity_test()
+{
+  boost::system::error_code ec;
+  std::size_t processor = boost::asio::current_processor(ec);
+  std::size_t node = boost::asio::current_numa_node(ec);
+  if (ec)
+    return;
+
+  boost::asio::context_options options1;
+  options1.processors(std::vector<std::size_t>(1, processor));
+
+  thread_pool pool1(2, options1);
+  boost::asio::detail::atomic_count mismatches(0);
+
+  for (int i = 0; i < 16; ++i)
+    boost::asio::post(pool1, bindns::bind(check_processor,
+          processor, &mismatches));
+
+  pool1.wait();
+
+  BOOST_ASIO_CHECK(mismatches == 0);
+
+  boost::asio::context_options options2;
+  options2.numa_nodes(std::vector<std::size_t>(1, node));
+
+  thread_pool pool2(4, options2);
+  boost::asio::detail::atomic_count count(0);
+
+  boost::asio::post(pool2, bindns::bind(fan_out, &pool2, &count, 6));
+
+  pool2.wait();
+
+  BOOST_ASIO_CHECK(count == 5461);
+}
+
+void sleep_for_ms(int ms)
+{
+  boost::asio::io_context ioc;
+  boost::asio::steady_timer t(ioc, boost::asio::chrono::milliseconds(ms));
+  t.wait();
+}
+
+void sleep_increment(boost::asio::detail::atomic_count* count)
+{
+  sleep_for_ms(10);
+  ++(*count);
+}
+
+class recording_policy : public boost::asio::thread_pool_resize_policy
+{
+public:
+  recording_policy()
+    : grows_(0),
+      shrinks_(0),
+      threads_(1),
+      max_threads_(1)
+  {
+  }
+
+  void resized(const boost::asio::thread_pool_resize_event& event)
+  {
+    if (event.threads > event.previous_threads)
+      ++grows_;
+    else
+      ++shrinks_;
+    threads_ = event.threads;
+    if (event.threads > max_threads_)
+      max_threads_ = event.threads;
+  }
+
+  boost::asio::detail::atomic_count grows_;
+  boost::asio::detail::atomic_count shrinks_;
+  std::atomic<std::size_t> threads_;
+  std::atomic<std::size_t> max_threads_;
+};
+
+void thread_pool_elastic_test()
+{
+  std::shared_ptr<recording_policy> policy(new recording_policy);
+
+  boost::asio::thread_pool_elasticity elasticity;
+  elasticity.min_threads(1);
+  elasticity.max_threads(4);
+  elasticity.target_latency(boost::asio::chrono::milliseconds(1));
+  elasticity.idle_timeout(boost::asio::chrono::milliseconds(50));
+  elasticity.sample_interval(boost::asio::chrono::milliseconds(2));
+  elasticity.policy(policy);
+
+  thread_pool pool(elasticity);
+  boost::asio::detail::atomic_count count(0);
+
+  // A burst of slow functions makes the pool grow.
+  for (int i = 0; i < 16; ++i)
+    boost::asio::post(pool, bindns::bind(sleep_increment, &count));
+
+  for (int i = 0; i < 500 && count != 16; ++i)
+    sleep_for_ms(10);
+
+  BOOST_ASIO_CHECK(count == 16);
+  BOOST_ASIO_CHECK(policy->grows_ > 0);
+  BOOST_ASIO_CHECK(policy->max_threads_ > 1);
+  BOOST_ASIO_CHECK(policy->max_threads_ <= 4);
+
+  // The added threads retire once the pool is idle.
+  for (int i = 0; i < 500 && policy->threads_ != 1; ++i)
+    sleep_for_ms(10);
+
+  BOOST_ASIO_CHECK(policy->shrinks_ > 0);
+  BOOST_ASIO_CHECK(policy->threads_ == 1);
+
+  boost::asio::post(pool, bindns::bind(atomic_increment, &count));
+  pool.join();
+
+  BOOST_ASIO_CHECK(count == 17);
+
+  // A pool that cannot grow runs its minimum number of threads.
+  boost::asio::thread_pool_elasticity fixed;
+  fixed.min_threads(0);
+  fixed.max_threads(0);
+  boost::asio::context_options options;
+  options.collect_metrics(true);
+
+  thread_pool pool2(fixed, options);
+  count = 0;
+
+  boost::asio::post(pool2, bindns::bind(fan_out, &pool2, &count, 4));
+  pool2.wait();
+
+  BOOST_ASIO_CHECK(count == 341);
+}
+
 class test_service : public boost::asio::execution_context::service
 {
 public:
@@ -277,6 +511,12 @@ BOOST_ASIO_TEST_SUITE
 (
   "thread_pool",
   BOOST_ASIO_TEST_CASE(thread_pool_test)
+  BOOST_ASIO_TEST_CASE(thread_pool_work_stealing_test)
+  BOOST_ASIO_TEST_CASE(thread_pool_spin_test)
+  BOOST_ASIO_TEST_CASE(thread_pool_batch_test)
+  BOOST_ASIO_TEST_CASE(thread_pool_metrics_test)
+  BOOST_ASIO_TEST_CASE(thread_pool_affinity_test)
+  BOOST_ASIO_TEST_CASE(thread_pool_elastic_test)
   BOOST_ASIO_TEST_CASE(thread_pool_service_test)
   BOOST_ASIO_TEST_CASE(thread_pool_executor_query_test)
   BOOST_ASIO_TEST_CASE(thread_pool_executor_execute_test)
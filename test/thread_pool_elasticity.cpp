@@ -0,0 +1,87 @@
+//
+// thread_pool_elasticity.cpp
+// ~~~~~~~~~~~~~~~~~~~~~~~~~~
+//
+// Copyright (c) 2003-2024 Christopher M. Kohlhoff (chris at kohlhoff dot com)
+//
+// Distributed under the Boost Software License, Version 1.0. (See accompanying
+// file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+//
+
+// Disable autolinking for unit tests.
+#if !defined(BOOST_ALL_NO_LIB)
+#define BOOST_ALL_NO_LIB 1
+#endif // !defined(BOOST_ALL_NO_LIB)
+
+// Test that header file is self-contained.
+#include <boost/asio/thread_pool_elasticity.hpp>
+
+#include "unit_test.hpp"
+
+void thread_pool_elasticity_test()
+{
+  boost::asio::thread_pool_elasticity elasticity;
+
+  BOOST_ASIO_CHECK(elasticity.min_threads() == 1);
+  BOOST_ASIO_CHECK(elasticity.max_threads() == 0);
+  BOOST_ASIO_CHECK(
+      elasticity.target_latency() > boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(
+      elasticity.idle_timeout() > boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(
+      elasticity.sample_interval() > boost::asio::chrono::nanoseconds(0));
+  BOOST_ASIO_CHECK(!elasticity.policy());
+
+  elasticity.min_threads(2);
+  BOOST_ASIO_CHECK(elasticity.min_threads() == 2);
+
+  elasticity.max_threads(16);
+  BOOST_ASIO_CHECK(elasticity.max_threads() == 16);
+
+  elasticity.target_latency(boost::asio::chrono::microseconds(200));
+  BOOST_ASIO_CHECK(
+      elasticity.target_latency() == boost::asio::chrono::microseconds(200));
+
+  elasticity.idle_timeout(boost::asio::chrono::seconds(5));
+  BOOST_ASIO_CHECK(
+      elasticity.idle_timeout() == boost::asio::chrono::seconds(5));
+
+  elasticity.sample_interval(boost::asio::chrono::milliseconds(1));
+  BOOST_ASIO_CHECK(
+      elasticity.sample_interval() == boost::asio::chrono::milliseconds(1));
+
+  std::shared_ptr<boost::asio::thread_pool_resize_policy> policy(
+      new boost::asio::thread_pool_resize_policy);
+  elasticity.policy(policy);
+  BOOST_ASIO_CHECK(elasticity.policy() == policy);
+
+  boost::asio::thread_pool_elasticity elasticity2(elasticity);
+  BOOST_ASIO_CHECK(elasticity2.min_threads() == 2);
+  BOOST_ASIO_CHECK(elasticity2.max_threads() == 16);
+  BOOST_ASIO_CHECK(elasticity2.policy() == policy);
+
+  // The default policy grows above the target latency and retires threads
+  // after the idle timeout.
+  boost::asio::thread_pool_load load;
+  load.threads = 4;
+  load.min_threads = 2;
+  load.max_threads = 16;
+  load.queue_latency = boost::asio::chrono::microseconds(100);
+  load.target_latency = boost::asio::chrono::microseconds(200);
+  load.idle_timeout = boost::asio::chrono::seconds(5);
+
+  BOOST_ASIO_CHECK(policy->threads_to_add(load) == 0);
+  load.queue_latency = boost::asio::chrono::microseconds(300);
+  BOOST_ASIO_CHECK(policy->threads_to_add(load) == 1);
+
+  BOOST_ASIO_CHECK(!policy->should_retire(load,
+        boost::asio::chrono::seconds(1)));
+  BOOST_ASIO_CHECK(policy->should_retire(load,
+        boost::asio::chrono::seconds(5)));
+}
+
+BOOST_ASIO_TEST_SUITE
+(
+  "thread_pool_elasticity",
+  BOOST_ASIO_TEST_CASE(thread_pool_elasticity_test)
+)